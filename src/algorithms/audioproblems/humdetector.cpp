@@ -172,6 +172,8 @@ void HumDetector::configure() {
                             "timeContinuity", _timeContinuity);
 
 
+  _smoothingArray = _Smoothing->inputHandle<vector<Real> >("array");
+
   _referenceTerm = 0.5 - _binsInOctave * log2(_minimumFrequency);
 
   _EPS = numeric_limits<Real>::epsilon();
@@ -257,7 +259,7 @@ AlgorithmStatus HumDetector::process() {
   vector<Real> filtered = vector<Real>(_spectSize, 0.f);
   _Smoothing->configure("kernelSize", _medianFilterSize); 
   _Smoothing->output("filteredArray").set(filtered);
-  _Smoothing->input("array").set(rSpec);
+  _smoothingArray.set(rSpec);
   for (uint j = 0; j < _iterations; j++) {
     for (uint i = 0; i < _spectSize; i++) {
       rSpec[i] = r[i][j];
@@ -275,7 +277,7 @@ AlgorithmStatus HumDetector::process() {
   _Smoothing->output("filteredArray").set(filtered);
 
   for (uint i = 0; i < _spectSize; i++) {
-    _Smoothing->input("array").set(r[i]);
+    _smoothingArray.set(r[i]);
     _Smoothing->compute();
 
     for (uint j = 0; j < _iterations; j++)
@@ -292,6 +294,19 @@ AlgorithmStatus HumDetector::process() {
   bool peakBinsNotEmpty = false;
   Real threshold;
 
+  // the same buffers are used for all the iterations
+  _spectralPeaks->input("spectrum").set(rSpec);
+  _spectralPeaks->output("frequencies").set(frequencies);
+  _spectralPeaks->output("magnitudes").set(magnitudes);
+
+  _pitchSalienceFunction->input("frequencies").set(frequencies);
+  _pitchSalienceFunction->input("magnitudes").set(magnitudes);
+  _pitchSalienceFunction->output("salienceFunction").set(salienceFunction);
+
+  _pitchSalienceFunctionPeaks->input("salienceFunction").set(salienceFunction);
+  _pitchSalienceFunctionPeaks->output("salienceBins").set(salienceBins);
+  _pitchSalienceFunctionPeaks->output("salienceValues").set(salienceValues);
+
   // finally the r matrix is feed into the pitch contours recommended signal chain
   for (uint j = 0; j < _iterations; j++) {
     for (uint i = 0; i < _spectSize; i++) 
@@ -305,19 +320,8 @@ AlgorithmStatus HumDetector::process() {
                               "magnitudeThreshold", threshold,
                               "maxPeaks", 5);
 
-    _spectralPeaks->input("spectrum").set(rSpec);
-    _spectralPeaks->output("frequencies").set(frequencies);
-    _spectralPeaks->output("magnitudes").set(magnitudes);
     _spectralPeaks->compute();
-
-    _pitchSalienceFunction->input("frequencies").set(frequencies);
-    _pitchSalienceFunction->input("magnitudes").set(magnitudes);
-    _pitchSalienceFunction->output("salienceFunction").set(salienceFunction);
     _pitchSalienceFunction->compute();
-
-    _pitchSalienceFunctionPeaks->input("salienceFunction").set(salienceFunction);
-    _pitchSalienceFunctionPeaks->output("salienceBins").set(salienceBins);
-    _pitchSalienceFunctionPeaks->output("salienceValues").set(salienceValues);
     _pitchSalienceFunctionPeaks->compute();
 
     peakBins[j] = salienceBins;
@@ -41,6 +41,8 @@ class HumDetector : public AlgorithmComposite {
   standard::Algorithm* _pitchSalienceFunctionPeaks;
   standard::Algorithm* _pitchContours;
 
+  standard::InputHandle<std::vector<Real> > _smoothingArray;
+
   SinkProxy<Real> _signal;
 
   Source<TNT::Array2D<Real> > _rMatrix;
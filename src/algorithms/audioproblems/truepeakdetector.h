@@ -65,7 +65,7 @@ class TruePeakDetector : public Algorithm {
   void declareParameters() {
     declareParameter("sampleRate", "the sampling rate of the audio signal [Hz]", "(0,inf)", 44100.);
     declareParameter("oversamplingFactor", "times the signal is oversapled", "[1,inf)", 4);
-    declareParameter("quality", "type of interpolation applied (see libresmple)", "[0,4]", 1);
+    declareParameter("quality", "type of interpolation applied (see the quality parameter of Resample)", "[0,5]", 1);
     declareParameter("blockDC", "flag to activate the optional DC blocker", "{true,false}", false);
     declareParameter("emphasise", "flag to activate the optional emphasis filter", "{true,false}", false);
     declareParameter("threshold", "threshold to detect peaks [dB]", "(-inf,inf)", -0.0002);
@@ -19,6 +19,7 @@
 
 #include "extractor.h"
 #include "algorithmfactory.h"
+#include "algorithmpool.h"
 #include "essentiamath.h"
 #include "poolstorage.h"
 #include "vectorinput.h"
@@ -238,16 +239,20 @@ void Extractor::computeRelativeIoi(Pool& p) {
     fullIoi[i][1]=fullIoiDist[i].second;
   }
   size = ioiDist.size();
-  Algorithm * peakDetection = AlgorithmFactory::create("PeakDetection",
-                                                       "minPosition", 0., "maxPosition", size,
-                                                       "maxPeaks", 5, "range", size-1,
-                                                       "interpolate", true, "orderBy", "amplitude");
+  ParameterMap peakParams;
+  peakParams.add("minPosition", 0.);
+  peakParams.add("maxPosition", size);
+  peakParams.add("maxPeaks", 5);
+  peakParams.add("range", size-1);
+  peakParams.add("interpolate", true);
+  peakParams.add("orderBy", "amplitude");
+  Algorithm * peakDetection = AlgorithmPool::acquire("PeakDetection", peakParams);
   vector<Real> pos, values;
   peakDetection->input("array").set(ioiDist);
   peakDetection->output("positions").set(pos);
   peakDetection->output("amplitudes").set(values);
   peakDetection->compute();
-  delete peakDetection;
+  AlgorithmPool::release(peakDetection);
 
   //vector<pair<Real, Real> > ioi_peaks(pos.size());
   TNT::Array2D<Real> ioi_peaks(pos.size(), 2);
@@ -318,9 +323,9 @@ void Extractor::tuningSystemFeatures(Pool& pool) {
   normalize(hpcp_highres);
 
   // 1- diatonic strength
-  AlgorithmFactory& factory = AlgorithmFactory::instance();
-
-  Algorithm* keyDetect = factory.create("Key", "profileType", "diatonic");
+  ParameterMap keyParams;
+  keyParams.add("profileType", "diatonic");
+  Algorithm* keyDetect = AlgorithmPool::acquire("Key", keyParams);
 
   string key, scale;
   Real strength, unused;
@@ -334,7 +339,7 @@ void Extractor::tuningSystemFeatures(Pool& pool) {
   pool.set(_tonalspace + "tuning_diatonic_strength", strength);
 
   // 2- high resolution features
-  Algorithm* highres = factory.create("HighResolutionFeatures");
+  Algorithm* highres = AlgorithmPool::acquire("HighResolutionFeatures");
 
   Real eqTempDeviation, ntEnergy, ntPeaks;
   highres->input("hpcp").set(hpcp_highres);
@@ -361,44 +366,45 @@ void Extractor::tuningSystemFeatures(Pool& pool) {
 
   pool.set(_tonalspace + "thpcp", hpcp);
 
-  delete keyDetect;
-  delete highres;
+  AlgorithmPool::release(keyDetect);
+  AlgorithmPool::release(highres);
 }
 
 void Extractor::sfxPitch(Pool& pool) {
   vector<Real> pitch = pool.value<vector<Real> >(_llspace + "pitch");
 
-  Algorithm* maxtt = AlgorithmFactory::create("MaxToTotal");
+  Algorithm* maxtt = AlgorithmPool::acquire("MaxToTotal");
   Real maxToTotal;
   maxtt->input("envelope").set(pitch);
   maxtt->output("maxToTotal").set(maxToTotal);
   maxtt->compute();
   pool.set(_sfxspace + "pitch_max_to_total", maxToTotal);
 
-  Algorithm* mintt = AlgorithmFactory::create("MinToTotal");
+  Algorithm* mintt = AlgorithmPool::acquire("MinToTotal");
   Real minToTotal;
   mintt->input("envelope").set(pitch);
   mintt->output("minToTotal").set(minToTotal);
   mintt->compute();
   pool.set(_sfxspace + "pitch_min_to_total", minToTotal);
 
-  Algorithm* pc = AlgorithmFactory::create("Centroid");
+  ParameterMap centroidParams;
+  centroidParams.add("range", (uint)pitch.size() - 1);
+  Algorithm* pc = AlgorithmPool::acquire("Centroid", centroidParams);
   Real centroid;
-  pc->configure("range", (uint)pitch.size() - 1);
   pc->input("array").set(pitch);
   pc->output("centroid").set(centroid);
   pc->compute();
   pool.set(_sfxspace + "pitch_centroid", centroid);
 
-  Algorithm* amt = AlgorithmFactory::create("AfterMaxToBeforeMaxEnergyRatio");
+  Algorithm* amt = AlgorithmPool::acquire("AfterMaxToBeforeMaxEnergyRatio");
   Real ratio;
   amt->input("pitch").set(pitch);
   amt->output("afterMaxToBeforeMaxEnergyRatio").set(ratio);
   amt->compute();
   pool.set(_sfxspace + "pitch_after_max_to_before_max_energy_ratio", ratio);
 
-  delete maxtt;
-  delete mintt;
-  delete pc;
-  delete amt;
+  AlgorithmPool::release(maxtt);
+  AlgorithmPool::release(mintt);
+  AlgorithmPool::release(pc);
+  AlgorithmPool::release(amt);
 }
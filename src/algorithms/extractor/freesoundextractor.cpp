@@ -18,12 +18,21 @@
  */
 
 #include "freesoundextractor.h"
+#include "lowlevelsegments.h"
 
 using namespace std;
 
 namespace essentia {
 namespace standard {
 
+// frame-level low-level descriptors computed on segments of the audio when
+// segmentDuration is set
+static void createLowlevelSegmentNetwork(SourceBase& source, Pool& options, Pool& pool) {
+  FreesoundLowlevelDescriptors lowlevel(options);
+  lowlevel.createNetworkFrames(source, pool);
+}
+
+
 const char* FreesoundExtractor::name = "FreesoundExtractor";
 const char* FreesoundExtractor::category = "Extractors";
 const char* FreesoundExtractor::description = DOC("This algorithm is a wrapper for Freesound Extractor. See documentation for 'essentia_streaming_extractor_freesound'.");
@@ -55,6 +64,7 @@ void FreesoundExtractor::configure() {
   analysisSampleRate = parameter("analysisSampleRate").toReal();
   startTime = parameter("startTime").toReal();
   endTime = parameter("endTime").toReal();
+  segmentDuration = parameter("segmentDuration").toReal();
 
   lowlevelFrameSize = parameter("lowlevelFrameSize").toInt();
   lowlevelHopSize = parameter("lowlevelHopSize").toInt();
@@ -100,6 +110,7 @@ void FreesoundExtractor::configure() {
     analysisSampleRate = options.value<Real>("analysisSampleRate");
     startTime = options.value<Real>("startTime");
     endTime = options.value<Real>("endTime");
+    segmentDuration = options.value<Real>("segmentDuration");
   }
 
   if (options.value<Real>("highlevel.compute")) {
@@ -118,6 +129,7 @@ void FreesoundExtractor::setExtractorDefaultOptions() {
   options.set("startTime", startTime);
   options.set("endTime", endTime);
   options.set("analysisSampleRate", analysisSampleRate);
+  options.set("segmentDuration", segmentDuration);
 
   // lowlevel
   options.set("lowlevel.frameSize", lowlevelFrameSize);
@@ -213,15 +225,30 @@ void FreesoundExtractor::compute() {
   FreesoundTonalDescriptors *tonal = new FreesoundTonalDescriptors(options);
   FreesoundSfxDescriptors *sfx = new FreesoundSfxDescriptors(options);
  
+  // with segmentDuration, the frame-level low-level descriptors are computed
+  // on segments of the audio in separate threads, while the descriptors which
+  // need the whole audio are computed by this network. The segments are
+  // loaded with the default replay gain of EasyLoader, as the whole audio
+  util::LowlevelSegments segments;
+  segments.create(options, results.value<Real>("metadata.audio_properties.analysis.length"),
+                  audioFilename, -6.0, downmix, createLowlevelSegmentNetwork);
+
   SourceBase& source = loader->output("audio");
-  lowlevel->createNetwork(loader->output("audio"),results);
+  if (segments.empty()) {
+    lowlevel->createNetwork(loader->output("audio"),results);
+  }
+  else {
+    lowlevel->createNetworkWholeAudio(loader->output("audio"), results);
+  }
   rhythm->createNetwork(source, results);
   tonal->createNetwork(source, results);
   sfx->createNetwork(loader->output("audio"),results);
   sfx->createHarmonicityNetwork(loader->output("audio"), results);            
 
+  segments.start();
   scheduler::Network network(loader);
   network.run();
+  segments.merge(results);
   
   // Descriptors that require values from other descriptors in the previous chain
   
@@ -265,8 +292,8 @@ void FreesoundExtractor::compute() {
   }
   E_INFO("All done");
   
-  resultsStats = stats;
-  resultsFrames = results;
+  resultsStats.swap(stats);
+  resultsFrames.swap(results);
 }
 
 
@@ -400,7 +427,7 @@ void FreesoundExtractor::readMetadata(const string& audioFilename, Pool& results
 
   metadata->compute();
 
-  results.merge(poolTags);
+  results.absorb(poolTags);
   delete metadata;
 
 #if defined(OS_WIN32) && !defined(OS_MINGW)
@@ -563,7 +590,7 @@ void FreesoundExtractor::setExtractorOptions(const std::string& filename) {
   yaml->output("pool").set(opts);
   yaml->compute();
   delete yaml;
-  options.merge(opts, "replace");
+  options.absorb(opts, "replace");
 }
 
 } // namespace standard
@@ -41,6 +41,7 @@ class FreesoundExtractor : public Algorithm {
   Real analysisSampleRate;
   Real startTime;
   Real endTime;
+  Real segmentDuration;
 
   int lowlevelFrameSize;
   int lowlevelHopSize;
@@ -97,6 +98,7 @@ class FreesoundExtractor : public Algorithm {
     declareParameter("analysisSampleRate", "the analysis sampling rate of the audio signal [Hz]", "(0,inf)", 44100.0);
     declareParameter("startTime", "the start time of the slice you want to extract [s]", "[0,inf)", 0.0);
     declareParameter("endTime", "the end time of the slice you want to extract [s]", "[0,inf)", 1.0e6); 
+    declareParameter("segmentDuration", "the duration of the segments in which frame-level low-level features are computed in parallel threads, 0 to compute them on the whole audio in a single thread [s]. The frames are the same, but their values may differ slightly from the ones computed on the whole audio: each segment is decoded from a point found by seeking in the file, and its filters only analyze one second of audio before its first frame", "[0,inf)", 0.0);
     declareParameter("lowlevelFrameSize", "the frame size for computing low-level features", "(0,inf)", 2048);
     declareParameter("lowlevelHopSize", "the hop size for computing low-level features", "(0,inf)", 1024);
     declareParameter("lowlevelZeroPadding", "zero padding factor for computing low-level features", "[0,inf)", 0);
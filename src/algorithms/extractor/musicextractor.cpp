@@ -19,12 +19,22 @@
 
 #include "musicextractor.h"
 #include "extractor_music/tagwhitelist.h"
+#include "lowlevelsegments.h"
 
 using namespace std;
 
 namespace essentia {
 namespace standard {
 
+// frame-level low-level descriptors computed on segments of the audio when
+// segmentDuration is set
+static void createLowlevelSegmentNetwork(SourceBase& source, Pool& options, Pool& pool) {
+  MusicLowlevelDescriptors lowlevel(options);
+  lowlevel.createNetworkNeqLoud(source, pool);
+  lowlevel.createNetworkEqLoud(source, pool);
+}
+
+
 const char* MusicExtractor::name = "MusicExtractor";
 const char* MusicExtractor::category = "Extractors";
 const char* MusicExtractor::description = DOC("This algorithm is a wrapper for Music Extractor. See documentation for 'essentia_streaming_extractor_music'.");
@@ -57,6 +67,7 @@ void MusicExtractor::configure() {
   startTime = parameter("startTime").toReal();
   endTime = parameter("endTime").toReal();
   requireMbid = parameter("requireMbid").toBool();
+  segmentDuration = parameter("segmentDuration").toReal();
 
   lowlevelFrameSize = parameter("lowlevelFrameSize").toInt();
   lowlevelHopSize = parameter("lowlevelHopSize").toInt();
@@ -101,6 +112,7 @@ void MusicExtractor::configure() {
     startTime = options.value<Real>("startTime");
     endTime = options.value<Real>("endTime");
     requireMbid = options.value<Real>("requireMbid");
+    segmentDuration = options.value<Real>("segmentDuration");
   }
 
   if (options.value<Real>("highlevel.compute")) {
@@ -120,6 +132,7 @@ void MusicExtractor::setExtractorDefaultOptions() {
   options.set("endTime", endTime);
   options.set("analysisSampleRate", analysisSampleRate);
   options.set("requireMbid", requireMbid);
+  options.set("segmentDuration", segmentDuration);
 
   // lowlevel
   options.set("lowlevel.frameSize", lowlevelFrameSize);
@@ -221,15 +234,26 @@ void MusicExtractor::compute() {
   MusicRhythmDescriptors *rhythm = new MusicRhythmDescriptors(options);
   MusicTonalDescriptors *tonal = new MusicTonalDescriptors(options);
   
+  // with segmentDuration, the frame-level low-level descriptors are computed
+  // on segments of the audio in separate threads, while the descriptors which
+  // need the whole audio are computed by this network
+  util::LowlevelSegments segments;
+  segments.create(options, results.value<Real>("metadata.audio_properties.analysis.length"),
+                  audioFilename, replayGain, downmix, createLowlevelSegmentNetwork);
+
   SourceBase& source = loader->output("audio");
-  lowlevel->createNetworkNeqLoud(source, results);
-  lowlevel->createNetworkEqLoud(source, results);
+  if (segments.empty()) {
+    lowlevel->createNetworkNeqLoud(source, results);
+    lowlevel->createNetworkEqLoud(source, results);
+  }
   lowlevel->createNetworkLoudness(source, results);
   rhythm->createNetwork(source, results);
   tonal->createNetworkTuningFrequency(source, results);
 
+  segments.start();
   scheduler::Network network(loader);
   network.run();
+  segments.merge(results);
   
   // Descriptors that require values from other descriptors in the previous chain
   lowlevel->computeAverageLoudness(results);  // requires 'loudness'
@@ -275,8 +299,8 @@ void MusicExtractor::compute() {
   }
   E_INFO("All done");
   
-  resultsStats = stats;
-  resultsFrames = results;
+  resultsStats.swap(stats);
+  resultsFrames.swap(results);
 }
 
 
@@ -396,7 +420,7 @@ void MusicExtractor::readMetadata(const string& audioFilename, Pool& results) {
 
   metadata->compute();
 
-  results.merge(poolTags);
+  results.absorb(poolTags);
   delete metadata;
 
 #if defined(OS_WIN32) && !defined(OS_MINGW)
@@ -582,7 +606,7 @@ void MusicExtractor::setExtractorOptions(const std::string& filename) {
   yaml->output("pool").set(opts);
   yaml->compute();
   delete yaml;
-  options.merge(opts, "replace");
+  options.absorb(opts, "replace");
 }
 
 } // namespace standard
@@ -41,6 +41,7 @@ class MusicExtractor : public Algorithm {
   Real startTime;
   Real endTime;
   bool requireMbid;
+  Real segmentDuration;
 
   int lowlevelFrameSize;
   int lowlevelHopSize;
@@ -100,6 +101,7 @@ class MusicExtractor : public Algorithm {
     declareParameter("requireMbid", "ignore audio files without musicbrainz recording id tag (throw exception)", "{true,false}", false);
     // requireMbid option is very specific for AcousticBrainz extractor
     // however, we'll keep it here for now...
+    declareParameter("segmentDuration", "the duration of the segments in which frame-level low-level features are computed in parallel threads, 0 to compute them on the whole audio in a single thread [s]. The frames are the same, but their values may differ slightly from the ones computed on the whole audio: each segment is decoded from a point found by seeking in the file, and its filters only analyze one second of audio before its first frame", "[0,inf)", 0.0);
   
     declareParameter("lowlevelFrameSize", "the frame size for computing low-level features", "(0,inf)", 2048);
     declareParameter("lowlevelHopSize", "the hop size for computing low-level features", "(0,inf)", 1024);
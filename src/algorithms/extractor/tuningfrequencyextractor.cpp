@@ -31,7 +31,7 @@ const char* TuningFrequencyExtractor::category = essentia::standard::TuningFrequ
 const char* TuningFrequencyExtractor::description = essentia::standard::TuningFrequencyExtractor::description;
 
 
-TuningFrequencyExtractor::TuningFrequencyExtractor(): _frameCutter(0), _spectralPeaks(0), _spectrum(0), _tuningFrequency(0), _windowing(0) {
+TuningFrequencyExtractor::TuningFrequencyExtractor(): _spectralPeaks(0), _spectrum(0), _tuningFrequency(0) {
   createInnerNetwork();
 }
 
@@ -39,13 +39,10 @@ void TuningFrequencyExtractor::createInnerNetwork() {
 
   AlgorithmFactory& factory = AlgorithmFactory::instance();
 
-  _frameCutter     = factory.create("FrameCutter");
   _spectralPeaks   = factory.create("SpectralPeaks");
-  _spectrum        = factory.create("Spectrum");
+  _spectrum        = factory.create("FrameCutterSpectrum");
   _tuningFrequency = factory.create("TuningFrequency");
-  _windowing       = factory.create("Windowing");
 
-  _windowing->configure("type", "blackmanharris62");
   _spectralPeaks->configure("orderBy", "frequency",
                             "magnitudeThreshold", 1e-05,
                             "minFrequency", 40,
@@ -55,10 +52,8 @@ void TuningFrequencyExtractor::createInnerNetwork() {
   declareInput(_signal, "signal", "the input audio signal");
   declareOutput(_tuningFreq, "tuningFrequency", "the computed tuning frequency");
 
-  attach(_signal, _frameCutter->input("signal"));
+  attach(_signal, _spectrum->input("signal"));
 
-  _frameCutter->output("frame")            >>  _windowing->input("frame");
-  _windowing->output("frame")              >>  _spectrum->input("frame");
   _spectrum->output("spectrum")            >>  _spectralPeaks->input("spectrum");
   _spectralPeaks->output("frequencies")    >>  _tuningFrequency->input("frequencies");
   _spectralPeaks->output("magnitudes")     >>  _tuningFrequency->input("magnitudes");
@@ -70,16 +65,15 @@ void TuningFrequencyExtractor::createInnerNetwork() {
 void TuningFrequencyExtractor::configure() {
   int frameSize = parameter("frameSize").toInt();
   int hopSize = parameter("hopSize").toInt();
-  _frameCutter->configure("silentFrames", "noise", "hopSize", hopSize, "frameSize", frameSize);
+  _spectrum->configure("silentFrames", "noise", "hopSize", hopSize, "frameSize", frameSize,
+                       "windowType", "blackmanharris62");
 }
 
 
 TuningFrequencyExtractor::~TuningFrequencyExtractor() {
-  delete _frameCutter;
   delete _spectralPeaks;
   delete _spectrum;
   delete _tuningFrequency;
-  delete _windowing;
 }
 
 } // namespace streaming
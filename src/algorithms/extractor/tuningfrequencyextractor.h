@@ -31,7 +31,7 @@ namespace streaming {
 
 class TuningFrequencyExtractor : public AlgorithmComposite {
  protected:
-  Algorithm* _frameCutter, *_spectralPeaks, *_spectrum, *_tuningFrequency, *_windowing;
+  Algorithm* _spectralPeaks, *_spectrum, *_tuningFrequency;
 
   SinkProxy<Real> _signal;
   SourceProxy<Real> _tuningFreq;
@@ -46,7 +46,7 @@ class TuningFrequencyExtractor : public AlgorithmComposite {
   }
 
   void declareProcessOrder() {
-    declareProcessStep(ChainFrom(_frameCutter));
+    declareProcessStep(ChainFrom(_spectrum));
   }
 
   void configure();
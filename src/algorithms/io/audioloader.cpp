@@ -198,6 +198,60 @@ string uint8_t_to_hex(uint8_t* input, int size) {
 }
 
 
+string AudioLoader::md5(const string& filename, int audioStream) {
+    av_register_all();
+
+    AVFormatContext* demuxCtx = 0;
+    if (avformat_open_input(&demuxCtx, filename.c_str(), NULL, NULL) != 0) {
+        throw EssentiaException("AudioLoader: Could not open file \"", filename, "\"");
+    }
+    if (avformat_find_stream_info(demuxCtx, NULL) < 0) {
+        avformat_close_input(&demuxCtx);
+        throw EssentiaException("AudioLoader: Could not find stream information in file \"", filename, "\"");
+    }
+
+    // same stream selection as in openAudioFile()
+    int streamIdx = -1;
+    for (int i=0, nAudioStreams=0; i<(int)demuxCtx->nb_streams; i++) {
+        if (demuxCtx->streams[i]->codec->codec_type == AVMEDIA_TYPE_AUDIO) {
+            if (nAudioStreams++ == audioStream) {
+                streamIdx = i;
+                break;
+            }
+        }
+    }
+    if (streamIdx < 0) {
+        avformat_close_input(&demuxCtx);
+        ostringstream msg;
+        msg << "AudioLoader: could not find audio stream " << audioStream << " in file \"" << filename << "\"";
+        throw EssentiaException(msg);
+    }
+
+    AVMD5* md5Encoded = av_md5_alloc();
+    if (!md5Encoded) {
+        avformat_close_input(&demuxCtx);
+        throw EssentiaException("Error allocating the MD5 context");
+    }
+    av_md5_init(md5Encoded);
+
+    AVPacket packet;
+    av_init_packet(&packet);
+    while (av_read_frame(demuxCtx, &packet) == 0) {
+        if (packet.stream_index == streamIdx) {
+            av_md5_update(md5Encoded, packet.data, packet.size);
+        }
+        av_free_packet(&packet);
+    }
+
+    uint8_t checksum[16];
+    av_md5_final(md5Encoded, checksum);
+    av_freep(&md5Encoded);
+    avformat_close_input(&demuxCtx);
+
+    return uint8_t_to_hex(checksum, 16);
+}
+
+
 AlgorithmStatus AudioLoader::process() {
     if (!parameter("filename").isConfigured()) {
         throw EssentiaException("AudioLoader: Trying to call process() on an AudioLoader algo which hasn't been correctly configured.");
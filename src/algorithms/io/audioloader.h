@@ -111,6 +111,13 @@ class AudioLoader : public Algorithm {
   AlgorithmStatus process();
   void reset();
 
+  /**
+   * Returns the MD5 checksum of the undecoded payload of the given audio
+   * stream (the same as the "md5" output), by reading the packets of the
+   * file without decoding them.
+   */
+  static std::string md5(const std::string& filename, int audioStream=0);
+
   void declareParameters() {
     declareParameter("filename", "the name of the file from which to read", "", Parameter::STRING);
     declareParameter("computeMD5", "compute the MD5 checksum", "{true,false}", false);
@@ -54,37 +54,37 @@ AlgorithmStatus AudioWriter::process() {
   if (!_audioCtx.isOpen()) _audioCtx.open();
 
   EXEC_DEBUG("process()");
-  AlgorithmStatus status = acquireData();
 
-  if (status != OK) {
-    if (!shouldStop()) return status;
+  // the audio context accumulates the samples into codec frames itself, so
+  // write everything that is available in one block
+  int available = _audio.available();
 
-    // encode whatever is left over
-    int available = _audio.available();
+  if (available == 0) {
+    if (!shouldStop()) return NO_INPUT;
 
-    if (available == 0) {
-      EXEC_DEBUG("End of stream. There are 0 available tokens");
-      shouldStop(true);
+    EXEC_DEBUG("End of stream. There are 0 available tokens");
+    shouldStop(true);
+    try {
       _audioCtx.close();
-      return FINISHED;
     }
-
-    EXEC_DEBUG("Audio frame could not be fully acquired.");
-    EXEC_DEBUG("There are " << available << " available tokens");
-    _audio.setAcquireSize(available);
-    _audio.setReleaseSize(available);
-
-    return process();
+    catch (EssentiaException& e) {
+      throw EssentiaException("AudioWriter: error writing to audio file: ", e.what());
+    }
+    return FINISHED;
   }
 
+  int n = min(available, _audio.buffer().bufferInfo().maxContiguousElements);
+  n = max(n, 1);
+  _audio.acquire(n);
+
   try {
-    _audioCtx.write(_audio.tokens());
+    _audioCtx.write(&_audio.tokens()[0], n);
   }
   catch (EssentiaException& e) {
     throw EssentiaException("AudioWriter: error writing to audio file: ", e.what());
   }
 
-  releaseData();
+  _audio.release(n);
 
   return OK;
 }
@@ -103,6 +103,7 @@ void AudioWriter::reset() {
   catch (EssentiaException& e) {
     throw EssentiaException("AudioWriter: Error creating audio file: ", e.what());
   }
+  _audioCtx.setBackgroundEncoding(parameter("backgroundEncoding").toBool());
 
   _audio.setAcquireSize(recommendedBufferSize);
   _audio.setReleaseSize(recommendedBufferSize);
@@ -121,7 +122,8 @@ const char* AudioWriter::name = "AudioWriter";
 const char* AudioWriter::category = "Input/output";
 const char* AudioWriter::description = DOC("This algorithm encodes an input stereo signal into a stereo audio file.\n\n"
 "The algorithm uses the FFmpeg library. Supported formats are wav, aiff, mp3, flac and ogg. The default FFmpeg encoders are used for each format.\n\n"
-"An exception is thrown when other extensions are given. Note that to encode in mp3 format it is mandatory that FFmpeg was configured with mp3 enabled.");
+"An exception is thrown when other extensions are given. Note that to encode in mp3 format it is mandatory that FFmpeg was configured with mp3 enabled.\n\n"
+"When backgroundEncoding is enabled, the audio is encoded and written to the file in a separate thread, fed by a bounded queue of codec frames, so that the algorithms producing the audio do not wait for the encoder. The resulting file is identical.");
 
 
 void AudioWriter::createInnerNetwork() {
@@ -139,7 +141,8 @@ void AudioWriter::configure() {
   try {
     _writer->configure(INHERIT("filename"),
                        INHERIT("format"),
-                       INHERIT("sampleRate"));
+                       INHERIT("sampleRate"),
+                       INHERIT("backgroundEncoding"));
   }
   catch (EssentiaException&) {
     // no file has been specified, do not do anything
@@ -43,6 +43,7 @@ class AudioWriter : public Algorithm {
     declareParameter("sampleRate", "the audio sampling rate [Hz]","(0,inf)", 44100.);
     declareParameter("bitrate", "the audio bit rate for compressed formats [kbps]",
                      "{32,40,48,56,64,80,96,112,128,144,160,192,224,256,320}", 192);
+    declareParameter("backgroundEncoding", "encode and write the audio in a separate thread, so that the network does not wait for the encoder", "{true,false}", false);
   }
 
   void configure();
@@ -100,6 +101,7 @@ class AudioWriter : public Algorithm {
     declareParameter("sampleRate", "the audio sampling rate [Hz]","(0,inf)", 44100.);
     declareParameter("bitrate", "the audio bit rate for compressed formats [kbps]",
                      "{32,40,48,56,64,80,96,112,128,144,160,192,224,256,320}", 192);
+    declareParameter("backgroundEncoding", "encode and write the audio in a separate thread, so that the network does not wait for the encoder", "{true,false}", false);
   }
 
   void configure();
@@ -0,0 +1,568 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "fastmonoloader.h"
+#include "algorithmfactory.h"
+#include "essentiamath.h"
+#include "resample.h"
+#include "threading.h"
+
+using namespace std;
+
+namespace essentia {
+namespace streaming {
+
+const char* FastMonoLoader::name = essentia::standard::FastMonoLoader::name;
+const char* FastMonoLoader::category = essentia::standard::FastMonoLoader::category;
+const char* FastMonoLoader::description = essentia::standard::FastMonoLoader::description;
+
+// maximum number of samples acquired at once on the output
+static const int MAX_ACQUIRE_SIZE = 65536;
+
+// when seeking, decoding starts this long before the start time [s], so that
+// the decoder and the resampler have settled when the slice begins
+static const Real SEEK_PREROLL = 1.0;
+
+// opening and closing codecs is not thread-safe in older versions of libav,
+// and loaders may run in parallel threads (see MusicExtractor)
+static ForcedMutex codecMutex;
+
+
+FastMonoLoader::FastMonoLoader() : Algorithm(),
+                                   _demuxCtx(0), _audioCtx(0), _audioCodec(0), _decodedFrame(0),
+                                   _convertCtxAv(0), _streamIdx(0), _nChannels(0), _inputSampleRate(0),
+                                   _downmix(MIX), _resample(false), _quality(1), _srcState(0),
+                                   _ratio(1.0), _gain(1.0), _startIndex(0), _endIndex(0),
+                                   _outputIndex(0), _seekPending(false) {
+
+  declareOutput(_audio, 1, "audio", "the mono audio signal");
+
+  _audio.setBufferType(BufferUsage::forLargeAudioStream);
+
+  // Register all formats and codecs
+  av_register_all();
+}
+
+FastMonoLoader::~FastMonoLoader() {
+  closeAudioFile();
+  if (_srcState) src_delete(_srcState);
+}
+
+void FastMonoLoader::configure() {
+  // set ffmpeg to be silent by default, as in AudioLoader
+  av_log_set_level(AV_LOG_QUIET);
+
+  string downmix = parameter("downmix").toLower();
+  if (downmix == "left") _downmix = LEFT;
+  else if (downmix == "right") _downmix = RIGHT;
+  else _downmix = MIX;
+
+  _quality = parameter("resampleQuality").toInt();
+
+  Real sampleRate = parameter("sampleRate").toReal();
+  _startIndex = (long long)(parameter("startTime").toReal() * sampleRate);
+  _endIndex = (long long)(parameter("endTime").toReal() * sampleRate);
+  if (_startIndex > _endIndex) {
+    throw EssentiaException("FastMonoLoader: startTime cannot be larger than endTime.");
+  }
+
+  // apply a 6dB preamp, as done by all audio players.
+  _gain = db2amp(parameter("replayGain").toReal() + 6.0);
+
+  // if no file has been specified, do not do anything
+  if (!parameter("filename").isConfigured()) return;
+
+  reset();
+
+  // same as in MonoLoader
+  _params.add("originalSampleRate", (int)_inputSampleRate);
+}
+
+
+void FastMonoLoader::openAudioFile(const string& filename) {
+  E_DEBUG(EAlgorithm, "FastMonoLoader: opening file: " << filename);
+
+  int errnum;
+  if ((errnum = avformat_open_input(&_demuxCtx, filename.c_str(), NULL, NULL)) != 0) {
+    char errorstr[128];
+    string error = "Unknown error";
+    if (av_strerror(errnum, errorstr, 128) == 0) error = errorstr;
+    throw EssentiaException("FastMonoLoader: Could not open file \"", filename, "\", error = ", error);
+  }
+
+  if ((errnum = avformat_find_stream_info(_demuxCtx, NULL)) < 0) {
+    char errorstr[128];
+    string error = "Unknown error";
+    if (av_strerror(errnum, errorstr, 128) == 0) error = errorstr;
+    avformat_close_input(&_demuxCtx);
+    _demuxCtx = 0;
+    throw EssentiaException("FastMonoLoader: Could not find stream information, error = ", error);
+  }
+
+  vector<int> streams;
+  for (int i=0; i<(int)_demuxCtx->nb_streams; i++) {
+    if (_demuxCtx->streams[i]->codec->codec_type == AVMEDIA_TYPE_AUDIO) {
+      streams.push_back(i);
+    }
+  }
+
+  int selectedStream = parameter("audioStream").toInt();
+  if (streams.empty()) {
+    avformat_close_input(&_demuxCtx);
+    _demuxCtx = 0;
+    throw EssentiaException("FastMonoLoader ERROR: found 0 streams in the file, expecting one or more audio streams");
+  }
+  if (selectedStream >= (int)streams.size()) {
+    avformat_close_input(&_demuxCtx);
+    _demuxCtx = 0;
+    throw EssentiaException("FastMonoLoader ERROR: 'audioStream' parameter set to ", selectedStream, ". It should be smaller than the audio streams count, ", streams.size());
+  }
+
+  _streamIdx = streams[selectedStream];
+
+  _audioCtx = _demuxCtx->streams[_streamIdx]->codec;
+  _audioCodec = avcodec_find_decoder(_audioCtx->codec_id);
+
+  if (!_audioCodec) {
+    throw EssentiaException("FastMonoLoader: Unsupported codec!");
+  }
+
+  {
+    ForcedMutexLocker lock(codecMutex);
+    if (avcodec_open2(_audioCtx, _audioCodec, NULL) < 0) {
+      throw EssentiaException("FastMonoLoader: Unable to instantiate codec...");
+    }
+  }
+
+  _nChannels = _audioCtx->channels;
+  _inputSampleRate = _audioCtx->sample_rate;
+
+  if (_nChannels > 2) {
+    throw EssentiaException("FastMonoLoader: could not load audio. Audio file has more than 2 channels.");
+  }
+  if (_inputSampleRate <= 0) {
+    throw EssentiaException("FastMonoLoader: could not load audio. Audio sampling rate must be greater than 0.");
+  }
+
+  // float samples are read directly from the decoded frames, any other format
+  // is first converted to planar float
+  if (_audioCtx->sample_fmt != AV_SAMPLE_FMT_FLT && _audioCtx->sample_fmt != AV_SAMPLE_FMT_FLTP) {
+    int64_t layout = av_get_default_channel_layout(_nChannels);
+
+    _convertCtxAv = avresample_alloc_context();
+    av_opt_set_int(_convertCtxAv, "in_channel_layout", layout, 0);
+    av_opt_set_int(_convertCtxAv, "out_channel_layout", layout, 0);
+    av_opt_set_int(_convertCtxAv, "in_sample_rate", _audioCtx->sample_rate, 0);
+    av_opt_set_int(_convertCtxAv, "out_sample_rate", _audioCtx->sample_rate, 0);
+    av_opt_set_int(_convertCtxAv, "in_sample_fmt", _audioCtx->sample_fmt, 0);
+    av_opt_set_int(_convertCtxAv, "out_sample_fmt", AV_SAMPLE_FMT_FLTP, 0);
+
+    if (avresample_open(_convertCtxAv) < 0) {
+      throw EssentiaException("FastMonoLoader: Could not initialize avresample context");
+    }
+  }
+
+  av_init_packet(&_packet);
+
+  _decodedFrame = av_frame_alloc();
+  if (!_decodedFrame) {
+    throw EssentiaException("FastMonoLoader: Could not allocate audio frame");
+  }
+}
+
+void FastMonoLoader::closeAudioFile() {
+  if (!_demuxCtx) return;
+
+  if (_convertCtxAv) {
+    avresample_close(_convertCtxAv);
+    avresample_free(&_convertCtxAv);
+  }
+
+  if (_audioCtx) {
+    ForcedMutexLocker lock(codecMutex);
+    avcodec_close(_audioCtx);
+  }
+  avformat_close_input(&_demuxCtx);
+  av_frame_free(&_decodedFrame);
+
+  _demuxCtx = 0;
+  _audioCtx = 0;
+}
+
+void FastMonoLoader::configureResampler() {
+  Real sampleRate = parameter("sampleRate").toReal();
+  _ratio = (double)sampleRate / _inputSampleRate;
+  _resample = (_ratio != 1.0);
+
+  if (_srcState) {
+    src_delete(_srcState);
+    _srcState = 0;
+  }
+
+  if (!_resample) return;
+
+  if (_quality == standard::Resample::POLYPHASE_QUALITY) {
+    _polyphase.configure(_inputSampleRate, sampleRate);
+    _polyphase.reset();
+    return;
+  }
+
+  int error;
+  _srcState = src_new(_quality, 1, &error);
+  if (!_srcState) {
+    throw EssentiaException("FastMonoLoader: Error in resampling: ", src_strerror(error));
+  }
+}
+
+
+AlgorithmStatus FastMonoLoader::process() {
+  if (!parameter("filename").isConfigured()) {
+    throw EssentiaException("FastMonoLoader: Trying to call process() on a FastMonoLoader algo which hasn't been correctly configured.");
+  }
+
+  // no need to decode what comes after the end of the slice
+  if (_outputIndex >= _endIndex) {
+    shouldStop(true);
+    closeAudioFile();
+    return FINISHED;
+  }
+
+  // read packets until we get one from our audio stream
+  do {
+    int result = av_read_frame(_demuxCtx, &_packet);
+    if (result != 0) {
+      if (result != AVERROR_EOF) {
+        char errstring[1204];
+        av_strerror(result, errstring, sizeof(errstring));
+        ostringstream msg;
+        msg << "FastMonoLoader: Error reading frame: " << errstring;
+        E_WARNING(msg.str());
+      }
+      shouldStop(true);
+      flushDecoder();
+      resample(0, 0, true);
+      closeAudioFile();
+      return FINISHED;
+    }
+    if (_packet.stream_index != _streamIdx) av_free_packet(&_packet);
+  } while (_packet.stream_index != _streamIdx);
+
+  // after seeking, the position in the output is given by the timestamp of
+  // the first packet
+  if (_seekPending) {
+    _seekPending = false;
+
+    AVStream* stream = _demuxCtx->streams[_streamIdx];
+    int64_t ts = _packet.pts != (int64_t)AV_NOPTS_VALUE ? _packet.pts : _packet.dts;
+    if (ts == (int64_t)AV_NOPTS_VALUE) {
+      E_WARNING("FastMonoLoader: no timestamp after seeking, decoding the file from the beginning");
+      av_free_packet(&_packet);
+      closeAudioFile();
+      openAudioFile(parameter("filename").toString());
+      configureResampler();
+      return OK;
+    }
+
+    int64_t start = stream->start_time != (int64_t)AV_NOPTS_VALUE ? stream->start_time : 0;
+    _outputIndex = llround((ts - start) * av_q2d(stream->time_base) * parameter("sampleRate").toReal());
+  }
+
+  // decode all the frames contained in the packet
+  AVPacket packet = _packet;
+  while (packet.size > 0) {
+    int len = decodePacket(&packet);
+    if (len < 0) {
+      char errstring[1204];
+      av_strerror(len, errstring, sizeof(errstring));
+      E_WARNING("FastMonoLoader: error while decoding, skipping frame: " << errstring);
+      break;
+    }
+    packet.size -= len;
+    packet.data += len;
+  }
+  av_free_packet(&_packet);
+
+  return OK;
+}
+
+/**
+ * Decodes one frame from the given packet, and sends its samples down the
+ * downmix/resample/trim chain. Returns the number of bytes of the packet that
+ * were used, or a negative error code.
+ */
+int FastMonoLoader::decodePacket(AVPacket* packet) {
+  int gotFrame = 0;
+  av_frame_unref(_decodedFrame);
+
+  int len = avcodec_decode_audio4(_audioCtx, _decodedFrame, &gotFrame, packet);
+  if (len < 0) return len;
+
+  if (gotFrame) processFrame();
+  else if (len == 0) return packet->size; // nothing consumed nor decoded, give up on this packet
+
+  return len;
+}
+
+void FastMonoLoader::flushDecoder() {
+  AVPacket empty;
+  av_init_packet(&empty);
+  empty.data = NULL;
+  empty.size = 0;
+
+  int gotFrame;
+  do {
+    gotFrame = 0;
+    av_frame_unref(_decodedFrame);
+    int len = avcodec_decode_audio4(_audioCtx, _decodedFrame, &gotFrame, &empty);
+    if (len < 0) {
+      char errstring[1204];
+      av_strerror(len, errstring, sizeof(errstring));
+      E_WARNING("FastMonoLoader: decoding error while flushing a packet:" << errstring);
+      break;
+    }
+    if (gotFrame) processFrame();
+  } while (gotFrame);
+}
+
+void FastMonoLoader::processFrame() {
+  int size = _decodedFrame->nb_samples;
+  if (size <= 0) return;
+
+  const float* left;
+  const float* right;
+  int stride;
+
+  switch (_audioCtx->sample_fmt) {
+  case AV_SAMPLE_FMT_FLTP:
+    left = (const float*)_decodedFrame->extended_data[0];
+    right = (const float*)_decodedFrame->extended_data[_nChannels-1];
+    stride = 1;
+    break;
+
+  case AV_SAMPLE_FMT_FLT:
+    left = (const float*)_decodedFrame->extended_data[0];
+    right = left + (_nChannels-1);
+    stride = _nChannels;
+    break;
+
+  default: {
+    for (int c=0; c<_nChannels; c++) _planes[c].resize(size);
+    uint8_t* planes[2] = { (uint8_t*)&_planes[0][0], (uint8_t*)&_planes[_nChannels-1][0] };
+    int converted = avresample_convert(_convertCtxAv, planes, size*sizeof(float), size,
+                                       _decodedFrame->extended_data,
+                                       _decodedFrame->linesize[0], size);
+    if (converted < size) {
+      ostringstream msg;
+      msg << "FastMonoLoader: Incomplete format conversion (some samples missing)"
+          << " from " << av_get_sample_fmt_name(_audioCtx->sample_fmt)
+          << " to "   << av_get_sample_fmt_name(AV_SAMPLE_FMT_FLTP);
+      throw EssentiaException(msg);
+    }
+    left = &_planes[0][0];
+    right = &_planes[_nChannels-1][0];
+    stride = 1;
+  }
+  }
+
+  downmix(left, right, stride, size);
+  resample(&_mono[0], size, false);
+}
+
+void FastMonoLoader::downmix(const float* left, const float* right, int stride, int size) {
+  _mono.resize(size);
+
+  if (_nChannels == 1 || _downmix == LEFT) {
+    for (int i=0; i<size; i++) _mono[i] = left[i*stride];
+  }
+  else if (_downmix == RIGHT) {
+    for (int i=0; i<size; i++) _mono[i] = right[i*stride];
+  }
+  else {
+    // same as MonoMixer
+    for (int i=0; i<size; i++) _mono[i] = (left[i*stride] + right[i*stride]) * 0.5;
+  }
+}
+
+void FastMonoLoader::resample(const Real* input, int size, bool endOfStream) {
+  if (!_resample) {
+    if (size > 0) emit(input, size);
+    return;
+  }
+
+  if (!_srcState) {
+    if (size > 0) {
+      _resampled.resize(_polyphase.maxOutputSize(size));
+      emit(&_resampled[0], _polyphase.process(input, size, &_resampled[0]));
+    }
+    if (endOfStream) {
+      _resampled.resize(_polyphase.maxFlushSize());
+      emit(&_resampled[0], _polyphase.flush(&_resampled[0]));
+    }
+    return;
+  }
+
+  _resampled.resize((int)(_ratio * size) + 1024);
+
+  // libsamplerate does not accept a null input, even when it is empty
+  Real empty = 0;
+
+  SRC_DATA data;
+  data.data_in = input ? const_cast<Real*>(input) : &empty;
+  data.input_frames = size;
+  data.src_ratio = _ratio;
+  data.end_of_input = endOfStream ? 1 : 0;
+
+  // keep calling src_process until all the input has been consumed, and until
+  // the whole tail of the signal has been produced at the end of the stream
+  while (true) {
+    data.data_out = &_resampled[0];
+    data.output_frames = _resampled.size();
+
+    int error = src_process(_srcState, &data);
+    if (error) {
+      throw EssentiaException("FastMonoLoader: Error in resampling: ", src_strerror(error));
+    }
+
+    emit(&_resampled[0], data.output_frames_gen);
+
+    data.data_in += data.input_frames_used;
+    data.input_frames -= data.input_frames_used;
+
+    if (data.input_frames == 0 && (!endOfStream || data.output_frames_gen == 0)) break;
+  }
+}
+
+void FastMonoLoader::emit(const Real* samples, int size) {
+  // trim to [_startIndex, _endIndex)
+  long long begin = max(_startIndex - _outputIndex, 0LL);
+  long long end = min(_endIndex - _outputIndex, (long long)size);
+  _outputIndex += size;
+
+  for (long long i=begin; i<end; ) {
+    int n = (int)min(end - i, (long long)MAX_ACQUIRE_SIZE);
+
+    if (!_audio.acquire(n)) {
+      throw EssentiaException("FastMonoLoader: could not acquire output for audio");
+    }
+
+    vector<AudioSample>& audio = *((vector<AudioSample>*)_audio.getTokens());
+    for (int j=0; j<n; j++) audio[j] = samples[i+j] * _gain;
+
+    _audio.release(n);
+    i += n;
+  }
+}
+
+void FastMonoLoader::reset() {
+  Algorithm::reset();
+
+  _outputIndex = 0;
+
+  if (!parameter("filename").isConfigured()) return;
+
+  closeAudioFile();
+  openAudioFile(parameter("filename").toString());
+  configureResampler();
+
+  _seekPending = false;
+  if (parameter("seek").toBool()) seekToStart();
+}
+
+void FastMonoLoader::seekToStart() {
+  Real time = parameter("startTime").toReal() - SEEK_PREROLL;
+  if (time <= 0) return;
+
+  AVStream* stream = _demuxCtx->streams[_streamIdx];
+  int64_t start = stream->start_time != (int64_t)AV_NOPTS_VALUE ? stream->start_time : 0;
+  int64_t ts = start + (int64_t)(time / av_q2d(stream->time_base));
+
+  if (av_seek_frame(_demuxCtx, _streamIdx, ts, AVSEEK_FLAG_BACKWARD) < 0) {
+    E_WARNING("FastMonoLoader: could not seek in file, decoding it from the beginning");
+    closeAudioFile();
+    openAudioFile(parameter("filename").toString());
+    configureResampler();
+    return;
+  }
+
+  avcodec_flush_buffers(_audioCtx);
+  _seekPending = true;
+}
+
+} // namespace streaming
+} // namespace essentia
+
+
+namespace essentia {
+namespace standard {
+
+const char* FastMonoLoader::name = "FastMonoLoader";
+const char* FastMonoLoader::category = "Input/output";
+const char* FastMonoLoader::description = DOC("This algorithm loads the raw audio data from an audio file, downmixes it to mono, resamples it to the given sampling rate, trims it to the given start and end times and normalizes it using the given replayGain value. It gives the same output as the EasyLoader algorithm, but decoding, downmixing, resampling and trimming are done in a single algorithm, on each decoded frame, instead of going through four algorithms connected with streaming buffers. Decoded float samples are downmixed directly from the frames of the decoder, and decoding stops as soon as the end time has been reached.\n"
+"\n"
+"The \"resampleQuality\" parameter has the same meaning as the \"quality\" parameter of Resample, the value 5 selecting the built-in polyphase resampler. As resampling is done by blocks, the output of libsamplerate may differ very slightly from the one of MonoLoader when the sampling rates differ.\n"
+"\n"
+"When \"seek\" is enabled, the file is not decoded from its beginning but from a point one second before the start time, found by seeking in the file. This is much faster for slices far from the beginning of long files, but the position of the slice then relies on the timestamps of the file, and the first samples may differ slightly from the ones obtained by decoding the whole file, as the decoder and the resampler start from another state.\n"
+"\n"
+"This algorithm throws an exception if the file cannot be decoded (see AudioLoader) or if startTime is greater than endTime.");
+
+
+void FastMonoLoader::createInnerNetwork() {
+  _loader = streaming::AlgorithmFactory::create("FastMonoLoader");
+  _audioStorage = new streaming::VectorOutput<AudioSample>();
+
+  connect(_loader->output("audio"), _audioStorage->input("data"));
+
+  _network = new scheduler::Network(_loader);
+}
+
+void FastMonoLoader::configure() {
+  // if no file has been specified, do not do anything
+  if (!parameter("filename").isConfigured()) return;
+
+  _loader->configure(INHERIT("filename"),
+                     INHERIT("sampleRate"),
+                     INHERIT("downmix"),
+                     INHERIT("audioStream"),
+                     INHERIT("startTime"),
+                     INHERIT("endTime"),
+                     INHERIT("replayGain"),
+                     INHERIT("resampleQuality"),
+                     INHERIT("seek"));
+}
+
+void FastMonoLoader::compute() {
+  if (!parameter("filename").isConfigured()) {
+    throw EssentiaException("FastMonoLoader: Trying to call compute() on a "
+                            "FastMonoLoader algo which hasn't been correctly configured.");
+  }
+
+  vector<AudioSample>& audio = _audio.get();
+
+  _audioStorage->setVector(&audio);
+
+  _network->run();
+  reset();
+}
+
+void FastMonoLoader::reset() {
+  _network->reset();
+}
+
+} // namespace standard
+} // namespace essentia
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_STREAMING_FASTMONOLOADER_H
+#define ESSENTIA_STREAMING_FASTMONOLOADER_H
+
+#include <samplerate.h>
+#include "streamingalgorithm.h"
+#include "network.h"
+#include "ffmpegapi.h"
+#include "polyphaseresampler.h"
+
+namespace essentia {
+namespace streaming {
+
+class FastMonoLoader : public Algorithm {
+ protected:
+  Source<AudioSample> _audio;
+
+  AVFormatContext* _demuxCtx;
+  AVCodecContext* _audioCtx;
+  AVCodec* _audioCodec;
+  AVPacket _packet;
+  AVFrame* _decodedFrame;
+
+  // conversion to planar float, only used if the decoder outputs another
+  // sample format
+  struct AVAudioResampleContext* _convertCtxAv;
+  std::vector<float> _planes[2];
+
+  int _streamIdx; // index of the audio stream among all the streams contained in the file
+  int _nChannels;
+  Real _inputSampleRate;
+
+  enum DownmixType {
+    MIX, LEFT, RIGHT
+  };
+  DownmixType _downmix;
+  std::vector<Real> _mono;
+
+  bool _resample;
+  int _quality;
+  util::PolyphaseResampler _polyphase;
+  SRC_STATE* _srcState;
+  double _ratio;
+  std::vector<Real> _resampled;
+
+  Real _gain;
+  long long _startIndex;
+  long long _endIndex;
+  long long _outputIndex; // number of output samples before trimming
+  bool _seekPending;      // _outputIndex has to be set from the next packet
+
+  void openAudioFile(const std::string& filename);
+  void closeAudioFile();
+  void configureResampler();
+  void seekToStart();
+
+  int decodePacket(AVPacket* packet);
+  void flushDecoder();
+  void processFrame();
+  void downmix(const float* left, const float* right, int stride, int size);
+  void resample(const Real* input, int size, bool endOfStream);
+  void emit(const Real* samples, int size);
+
+ public:
+  FastMonoLoader();
+  ~FastMonoLoader();
+
+  void declareParameters() {
+    declareParameter("filename", "the name of the file from which to read", "", Parameter::STRING);
+    declareParameter("sampleRate", "the output sampling rate [Hz]", "(0,inf)", 44100.);
+    declareParameter("downmix", "the mixing type for stereo files", "{left,right,mix}", "mix");
+    declareParameter("audioStream", "audio stream index to be loaded. Other streams are not taken into account (e.g. if stream 0 is video and 1 is audio use index 0 to access it.)", "[0,inf)", 0);
+    declareParameter("startTime", "the start time of the slice to be extracted [s]", "[0,inf)", 0.0);
+    declareParameter("endTime", "the end time of the slice to be extracted [s]", "[0,inf)", 1e6);
+    declareParameter("replayGain", "the value of the replayGain that should be used to normalize the signal [dB] (the default value does not change the signal)", "(-inf,inf)", -6.0);
+    declareParameter("resampleQuality", "the quality of the resampling (see the quality parameter of Resample)", "[0,5]", 1);
+    declareParameter("seek", "seek to the start time instead of decoding the file from its beginning", "{true,false}", false);
+  }
+
+  void configure();
+  AlgorithmStatus process();
+  void reset();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+
+};
+
+} // namespace streaming
+} // namespace essentia
+
+
+#include "vectoroutput.h"
+#include "algorithm.h"
+
+namespace essentia {
+namespace standard {
+
+// Standard non-streaming algorithm comes after the streaming one as it
+// depends on it
+class FastMonoLoader : public Algorithm {
+ protected:
+  Output<std::vector<AudioSample> > _audio;
+
+  streaming::Algorithm* _loader;
+  streaming::VectorOutput<AudioSample>* _audioStorage;
+  scheduler::Network* _network;
+
+  void createInnerNetwork();
+
+ public:
+  FastMonoLoader() {
+    declareOutput(_audio, "audio", "the audio signal");
+
+    createInnerNetwork();
+  }
+
+  ~FastMonoLoader() {
+    // NB: this will also delete all the algorithms as the Network took ownership of them
+    delete _network;
+  }
+
+  void declareParameters() {
+    declareParameter("filename", "the name of the file from which to read", "", Parameter::STRING);
+    declareParameter("sampleRate", "the output sampling rate [Hz]", "(0,inf)", 44100.);
+    declareParameter("downmix", "the mixing type for stereo files", "{left,right,mix}", "mix");
+    declareParameter("audioStream", "audio stream index to be loaded. Other streams are not taken into account (e.g. if stream 0 is video and 1 is audio use index 0 to access it.)", "[0,inf)", 0);
+    declareParameter("startTime", "the start time of the slice to be extracted [s]", "[0,inf)", 0.0);
+    declareParameter("endTime", "the end time of the slice to be extracted [s]", "[0,inf)", 1e6);
+    declareParameter("replayGain", "the value of the replayGain that should be used to normalize the signal [dB] (the default value does not change the signal)", "(-inf,inf)", -6.0);
+    declareParameter("resampleQuality", "the quality of the resampling (see the quality parameter of Resample)", "[0,5]", 1);
+    declareParameter("seek", "seek to the start time instead of decoding the file from its beginning", "{true,false}", false);
+  }
+
+  void configure();
+  void compute();
+  void reset();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+};
+
+} // namespace standard
+} // namespace essentia
+
+#endif // ESSENTIA_STREAMING_FASTMONOLOADER_H
@@ -19,6 +19,7 @@
 
 #include "monoloader.h"
 #include "algorithmfactory.h"
+#include "audioloader.h"
 
 using namespace std;
 
@@ -31,7 +32,7 @@ const char* MonoLoader::description = essentia::standard::MonoLoader::descriptio
 
 
 MonoLoader::MonoLoader() : AlgorithmComposite(),
-                           _audioLoader(0), _mixer(0), _resample(0), _configured(false) {
+                           _audioLoader(0), _mixer(0), _resample(0), _cache(0), _configured(false) {
 
   declareOutput(_audio, "audio", "the mono audio signal");
 
@@ -40,17 +41,19 @@ MonoLoader::MonoLoader() : AlgorithmComposite(),
   _audioLoader = factory.create("AudioLoader");
   _mixer       = factory.create("MonoMixer");
   _resample    = factory.create("Resample");
+  _cache       = new AudioCacheStorage();
 
   _audioLoader->output("audio")           >>  _mixer->input("audio");
   _audioLoader->output("numberChannels")  >>  _mixer->input("numberChannels");
   _mixer->output("audio")                 >>  _resample->input("signal");
+  _resample->output("signal")             >>  _cache->input("signal");
 
   _audioLoader->output("md5")        >> NOWHERE;
   _audioLoader->output("bit_rate")   >> NOWHERE;
   _audioLoader->output("codec")      >> NOWHERE;
   _audioLoader->output("sampleRate") >> NOWHERE;
 
-  attach(_resample->output("signal"), _audio);
+  attach(_cache->output("signal"), _audio);
 }
 
 void MonoLoader::configure() {
@@ -58,12 +61,35 @@ void MonoLoader::configure() {
   // if no file has been specified, do not do anything
   if (!filename.isConfigured()) return;
 
+  // look for the decoded audio in the cache, see util::AudioCache
+  string cachePath;
+  if (util::AudioCache::enabled()) {
+    int audioStream = parameter("audioStream").toInt();
+    string key = util::AudioCache::fileKey(filename.toString(), audioStream);
+    string md5 = util::AudioCache::indexedMD5(key);
+    if (md5.empty()) {
+      md5 = AudioLoader::md5(filename.toString(), audioStream);
+      if (!key.empty()) util::AudioCache::indexMD5(key, md5);
+    }
+
+    cachePath = util::AudioCache::path(md5, parameter("sampleRate").toReal(),
+                                       parameter("downmix").toLower());
+
+    if (_cache->serve(cachePath)) {
+      _params.add("originalSampleRate", (int)_cache->entry().originalSampleRate());
+      return;
+    }
+  }
+
   _audioLoader->configure("filename", filename,
                           "computeMD5", false,
                           INHERIT("audioStream"));
 
   int inputSampleRate = (int)lastTokenProduced<Real>(_audioLoader->output("sampleRate"));
 
+  if (cachePath.empty()) _cache->passThrough();
+  else _cache->record(cachePath, _audioLoader, parameter("sampleRate").toReal(), inputSampleRate);
+
   // TODO: this should probably be turned into a source as well, same as what's done above for audioLoader->sampleRate
   // also keep it as a parameter (ugly), but act as an optional source (no need
   // to connect, etc...)
@@ -88,6 +114,8 @@ const char* MonoLoader::name = "MonoLoader";
 const char* MonoLoader::category = "Input/output";
 const char* MonoLoader::description = DOC("This algorithm loads the raw audio data from an audio file and downmixes it to mono. Audio is resampled in case the given sampling rate does not match the sampling rate of the input signal.\n"
 "\n"
+"If the audio cache is enabled (by setting the ESSENTIA_AUDIO_CACHE environment variable to a directory), the decoded and resampled audio is stored in that directory, keyed by the MD5 of the audio payload, the sampling rate and the downmix type, and files which are found in the cache are not decoded again. The checksum of a file is computed once (by reading its packets without decoding them) and indexed by the path, size and modification time of the file, so that files which have already been seen are not even opened. A file which is modified without changing its size or its modification time is not detected.\n"
+"\n"
 "This algorithm uses AudioLoader and thus inherits all of its input requirements and exceptions.");
 
 
@@ -22,6 +22,7 @@
 
 
 #include "streamingalgorithmcomposite.h"
+#include "audiocachestorage.h"
 #include "network.h"
 
 namespace essentia {
@@ -32,6 +33,7 @@ class MonoLoader : public AlgorithmComposite {
   Algorithm* _audioLoader;
   Algorithm* _mixer;
   Algorithm* _resample;
+  AudioCacheStorage* _cache;
 
   SourceProxy<AudioSample> _audio;
   bool _configured;
@@ -43,6 +45,7 @@ class MonoLoader : public AlgorithmComposite {
     delete _audioLoader;
     delete _mixer;
     delete _resample;
+    delete _cache;
   }
 
   void declareParameters() {
@@ -54,7 +57,9 @@ class MonoLoader : public AlgorithmComposite {
   }
 
   void declareProcessOrder() {
-    declareProcessStep(ChainFrom(_audioLoader));
+    // when the audio is in the cache, nothing needs to be decoded
+    if (_cache->serving()) declareProcessStep(ChainFrom(_cache));
+    else declareProcessStep(ChainFrom(_audioLoader));
   }
 
   void configure();
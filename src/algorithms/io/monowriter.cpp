@@ -43,6 +43,7 @@ void MonoWriter::reset() {
   catch (EssentiaException& e) {
     throw EssentiaException("MonoWriter: Error creating audio file: ", e.what());
   }
+  _audioCtx.setBackgroundEncoding(parameter("backgroundEncoding").toBool());
 
   _audio.setAcquireSize(recommendedBufferSize);
   _audio.setReleaseSize(recommendedBufferSize);
@@ -69,37 +70,37 @@ AlgorithmStatus MonoWriter::process() {
   if (!_audioCtx.isOpen()) _audioCtx.open();
 
   EXEC_DEBUG("process()");
-  AlgorithmStatus status = acquireData();
 
-  if (status != OK) {
-    if (!shouldStop()) return status;
+  // the audio context accumulates the samples into codec frames itself, so
+  // write everything that is available in one block
+  int available = _audio.available();
 
-    // encode whatever is left over
-    int available = _audio.available();
+  if (available == 0) {
+    if (!shouldStop()) return NO_INPUT;
 
-    if (available == 0) {
-      EXEC_DEBUG("End of stream. There are 0 available tokens");
-      shouldStop(true);
+    EXEC_DEBUG("End of stream. There are 0 available tokens");
+    shouldStop(true);
+    try {
       _audioCtx.close();
-      return FINISHED;
     }
-
-    EXEC_DEBUG("Audio frame could not be fully acquired.");
-    EXEC_DEBUG("There are " << available << " available tokens");
-    _audio.setAcquireSize(available);
-    _audio.setReleaseSize(available);
-
-    return process();
+    catch (EssentiaException& e) {
+      throw EssentiaException("MonoWriter: error writing to audio file: ", e.what());
+    }
+    return FINISHED;
   }
 
+  int n = min(available, _audio.buffer().bufferInfo().maxContiguousElements);
+  n = max(n, 1);
+  _audio.acquire(n);
+
   try {
-    _audioCtx.write(_audio.tokens());
+    _audioCtx.write(&_audio.tokens()[0], n);
   }
   catch (EssentiaException& e) {
     throw EssentiaException("MonoWriter: error writing to audio file: ", e.what());
   }
 
-  releaseData();
+  _audio.release(n);
 
   return OK;
 }
@@ -120,7 +121,8 @@ const char* MonoWriter::description = DOC("This algorithm writes a mono audio st
 
 "The algorithm uses FFmpeg. Supported formats are wav, aiff, mp3, flac and ogg. An exception is thrown when other extensions are given. The default FFmpeg encoders are used for each format. Note that to encode in mp3 format it is mandatory that FFmpeg was configured with mp3 enabled.\n\n"
 
-"If the file specified by filename could not be opened or the header of the file omits channel's information, an exception is thrown.");
+"If the file specified by filename could not be opened or the header of the file omits channel's information, an exception is thrown.\n\n"
+"When backgroundEncoding is enabled, the audio is encoded and written to the file in a separate thread, fed by a bounded queue of codec frames, so that the algorithms producing the audio do not wait for the encoder. The resulting file is identical.");
 
 
 void MonoWriter::createInnerNetwork() {
@@ -135,7 +137,8 @@ void MonoWriter::createInnerNetwork() {
 void MonoWriter::configure() {
   _writer->configure(INHERIT("filename"),
                      INHERIT("format"),
-                     INHERIT("sampleRate"));
+                     INHERIT("sampleRate"),
+                     INHERIT("backgroundEncoding"));
   _configured = true;
 }
 
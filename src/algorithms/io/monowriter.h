@@ -44,6 +44,7 @@ class MonoWriter : public Algorithm {
     declareParameter("format", "the audio output format","{wav,aiff,mp3,ogg,flac}", "wav");
     declareParameter("bitrate", "the audio bit rate for compressed formats [kbps]",
 		     "{32,40,48,56,64,80,96,112,128,144,160,192,224,256,320}", 192);
+    declareParameter("backgroundEncoding", "encode and write the audio in a separate thread, so that the network does not wait for the encoder", "{true,false}", false);
   }
 
   void configure();
@@ -101,6 +102,7 @@ class MonoWriter : public Algorithm {
     declareParameter("sampleRate", "the audio sampling rate [Hz]","(0,inf)", 44100.);
     declareParameter("bitrate", "the audio bit rate for compressed formats [kbps]",
 		     "{32,40,48,56,64,80,96,112,128,144,160,192,224,256,320}", 192);
+    declareParameter("backgroundEncoding", "encode and write the audio in a separate thread, so that the network does not wait for the encoder", "{true,false}", false);
   }
 
   void configure();
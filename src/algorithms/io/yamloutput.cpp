@@ -222,7 +222,23 @@ void fillYamlTree (const Pool& p, YamlNode* root) {
   FILL_YAML_TREE_MACRO(Real, SingleReal);
   FILL_YAML_TREE_MACRO(vector<Real>, Real);
   FILL_YAML_TREE_MACRO(vector<Real>, SingleVectorReal);
-  FILL_YAML_TREE_MACRO(vector<vector<Real> >, VectorReal);
+
+  // the frames of vector descriptors are stored either as one vector per frame
+  // or contiguously, go through both in the order of the descriptor names so
+  // that the output does not depend on how they are stored
+  const PoolOf(vector<Real>)& vectorRows = p.getVectorRealRowsPool();
+  const map<string, FrameMatrix>& vectorMatrices = p.getVectorRealMatrixPool();
+  PoolOf(vector<Real>)::const_iterator rowsIt = vectorRows.begin();
+  map<string, FrameMatrix>::const_iterator matrixIt = vectorMatrices.begin();
+  while (rowsIt != vectorRows.end() || matrixIt != vectorMatrices.end()) {
+    if (matrixIt == vectorMatrices.end() ||
+        (rowsIt != vectorRows.end() && rowsIt->first < matrixIt->first)) {
+      fillYamlTreeHelper(root, rowsIt++);
+    }
+    else {
+      fillYamlTreeHelper(root, matrixIt++);
+    }
+  }
 
   FILL_YAML_TREE_MACRO(string, SingleString);
   FILL_YAML_TREE_MACRO(vector<string>, String);
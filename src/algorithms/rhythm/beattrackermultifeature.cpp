@@ -19,8 +19,15 @@
 
 #include "beattrackermultifeature.h"
 #include "poolstorage.h"
+#include "vectoroutput.h"
 #include "algorithmfactory.h"
 
+#ifdef CPP_11
+#  include <thread>
+#  include <exception>
+#  include <system_error>
+#endif
+
 using namespace std;
 
 namespace essentia {
@@ -33,9 +40,10 @@ const char* BeatTrackerMultiFeature::description = essentia::standard::BeatTrack
 
 BeatTrackerMultiFeature::BeatTrackerMultiFeature() : AlgorithmComposite(),
     _frameCutter1(0), _windowing1(0), _fft1(0), _cart2polar1(0), _onsetRms1(0),
-    _onsetComplex1(0), _ticksRms1(0), _ticksComplex1(0), _onsetMelFlux1(0),
+    _onsetComplex1(0), _onsetMelFlux1(0), _ticksRms1(0), _ticksComplex1(0),
     _ticksMelFlux1(0), _onsetBeatEmphasis3(0), _ticksBeatEmphasis3(0),
-    _onsetInfogain4(0), _ticksInfogain4(0), _scale(0), _configured(false) {
+    _onsetInfogain4(0), _ticksInfogain4(0), _tempoTapMaxAgreement(0), _scale(0),
+    _configured(false) {
 
   declareInput(_signal, 1024, "signal", "input signal");
   declareOutput(_ticks, 0, "ticks", "the estimated tick locations [s]");
@@ -57,15 +65,15 @@ void BeatTrackerMultiFeature::createInnerNetwork() {
   _onsetRms1            = factory.create("OnsetDetection");
   _onsetComplex1        = factory.create("OnsetDetection");
   _onsetMelFlux1        = factory.create("OnsetDetection");
-  _ticksRms1            = factory.create("TempoTapDegara");
-  _ticksComplex1        = factory.create("TempoTapDegara");
-  _ticksMelFlux1        = factory.create("TempoTapDegara");
+  _ticksRms1            = standard::AlgorithmFactory::create("TempoTapDegara");
+  _ticksComplex1        = standard::AlgorithmFactory::create("TempoTapDegara");
+  _ticksMelFlux1        = standard::AlgorithmFactory::create("TempoTapDegara");
 
-  _onsetBeatEmphasis3   = factory.create("OnsetDetectionGlobal");
-  _ticksBeatEmphasis3   = factory.create("TempoTapDegara");
+  _onsetBeatEmphasis3   = standard::AlgorithmFactory::create("OnsetDetectionGlobal");
+  _ticksBeatEmphasis3   = standard::AlgorithmFactory::create("TempoTapDegara");
 
-  _onsetInfogain4       = factory.create("OnsetDetectionGlobal");
-  _ticksInfogain4       = factory.create("TempoTapDegara");
+  _onsetInfogain4       = standard::AlgorithmFactory::create("OnsetDetectionGlobal");
+  _ticksInfogain4       = standard::AlgorithmFactory::create("TempoTapDegara");
 
   _tempoTapMaxAgreement = standard::AlgorithmFactory::create("TempoTapMaxAgreement");
 
@@ -88,22 +96,14 @@ void BeatTrackerMultiFeature::createInnerNetwork() {
   _cart2polar1->output("magnitude")          >>   _onsetMelFlux1->input("spectrum");
   _cart2polar1->output("phase")              >>   _onsetMelFlux1->input("phase");
 
-  _onsetComplex1->output("onsetDetection")   >>   _ticksComplex1->input("onsetDetections");
-  _ticksComplex1->output("ticks")            >>   PC(_pool, "internal.ticksComplex");
-  _onsetRms1->output("onsetDetection")       >>   _ticksRms1->input("onsetDetections");
-  _ticksRms1->output("ticks")                >>   PC(_pool, "internal.ticksRms");
-  _onsetMelFlux1->output("onsetDetection")   >>   _ticksMelFlux1->input("onsetDetections");
-  _ticksMelFlux1->output("ticks")            >>   PC(_pool, "internal.ticksMelFlux");
-
-  //_signal                                           >>   _onsetBeatEmphasis3->input("signal");
-  _scale->output("signal")                         >>  _onsetBeatEmphasis3->input("signal");
-  _onsetBeatEmphasis3->output("onsetDetections")   >>  _ticksBeatEmphasis3->input("onsetDetections");
-  _ticksBeatEmphasis3->output("ticks")             >>  PC(_pool, "internal.ticksBeatEmphasis");
+  _onsetComplex1->output("onsetDetection")   >>   PC(_pool, "internal.onsetComplex");
+  _onsetRms1->output("onsetDetection")       >>   PC(_pool, "internal.onsetRms");
+  _onsetMelFlux1->output("onsetDetection")   >>   PC(_pool, "internal.onsetMelFlux");
 
-  //_signal                                           >> _onsetInfogain4->input("signal");
-  _scale->output("signal")  >> _onsetInfogain4->input("signal");
-  _onsetInfogain4->output("onsetDetections")        >> _ticksInfogain4->input("onsetDetections");
-  _ticksInfogain4->output("ticks")                  >> PC(_pool, "internal.ticksInfogain");
+  // the signal is stored once for both global onset detection functions
+  // (beat emphasis and infogain), in a plain vector rather than in the pool
+  // which would store it sample by sample
+  _scale->output("signal")                   >>   _signalBuffer;
 
   _network = new scheduler::Network(_scale);
 }
@@ -112,6 +112,13 @@ void BeatTrackerMultiFeature::clearAlgos() {
   if (!_configured) return;
 
   delete _network;
+  delete _ticksRms1;
+  delete _ticksComplex1;
+  delete _ticksMelFlux1;
+  delete _onsetBeatEmphasis3;
+  delete _ticksBeatEmphasis3;
+  delete _onsetInfogain4;
+  delete _ticksInfogain4;
   delete _tempoTapMaxAgreement;
 }
 
@@ -201,32 +208,117 @@ void BeatTrackerMultiFeature::configure() {
   _configured = true;
 }
 
-AlgorithmStatus BeatTrackerMultiFeature::process() {
-  if (!shouldStop()) return PASS;
+namespace {
+
+// One processing chain going from an onset detection function (computed
+// either in the streaming network or by a global onset detection algorithm
+// from the signal) to its tick candidates.
+struct TicksBranch {
+  standard::Algorithm* onsetDetection; // null if input is already the ODF
+  standard::Algorithm* tempoTap;
+  const vector<Real>* input;
+  vector<Real>* ticks;
+
+  void compute() {
+    vector<Real> detections;
+    const vector<Real>* odf = input;
+    if (onsetDetection) {
+      onsetDetection->input("signal").set(*input);
+      onsetDetection->output("onsetDetections").set(detections);
+      onsetDetection->compute();
+      odf = &detections;
+    }
+    tempoTap->input("onsetDetections").set(*odf);
+    tempoTap->output("ticks").set(*ticks);
+    tempoTap->compute();
+  }
 
-  vector<vector<Real> > tickCandidates;
-  vector<Real> ticks;
-  Real confidence;
+#ifdef CPP_11
+  exception_ptr error;
+
+  void run() {
+    try {
+      compute();
+    }
+    catch (...) {
+      error = current_exception();
+    }
+  }
+#endif
+};
 
+} // namespace
+
+
+void BeatTrackerMultiFeature::computeTickCandidates(vector<vector<Real> >& tickCandidates) {
   tickCandidates.resize(5);
 
+  const char* odfNames[] = { "internal.onsetComplex", "internal.onsetRms",
+                             "internal.onsetMelFlux", 0, 0 };
+  standard::Algorithm* onsets[] = { 0, 0, 0, _onsetBeatEmphasis3, _onsetInfogain4 };
+  standard::Algorithm* tempoTaps[] = { _ticksComplex1, _ticksRms1, _ticksMelFlux1,
+                                       _ticksBeatEmphasis3, _ticksInfogain4 };
+
   // ticks candidates might be empty for very short signals, but
   // it is ok to feed empty tick vetors to TempoTapMaxAgreement
-  if (_pool.contains<vector<Real> >("internal.ticksComplex")) {
-    tickCandidates[0] = _pool.value<vector<Real> >("internal.ticksComplex");
+  vector<TicksBranch> branches;
+  for (int i=0; i<5; ++i) {
+    tickCandidates[i].clear();
+    const vector<Real>* input = &_signalBuffer;
+    if (odfNames[i]) {
+      if (!_pool.contains<vector<Real> >(odfNames[i])) continue;
+      input = &_pool.value<vector<Real> >(odfNames[i]);
+    }
+    else if (_signalBuffer.empty()) continue;
+
+    TicksBranch branch;
+    branch.onsetDetection = onsets[i];
+    branch.tempoTap = tempoTaps[i];
+    branch.input = input;
+    branch.ticks = &tickCandidates[i];
+    branches.push_back(branch);
   }
-  if (_pool.contains<vector<Real> >("internal.ticksRms")) {
-    tickCandidates[1] = _pool.value<vector<Real> >("internal.ticksRms");
+
+#ifdef CPP_11
+  // each branch only touches its own algorithms and output, and only reads
+  // from the pool and the signal, so they can safely run in separate threads
+  vector<thread> threads;
+  threads.reserve(branches.size());
+  for (size_t i=0; i<branches.size(); ++i) {
+    try {
+      threads.push_back(thread(&TicksBranch::run, &branches[i]));
+    }
+    catch (system_error&) {
+      // threads not available on this platform, compute in this one
+      branches[i].run();
+    }
+    catch (...) {
+      // the threads already started need to be joined before rethrowing
+      branches[i].error = current_exception();
+    }
   }
-  if (_pool.contains<vector<Real> >("internal.ticksMelFlux")) {
-    tickCandidates[2] = _pool.value<vector<Real> >("internal.ticksMelFlux");
+  for (size_t i=0; i<threads.size(); ++i) {
+    threads[i].join();
   }
-  if (_pool.contains<vector<Real> >("internal.ticksBeatEmphasis")) {
-    tickCandidates[3] = _pool.value<vector<Real> >("internal.ticksBeatEmphasis");
+  for (size_t i=0; i<branches.size(); ++i) {
+    if (branches[i].error) rethrow_exception(branches[i].error);
   }
-  if (_pool.contains<vector<Real> >("internal.ticksInfogain")) {
-    tickCandidates[4] = _pool.value<vector<Real> >("internal.ticksInfogain");
+#else
+  for (size_t i=0; i<branches.size(); ++i) {
+    branches[i].compute();
   }
+#endif
+}
+
+
+AlgorithmStatus BeatTrackerMultiFeature::process() {
+  if (!shouldStop()) return PASS;
+
+  vector<vector<Real> > tickCandidates;
+  vector<Real> ticks;
+  Real confidence;
+
+  computeTickCandidates(tickCandidates);
 
   _tempoTapMaxAgreement->input("tickCandidates").set(tickCandidates);
   _tempoTapMaxAgreement->output("ticks").set(ticks);
@@ -243,7 +335,16 @@ AlgorithmStatus BeatTrackerMultiFeature::process() {
 
 void BeatTrackerMultiFeature::reset() {
   AlgorithmComposite::reset();
+  _ticksRms1->reset();
+  _ticksComplex1->reset();
+  _ticksMelFlux1->reset();
+  _onsetBeatEmphasis3->reset();
+  _ticksBeatEmphasis3->reset();
+  _onsetInfogain4->reset();
+  _ticksInfogain4->reset();
   _tempoTapMaxAgreement->reset();
+  _pool.clear();
+  _signalBuffer.clear();
 }
 
 } // namespace streaming
@@ -263,6 +364,8 @@ const char* BeatTrackerMultiFeature::description = DOC("This algorithm estimates
 "  - beat emphasis function (see 'beat_emphasis' method in OnsetDetectionGlobal algorithm, 2048/512)\n"
 "  - spectral flux between histogrammed spectrum frames, measured by the modified information gain (see 'infogain' method in OnsetDetectionGlobal algorithm, 2048/512)\n"
 "\n"
+"Once the whole signal has been processed, the beat candidates of these five chains are computed concurrently in separate threads (when supported by the platform), which yields the same results as computing them one after another.\n"
+"\n"
 "You can follow these guidelines [2] to assess the quality of beats estimation based on the computed confidence value:\n"
 "  - [0, 1)      very low confidence, the input signal is hard for the employed candidate beat trackers\n"
 "  - [1, 1.5]    low confidence\n"
@@ -36,6 +36,7 @@ class BeatTrackerMultiFeature : public AlgorithmComposite {
   Source<Real> _confidence;
 
   Pool _pool;
+  std::vector<Real> _signalBuffer;
 
   // algorithm numeration corresponds to the process chains
   Algorithm* _frameCutter1;
@@ -44,16 +45,20 @@ class BeatTrackerMultiFeature : public AlgorithmComposite {
   Algorithm* _cart2polar1;
   Algorithm* _onsetRms1;
   Algorithm* _onsetComplex1;
-  Algorithm* _ticksRms1;
-  Algorithm* _ticksComplex1;
   Algorithm* _onsetMelFlux1;
-  Algorithm* _ticksMelFlux1;
 
-  Algorithm* _onsetBeatEmphasis3;
-  Algorithm* _ticksBeatEmphasis3;
+  // The global onset detection functions and the beat trackers need the
+  // whole input, and after the FFT the chains do not share anything, so they
+  // are standard algorithms run concurrently once the stream has ended.
+  standard::Algorithm* _ticksRms1;
+  standard::Algorithm* _ticksComplex1;
+  standard::Algorithm* _ticksMelFlux1;
 
-  Algorithm* _onsetInfogain4;
-  Algorithm* _ticksInfogain4;
+  standard::Algorithm* _onsetBeatEmphasis3;
+  standard::Algorithm* _ticksBeatEmphasis3;
+
+  standard::Algorithm* _onsetInfogain4;
+  standard::Algorithm* _ticksInfogain4;
 
   standard::Algorithm* _tempoTapMaxAgreement;
 
@@ -64,6 +69,7 @@ class BeatTrackerMultiFeature : public AlgorithmComposite {
 
   void createInnerNetwork();
   void clearAlgos();
+  void computeTickCandidates(std::vector<std::vector<Real> >& tickCandidates);
   Real _sampleRate;
 
  public:
@@ -252,8 +252,10 @@ void TempoTapDegara::decodeBeats(map<Real,
   // Transition probability matrix at the begining of the track
   size_t currentIndex = 0;
 
-  // Best transition information for backtracking
-  vector<vector<int> > stateBacktracking(_numberStates, vector<int>(_numberFrames));
+  // Best transition information for backtracking. Only state 0 can be reached
+  // from any state; any other state is necessarily reached from the previous
+  // one, so there is no need to store it.
+  vector<int> stateBacktracking(_numberFrames);
 
   // HMM cost for each state for the current time
   vector<Real> cost(_numberStates, numeric_limits<Real>::max());
@@ -263,11 +265,13 @@ void TempoTapDegara::decodeBeats(map<Real,
 
   // Dynamic programming
   for (size_t t=0; t<_numberFrames; ++t) {
+    const vector<vector<Real> >& transitions = transitionMatrix[beatPeriods[currentIndex]];
+
     // Evaluate transitions from any state to state event (state 0)
 
     // Look for the minimum cost
     for (int i=0; i<_numberStates; ++i) {
-      diff[i] = costOld[i] - transitionMatrix[beatPeriods[currentIndex]][i][0];
+      diff[i] = costOld[i] - transitions[i][0];
     }
     int bestState = argmin(diff);
     Real bestPath = diff[bestState];
@@ -277,18 +281,17 @@ void TempoTapDegara::decodeBeats(map<Real,
     }
 
     // Save best transtions information for backtracking
-    stateBacktracking[0][t] = bestState;
+    stateBacktracking[t] = bestState;
     // Update cost; the only possible transition is from state to state+1
     cost[0] = - biy[0][t] + bestPath;
     for (int state=1; state<_numberStates; ++state) {
       cost[state] = costOld[state-1]
-                    - transitionMatrix[beatPeriods[currentIndex]][state-1][state]
+                    - transitions[state-1][state]
                     - biy[state][t];
-      stateBacktracking[state][t] = state-1;
     }
 
     // Update cost at t-1
-    costOld = cost;
+    costOld.swap(cost);
 
     // Find the transition matrix corresponding to next frame
     if (t+1 < _numberFrames) {
@@ -302,13 +305,14 @@ void TempoTapDegara::decodeBeats(map<Real,
 
   // Decide which of the final states is the most probable
 
-  int finalState = argmin(cost);
+  int finalState = argmin(costOld);
   // Backtrace through the model
   sequenceStates.resize(_numberFrames);
   sequenceStates.back() = finalState;
   if (_numberFrames >= 2) {
     for (size_t t=_numberFrames-2; ; --t) {
-      sequenceStates[t] = stateBacktracking[sequenceStates[t+1]][t+1];
+      int nextState = sequenceStates[t+1];
+      sequenceStates[t] = nextState == 0 ? stateBacktracking[t+1] : nextState-1;
       if (t==0) {
         break;
       }
@@ -427,17 +431,24 @@ void TempoTapDegara::computeBeatPeriodsDavies(vector<Real> detections,
   _frameCutter->reset();  // TODO reset here for consequent signal inputs, or should the user do it always?
 
   _numberFramesODF = observations.size();
-  // Add noise
+  // Add noise. Use an own generator with a fixed seed rather than rand(), so
+  // that results are reproducible and several instances can run concurrently.
+  unsigned long seed = 0;
+  _mtrand.seed(seed);
   for (size_t t=0; t<_numberFramesODF; ++t) {
     for (int i=0; i<_hopSizeODF; ++i) {
-      observations[t][i] += 0.0001 * observationsMax * (Real) rand() / RAND_MAX;
+#ifdef CPP_11
+      observations[t][i] += 0.0001 * observationsMax * Real(_mtrand()) / std::mt19937::max();
+#else
+      observations[t][i] += 0.0001 * observationsMax * Real(_mtrand());
+#endif
     }
   }
 
   // find Viterbi path (ODF-frame-wise list of indices of the estimated periods;
   // zero index corresponds to beat period of 1 ODF frame hopsize)
   vector <Real> path;
-  findViterbiPath(_tempoWeights, _transitionsViterbi, observations, path);
+  findViterbiPath(_tempoWeights, observations, path);
 
   beatPeriods.reserve(_numberFramesODF);
   beatEndPositions.reserve(_numberFramesODF);
@@ -450,71 +461,23 @@ void TempoTapDegara::computeBeatPeriodsDavies(vector<Real> detections,
 
 
 void TempoTapDegara::findViterbiPath(const vector<Real>& prior,
-                     const vector<vector<Real> > transitionMatrix,
                      const vector<vector <Real> >& observations,
                      vector<Real>& path) {
   // Find the most-probable (Viterbi) path through the HMM state trellis.
 
   // Inputs:
   //   prior(i) = Pr(Q(1) = i)
-  //   transmat(i,j) = Pr(Q(t+1)=j | Q(t)=i)
+  //   transmat(i,j) = Pr(Q(t+1)=j | Q(t)=i), set up in createViterbiTransitionMatrix
   //   observations(i,t) = Pr(y(t) | Q(t)=i)
   //
   // Outputs:
   //   path(t) = q(t), where q1 ... qT is the argmax of the above expression.
 
-  // delta(j,t) = prob. of the best sequence of length t-1 and then going to state j, and O(1:t)
-  // psi(j,t) = the best predecessor state, given that we ended up in state j at t
-
-  int numberPeriods = prior.size();
-
-  vector<vector<Real> > delta; // = zeros(numberFramesODF,numberPeriods);
-  vector<vector<Real> > psi;   // = zeros(numberFramesODF,numberPeriods);
-
-  vector<Real> deltaNew;
-  deltaNew.resize(numberPeriods);
-
-  // weighten likelihoods of periods in the first frame by the prior
-  for (int i=0; i<numberPeriods; ++i) {
-    deltaNew[i] = prior[i] * observations[0][i];
-  }
-  normalizeSum(deltaNew);
-  delta.push_back(deltaNew);
-
-  vector<Real> psiNew;
-  // a vector of zeros (arbitrary, since there is no predecessor to the first frame)
-  psiNew.resize(numberPeriods);
-  psi.push_back(psiNew);
-
-  vector<Real> tmp;
-  tmp.resize(numberPeriods);
-
-  for (size_t t=1; t<_numberFramesODF; ++t) {
-    for (int j=0; j<numberPeriods; ++j) {
-      for (int i=0; i<numberPeriods; ++i) {
-        // weighten delta for a previous frame by vector from the transitionMatrix
-        tmp[i] = delta.back()[i] * transitionMatrix[j][i];
-      }
-      int iMax = argmax(tmp);
-      deltaNew[j] = tmp[iMax] * observations[t][j];
-      psiNew[j] = iMax;
-    }
-    normalizeSum(deltaNew);
-    delta.push_back(deltaNew);
-    psi.push_back(psiNew);
-  }
-
-  // track the path backwards in time
-  path.resize(_numberFramesODF);
-  path.back() = argmax(delta.back());
-  if (_numberFramesODF >= 2) {
-    for (size_t t=_numberFramesODF-2;; --t) {
-      path[t] = psi[t+1][path[t+1]];
-      if (t==0) { // size_t can't be negative, break on zero
-        break;
-      }
-    }
-  }
+  // The transition matrix is banded (gaussians of limited width), so the
+  // sparse decoder only visits the non-zero transitions of each state.
+  vector<int> states;
+  _viterbi.decode(prior, observations, states);
+  path.assign(states.begin(), states.end());
 }
 
 
@@ -529,10 +492,7 @@ void TempoTapDegara::createViterbiTransitionMatrix() {
 
   // Generalize values to any ODF sample rate.
 
-  _transitionsViterbi.resize(_hopSizeODF);
-  for (int i=0; i<_hopSizeODF; ++i) {
-    _transitionsViterbi[i].resize(_hopSizeODF);
-  }
+  vector<vector<Real> > transitions(_hopSizeODF, vector<Real>(_hopSizeODF, 0.));
 
   Real scale = _sampleRateODF / (44100./512);
 
@@ -548,10 +508,14 @@ void TempoTapDegara::createViterbiTransitionMatrix() {
     // gaussian with mean=i, std=8*scale;
     for (int j=i-gaussianMean; j<=i+gaussianMean; ++j) {
       if (j>=minIndex && j <= maxIndex) {
-        _transitionsViterbi[i][j] = gaussian[j - (i-gaussianMean)];
+        transitions[i][j] = gaussian[j - (i-gaussianMean)];
       }
     }
   }
+
+  // all-zero frames are kept as they are (as normalizeSum does)
+  _viterbi.setTransitions(transitions);
+  _viterbi.setUniformOnZero(false);
 }
 
 
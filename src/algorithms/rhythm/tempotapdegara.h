@@ -21,6 +21,13 @@
 #define ESSENTIA_TEMPOTAPDEGARA_H
 
 #include "algorithmfactory.h"
+#include "viterbidecoder.h"
+
+#ifdef CPP_11
+#  include <random>
+#else
+#  include "MersenneTwister.h"
+#endif
 
 namespace essentia {
 namespace standard {
@@ -77,14 +84,18 @@ class TempoTapDegara : public Algorithm {
   int _periodMaxUserIndex;
   int _periodMinUserIndex;
   std::vector<Real> _tempoWeights;
-  std::vector<std::vector<Real> > _transitionsViterbi;  // transition matrix for Viterbi
+  util::ViterbiDecoder<Real> _viterbi;  // decoder with the transition matrix for Viterbi
+#ifdef CPP_11
+  std::mt19937 _mtrand;  // generator for the noise added to the observations
+#else
+  MTRand _mtrand;
+#endif
   Algorithm* _autocorrelation;
   Algorithm* _movingAverage;
   Algorithm* _frameCutter;
   void createTempoPreferenceCurve();
   void createViterbiTransitionMatrix();
   void findViterbiPath(const std::vector<Real>& prior,
-                     const std::vector<std::vector<Real> > transitionMatrix,
                      const std::vector<std::vector<Real> >& observations,
                      std::vector<Real>& path);
   void computeBeatPeriodsDavies(std::vector<Real> detections,
@@ -86,6 +86,12 @@ void BFCC::configure() {
                   INHERIT("liftering"));
   _logbands.resize(parameter("numberBands").toInt());
 
+  // the DCT always reads the log bands, the other ports are bound in compute()
+  _dct->input("array").set(_logbands);
+  _filterSpectrum = _triangularBarkFilter->inputHandle<vector<Real> >("spectrum");
+  _filterBands = _triangularBarkFilter->outputHandle<vector<Real> >("bands");
+  _dctOutput = _dct->outputHandle<vector<Real> >("dct");
+
   setCompressor(parameter("logType").toString());
 
 }
@@ -98,8 +104,8 @@ void BFCC::compute() {
   vector<Real>& bands = _bands.get();
 
   // filter the spectrum using a mel-scaled filterbank
-  _triangularBarkFilter->input("spectrum").set(spectrum);
-  _triangularBarkFilter->output("bands").set(bands);
+  _filterSpectrum.set(spectrum);
+  _filterBands.set(bands);
   _triangularBarkFilter->compute();
 
   // take the dB amplitude of the spectrum
@@ -108,8 +114,7 @@ void BFCC::compute() {
   }
 
   // compute the DCT of these bands
-  _dct->input("array").set(_logbands);
-  _dct->output("dct").set(bfcc);
+  _dctOutput.set(bfcc);
   _dct->compute();
 }
 
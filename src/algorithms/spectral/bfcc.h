@@ -37,6 +37,10 @@ class BFCC : public Algorithm {
 
   std::vector<Real> _logbands;
 
+  InputHandle<std::vector<Real> > _filterSpectrum;
+  OutputHandle<std::vector<Real> > _filterBands;
+  OutputHandle<std::vector<Real> > _dctOutput;
+
   typedef  Real (*funcPointer)(Real);
   funcPointer _compressor;
 
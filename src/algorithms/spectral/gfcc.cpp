@@ -46,6 +46,12 @@ void GFCC::configure() {
                   INHERIT("dctType"));
   _logbands.resize(parameter("numberBands").toInt());
 
+  // the DCT always reads the log bands, the other ports are bound in compute()
+  _dct->input("array").set(_logbands);
+  _filterSpectrum = _gtFilter->inputHandle<vector<Real> >("spectrum");
+  _filterBands = _gtFilter->outputHandle<vector<Real> >("bands");
+  _dctOutput = _dct->outputHandle<vector<Real> >("dct");
+
   _logType = parameter("logType").toLower();
   _silenceThreshold = parameter("silenceThreshold").toReal();
   _dbSilenceThreshold = 10 * log10(_silenceThreshold);
@@ -59,8 +65,8 @@ void GFCC::compute() {
   vector<Real>& bands = _bands.get();
 
   // filter the spectrum using a gammatone filterbank
-  _gtFilter->input("spectrum").set(spectrum);
-  _gtFilter->output("bands").set(bands);
+  _filterSpectrum.set(spectrum);
+  _filterBands.set(bands);
   _gtFilter->compute();
 
   for (int i=0; i<int(bands.size()); ++i) {
@@ -82,8 +88,7 @@ void GFCC::compute() {
   }
 
   // compute the DCT of these bands
-  _dct->input("array").set(_logbands);
-  _dct->output("dct").set(gfcc);
+  _dctOutput.set(gfcc);
   _dct->compute();
 }
 
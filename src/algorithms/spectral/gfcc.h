@@ -37,6 +37,10 @@ class GFCC : public Algorithm {
 
   std::vector<Real> _logbands;
 
+  InputHandle<std::vector<Real> > _filterSpectrum;
+  OutputHandle<std::vector<Real> > _filterBands;
+  OutputHandle<std::vector<Real> > _dctOutput;
+
   std::string _logType;
   Real _silenceThreshold;
   Real _dbSilenceThreshold;
@@ -30,6 +30,8 @@ const char* HPCP::description = DOC("Computes a Harmonic Pitch Class Profile (HP
 "\n"
 "Exceptions are thrown if \"minFrequency\", \"bandSplitFrequency\" and \"maxFrequency\" are not separated by at least 200Hz from each other, requiring that \"maxFrequency\" be greater than \"bandSplitFrequency\" and \"bandSplitFrequency\" be greater than \"minFrequency\". Other exceptions are thrown if input vectors have different size, if parameter \"size\" is not a positive non-zero multiple of 12 or if \"windowSize\" is less than one hpcp bin (12/size).\n"
 "\n"
+"To compute HPCPs of several sizes with the same parameters from the same spectral peaks, use MultiResolutionHPCP, which shares the computation of the contributions of the peaks.\n"
+"\n"
 "References:\n"
 "  [1] T. Fujishima, \"Realtime Chord Recognition of Musical Sound: A System\n"
 "  Using Common Lisp Music,\" in International Computer Music Conference\n"
@@ -136,13 +138,15 @@ void HPCP::initHarmonicContributionTable() {
 }
 
 
-void HPCP::addContributionWithWeight(Real freq, Real mag_lin, vector<Real>& hpcp, Real harmonicWeight) const {
+void HPCP::addContributionWithWeight(const Contribution& contribution, vector<Real>& hpcp) const {
   int pcpSize = hpcp.size();
   Real resolution = pcpSize / 12; // # of bins / semitone
+  Real mag_lin = contribution.magnitude;
+  Real harmonicWeight = contribution.harmonicWeight;
 
   // convert frequency in Hz to frequency in pcpBin index.
   // note: this can be a negative value
-  Real pcpBinF = log2(freq / _referenceFrequency) * (Real)pcpSize;
+  Real pcpBinF = contribution.octave * (Real)pcpSize;
 
   // which bins are covered by the window centered at this frequency
   // note: this is not wrapped.
@@ -175,16 +179,14 @@ void HPCP::addContributionWithWeight(Real freq, Real mag_lin, vector<Real>& hpcp
 }
 
 
-void HPCP::addContributionWithoutWeight(Real freq, Real mag_lin, vector<Real>& hpcp, Real harmonicWeight) const {
-  if (freq <= 0)
-    return;
-
+void HPCP::addContributionWithoutWeight(const Contribution& contribution, vector<Real>& hpcp) const {
   // Original Fujishima algorithm, basically places the contribution in the
   // bin nearest to the given frequency
   int pcpsize = hpcp.size();
+  Real mag_lin = contribution.magnitude;
+  Real harmonicWeight = contribution.harmonicWeight;
 
-  Real octave = log2(freq/_referenceFrequency);
-  int pcpbin = (int)round(pcpsize * octave);  // bin distance from ref frequency
+  int pcpbin = (int)round(pcpsize * contribution.octave);  // bin distance from ref frequency
 
   pcpbin %= pcpsize;
   if (pcpbin < 0)
@@ -197,7 +199,7 @@ void HPCP::addContributionWithoutWeight(Real freq, Real mag_lin, vector<Real>& h
 // Adds the magnitude contribution of the given frequency as the tonic
 // semitone, as well as its possible contribution as a harmonic of another
 // pitch.
-void HPCP::addContribution(Real freq, Real mag_lin, vector<Real>& hpcp) const {
+void HPCP::addContribution(Real freq, Real mag_lin, bool lowBand, vector<Contribution>& contributions) const {
   vector<HarmonicPeak>::const_iterator it;
 
   for (it=_harmonicPeaks.begin(); it!= _harmonicPeaks.end(); it++) {
@@ -205,13 +207,37 @@ void HPCP::addContribution(Real freq, Real mag_lin, vector<Real>& hpcp) const {
     // _harmonicPeaks data structure always includes at least one element,
     // whose semitone value is 0, thus making this first iteration be freq == f
     Real f = freq * pow(2., -(*it).semitone / 12.0);
-    Real harmonicWeight = (*it).harmonicStrength;
 
-    if (_weightType != NONE) {
-      addContributionWithWeight(f, mag_lin, hpcp, harmonicWeight);
-    }
-    else {
-      addContributionWithoutWeight(f, mag_lin, hpcp, harmonicWeight);
+    if (_weightType == NONE && f <= 0) continue;
+
+    Contribution contribution;
+    contribution.octave = log2(f / _referenceFrequency);
+    contribution.magnitude = mag_lin;
+    contribution.harmonicWeight = (*it).harmonicStrength;
+    contribution.lowBand = lowBand;
+    contributions.push_back(contribution);
+  }
+}
+
+
+void HPCP::computeContributions(const vector<Real>& frequencies,
+                                const vector<Real>& magnitudes,
+                                vector<Contribution>& contributions) const {
+  // Check inputs
+  if (magnitudes.size() != frequencies.size()) {
+    throw EssentiaException("HPCP: Frequency and magnitude input vectors are not of equal size");
+  }
+
+  contributions.clear();
+
+  // Add each contribution of the spectral frequencies to the HPCP
+  for (int i=0; i<(int)frequencies.size(); i++) {
+    Real freq = frequencies[i];
+    Real mag_lin = magnitudes[i];
+
+    // Filter out frequencies not between min and max
+    if (freq >= _minFrequency && freq <= _maxFrequency) {
+      addContribution(freq, mag_lin, _bandPreset && freq < _splitFrequency, contributions);
     }
   }
 }
@@ -222,39 +248,33 @@ void HPCP::compute() {
   const vector<Real>& magnitudes = _magnitudes.get();
   vector<Real>& hpcp = _hpcp.get();
 
-  // Check inputs
-  if (magnitudes.size() != frequencies.size()) {
-    throw EssentiaException("HPCP: Frequency and magnitude input vectors are not of equal size");
-  }
+  computeContributions(frequencies, magnitudes, _contributions);
+  computeHPCP(_contributions, hpcp);
+}
+
 
+void HPCP::computeHPCP(const vector<Contribution>& contributions, vector<Real>& hpcp) {
   // Initialize data structures
   hpcp.resize(_size);
   fill(hpcp.begin(), hpcp.end(), (Real)0.0);
 
-  vector<Real> hpcp_LO;
-  vector<Real> hpcp_HI;
-
   if (_bandPreset) {
-    hpcp_LO.resize(_size);
-    fill(hpcp_LO.begin(), hpcp_LO.end(), (Real)0.0);
+    _hpcp_LO.resize(_size);
+    fill(_hpcp_LO.begin(), _hpcp_LO.end(), (Real)0.0);
 
-    hpcp_HI.resize(_size);
-    fill(hpcp_HI.begin(), hpcp_HI.end(), (Real)0.0);
+    _hpcp_HI.resize(_size);
+    fill(_hpcp_HI.begin(), _hpcp_HI.end(), (Real)0.0);
   }
 
-  // Add each contribution of the spectral frequencies to the HPCP
-  for (int i=0; i<(int)frequencies.size(); i++) {
-    Real freq = frequencies[i];
-    Real mag_lin = magnitudes[i];
+  for (int i=0; i<(int)contributions.size(); i++) {
+    const Contribution& contribution = contributions[i];
+    vector<Real>& band = _bandPreset ? (contribution.lowBand ? _hpcp_LO : _hpcp_HI) : hpcp;
 
-    // Filter out frequencies not between min and max
-    if (freq >= _minFrequency && freq <= _maxFrequency) {
-      if (_bandPreset) {
-        addContribution(freq, mag_lin, (freq < _splitFrequency) ? hpcp_LO : hpcp_HI);
-      }
-      else {
-        addContribution(freq, mag_lin, hpcp);
-      }
+    if (_weightType != NONE) {
+      addContributionWithWeight(contribution, band);
+    }
+    else {
+      addContributionWithoutWeight(contribution, band);
     }
   }
 
@@ -262,18 +282,18 @@ void HPCP::compute() {
   
   if (_bandPreset) {
     if (_normalized == N_UNIT_MAX) {
-      normalize(hpcp_LO);
-      normalize(hpcp_HI);
+      normalize(_hpcp_LO);
+      normalize(_hpcp_HI);
     }
     else if (_normalized == N_UNIT_SUM) {
       // TODO does it makes sense to apply band preset together with unit sum normalization?
       E_WARNING("HPCP: applying band preset together with unit sum normalization was not tested.");
-      normalizeSum(hpcp_LO);
-      normalizeSum(hpcp_HI);
+      normalizeSum(_hpcp_LO);
+      normalizeSum(_hpcp_HI);
     }
     
     for (int i=0; i<(int)hpcp.size(); i++) {
-      hpcp[i] = hpcp_LO[i] + hpcp_HI[i];
+      hpcp[i] = _hpcp_LO[i] + _hpcp_HI[i];
     }
   }
 
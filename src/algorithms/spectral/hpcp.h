@@ -35,6 +35,19 @@ class HPCP : public Algorithm {
     Real harmonicStrength;
   };
 
+  /**
+   * Contribution of a spectral peak, as a harmonic of a hypothesized
+   * fundamental frequency. It does not depend on the size of the HPCP, so
+   * that the contributions of a frame can be shared by HPCPs of different
+   * resolutions (see MultiResolutionHPCP).
+   */
+  struct Contribution {
+    Real octave; // log2 of the fundamental frequency over the reference one
+    Real magnitude;
+    Real harmonicWeight;
+    bool lowBand; // only used with the band preset
+  };
+
  protected:
   Input<std::vector<Real> > _frequencies;
   Input<std::vector<Real> > _magnitudes;
@@ -71,10 +84,25 @@ class HPCP : public Algorithm {
   static const char* description;
   static const Real precision;
 
+  // compute() is split in the two steps below, so that MultiResolutionHPCP
+  // can share the first one between HPCPs of different sizes
+
+  /**
+   * Computes the contributions of the given spectral peaks.
+   */
+  void computeContributions(const std::vector<Real>& frequencies,
+                            const std::vector<Real>& magnitudes,
+                            std::vector<Contribution>& contributions) const;
+
+  /**
+   * Computes the HPCP from the contributions of the spectral peaks.
+   */
+  void computeHPCP(const std::vector<Contribution>& contributions, std::vector<Real>& hpcp);
+
  protected:
-  void addContribution(Real freq, Real mag_lin, std::vector<Real>& hpcp) const;
-  void addContributionWithWeight(Real freq, Real mag_lin, std::vector<Real>& hpcp, Real harmonicWeight) const;
-  void addContributionWithoutWeight(Real freq, Real mag_lin, std::vector<Real>& hpcp, Real harmonicWeight) const;
+  void addContribution(Real freq, Real mag_lin, bool lowBand, std::vector<Contribution>& contributions) const;
+  void addContributionWithWeight(const Contribution& contribution, std::vector<Real>& hpcp) const;
+  void addContributionWithoutWeight(const Contribution& contribution, std::vector<Real>& hpcp) const;
 
   void initHarmonicContributionTable();
   int _size;
@@ -100,6 +128,10 @@ class HPCP : public Algorithm {
   bool _maxShifted;
 
   std::vector<HarmonicPeak> _harmonicPeaks;
+
+  std::vector<Contribution> _contributions;
+  std::vector<Real> _hpcp_LO;
+  std::vector<Real> _hpcp_HI;
 };
 
 } // namespace standard
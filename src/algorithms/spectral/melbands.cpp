@@ -46,6 +46,7 @@ const char* MelBands::description = DOC("This algorithm computes energy in mel b
 
 
 void MelBands::configure() {
+  markConfigured();
   if (parameter("highFrequencyBound").toReal() > parameter("sampleRate").toReal()*0.5 ) {
     throw EssentiaException("MelBands: High frequency bound cannot be higher than Nyquist frequency");
   }
@@ -90,6 +91,8 @@ void MelBands::calculateFilterFrequencies() {
 
 
 void MelBands::compute() {
+  ensureConfigured();
+
   const std::vector<Real>& spectrum = _spectrumInput.get();
   std::vector<Real>& bands = _bandsOutput.get();
 
@@ -63,6 +63,7 @@ class MelBands : public Algorithm {
   }
 
   void configure();
+  bool deferDefaultConfiguration() const { return true; }
   void compute();
 
   static const char* name;
@@ -82,6 +82,7 @@ const char* MFCC::description = DOC("This algorithm computes the mel-frequency c
 
 
 void MFCC::configure() {
+  markConfigured();
   _melFilter->configure(INHERIT("inputSize"),
                         INHERIT("sampleRate"),
                         INHERIT("numberBands"),
@@ -98,6 +99,12 @@ void MFCC::configure() {
                   INHERIT("liftering"));
   _logbands.resize(parameter("numberBands").toInt());
 
+  // the DCT always reads the log bands, the other ports are bound in compute()
+  _dct->input("array").set(_logbands);
+  _filterSpectrum = _melFilter->inputHandle<vector<Real> >("spectrum");
+  _filterBands = _melFilter->outputHandle<vector<Real> >("bands");
+  _dctOutput = _dct->outputHandle<vector<Real> >("dct");
+
   _logType = parameter("logType").toLower();
   _silenceThreshold = parameter("silenceThreshold").toReal();
   _dbSilenceThreshold = 10 * log10(_silenceThreshold);
@@ -106,6 +113,7 @@ void MFCC::configure() {
 
 
 void MFCC::compute() {
+  ensureConfigured();
 
   // get the inputs and outputs
   const vector<Real>& spectrum = _spectrum.get();
@@ -113,8 +121,8 @@ void MFCC::compute() {
   vector<Real>& bands = _bands.get();
 
   // filter the spectrum using a mel-scaled filterbank
-  _melFilter->input("spectrum").set(spectrum);
-  _melFilter->output("bands").set(bands);
+  _filterSpectrum.set(spectrum);
+  _filterBands.set(bands);
   _melFilter->compute();
 
   // take the dB amplitude of the spectrum
@@ -137,7 +145,6 @@ void MFCC::compute() {
   }
 
   // compute the DCT of these bands
-  _dct->input("array").set(_logbands);
-  _dct->output("dct").set(mfcc);
+  _dctOutput.set(mfcc);
   _dct->compute();
 }
@@ -36,6 +36,10 @@ class MFCC : public Algorithm {
   Algorithm* _dct;
 
   std::vector<Real> _logbands;
+
+  InputHandle<std::vector<Real> > _filterSpectrum;
+  OutputHandle<std::vector<Real> > _filterBands;
+  OutputHandle<std::vector<Real> > _dctOutput;
   std::string _logType;
   Real _silenceThreshold;
   Real _dbSilenceThreshold;
@@ -74,6 +78,7 @@ class MFCC : public Algorithm {
   }
 
   void configure();
+  bool deferDefaultConfiguration() const { return true; }
   void compute();
 
   static const char* name;
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "multiresolutionhpcp.h"
+#include "algorithmfactory.h"
+
+using namespace std;
+
+namespace essentia {
+namespace standard {
+
+const char* MultiResolutionHPCP::name = "MultiResolutionHPCP";
+const char* MultiResolutionHPCP::category = "Tonal";
+const char* MultiResolutionHPCP::description = DOC("This algorithm computes Harmonic Pitch Class Profiles (HPCP) of several sizes from the same spectral peaks. It is equivalent to (and gives exactly the same values as) one HPCP algorithm per size, all of them configured with the same parameters, but the contribution of each spectral peak and its harmonics (band filtering, fundamental frequency and octave position) is only computed once and shared by all the resolutions.\n"
+"\n"
+"Outputs are created for each of the sizes in the \"sizes\" parameter, so that the HPCP of the size with index i is output as \"hpcp_i\". All the other parameters have the same meaning as in HPCP.\n"
+"\n"
+"Exceptions are thrown if the list of sizes is empty, and for the same reasons as in HPCP for any of the sizes.");
+
+
+void MultiResolutionHPCP::clearOutputs() {
+  for (int i=0; i<(int)_hpcps.size(); i++) delete _hpcps[i];
+  _hpcps.clear();
+  _outputs.clear(); // so that the outputs can be declared again
+}
+
+void MultiResolutionHPCP::clearAlgorithms() {
+  for (int i=0; i<(int)_hpcpAlgos.size(); i++) delete _hpcpAlgos[i];
+  _hpcpAlgos.clear();
+}
+
+void MultiResolutionHPCP::configure() {
+  vector<Real> sizes = parameter("sizes").toVectorReal();
+
+  if (sizes.empty()) {
+    throw EssentiaException("MultiResolutionHPCP: the list of sizes is empty");
+  }
+
+  clearAlgorithms();
+  for (int i=0; i<(int)sizes.size(); i++) {
+    if (sizes[i] < 12 || sizes[i] != (int)sizes[i]) {
+      throw EssentiaException("MultiResolutionHPCP: the sizes must be positive nonzero multiples of 12");
+    }
+
+    Algorithm* hpcp = AlgorithmFactory::create("HPCP");
+    _hpcpAlgos.push_back(static_cast<HPCP*>(hpcp));
+    hpcp->configure("size", (int)sizes[i],
+                    INHERIT("referenceFrequency"),
+                    INHERIT("harmonics"),
+                    INHERIT("bandPreset"),
+                    INHERIT("bandSplitFrequency"),
+                    INHERIT("minFrequency"),
+                    INHERIT("maxFrequency"),
+                    INHERIT("weightType"),
+                    INHERIT("nonLinear"),
+                    INHERIT("windowSize"),
+                    INHERIT("sampleRate"),
+                    INHERIT("maxShifted"),
+                    INHERIT("normalized"));
+  }
+
+  clearOutputs();
+  for (int i=0; i<(int)sizes.size(); i++) {
+    ostringstream index;
+    index << i;
+    ostringstream size;
+    size << (int)sizes[i];
+    _hpcps.push_back(new Output<vector<Real> >());
+    declareOutput(*_hpcps.back(), "hpcp_" + index.str(),
+                  "the resulting harmonic pitch class profile of size " + size.str());
+  }
+}
+
+void MultiResolutionHPCP::compute() {
+  const vector<Real>& frequencies = _frequencies.get();
+  const vector<Real>& magnitudes = _magnitudes.get();
+
+  // the contributions only depend on the parameters shared by all the HPCPs
+  _hpcpAlgos[0]->computeContributions(frequencies, magnitudes, _contributions);
+
+  for (int i=0; i<(int)_hpcpAlgos.size(); i++) {
+    _hpcpAlgos[i]->computeHPCP(_contributions, _hpcps[i]->get());
+  }
+}
+
+} // namespace standard
+} // namespace essentia
+
+
+namespace essentia {
+namespace streaming {
+
+const char* MultiResolutionHPCP::name = standard::MultiResolutionHPCP::name;
+const char* MultiResolutionHPCP::category = standard::MultiResolutionHPCP::category;
+const char* MultiResolutionHPCP::description = standard::MultiResolutionHPCP::description;
+
+MultiResolutionHPCP::MultiResolutionHPCP() : Algorithm() {
+  _hpcpAlgo = standard::AlgorithmFactory::create("MultiResolutionHPCP");
+
+  declareInput(_frequencies, 1, "frequencies", "the frequencies of the spectral peaks [Hz]");
+  declareInput(_magnitudes, 1, "magnitudes", "the magnitudes of the spectral peaks");
+}
+
+MultiResolutionHPCP::~MultiResolutionHPCP() {
+  clearOutputs();
+  delete _hpcpAlgo;
+}
+
+void MultiResolutionHPCP::clearOutputs() {
+  for (int i=0; i<(int)_hpcps.size(); i++) delete _hpcps[i];
+  _hpcps.clear();
+  _outputs.clear(); // so that the outputs can be declared again
+}
+
+void MultiResolutionHPCP::configure() {
+  _hpcpAlgo->configure(INHERIT("sizes"),
+                       INHERIT("referenceFrequency"),
+                       INHERIT("harmonics"),
+                       INHERIT("bandPreset"),
+                       INHERIT("bandSplitFrequency"),
+                       INHERIT("minFrequency"),
+                       INHERIT("maxFrequency"),
+                       INHERIT("weightType"),
+                       INHERIT("nonLinear"),
+                       INHERIT("windowSize"),
+                       INHERIT("sampleRate"),
+                       INHERIT("maxShifted"),
+                       INHERIT("normalized"));
+
+  vector<Real> sizes = parameter("sizes").toVectorReal();
+
+  clearOutputs();
+  for (int i=0; i<(int)sizes.size(); i++) {
+    ostringstream index;
+    index << i;
+    string outputName = "hpcp_" + index.str();
+    _hpcps.push_back(new Source<vector<Real> >());
+    declareOutput(*_hpcps.back(), 1, outputName, _hpcpAlgo->outputDescription[outputName]);
+  }
+}
+
+AlgorithmStatus MultiResolutionHPCP::process() {
+  AlgorithmStatus status = acquireData();
+  if (status != OK) return status;
+
+  _hpcpAlgo->input("frequencies").set(_frequencies.firstToken());
+  _hpcpAlgo->input("magnitudes").set(_magnitudes.firstToken());
+  for (int i=0; i<(int)_hpcps.size(); i++) {
+    ostringstream index;
+    index << i;
+    _hpcpAlgo->output("hpcp_" + index.str()).set(_hpcps[i]->firstToken());
+  }
+  _hpcpAlgo->compute();
+
+  releaseData();
+
+  return OK;
+}
+
+} // namespace streaming
+} // namespace essentia
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_MULTIRESOLUTIONHPCP_H
+#define ESSENTIA_MULTIRESOLUTIONHPCP_H
+
+#include "algorithm.h"
+#include "hpcp.h"
+
+namespace essentia {
+namespace standard {
+
+class MultiResolutionHPCP : public Algorithm {
+
+ protected:
+  Input<std::vector<Real> > _frequencies;
+  Input<std::vector<Real> > _magnitudes;
+  std::vector<Output<std::vector<Real> >*> _hpcps;
+
+  std::vector<HPCP*> _hpcpAlgos;
+  std::vector<HPCP::Contribution> _contributions;
+
+  void clearOutputs();
+  void clearAlgorithms();
+
+ public:
+  MultiResolutionHPCP() {
+    declareInput(_frequencies, "frequencies", "the frequencies of the spectral peaks [Hz]");
+    declareInput(_magnitudes, "magnitudes", "the magnitudes of the spectral peaks");
+  }
+
+  ~MultiResolutionHPCP() {
+    clearOutputs();
+    clearAlgorithms();
+  }
+
+  void declareParameters() {
+    Real sizes[] = { 12, 36, 120 };
+    declareParameter("sizes", "the sizes of the output HPCPs (each must be a positive nonzero multiple of 12)", "", arrayToVector<Real>(sizes));
+    declareParameter("referenceFrequency", "the reference frequency for semitone index calculation, corresponding to A3 [Hz]", "(0,inf)", 440.0);
+    declareParameter("harmonics", "number of harmonics for frequency contribution, 0 indicates exclusive fundamental frequency contribution", "[0,inf)", 0);
+    declareParameter("bandPreset", "enables whether to use a band preset", "{true,false}", true);
+    declareParameter("bandSplitFrequency", "the split frequency for low and high bands, not used if bandPreset is false [Hz]", "(0,inf)", 500.0);
+    declareParameter("minFrequency", "the minimum frequency that contributes to the HPCP [Hz] (the difference between the min and split frequencies must not be less than 200.0 Hz)", "(0,inf)", 40.0);
+    declareParameter("maxFrequency", "the maximum frequency that contributes to the HPCP [Hz] (the difference between the max and split frequencies must not be less than 200.0 Hz)", "(0,inf)", 5000.0);
+    declareParameter("weightType", "type of weighting function for determining frequency contribution", "{none,cosine,squaredCosine}", "squaredCosine");
+    declareParameter("nonLinear", "apply non-linear post-processing to the output (use with normalized='unitMax'). Boosts values close to 1, decreases values close to 0.", "{true,false}", false);
+    declareParameter("windowSize", "the size, in semitones, of the window used for the weighting", "(0,12]", 1.0);
+    declareParameter("sampleRate", "the sampling rate of the audio signal [Hz]", "(0,inf)", 44100.);
+    declareParameter("maxShifted", "whether to shift the HPCP vectors so that the maximum peak is at index 0", "{true,false}", false);
+    declareParameter("normalized", "whether to normalize the HPCP vectors", "{none,unitSum,unitMax}", "unitMax");
+  }
+
+  void configure();
+  void compute();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+};
+
+} // namespace standard
+} // namespace essentia
+
+#include "streamingalgorithm.h"
+
+namespace essentia {
+namespace streaming {
+
+class MultiResolutionHPCP : public Algorithm {
+
+ protected:
+  Sink<std::vector<Real> > _frequencies;
+  Sink<std::vector<Real> > _magnitudes;
+  std::vector<Source<std::vector<Real> >*> _hpcps;
+
+  standard::Algorithm* _hpcpAlgo;
+
+  void clearOutputs();
+
+ public:
+  MultiResolutionHPCP();
+  ~MultiResolutionHPCP();
+
+  void declareParameters() {
+    Real sizes[] = { 12, 36, 120 };
+    declareParameter("sizes", "the sizes of the output HPCPs (each must be a positive nonzero multiple of 12)", "", arrayToVector<Real>(sizes));
+    declareParameter("referenceFrequency", "the reference frequency for semitone index calculation, corresponding to A3 [Hz]", "(0,inf)", 440.0);
+    declareParameter("harmonics", "number of harmonics for frequency contribution, 0 indicates exclusive fundamental frequency contribution", "[0,inf)", 0);
+    declareParameter("bandPreset", "enables whether to use a band preset", "{true,false}", true);
+    declareParameter("bandSplitFrequency", "the split frequency for low and high bands, not used if bandPreset is false [Hz]", "(0,inf)", 500.0);
+    declareParameter("minFrequency", "the minimum frequency that contributes to the HPCP [Hz] (the difference between the min and split frequencies must not be less than 200.0 Hz)", "(0,inf)", 40.0);
+    declareParameter("maxFrequency", "the maximum frequency that contributes to the HPCP [Hz] (the difference between the max and split frequencies must not be less than 200.0 Hz)", "(0,inf)", 5000.0);
+    declareParameter("weightType", "type of weighting function for determining frequency contribution", "{none,cosine,squaredCosine}", "squaredCosine");
+    declareParameter("nonLinear", "apply non-linear post-processing to the output (use with normalized='unitMax'). Boosts values close to 1, decreases values close to 0.", "{true,false}", false);
+    declareParameter("windowSize", "the size, in semitones, of the window used for the weighting", "(0,12]", 1.0);
+    declareParameter("sampleRate", "the sampling rate of the audio signal [Hz]", "(0,inf)", 44100.);
+    declareParameter("maxShifted", "whether to shift the HPCP vectors so that the maximum peak is at index 0", "{true,false}", false);
+    declareParameter("normalized", "whether to normalize the HPCP vectors", "{none,unitSum,unitMax}", "unitMax");
+  }
+
+  void configure();
+  AlgorithmStatus process();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+};
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_MULTIRESOLUTIONHPCP_H
@@ -31,6 +31,7 @@ const char* TriangularBands::description = DOC("This algorithm computes energy i
 
 
 void TriangularBands::configure() {
+  markConfigured();
   _bandFrequencies = parameter("frequencyBands").toVectorReal();
   _nBands = int(_bandFrequencies.size() - 2);
   _inputSize = parameter("inputSize").toReal();
@@ -57,6 +58,8 @@ void TriangularBands::configure() {
 
 
 void TriangularBands::compute() {
+  ensureConfigured();
+
   const vector<Real>& spectrum = _spectrumInput.get();
   vector<Real>& bands = _bandsOutput.get();
 
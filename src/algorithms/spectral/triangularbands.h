@@ -70,6 +70,7 @@ class TriangularBands : public Algorithm {
 
   void compute();
   void configure();
+  bool deferDefaultConfiguration() const { return true; }
 
 
   static const char* name;
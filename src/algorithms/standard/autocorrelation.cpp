@@ -54,11 +54,6 @@ void AutoCorrelation::configure() {
 
   _generalized = parameter("generalized").toBool();
   _frequencyDomainCompression = parameter("frequencyDomainCompression").toReal();
-
-  _ifft->configure("normalize", !_generalized);
-
-  _fft->output("fft").set(_fftBuffer);
-  _ifft->input("fft").set(_fftBuffer);
 }
 
 void AutoCorrelation::compute() {
@@ -71,9 +66,6 @@ void AutoCorrelation::compute() {
     return;
   }
 
-  _fft->input("frame").set(_paddedSignal);
-  _ifft->output("frame").set(_corr);
-
   int size = int(signal.size());
   int sizeFFT = int(nextPowerTwo(2*size));
 
@@ -82,13 +74,9 @@ void AutoCorrelation::compute() {
   //  X = fft(x,2^nextpow2(2*M-1));
   //  c = ifft(abs(X).^2);
 
-  // copy signal, and zero-pad it; use _corr as temporary array
-  _paddedSignal.resize(sizeFFT);
-  for (int i=0; i<size; i++) _paddedSignal[i] = signal[i];
-  for (int i=size; i<sizeFFT; i++) _paddedSignal[i] = 0.0;
-
-  // first compute fft
-  _fft->compute();
+  // first compute fft of the zero-padded signal; input sizes falling in the
+  // same power-of-two bucket reuse the same plans
+  _correlator.spectrum(signal, sizeFFT, _fftBuffer);
 
   // take squared amplitude of the spectrum
   // (using magnitude would compute sqrt*sqrt)
@@ -106,7 +94,7 @@ void AutoCorrelation::compute() {
   }
 
   // step 3
-  _ifft->compute();
+  _correlator.inverse(_fftBuffer, _corr, !_generalized);
 
   // copy results in output array, scaling on the go (normalizing the output of the IFFT)
   correlation.resize(size);
@@ -21,6 +21,7 @@
 #define ESSENTIA_AUTOCORRELATION_H
 
 #include "algorithmfactory.h"
+#include "fftcorrelation.h"
 #include <complex>
 
 namespace essentia {
@@ -36,23 +37,14 @@ class AutoCorrelation : public Algorithm {
   Real _frequencyDomainCompression;
   std::vector<std::complex<Real> > _fftBuffer;
   std::vector<Real> _corr;
-  std::vector<Real> _paddedSignal;
 
-  Algorithm* _fft;
-  Algorithm* _ifft;
+  // keeps the FFT/IFFT plans of the last power-of-two sizes used
+  util::FFTCorrelation _correlator;
 
  public:
-  AutoCorrelation() : _fftBuffer(0), _corr(0), _paddedSignal(0) {
+  AutoCorrelation() : _fftBuffer(0), _corr(0) {
     declareInput(_signal, "array", "the array to be analyzed");
     declareOutput(_correlation, "autoCorrelation", "the autocorrelation vector");
-
-    _fft = AlgorithmFactory::create("FFT");
-    _ifft = AlgorithmFactory::create("IFFT");
-  }
-
-  ~AutoCorrelation() {
-    delete _fft;
-    delete _ifft;
   }
 
   void declareParameters() {
@@ -64,10 +56,6 @@ class AutoCorrelation : public Algorithm {
   void configure();
   void compute();
 
- protected:
-  void createFFTObject(int size);
-
- public:
   static const char* name;
   static const char* category;
   static const char* description;
@@ -20,6 +20,9 @@
 #include "constantq.h"
 #include "essentia.h"
 #include <iostream>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 using namespace std;
 using namespace essentia;
@@ -52,17 +55,66 @@ void ConstantQ::compute() {
   _fft->input("frame").set(frame);
   _fft->compute();
 
-  constantQ.assign(_numberBins, complex<Real>(0, 0)); // Initialize output.
+  constantQ.resize(_numberBins);
 
-  for (unsigned i=0; i<_sparseKernel.real.size(); i++) {
-    const unsigned row = _sparseKernel.j[i];
-    const unsigned col = _sparseKernel.i[i];
-    const double & r1  = _sparseKernel.real[i];
-    const double & i1  = _sparseKernel.imag[i];
-    const double r2 = (double)_fftData[col].real();
-    const double i2 = (double)_fftData[col].imag();
+  const complex<Real>* fft = &_fftData[0];
+  const vector<unsigned>& rowStart = _kernel->rowStart;
+  const unsigned* columns = _kernel->columns.empty() ? 0 : &_kernel->columns[0];
+  const double* values = _kernel->values.empty() ? 0 : &_kernel->values[0];
 
-    constantQ[row] += complex<Real>((r1*r2 - i1*i2), (r1*i2 + i1*r2));
+  // The products are computed in double precision and accumulated in single
+  // precision, in the order of the kernel coefficients.
+  for (unsigned k=0; k<_numberBins; k++) {
+    const unsigned end = rowStart[k+1];
+
+#ifdef __SSE2__
+    const __m128d negateReal = _mm_set_pd(0.0, -0.0);
+    __m128 sum = _mm_setzero_ps();
+
+    for (unsigned n=rowStart[k]; n<end; n++) {
+      const __m128d kernel = _mm_loadu_pd(values + 2*n);          // (r1, i1)
+      const __m128d x = _mm_cvtps_pd(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(fft + columns[n]))); // (r2, i2)
+
+      __m128d a = _mm_mul_pd(kernel, _mm_unpacklo_pd(x, x));      // (r1*r2, i1*r2)
+      __m128d b = _mm_mul_pd(_mm_shuffle_pd(kernel, kernel, 1),
+                             _mm_unpackhi_pd(x, x));              // (i1*i2, r1*i2)
+      b = _mm_xor_pd(b, negateReal);
+
+      sum = _mm_add_ps(sum, _mm_cvtpd_ps(_mm_add_pd(a, b)));
+    }
+
+    _mm_storel_pi((__m64*)&constantQ[k], sum);
+#else
+    Real sumReal = 0, sumImag = 0;
+
+    for (unsigned n=rowStart[k]; n<end; n++) {
+      const double r1 = values[2*n];
+      const double i1 = values[2*n+1];
+      const double r2 = (double)fft[columns[n]].real();
+      const double i2 = (double)fft[columns[n]].imag();
+
+      sumReal += (Real)(r1*r2 - i1*i2);
+      sumImag += (Real)(r1*i2 + i1*r2);
+    }
+
+    constantQ[k] = complex<Real>(sumReal, sumImag);
+#endif
+  }
+}
+
+
+void ConstantQ::Kernel::write(ostream& out) const {
+  util::writeBinary(out, rowStart);
+  util::writeBinary(out, columns);
+  util::writeBinary(out, values);
+}
+
+void ConstantQ::Kernel::read(istream& in) {
+  util::readBinary(in, rowStart);
+  util::readBinary(in, columns);
+  util::readBinary(in, values);
+  if (rowStart.empty() || rowStart.back() != columns.size() || values.size() != 2*columns.size()) {
+    throw EssentiaException("ConstantQ: corrupt kernel in the kernel cache");
   }
 }
 
@@ -93,13 +145,27 @@ void ConstantQ::configure() {
   // Work only with a non-negative part of FFT as an input.
   _inputFFTSize = _windowSize / 2 + 1;
 
-  // Get a new sparseKernel and reserve the maximum amount
-  // of memory posible (for the dense kernel case).
-  _sparseKernel = {};
-  _sparseKernel.i.reserve(_windowSize / 2 + 1);
-  _sparseKernel.j.reserve(_windowSize / 2 + 1);
-  _sparseKernel.real.reserve(_windowSize / 2 + 1);
-  _sparseKernel.imag.reserve(_windowSize / 2 + 1);
+  // Computing the kernel needs an FFT per bin, so it is only done if no
+  // other instance has already done it with the same parameters.
+  string key = util::kernelKey(name, _params);
+  _kernel = kernelCache().get(key);
+  if (!_kernel) {
+    std::shared_ptr<Kernel> kernel(new Kernel());
+    computeKernel(*kernel);
+    _kernel = kernel;
+    kernelCache().insert(key, _kernel);
+  }
+}
+
+
+void ConstantQ::computeKernel(Kernel& kernel) {
+  // The kernel coefficients, in the order in which they are computed.
+  vector<unsigned> rows, columns;
+  vector<double> values;
+
+  rows.reserve(_windowSize / 2 + 1);
+  columns.reserve(_windowSize / 2 + 1);
+  values.reserve(_windowSize + 2);
 
   vector<complex<Real> > binKernel;
   vector<complex<Real> > binKernelFFT;
@@ -182,12 +248,32 @@ void ConstantQ::configure() {
       if (abs(binKernelFFT[j]) / 2 <= threshold) continue;
 
       // Insert non-zero position indexes.
-      _sparseKernel.i.push_back(j);
-      _sparseKernel.j.push_back(k);
+      rows.push_back(k);
+      columns.push_back(j);
 
-      // Take conjugate, normalize and add to array sparseKernel.
-      _sparseKernel.real.push_back(binKernelFFT[j].real() * length / ((Real)_windowSize * 2));
-      _sparseKernel.imag.push_back(-binKernelFFT[j].imag() * length / ((Real)_windowSize * 2));
+      // Take conjugate, normalize and add to the kernel.
+      values.push_back(binKernelFFT[j].real() * length / ((Real)_windowSize * 2));
+      values.push_back(-binKernelFFT[j].imag() * length / ((Real)_windowSize * 2));
     }
   }
+
+  // Convert to compressed sparse rows, keeping the order of the coefficients
+  // within each row.
+  kernel.rowStart.assign(_numberBins + 1, 0);
+  for (size_t n=0; n<rows.size(); n++) {
+    kernel.rowStart[rows[n] + 1]++;
+  }
+  for (unsigned k=0; k<_numberBins; k++) {
+    kernel.rowStart[k+1] += kernel.rowStart[k];
+  }
+
+  vector<unsigned> next(kernel.rowStart.begin(), kernel.rowStart.end() - 1);
+  kernel.columns.resize(columns.size());
+  kernel.values.resize(values.size());
+  for (size_t n=0; n<rows.size(); n++) {
+    unsigned pos = next[rows[n]]++;
+    kernel.columns[pos] = columns[n];
+    kernel.values[2*pos] = values[2*n];
+    kernel.values[2*pos+1] = values[2*n+1];
+  }
 }
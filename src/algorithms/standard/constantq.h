@@ -23,6 +23,7 @@
 #include "algorithm.h"
 #include "algorithmfactory.h"
 #include "essentiamath.h"
+#include "kernelcache.h"
 #include <complex>
 #include <vector>
 
@@ -31,6 +32,31 @@ namespace essentia {
 namespace standard {
 
 class ConstantQ : public Algorithm {
+ public:
+  /**
+   * Spectral kernel in compressed sparse row format: the coefficients of bin
+   * k are the ones in [rowStart[k], rowStart[k+1]), ordered by FFT bin, with
+   * their real and imaginary parts interleaved in values.
+   */
+  struct Kernel {
+    std::vector<unsigned> rowStart;
+    std::vector<unsigned> columns;
+    std::vector<double> values;
+
+    static const char* cacheTag() { return "ConstantQ"; }
+    static int cacheVersion() { return 1; }
+    void write(std::ostream& out) const;
+    void read(std::istream& in);
+  };
+
+  /**
+   * The kernels of all the ConstantQ instances of the process, which can be
+   * saved to disk and reloaded to avoid computing them again.
+   */
+  static util::KernelCache<Kernel>& kernelCache() {
+    return util::KernelCache<Kernel>::instance();
+  }
+
  protected:
   Input<std::vector<Real> > _frame;
   Output<std::vector<std::complex<Real> > > _constantQ;
@@ -58,14 +84,9 @@ class ConstantQ : public Algorithm {
 
   bool _zeroPhase;
 
-  struct SparseKernel {
-    std::vector<double> real;
-    std::vector<double> imag;
-    std::vector<unsigned> i; 
-    std::vector<unsigned> j;
-  };
+  util::KernelCache<Kernel>::KernelPtr _kernel;
 
-  SparseKernel _sparseKernel;
+  void computeKernel(Kernel& kernel);
 
 
  public:
@@ -81,6 +102,7 @@ class ConstantQ : public Algorithm {
   ~ConstantQ() {
     delete _fftc;
     delete _windowing;
+    delete _fft;
   }
 
   void declareParameters() {
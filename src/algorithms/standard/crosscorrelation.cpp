@@ -18,6 +18,7 @@
  */
 
 #include "crosscorrelation.h"
+#include "essentiamath.h"
 
 using namespace essentia;
 using namespace standard;
@@ -26,6 +27,8 @@ const char* CrossCorrelation::name = "CrossCorrelation";
 const char* CrossCorrelation::category = "Standard";
 const char* CrossCorrelation::description = DOC("This algorithm computes the cross-correlation vector of two signals. It accepts 2 parameters, minLag and maxLag which define the range of the computation of the innerproduct.\n"
 "\n"
+"By default the inner products are computed directly. With the \"method\" parameter set to \"fft\", the correlation is computed via FFT in O(n log n) instead, which is much faster for large lag ranges but less precise: the error grows with the energy of the inputs rather than with the size of each inner product. With \"auto\", the FFT is only used when the number of lags and the input sizes make it faster.\n"
+"\n"
 "An exception is thrown if \"minLag\" is larger than \"maxLag\". An exception is also thrown if the input vectors are empty.\n"
 "\n"
 "References:\n"
@@ -36,6 +39,7 @@ void CrossCorrelation::configure() {
   if (parameter("minLag").toInt() > parameter("maxLag").toInt()) {
     throw EssentiaException("CrossCorrelation: minLag parameter cannot be larger than maxLag parameter");
   }
+  _method = parameter("method").toString();
 }
 
 void CrossCorrelation::compute() {
@@ -55,6 +59,22 @@ void CrossCorrelation::compute() {
 
   int size = wantedMaxLag - wantedMinLag + 1;
 
+  if (_method != "direct" && maxLag >= minLag) {
+    bool useFFT = _method == "fft";
+    if (!useFFT) {
+      // estimated number of operations: direct computation vs. 3 FFTs (the
+      // constant accounts for the complex arithmetic and the FFT overhead)
+      int sizeFFT = util::FFTCorrelation::fftSize(signal_x.size(), signal_y.size());
+      double directCost = double(maxLag - minLag + 1) * std::min(signal_x.size(), signal_y.size());
+      double fftCost = 10. * sizeFFT * log2((Real)sizeFFT);
+      useFFT = directCost > fftCost;
+    }
+    if (useFFT) {
+      _correlator.crossCorrelation(signal_x, signal_y, wantedMinLag, wantedMaxLag, correlation);
+      return;
+    }
+  }
+
   correlation.resize(size);
 
   int correlationIndex = 0;
@@ -21,6 +21,7 @@
 #define ESSENTIA_CROSSCORRELATION_H
 
 #include "algorithm.h"
+#include "fftcorrelation.h"
 
 namespace essentia {
 namespace standard {
@@ -32,6 +33,9 @@ class CrossCorrelation : public Algorithm {
   Input<std::vector<Real> > _signal_y;
   Output<std::vector<Real> > _correlation;
 
+  util::FFTCorrelation _correlator;
+  std::string _method;
+
  public:
   CrossCorrelation() {
     declareInput(_signal_x, "arrayX", "the first input array");
@@ -42,6 +46,7 @@ class CrossCorrelation : public Algorithm {
   void declareParameters() {
     declareParameter("minLag", "the minimum lag to be computed between the two vectors", "(-inf,inf)", 0);
     declareParameter("maxLag", "the maximum lag to be computed between the two vectors", "(-inf,inf)", 1);
+    declareParameter("method", "how to compute the correlation: directly, via FFT (faster for large lag ranges, less precise), or via FFT only when it is faster", "{direct,fft,auto}", "direct");
   }
 
   void configure();
@@ -38,6 +38,7 @@ const char* DCT::description = DOC("This algorithm computes the Discrete Cosine
 
 
 void DCT::configure() {
+  markConfigured();
   int inputSize = parameter("inputSize").toInt();
   _outputSize = parameter("outputSize").toInt();
   _type = parameter("dctType").toInt();
@@ -123,6 +124,7 @@ void DCT::createDctTableIII(int inputSize, int outputSize) {
 
 
 void DCT::compute() {
+  ensureConfigured();
 
   const vector<Real>& array = _array.get();
   vector<Real>& dct = _dct.get();
@@ -45,6 +45,7 @@ class DCT : public Algorithm {
   }
 
   void configure();
+  bool deferDefaultConfiguration() const { return true; }
   void compute();
 
   static const char* name;
@@ -57,6 +57,8 @@ FFTA::~FFTA() {
 }
 
 void FFTA::compute() {
+  ensureConfigured();
+
     
   const std::vector<Real>& signal = _signal.get();
   std::vector<std::complex<Real> >& fft = _fft.get();
@@ -101,6 +103,7 @@ void FFTA::compute() {
 }
 
 void FFTA::configure() {
+  markConfigured();
   createFFTObject(parameter("size").toInt());
 }
 
@@ -53,6 +53,7 @@ class FFTA : public Algorithm {
 
   void compute();
   void configure();
+  bool deferDefaultConfiguration() const { return true; }
 
   static const char* name;
   static const char* category;
@@ -58,6 +58,8 @@ FFTAComplex::~FFTAComplex() {
 }
 
 void FFTAComplex::compute() {
+  ensureConfigured();
+
   const std::vector<std::complex<Real> >& signal = _signal.get();
   std::vector<std::complex<Real> >& fft = _fft.get();
 
@@ -92,6 +94,7 @@ void FFTAComplex::compute() {
 }
 
 void FFTAComplex::configure() {
+  markConfigured();
   _negativeFrequencies = parameter("negativeFrequencies").toBool();
   createFFTObject(parameter("size").toInt());
 }
@@ -56,6 +56,7 @@ class FFTAComplex : public Algorithm {
 
   void compute();
   void configure();
+  bool deferDefaultConfiguration() const { return true; }
 
   static const char* name;
   static const char* category;
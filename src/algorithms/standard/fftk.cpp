@@ -56,6 +56,7 @@ FFTK::~FFTK() {
 }
 
 void FFTK::compute() {
+  ensureConfigured();
 
   const std::vector<Real>& signal = _signal.get();
   std::vector<std::complex<Real> >& fft = _fft.get();
@@ -81,6 +82,7 @@ void FFTK::compute() {
 }
 
 void FFTK::configure() {
+  markConfigured();
   createFFTObject(parameter("size").toInt());
 }
 
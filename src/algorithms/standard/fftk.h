@@ -48,6 +48,7 @@ class FFTK : public Algorithm {
 
   void compute();
   void configure();
+  bool deferDefaultConfiguration() const { return true; }
 
   static const char* name;
   static const char* category;
@@ -56,6 +56,7 @@ FFTKComplex::~FFTKComplex() {
 }
 
 void FFTKComplex::compute() {
+  ensureConfigured();
 
   const vector<complex<Real> >& signal = _signal.get();
   vector<complex<Real> >& fft = _fft.get();
@@ -87,6 +88,7 @@ void FFTKComplex::compute() {
 }
 
 void FFTKComplex::configure() {
+  markConfigured();
   _negativeFrequencies = parameter("negativeFrequencies").toBool();
   createFFTObject(parameter("size").toInt());
 }
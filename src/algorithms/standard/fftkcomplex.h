@@ -50,6 +50,7 @@ class FFTKComplex : public Algorithm {
 
   void compute();
   void configure();
+  bool deferDefaultConfiguration() const { return true; }
 
   static const char* name;
   static const char* category;
@@ -52,6 +52,7 @@ FFTW::~FFTW() {
 }
 
 void FFTW::compute() {
+  ensureConfigured();
 
   const std::vector<Real>& signal = _signal.get();
   std::vector<std::complex<Real> >& fft = _fft.get();
@@ -80,6 +81,7 @@ void FFTW::compute() {
 }
 
 void FFTW::configure() {
+  markConfigured();
   createFFTObject(parameter("size").toInt());
 }
 
@@ -52,6 +52,7 @@ FFTWComplex::~FFTWComplex() {
 }
 
 void FFTWComplex::compute() {
+  ensureConfigured();
 
   const std::vector<std::complex<Real> >& signal = _signal.get();
   std::vector<std::complex<Real> >& fft = _fft.get();
@@ -85,6 +86,7 @@ void FFTWComplex::compute() {
 }
 
 void FFTWComplex::configure() {
+  markConfigured();
   createFFTObject(parameter("size").toInt());
   _negativeFrequencies = parameter("negativeFrequencies").toBool();
 }
@@ -158,51 +158,26 @@ const char* FrameCutter::description = DOC("This algorithm slices the input stre
 
 void FrameCutter::reset() {
   Algorithm::reset();
-  //_reschedule = false;
-  _streamIndex = 0;
-  if (_startFromZero) _startIndex = 0;
-  else                _startIndex = -(_frameSize+1)/2;
-
-  _audio.setAcquireSize(_frameSize);
-  _audio.setReleaseSize(_hopSize);
-  _frames.setAcquireSize(1);
-  _frames.setReleaseSize(1);
-}
-
-FrameCutter::SilenceType FrameCutter::typeFromString(const std::string& name) const {
-  if (name == "keep") return KEEP;
-  if (name == "drop") return DROP;
-  return ADD_NOISE;
+  _reader.reset();
 }
 
 void FrameCutter::configure() {
-  _frameSize = parameter("frameSize").toInt();
-  _hopSize = parameter("hopSize").toInt();
-  _silentFrames = typeFromString(parameter("silentFrames").toString());
-  _lastFrameToEndOfFile = parameter("lastFrameToEndOfFile").toBool();
-
-  _startFromZero = parameter("startFromZero").toBool();
-  if (_startFromZero) {
-    _startIndex = 0;
-  }
-  else {
-    _startIndex = -(_frameSize+1)/2;
-  }
-
+  bool startFromZero = parameter("startFromZero").toBool();
   Real ratio = parameter("validFrameThresholdRatio").toReal();
-  if (ratio > 0.5 && !_startFromZero) {
+  if (ratio > 0.5 && !startFromZero) {
     throw EssentiaException("FrameCutter: validFrameThresholdRatio cannot be "
                             "larger than 0.5 if startFromZero is false (this "
                             "is to prevent loss of the first frame which would "
                             "be only half a valid frame since the first frame "
                             "is centered on the beginning of the audio)");
   }
-  _validFrameThreshold = (int)round(ratio*_frameSize);
-  // Adding noise to avoid divisions by zero (in case the user chooses to do so
-  // by setting the silentFrames parameter to ADD_NOISE).  The level of such noise
-  // is chosen to be -100dB because it will still be detected as a silent frame
-  // by essentia::isSilent() and is unhearable by humans
-  _noiseAdder->configure("fixSeed", false, "level", -100);
+
+  _reader.configure(parameter("frameSize").toInt(),
+                    parameter("hopSize").toInt(),
+                    startFromZero,
+                    parameter("lastFrameToEndOfFile").toBool(),
+                    ratio,
+                    FrameReader::silenceTypeFromString(parameter("silentFrames").toString()));
   reset();
 }
 
@@ -240,161 +215,18 @@ void FrameCutter::configure() {
  */
 
 AlgorithmStatus FrameCutter::process() {
-  bool lastFrame = false;
-
   EXEC_DEBUG("process()");
 
-  // if _streamIndex < _startIndex, we need to advance into the stream until we
-  // arrive at _startIndex
-  if (_streamIndex < _startIndex) {
-    // to make sure we can skip that many, use frameSize (buffer has been resized
-    // to be able to accomodate at least that many sample before starting processing)
-    int skipSize = _frameSize;
-    int howmuch = min(_startIndex - _streamIndex, skipSize);
-    _audio.setAcquireSize(howmuch);
-    _audio.setReleaseSize(howmuch);
-    _frames.setAcquireSize(0);
-    _frames.setReleaseSize(0);
-
-    if (acquireData() != OK) return NO_INPUT;
-
-    releaseData();
-    _streamIndex += howmuch;
-
-    return OK;
-  }
-
-  // need to know whether we have to zero-pad on the left: ie, _startIndex < 0
-  int zeropadSize = 0;
-  int acquireSize = _frameSize;
-  int releaseSize = min(_hopSize, _frameSize); // in case hopsize > framesize
-  int available = _audio.available();
-
-  // we need this check anyway because we might be at the very end of the stream and try to acquire 0
-  // for our last frame, which will unfortunately work, so just get rid of this case right now
-  if (available == 0) return NO_INPUT;
-
-  if (_startIndex < 0) {
-    // left zero-padding and only acquire  as much as _frameSize + startIndex tokens and should release zero
-    acquireSize = _frameSize + _startIndex;
-    releaseSize = 0;
-    zeropadSize = -_startIndex;
-  }
-
-  // if there are not enough tokens in the stream (howmuch < available):
-  if (acquireSize >= available) { // has to be >= in case the size of the audio fits exactly with frameSize & hopSize
-    if (!shouldStop()) return NO_INPUT; // not end of stream -> return and wait for more data to come
-
-    acquireSize = available; // need to acquire what's left
-    releaseSize = _startIndex >= 0 ? min(available, _hopSize) : 0; // cannot release more tokens than there are available
-    if (_startFromZero) {
-      if (_lastFrameToEndOfFile) {
-        if (_startIndex >= _streamIndex+available) lastFrame = true;
-      }
-      else lastFrame = true;
-    }
-    else {
-      if (_startIndex + _frameSize/2 >= _streamIndex + available) // center of frame >= end of stream
-        lastFrame = true;
-    }
-  }
-
-  _frames.setAcquireSize(1);
-  _frames.setReleaseSize(1);
-  _audio.setAcquireSize(acquireSize);
-  _audio.setReleaseSize(releaseSize);
-
-  /*
-  EXEC_DEBUG("zeropadSize: " << zeropadSize
-             << "\tacquireSize: " << acquireSize
-             << "\treleaseSize: " << releaseSize
-             << "\tavailable: " << available
-             << "\tlast frame: " << lastFrame
-             << "\tstartIndex: " << _startIndex
-             << "\tstreamIndex: " << _streamIndex);
-  */
-
-  AlgorithmStatus status = acquireData();
-  EXEC_DEBUG("data acquired (audio: " << acquireSize << " - frames: 1)");
-
-  if (status != OK) {
-    if (status == NO_INPUT) return NO_INPUT;
-    if (status == NO_OUTPUT) return NO_OUTPUT;
-    throw EssentiaException("FrameCutter: something weird happened.");
-  }
-
-  // some semantic description to not get mixed up between the 2 meanings
-  // of a vector<Real> (which acts both as a stream of Real tokens at the
-  // input and as a single vector<Real> token at the output)
-  typedef vector<AudioSample> Frame;
-
-  // get the audio input and copy it as a frame to the output
-  const vector<AudioSample>& audio = _audio.tokens();
-  Frame& frame = _frames.firstToken();
+  // the frame is a view on the input tokens, unless it had to be zero-padded
+  AlgorithmStatus status = _reader.acquireFrame();
+  if (status != OK || !_reader.frame()) return status;
 
-
-  frame.resize(_frameSize);
-
-  // left zero-padding of the frame
-  int idxInFrame = 0;
-  for (; idxInFrame < zeropadSize; idxInFrame++) {
-    frame[idxInFrame] = (Real)0.0;
-  }
-
-  fastcopy(frame.begin()+idxInFrame, audio.begin(), acquireSize);
-  idxInFrame += acquireSize;
-
-  // check if the idxInFrame is below the threshold (this would only happen
-  // for the last frame in the stream) and if so, don't produce data
-  if (idxInFrame < _validFrameThreshold) {
-    E_INFO("FrameCutter: dropping incomplete frame");
-
-    // release inputs (advance to next frame), but not the output frame (we didn't produce anything)
-    _audio.release(_audio.releaseSize());
-    return NO_INPUT;
-  }
-
-  // right zero-padding on the last frame
-  for (; idxInFrame < _frameSize; idxInFrame++) {
-    frame[idxInFrame] = (Real)0.0;
-  }
-
-  _startIndex += _hopSize;
-
-  if (isSilent(frame)) {
-    switch (_silentFrames) {
-    case DROP:
-      E_INFO("FrameCutter: dropping silent frame");
-
-      // release inputs (advance to next frame), but not the output frame (we didn't produce anything)
-      _audio.release(_audio.releaseSize());
-      return OK;
-
-    case ADD_NOISE: {
-      vector<AudioSample> inputFrame(_frameSize, 0.0);
-      fastcopy(&inputFrame[0]+zeropadSize, &frame[0], acquireSize);
-      _noiseAdder->input("signal").set(inputFrame);
-      _noiseAdder->output("signal").set(frame);
-      _noiseAdder->compute();
-      break;
-    }
-
-    // otherwise, don't do nothing...
-    case KEEP:
-    default:
-      ;
-    }
-  }
+  // copy it as a frame to the output
+  const vector<AudioSample>& frame = *_reader.frame();
+  _frames.firstToken().assign(frame.begin(), frame.end());
 
   EXEC_DEBUG("produced frame; releasing");
-  releaseData();
-  _streamIndex += _audio.releaseSize();
-
-  EXEC_DEBUG("released");
-
-  if (lastFrame) return PASS;
-
-  return OK;
+  return _reader.releaseFrame();
 }
 
 } // namespace streaming
@@ -76,6 +76,7 @@ class FrameCutter : public Algorithm {
 
 
 #include "streamingalgorithm.h"
+#include "framereader.h"
 
 namespace essentia {
 namespace streaming {
@@ -87,32 +88,14 @@ class FrameCutter : public Algorithm {
   Sink<AudioSample> _audio;
   Source<std::vector<AudioSample> > _frames;
 
-  int _frameSize;
-  int _hopSize;
-  int _startIndex; // the desired start index of the next frame
-  int _streamIndex; // the index in the stream
-
-  int _validFrameThreshold;
-  bool _startFromZero;
-  bool _lastFrameToEndOfFile;
-
-  enum SilenceType {KEEP, DROP, ADD_NOISE};
-  SilenceType typeFromString(const std::string& name) const;
-  standard::Algorithm * _noiseAdder;
-
-  SilenceType _silentFrames;
-
+  FrameReader _reader;
 
  public:
-  FrameCutter() {
+  FrameCutter() : _reader(*this, _audio, _frames) {
     // at the beginning, releaseSize is set to 0, but will become hopSize once
     // we are done zero-padding the signal
-    declareInput(_audio, _frameSize, 0, "signal", "the input audio signal");
+    declareInput(_audio, 1024, 0, "signal", "the input audio signal");
     declareOutput(_frames, 1, "frame", "the frames of the audio signal");
-    _noiseAdder = standard::AlgorithmFactory::create("NoiseAdder");
-  }
-  ~FrameCutter() {
-    delete _noiseAdder;
   }
 
   void declareParameters() {
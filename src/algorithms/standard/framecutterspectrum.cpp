@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "framecutterspectrum.h"
+
+using namespace std;
+
+namespace essentia {
+namespace streaming {
+
+const char* FrameCutterSpectrum::name = "FrameCutterSpectrum";
+const char* FrameCutterSpectrum::category = "Spectral";
+const char* FrameCutterSpectrum::description = DOC("This algorithm slices the input stream into frames and outputs the spectrum of each windowed frame. It is equivalent to (and gives the same values as) a FrameCutter followed by a WindowedSpectrum algorithm, see their documentation for the meaning of the parameters.\n"
+"\n"
+"Frames are not copied into intermediate tokens: the window is applied directly on the samples of the input buffer. Only the frames that need to be zero-padded, at the beginning and end of the stream, are copied. This makes it cheaper than FrameCutter followed by WindowedSpectrum when the hop size is much smaller than the frame size.\n"
+"\n"
+"This algorithm is only available in streaming mode.");
+
+
+void FrameCutterSpectrum::reset() {
+  Algorithm::reset();
+  _reader.reset();
+}
+
+void FrameCutterSpectrum::configure() {
+  bool startFromZero = parameter("startFromZero").toBool();
+  Real ratio = parameter("validFrameThresholdRatio").toReal();
+  if (ratio > 0.5 && !startFromZero) {
+    throw EssentiaException("FrameCutterSpectrum: validFrameThresholdRatio cannot be "
+                            "larger than 0.5 if startFromZero is false");
+  }
+
+  _reader.configure(parameter("frameSize").toInt(),
+                    parameter("hopSize").toInt(),
+                    startFromZero,
+                    parameter("lastFrameToEndOfFile").toBool(),
+                    ratio,
+                    FrameReader::silenceTypeFromString(parameter("silentFrames").toString()));
+
+  _windowedSpectrum->configure("size", parameter("frameSize"),
+                               "type", parameter("windowType"),
+                               "zeroPadding", parameter("zeroPadding"),
+                               "zeroPhase", parameter("zeroPhase"),
+                               "normalized", parameter("normalized"),
+                               "spectrumType", parameter("spectrumType"));
+  reset();
+}
+
+AlgorithmStatus FrameCutterSpectrum::process() {
+  EXEC_DEBUG("process()");
+
+  AlgorithmStatus status = _reader.acquireFrame();
+  if (status != OK || !_reader.frame()) return status;
+
+  // the frame is (most of the time) a view on the input tokens
+  _windowedSpectrum->input("frame").set(*_reader.frame());
+  _windowedSpectrum->output("spectrum").set(_spectrum.firstToken());
+  _windowedSpectrum->compute();
+
+  EXEC_DEBUG("produced spectrum; releasing");
+  return _reader.releaseFrame();
+}
+
+} // namespace streaming
+} // namespace essentia
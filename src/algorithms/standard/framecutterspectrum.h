@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_FRAMECUTTERSPECTRUM_H
+#define ESSENTIA_FRAMECUTTERSPECTRUM_H
+
+#include "streamingalgorithm.h"
+#include "framereader.h"
+#include "algorithmfactory.h"
+
+namespace essentia {
+namespace streaming {
+
+class FrameCutterSpectrum : public Algorithm {
+ protected:
+
+  Sink<AudioSample> _audio;
+  Source<std::vector<Real> > _spectrum;
+
+  FrameReader _reader;
+  standard::Algorithm* _windowedSpectrum;
+
+ public:
+  FrameCutterSpectrum() : _reader(*this, _audio, _spectrum) {
+    declareInput(_audio, 1024, 0, "signal", "the input audio signal");
+    declareOutput(_spectrum, 1, "spectrum", "the spectrum of each windowed frame of the audio signal");
+    _windowedSpectrum = standard::AlgorithmFactory::create("WindowedSpectrum");
+  }
+  ~FrameCutterSpectrum() {
+    delete _windowedSpectrum;
+  }
+
+  void declareParameters() {
+    declareParameter("frameSize", "the size of the frame to cut", "[2,inf)", 1024);
+    declareParameter("hopSize", "the number of samples to jump after a frame is output", "[1,inf)", 512);
+    declareParameter("silentFrames", "whether to [keep/drop/add noise to] silent frames", "{drop,keep,noise}", "noise");
+    declareParameter("validFrameThresholdRatio", "frames smaller than this ratio will be discarded, those larger will be zero-padded to a full frame "
+                                                 "(i.e. a value of 0 will never discard frames and a value of 1 will only keep frames that are of length 'frameSize')",
+                     "[0,1]", 0.);
+    declareParameter("startFromZero", "whether to start the first frame at time 0 (centered at frameSize/2) if true, or -frameSize/2 otherwise (zero-centered)",
+                     "{true,false}", false);
+    declareParameter("lastFrameToEndOfFile", "whether the beginning of the last frame should reach the end of file. Only applicable if startFromZero is true",
+                     "{true,false}", false);
+    declareParameter("windowType", "the window type, which can be 'hamming', 'hann', 'triangular', 'square' or 'blackmanharrisXX'", "{hamming,hann,hannnsgcq,triangular,square,blackmanharris62,blackmanharris70,blackmanharris74,blackmanharris92}", "hann");
+    declareParameter("zeroPadding", "the size of the zero-padding of the windowed frames", "[0,inf)", 0);
+    declareParameter("zeroPhase", "a boolean value that enables zero-phase windowing", "{true,false}", true);
+    declareParameter("normalized", "a boolean value to specify whether to normalize windows (to have an area of 1) and then scale by a factor of 2", "{true,false}", true);
+    declareParameter("spectrumType", "the type of spectrum to output: linear magnitude, power (squared magnitude) or power in dB", "{magnitude,power,db}", "magnitude");
+  }
+
+  void reset();
+  void configure();
+  AlgorithmStatus process();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+
+};
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_FRAMECUTTERSPECTRUM_H
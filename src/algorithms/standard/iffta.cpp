@@ -51,6 +51,7 @@ IFFTA::~IFFTA() {
 }
 
 void IFFTA::compute() {
+  ensureConfigured();
 
   const std::vector<std::complex<Real> >& fft = _fft.get();
   std::vector<Real>& signal = _signal.get();
@@ -91,6 +92,7 @@ void IFFTA::compute() {
 }
 
 void IFFTA::configure() {
+  markConfigured();
   createFFTObject(parameter("size").toInt());
   _normalize = parameter("normalize").toBool();
 }
@@ -51,6 +51,7 @@ IFFTAComplex::~IFFTAComplex() {
 }
 
 void IFFTAComplex::compute() {
+  ensureConfigured();
 
   const std::vector<std::complex<Real> >& fft = _fft.get();
   std::vector<std::complex<Real> >& signal = _signal.get();
@@ -91,6 +92,7 @@ void IFFTAComplex::compute() {
 }
 
 void IFFTAComplex::configure() {
+  markConfigured();
   createFFTObject(parameter("size").toInt());
   _normalize = parameter("normalize").toBool();
 }
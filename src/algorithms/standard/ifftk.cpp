@@ -50,6 +50,7 @@ IFFTK::~IFFTK() {
 }
 
 void IFFTK::compute() {
+  ensureConfigured();
 
   const std::vector<std::complex<Real> >& fft = _fft.get();
   std::vector<Real>& signal = _signal.get();
@@ -84,6 +85,7 @@ void IFFTK::compute() {
 }
 
 void IFFTK::configure() {
+  markConfigured();
   createFFTObject(parameter("size").toInt());
   _normalize = parameter("normalize").toBool();
 }
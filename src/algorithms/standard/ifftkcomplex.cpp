@@ -51,6 +51,7 @@ IFFTKComplex::~IFFTKComplex() {
 }
 
 void IFFTKComplex::compute() {
+  ensureConfigured();
 
   const std::vector<std::complex<Real> >& fft = _fft.get();
   std::vector<std::complex<Real> >& signal = _signal.get();
@@ -85,6 +86,7 @@ void IFFTKComplex::compute() {
 }
 
 void IFFTKComplex::configure() {
+  markConfigured();
   createFFTObject(parameter("size").toInt());
   _normalize = parameter("normalize").toBool();
 }
@@ -46,6 +46,7 @@ IFFTW::~IFFTW() {
 }
 
 void IFFTW::compute() {
+  ensureConfigured();
 
   const std::vector<std::complex<Real> >& fft = _fft.get();
   std::vector<Real>& signal = _signal.get();
@@ -80,6 +81,7 @@ void IFFTW::compute() {
 }
 
 void IFFTW::configure() {
+  markConfigured();
   createFFTObject(parameter("size").toInt());
   _normalize = parameter("normalize").toBool();
 }
@@ -46,6 +46,7 @@ IFFTWComplex::~IFFTWComplex() {
 }
 
 void IFFTWComplex::compute() {
+  ensureConfigured();
 
   const std::vector<std::complex<Real> >& fft = _fft.get();
   std::vector<std::complex<Real> >& signal = _signal.get();
@@ -80,6 +81,7 @@ void IFFTWComplex::compute() {
 }
 
 void IFFTWComplex::configure() {
+  markConfigured();
   createFFTObject(parameter("size").toInt());
   _normalize = parameter("normalize").toBool();
 }
@@ -59,11 +59,65 @@ void NSGConstantQ::configure() {
     _inputSize++;
   }
 
+  computeFilterbank();
+
+  _fft->configure("size", _inputSize);
+}
+
+
+void NSGConstantQ::computeFilterbank() {
+  // the input size can change at compute time, so it is not taken from the
+  // parameters, and the phase mode is only used in compute()
+  vector<string> exclude;
+  exclude.push_back("inputSize");
+  exclude.push_back("phaseMode");
+  ostringstream key;
+  key << util::kernelKey(name, _params, exclude) << ";inputSize=" << _inputSize;
+
+  _filterbank = filterbankCache().get(key.str());
+  if (_filterbank) return;
+
   designWindow();
   createCoefficients();
   normalize();
 
-  _fft->configure("size", _inputSize);
+  std::shared_ptr<Filterbank> filterbank(new Filterbank());
+  filterbank->freqWins.swap(_freqWins);
+  filterbank->shifts.swap(_shifts);
+  filterbank->winsLen.swap(_winsLen);
+  filterbank->baseFreqs.swap(_baseFreqs);
+  filterbank->binsNum = _binsNum;
+  _filterbank = filterbank;
+  filterbankCache().insert(key.str(), _filterbank);
+}
+
+
+void NSGConstantQ::Filterbank::write(ostream& out) const {
+  size_t size = freqWins.size();
+  out.write((const char*)&size, sizeof(size));
+  for (size_t i=0; i<size; ++i) {
+    util::writeBinary(out, freqWins[i]);
+  }
+  util::writeBinary(out, shifts);
+  util::writeBinary(out, winsLen);
+  util::writeBinary(out, baseFreqs);
+  out.write((const char*)&binsNum, sizeof(binsNum));
+}
+
+void NSGConstantQ::Filterbank::read(istream& in) {
+  // each window takes at least the size of its length
+  size_t size = util::readSize(in, sizeof(size_t));
+  freqWins.resize(size);
+  for (size_t i=0; i<size; ++i) {
+    util::readBinary(in, freqWins[i]);
+  }
+  util::readBinary(in, shifts);
+  util::readBinary(in, winsLen);
+  util::readBinary(in, baseFreqs);
+  in.read((char*)&binsNum, sizeof(binsNum));
+  if (shifts.empty() || shifts.size() != size || winsLen.size() != size) {
+    throw EssentiaException("NSGConstantQ: corrupt filterbank in the kernel cache");
+  }
 }
 
 
@@ -312,14 +366,16 @@ void NSGConstantQ::compute() {
 
     _inputSize = signal.size();
 
-    designWindow();
-    createCoefficients();
-    normalize();
+    computeFilterbank();
 
     _fft->configure("size", _inputSize);
   }
 
-  int N = _shifts.size();
+  const vector<vector<Real> >& freqWins = _filterbank->freqWins;
+  const vector<int>& shifts = _filterbank->shifts;
+  const vector<int>& winsLen = _filterbank->winsLen;
+
+  int N = shifts.size();
 
   _fft->input("frame").set(signal);
   _fft->output("fft").set(fft);
@@ -329,28 +385,28 @@ void NSGConstantQ::compute() {
     fft.push_back(conj(fft[i]));
   }
 
-  int fill = _shifts[0] - _inputSize;
+  int fill = shifts[0] - _inputSize;
 
   posit.resize(N);
-  posit[0] = _shifts[0];
+  posit[0] = shifts[0];
 
   for (int j=1; j<N; ++j) {
-    posit[j] = posit[j-1] + _shifts[j];
-    fill += _shifts[j];
+    posit[j] = posit[j-1] + shifts[j];
+    fill += shifts[j];
   }
 
   transform(posit.begin(), posit.end(), posit.begin(),
-                  bind2nd(minus<int>(), _shifts[0]));
+                  bind2nd(minus<int>(), shifts[0]));
 
   // Add some zero padding if needed.
   vector<Real> padding(fill,0.0);
   fft.insert(fft.end(), padding.begin(), padding.end());
 
   // Extract filter lengths.
-  vector<int> Lg(_freqWins.size(),0);
+  vector<int> Lg(freqWins.size(),0);
 
-  for (int j = 0; j < (int)_freqWins.size(); ++j) {
-    Lg[j] = _freqWins[j].size();
+  for (int j = 0; j < (int)freqWins.size(); ++j) {
+    Lg[j] = freqWins[j].size();
 
     if ((posit[j] - Lg[j] / 2) <= float(_inputSize + fill) / 2) {
       N = j + 1;
@@ -385,25 +441,25 @@ void NSGConstantQ::compute() {
     }
 
 
-    if (_winsLen[j] < Lg[j]) {
+    if (winsLen[j] < Lg[j]) {
       throw EssentiaException("NSGConstantQ: non painless frame found. This case is currently not supported.");
       // TODO Implement non-painless case.
     }
     else {
-      for (int i = _winsLen[j] - Lg[j] / 2; i < _winsLen[j] + int(Lg[j] / 2.0 + .5); ++i) {
-        product_idx.push_back(fmod(i, _winsLen[j]));
+      for (int i = winsLen[j] - Lg[j] / 2; i < winsLen[j] + int(Lg[j] / 2.0 + .5); ++i) {
+        product_idx.push_back(fmod(i, winsLen[j]));
       }
 
-      product.resize(_winsLen[j]);
+      product.resize(winsLen[j]);
       std::fill(product.begin(), product.end(), 0);
 
       for (int i = 0; i < (int) idx.size(); ++i) {
-        product[product_idx[i]] = fft[win_range[i]] * _freqWins[j][idx[i]];
+        product[product_idx[i]] = fft[win_range[i]] * freqWins[j][idx[i]];
       }
 
       // Circular shift in order to get the global phase representation.
       if (_phaseMode == "global") {
-        int displace = (posit[j] - ((posit[j] / _winsLen[j]) * _winsLen[j])) % product.size();
+        int displace = (posit[j] - ((posit[j] / winsLen[j]) * winsLen[j])) % product.size();
 
         rotate(product.begin(),
                product.end() - displace,
@@ -411,7 +467,7 @@ void NSGConstantQ::compute() {
       }
 
 
-      _ifft->configure("size",_winsLen[j]);
+      _ifft->configure("size",winsLen[j]);
       _ifft->input("fft").set(product);
       _ifft->output("frame").set(constantQ[j]);
       _ifft->compute();
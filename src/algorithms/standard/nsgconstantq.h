@@ -22,6 +22,7 @@
 
 #include "algorithm.h"
 #include "algorithmfactory.h"
+#include "kernelcache.h"
 
 
 namespace essentia {
@@ -73,6 +74,31 @@ class NSGConstantQ : public Algorithm {
   void createCoefficients();
   void normalize();
 
+  /**
+   * The frequency windows and their positions, as computed by designWindow(),
+   * createCoefficients() and normalize().
+   */
+  struct Filterbank {
+    std::vector<std::vector<Real> > freqWins;
+    std::vector<int> shifts;
+    std::vector<int> winsLen;
+    std::vector<Real> baseFreqs;
+    int binsNum;
+
+    static const char* cacheTag() { return "NSGConstantQ"; }
+    static int cacheVersion() { return 1; }
+    void write(std::ostream& out) const;
+    void read(std::istream& in);
+  };
+
+  /**
+   * The filterbanks of all the NSGConstantQ instances of the process, which
+   * can be saved to disk and reloaded to avoid computing them again.
+   */
+  static util::KernelCache<Filterbank>& filterbankCache() {
+    return util::KernelCache<Filterbank>::instance();
+  }
+
   static const char* name;
   static const char* category;
   static const char* description;
@@ -83,6 +109,8 @@ class NSGConstantQ : public Algorithm {
   Algorithm* _fft;
   Algorithm* _windowing;
 
+  void computeFilterbank();
+
   // variables for the input parameters
   Real _minFrequency;
   Real _maxFrequency;
@@ -96,7 +124,10 @@ class NSGConstantQ : public Algorithm {
   int _minimumWindow;
   int _windowSizeFactor;
 
-  // windowing vectors
+  // the filterbank used by compute(), shared with the other instances
+  util::KernelCache<Filterbank>::KernelPtr _filterbank;
+
+  // windowing vectors, only used while designing the filterbank
   std::vector< std::vector<Real> > _freqWins;
   std::vector<int> _shifts;
   std::vector<int> _winsLen;
@@ -19,7 +19,10 @@
 
 #include "peakdetection.h"
 #include "essentiamath.h"
-#include "peak.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 using namespace essentia;
 using namespace standard;
@@ -44,9 +47,15 @@ void PeakDetection::configure() {
   _maxPeaks = parameter("maxPeaks").toInt();
   _range = parameter("range").toReal();
   _interpolate = parameter("interpolate").toBool();
-  _orderBy = parameter("orderBy").toLower();
   _minPeakDistance = parameter("minPeakDistance").toReal();
 
+  std::string orderBy = parameter("orderBy").toLower();
+  if      (orderBy == "position")  _orderBy = POSITION;
+  else if (orderBy == "amplitude") _orderBy = AMPLITUDE;
+  else {
+    throw EssentiaException("PeakDetection: Unsupported ordering type: '" + orderBy + "'");
+  }
+
   if (_minPos >= _maxPos) {
     throw EssentiaException("PeakDetection: The minimum position has to be less than the maximum position");
   }
@@ -57,6 +66,23 @@ void PeakDetection::configure() {
   assert(v.size() == 1);
 }
 
+// Returns the index of the first value above the threshold in [begin, end),
+// or end if there is none.
+static inline int findAboveThreshold(const Real* array, int begin, int end, Real threshold) {
+  int k = begin;
+#ifdef __SSE2__
+  const __m128 t = _mm_set1_ps(threshold);
+  for (; k+4 <= end; k+=4) {
+    int mask = _mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(array + k), t));
+    if (mask) return k + __builtin_ctz(mask);
+  }
+#endif
+  for (; k<end; k++) {
+    if (array[k] > threshold) return k;
+  }
+  return end;
+}
+
 void PeakDetection::compute() {
 
   const std::vector<Real>& array = _array.get();
@@ -74,8 +100,10 @@ void PeakDetection::compute() {
   // which makes more sense in general?
   const Real scale = _range / (Real)(size - 1);
 
-  std::vector<Peak> peaks;
-  peaks.reserve(size);
+  // the peaks are stored in a member buffer, so that no memory is allocated
+  // once it has grown to the number of peaks of the largest input
+  std::vector<Peak>& peaks = _peaks;
+  peaks.clear();
 
   // we want to round up to the next integer instead of simple truncation,
   // otherwise the peak frequency at i can be lower than _minPos
@@ -89,6 +117,15 @@ void PeakDetection::compute() {
   }
 
   while(true) {
+    // only values above the threshold can be peaks, so skip the values below
+    // it: starting again just before the next value above the threshold
+    // (which is then climbing) gives the same peaks as walking through them
+    if (i+1 < size-1 && !(array[i+1] > _threshold)) {
+      int k = findAboveThreshold(&array[0], i+2, size-1, _threshold);
+      if (k == size-1) break; // no more peaks (the last value is checked below)
+      i = k-1;
+    }
+
     // going down
     while (i+1 < size-1 && array[i] >= array[i+1]) {
       i++;
@@ -167,72 +204,95 @@ void PeakDetection::compute() {
     }
   }
 
-  // remove peaks that are closer than 'minPeakDistance'
-  if (_minPeakDistance > 0 && peaks.size() > 1) {
-    
-    std::vector<int> deletedPeaks;
-    deletedPeaks.reserve(peaks.size());
-    Real minPos;
-    Real maxPos;
-    
-    // iterate following an amplitude hierarchy
-    std::sort(peaks.begin(), peaks.end(),
-          ComparePeakMagnitude<std::greater<Real>, std::less<Real> >());
-
-    size_t k = 0;
-    while (k < peaks.size() - 1) {
-      minPos = peaks[k].position - _minPeakDistance;
-      maxPos = peaks[k].position + _minPeakDistance;
-
-      for (size_t l = k+1; l < peaks.size(); l++) {
-        if (peaks[l].position > minPos && peaks[l].position < maxPos) 
-          deletedPeaks.push_back(l);
-      }
+  selectPeaks(peakPosition, peakValue);
+}
 
-      // delete peaks starting from the end so the indexes are not altered
-      std::sort(deletedPeaks.begin(), deletedPeaks.end(), std::greater<int>());
-      
-      for (size_t l = 0; l < deletedPeaks.size(); l++)
-        peaks.erase(peaks.begin() + deletedPeaks[l]);
-        
-      deletedPeaks.clear();
-      deletedPeaks.reserve(peaks.size());
-      k++;
+// Orders indices of peaks the same way as ComparePeakMagnitude<std::greater<Real>, std::less<Real> >
+// orders the peaks themselves.
+class ComparePeakIndexMagnitude {
+  const std::vector<Peak>& _peaks;
+ public:
+  ComparePeakIndexMagnitude(const std::vector<Peak>& peaks) : _peaks(peaks) {}
+  bool operator()(int a, int b) const {
+    if (_peaks[a].magnitude > _peaks[b].magnitude) return true;
+    if (_peaks[b].magnitude > _peaks[a].magnitude) return false;
+    return _peaks[a].position < _peaks[b].position;
+  }
+};
+
+// Removes the peaks that are closer than minPeakDistance to a larger one,
+// orders them and outputs at most maxPeaks of them. The peaks are sorted by
+// position when entering this function.
+void PeakDetection::selectPeaks(std::vector<Real>& peakPosition, std::vector<Real>& peakValue) {
+  std::vector<Peak>& peaks = _peaks;
+  int nPeaks = (int)peaks.size();
+  size_t maxPeaks = (size_t)_maxPeaks;
+
+  // ordering of the peaks by amplitude: in case of equality, the one having
+  // smaller position comes first
+  ComparePeakMagnitude<std::greater<Real>, std::less<Real> > byMagnitude;
+
+  if (_minPeakDistance > 0 && nPeaks > 1) {
+    // iterate following an amplitude hierarchy, each remaining peak removing
+    // the smaller ones around it. The peaks are kept sorted by position, so
+    // that the ones around a peak are its neighbours in the array, and only
+    // their indices are sorted by amplitude
+    _order.resize(nPeaks);
+    for (int k=0; k<nPeaks; k++) _order[k] = k;
+    std::sort(_order.begin(), _order.end(), ComparePeakIndexMagnitude(peaks));
+
+    _rank.resize(nPeaks);
+    for (int k=0; k<nPeaks; k++) _rank[_order[k]] = k;
+    _deletedPeaks.assign(nPeaks, false);
+
+    int nRemaining = 0;
+    for (int k=0; k<nPeaks; k++) {
+      int p = _order[k];
+      if (_deletedPeaks[p]) continue;
+
+      // with amplitude ordering, the following peaks cannot be output
+      if (_orderBy == AMPLITUDE && nRemaining == (int)maxPeaks) break;
+      _order[nRemaining++] = p;
+
+      Real minPos = peaks[p].position - _minPeakDistance;
+      Real maxPos = peaks[p].position + _minPeakDistance;
+
+      // only the smaller peaks are removed
+      for (int l=p-1; l>=0 && peaks[l].position > minPos; l--) {
+        if (_rank[l] > k) _deletedPeaks[l] = true;
+      }
+      for (int l=p+1; l<nPeaks && peaks[l].position < maxPos; l++) {
+        if (_rank[l] > k) _deletedPeaks[l] = true;
+      }
     }
 
-    if (_orderBy == "position") {
-      // if required,sort peaks by 
-      // position again
-      std::sort(peaks.begin(), peaks.end(),
-                ComparePeakPosition<std::less<Real>, std::greater<Real> >());
-    }
-    else if (_orderBy == "amplitude") {
-      // already sorted by amplitude
+    if (_orderBy == AMPLITUDE) {
+      _selectedPeaks.resize(nRemaining);
+      for (int k=0; k<nRemaining; k++) _selectedPeaks[k] = peaks[_order[k]];
+      peaks.swap(_selectedPeaks);
     }
     else {
-      throw EssentiaException("PeakDetection: Unsupported ordering type: '" + _orderBy + "'");
-    }
-
-  } else {
-    // if haven't passed through the minPeakDistance part
-    // apply the inverse logic for sorting
-    if (_orderBy == "amplitude") {
-      // sort peaks by amplitude, in case of equality,
-      // return the one having smaller position
-      std::sort(peaks.begin(), peaks.end(),
-                ComparePeakMagnitude<std::greater<Real>, std::less<Real> >());
+      // the remaining peaks are still sorted by position
+      int n = 0;
+      for (int k=0; k<nPeaks; k++) {
+        if (!_deletedPeaks[k]) peaks[n++] = peaks[k];
+      }
+      peaks.resize(n);
     }
-    else if (_orderBy == "position") {
-      // already sorted by position
+  }
+  else if (_orderBy == AMPLITUDE) {
+    // only the maxPeaks largest peaks need to be sorted
+    if (maxPeaks < (size_t)nPeaks) {
+      std::partial_sort(peaks.begin(), peaks.begin() + maxPeaks, peaks.end(), byMagnitude);
     }
     else {
-      throw EssentiaException("PeakDetection: Unsupported ordering type: '" + _orderBy + "'");
+      std::sort(peaks.begin(), peaks.end(), byMagnitude);
     }
   }
-
+  // otherwise, the peaks are already sorted by position
 
   // we only want this many peaks
-  size_t nWantedPeaks = std::min((size_t)_maxPeaks, peaks.size());
+  size_t nWantedPeaks = std::min(maxPeaks, peaks.size());
 
   peakPosition.resize(nWantedPeaks);
   peakValue.resize(nWantedPeaks);
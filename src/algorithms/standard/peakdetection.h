@@ -21,6 +21,7 @@
 #define ESSENTIA_PEAKDETECTION_H
 
 #include "algorithm.h"
+#include "peak.h"
 
 namespace essentia {
 namespace standard {
@@ -38,9 +39,20 @@ class PeakDetection : public Algorithm {
   int _maxPeaks;
   Real _range;
   bool _interpolate;
-  std::string _orderBy;
   Real _minPeakDistance;
 
+  enum OrderBy {
+    POSITION, AMPLITUDE
+  };
+  OrderBy _orderBy;
+
+  // scratch buffers, reused between calls to compute()
+  std::vector<util::Peak> _peaks;
+  std::vector<util::Peak> _selectedPeaks;
+  std::vector<int> _order;
+  std::vector<int> _rank;
+  std::vector<bool> _deletedPeaks;
+
  public:
   PeakDetection() {
     declareInput(_array, "array", "the input array");
@@ -67,6 +79,7 @@ class PeakDetection : public Algorithm {
   static const char* description;
 
 private:
+  void selectPeaks(std::vector<Real>& peakPosition, std::vector<Real>& peakValue);
   void interpolate(const Real leftVal, const Real middleVal, const Real rightVal, int currentBin, Real& resultVal, Real& resultBin) const;
 
 };
@@ -28,7 +28,8 @@ const char* Resample::name = "Resample";
 const char* Resample::category = "Standard";
 const char* Resample::description = DOC("This algorithm resamples the input signal to the desired sampling rate.\n\n"
 
-"This algorithm is only supported if essentia has been compiled with Real=float, otherwise it will throw an exception. It may also throw an exception if there is an internal error in the SRC library during conversion.\n\n"
+"The quality parameter selects the converter: values from 0 to 4 use the converters of the SRC library (0: best quality sinc, 1: medium quality sinc, 2: fastest sinc, 3: zero order hold, 4: linear), and 5 uses a built-in polyphase FIR resampler. The polyphase resampler has a quality close to the medium quality sinc converter, and is much faster, as its filters are precomputed (and shared by all the instances of the same conversion ratio). It only supports integer sampling rates whose ratio can be reduced to L/M with L up to 1024, which includes all the usual conversions (e.g. 44100Hz to 22050Hz, 16000Hz or 8000Hz, 48000Hz to 44100Hz, or 4x oversampling).\n\n"
+"This algorithm is only supported if essentia has been compiled with Real=float, otherwise it will throw an exception. It may also throw an exception if there is an internal error in the SRC library during conversion, or if the sampling rates are not supported by the polyphase resampler.\n\n"
 
 "References:\n"
 "  [1] Secret Rabbit Code, http://www.mega-nerd.com/SRC\n\n"
@@ -44,6 +45,10 @@ void Resample::configure() {
   if (sizeof(Real) != sizeof(float)) {
     throw EssentiaException("Resample: Error, Essentia has to be compiled with Real=float for resampling to work.");
   }
+
+  if (_quality == POLYPHASE_QUALITY && _factor != 1.0) {
+    _polyphase.configure(parameter("inputSampleRate").toReal(), parameter("outputSampleRate").toReal());
+  }
 }
 
 void Resample::compute() {
@@ -57,6 +62,12 @@ void Resample::compute() {
 
   if (signal.empty()) return;
 
+  if (_quality == POLYPHASE_QUALITY) {
+    resampled.resize(_polyphase.outputSize((int)signal.size()));
+    _polyphase.resample(&signal[0], (int)signal.size(), &resampled[0]);
+    return;
+  }
+
   SRC_DATA src;
   src.input_frames = (long)signal.size();
   src.data_in = const_cast<float*>(&(signal[0]));
@@ -95,6 +106,13 @@ void Resample::configure() {
   int quality = parameter("quality").toInt();
   Real factor = parameter("outputSampleRate").toReal() / parameter("inputSampleRate").toReal();
 
+  _usePolyphase = (quality == standard::Resample::POLYPHASE_QUALITY && factor != 1.0);
+  if (_usePolyphase) {
+    _polyphase.configure(parameter("inputSampleRate").toReal(), parameter("outputSampleRate").toReal());
+  }
+  // the SRC state is not used by the polyphase resampler, but reset() needs one
+  if (quality == standard::Resample::POLYPHASE_QUALITY) quality = SRC_LINEAR;
+
   if (_state) src_delete(_state);
   int nChannels = 1;
   _state = src_new(quality, nChannels, &_errorCode);
@@ -107,6 +125,8 @@ void Resample::configure() {
 AlgorithmStatus Resample::process() {
   EXEC_DEBUG("process()");
 
+  if (_usePolyphase) return processPolyphase();
+
   EXEC_DEBUG("Trying to acquire data");
   AlgorithmStatus status = acquireData();
 
@@ -189,6 +209,46 @@ AlgorithmStatus Resample::process() {
   return OK;
 }
 
+AlgorithmStatus Resample::processPolyphase() {
+  // everything has been flushed at the end of the stream
+  if (_flushed) return NO_INPUT;
+
+  bool endOfStream = false;
+  AlgorithmStatus status = acquireData();
+
+  if (status != OK) {
+    if (status == NO_OUTPUT) return NO_OUTPUT;
+    if (!shouldStop()) return NO_INPUT;
+
+    // end of the stream: resample what's left (which is less than what we
+    // usually acquire), and the tail of the filter
+    int available = _signal.available();
+    _signal.setAcquireSize(available);
+    _signal.setReleaseSize(available);
+    _resampled.setAcquireSize(_polyphase.maxOutputSize(available) + _polyphase.maxFlushSize());
+    endOfStream = true;
+
+    status = acquireData();
+    if (status != OK) return status;
+  }
+
+  const vector<AudioSample>& signal = _signal.tokens();
+  vector<AudioSample>& resampled = _resampled.tokens();
+
+  int produced = _polyphase.process(signal.empty() ? 0 : &signal[0], (int)signal.size(), &resampled[0]);
+  if (endOfStream) {
+    produced += _polyphase.flush(&resampled[produced]);
+    _flushed = true;
+  }
+
+  _signal.setReleaseSize((int)signal.size());
+  _resampled.setReleaseSize(produced);
+
+  releaseData();
+
+  return OK;
+}
+
 void Resample::reset() {
   Algorithm::reset();
   _data.end_of_input = 0;
@@ -210,6 +270,9 @@ void Resample::reset() {
   buf.maxContiguousElements = maxElementsAtOnce*2;
   _resampled.setBufferInfo(buf);
 
+  if (_usePolyphase) _polyphase.reset();
+  _flushed = false;
+
   int error = src_reset(_state);
   if (error) throw EssentiaException("Resample: ", src_strerror(error));
 }
@@ -22,6 +22,7 @@
 
 #include <samplerate.h>
 #include "algorithm.h"
+#include "polyphaseresampler.h"
 
 namespace essentia {
 namespace standard {
@@ -41,13 +42,16 @@ class Resample : public Algorithm {
   void declareParameters() {
     declareParameter("inputSampleRate", "the sampling rate of the input signal [Hz]", "(0,inf)", 44100.);
     declareParameter("outputSampleRate", "the sampling rate of the output signal [Hz]", "(0,inf)", 44100.);
-    declareParameter("quality", "the quality of the conversion, 0 for best quality", "[0,4]", 1);
+    declareParameter("quality", "the quality of the conversion, 0 for best quality, 5 for the built-in polyphase resampler (see description)", "[0,5]", 1);
   }
 
   void configure();
 
   void compute();
 
+  // value of the quality parameter selecting the built-in polyphase resampler
+  static const int POLYPHASE_QUALITY = 5;
+
   static const char* name;
   static const char* category;
   static const char* description;
@@ -55,6 +59,7 @@ class Resample : public Algorithm {
  protected:
   double _factor;
   int _quality;
+  util::PolyphaseResampler _polyphase;
 };
 
 } // namespace standard
@@ -78,8 +83,14 @@ class Resample : public Algorithm {
   int _errorCode;
   float _delay;
 
+  bool _usePolyphase;
+  util::PolyphaseResampler _polyphase;
+  bool _flushed;
+
+  AlgorithmStatus processPolyphase();
+
  public:
-  Resample() : _state(0) {
+  Resample() : _state(0), _usePolyphase(false), _flushed(false) {
     _preferredSize = 4096; // arbitrary
     declareInput(_signal, _preferredSize, "signal", "the input signal");
     declareOutput(_resampled, _preferredSize, "signal", "the resampled signal");
@@ -93,7 +104,7 @@ class Resample : public Algorithm {
   void declareParameters() {
     declareParameter("inputSampleRate", "the sampling rate of the input signal [Hz]", "(0,inf)", 44100.);
     declareParameter("outputSampleRate", "the sampling rate of the output signal [Hz]", "(0,inf)", 44100.);
-    declareParameter("quality", "the quality of the conversion, 0 for best quality", "[0,4]", 1);
+    declareParameter("quality", "the quality of the conversion, 0 for best quality, 5 for the built-in polyphase resampler (see description)", "[0,5]", 1);
   }
 
   void configure();
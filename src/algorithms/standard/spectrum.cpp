@@ -32,6 +32,7 @@ const char* Spectrum::description = DOC("This algorithm computes the magnitude s
 "  http://en.wikipedia.org/wiki/Frequency_spectrum");
 
 void Spectrum::configure() {
+  markConfigured();
   // FFT configuration
   _fft->configure("size", this->parameter("size"));
 
@@ -39,9 +40,13 @@ void Spectrum::configure() {
   // to compute()
   _fft->output("fft").set(_fftBuffer);
   _magnitude->input("complex").set(_fftBuffer);
+
+  _fftFrame = _fft->inputHandle<vector<Real> >("frame");
+  _magnitudeSpectrum = _magnitude->outputHandle<vector<Real> >("magnitude");
 }
 
 void Spectrum::compute() {
+  ensureConfigured();
 
   const vector<Real>& signal = _signal.get();
   vector<Real>& spectrum = _spectrum.get();
@@ -50,11 +55,11 @@ void Spectrum::compute() {
   // will be checked anyway in the FFT algorithm.
 
   // compute FFT first...
-  _fft->input("frame").set(signal);
+  _fftFrame.set(signal);
   _fft->compute();
 
   // ...and then the magnitude of it
-  _magnitude->output("magnitude").set(spectrum);
+  _magnitudeSpectrum.set(spectrum);
   _magnitude->compute();
 
 }
@@ -36,6 +36,9 @@ class Spectrum : public Algorithm {
   Algorithm* _magnitude;
   std::vector<std::complex<Real> > _fftBuffer;
 
+  InputHandle<std::vector<Real> > _fftFrame;
+  OutputHandle<std::vector<Real> > _magnitudeSpectrum;
+
  public:
   Spectrum() {
     declareInput(_signal, "frame", "the input audio frame");
@@ -55,6 +58,7 @@ class Spectrum : public Algorithm {
   }
 
   void configure();
+  bool deferDefaultConfiguration() const { return true; }
   void compute();
 
   static const char* name;
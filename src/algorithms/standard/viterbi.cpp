@@ -28,7 +28,7 @@ const char* Viterbi::name = "Viterbi";
 const char* Viterbi::category = "Statistics";
 const char* Viterbi::description = DOC("This algorithm estimates the most-likely path by Viterbi algorithm. It is used in PitchYinProbabilistiesHMM algorithm.\n"
 "\n"
-"This Viterbi algorithm returns the most likely path. The internal variable calculation uses double for a better precision.\n"
+"This Viterbi algorithm returns the most likely path. The internal variable calculation uses double for a better precision. Transitions are grouped by destination state into bands of contiguous source states, so that banded transition matrices are decoded in time proportional to the number of transitions.\n"
 "\n"
 "References:\n"
 "  [1] M. Mauch and S. Dixon, \"pYIN: A Fundamental Frequency Estimator\n"
@@ -51,101 +51,33 @@ void Viterbi::compute() {
   vector<int>& path = _path.get();
 
   size_t nState = init.size();
-  size_t nFrame = obs.size();
-  
-  // check for consistency    
-  size_t nTrans = transProb.size();
-  
-  // declaring variables, use double for a better precision
-  vector<double> delta = vector<double>(nState);
-  vector<double> oldDelta = vector<double>(nState);
-  vector<vector<int> > psi; //  "matrix" of remembered indices of the best transitions
-  
-  _tempPath.resize(nFrame);
 
-  double deltasum = 0;
-
-  // initialise first frame
-  for (size_t iState = 0; iState < nState; ++iState)
-  {
-      oldDelta[iState] = init[iState] * obs[0][iState];
-      deltasum += oldDelta[iState];
-  }
-
-  for (size_t iState = 0; iState < nState; ++iState)
-  {
-      oldDelta[iState] /= deltasum; // normalise (scale)
-  }
-
-  psi.push_back(vector<int>(nState,0));
-
-  // rest of forward step
-  for (size_t iFrame = 1; iFrame < nFrame; ++iFrame)
-  {
-      deltasum = 0;
-      psi.push_back(vector<int>(nState,0));
-
-      // calculate best previous state for every current state
-      size_t fromState;
-      size_t toState;
-      double currentTransProb;
-      double currentValue;
-      
-      // this is the "sparse" loop
-      for (size_t iTrans = 0; iTrans < nTrans; ++iTrans)
-      {
-          fromState = from[iTrans];
-          toState = to[iTrans];
-          currentTransProb = transProb[iTrans];
-          
-          currentValue = oldDelta[fromState] * currentTransProb;
-          if (currentValue > delta[toState])
-          {
-              delta[toState] = currentValue; // will be multiplied by the right obs later!
-              psi[iFrame][toState] = fromState;
-          }            
-      }
-      
-      for (size_t jState = 0; jState < nState; ++jState)
-      {
-          delta[jState] *= obs[iFrame][jState];
-          deltasum += delta[jState];
-      }
-
-      if (deltasum > 0)
-      {
-          for (size_t iState = 0; iState < nState; ++iState)
-          {
-              oldDelta[iState] = delta[iState] / deltasum; // normalise (scale)
-              delta[iState] = 0;
-          }
-      } else
-      {
-          E_WARNING("WARNING: Viterbi has been fed some zero probabilities, at least they become zero at frame " <<  iFrame << " in combination with the model.");
-          for (size_t iState = 0; iState < nState; ++iState)
-          {
-              oldDelta[iState] = 1.0/nState;
-              delta[iState] = 0;
-          }
+  // the sparse transition structure is only rebuilt when it changes, so that
+  // consecutive calls with the same model do not pay for it
+  if (nState != _decoder.numberStates() || from != _from || to != _to || transProb != _transProb) {
+    if (from.size() != to.size() || from.size() != transProb.size()) {
+      throw EssentiaException("Viterbi: fromIndex, toIndex and transitionProbabilities should have the same size");
+    }
+    for (size_t i=0; i<from.size(); ++i) {
+      if (from[i] >= nState || to[i] >= nState) {
+        throw EssentiaException("Viterbi: transition indices are not consistent with the number of states");
       }
+    }
+    _from = from;
+    _to = to;
+    _transProb = transProb;
+    _decoder.setTransitions(nState, _from, _to, _transProb);
   }
 
-  // initialise backward step, use double for a better precision
-  double bestValue = 0;
-  for (size_t iState = 0; iState < nState; ++iState)
-  {
-      double currentValue = oldDelta[iState];
-      if (currentValue > bestValue)
-      {
-          bestValue = currentValue;            
-          _tempPath[nFrame-1] = iState;
-      }
+  for (size_t iFrame = 0; iFrame < obs.size(); ++iFrame) {
+    if (obs[iFrame].size() < nState) {
+      throw EssentiaException("Viterbi: observation probabilities should have a value for each state");
+    }
   }
 
-  // rest of backward step
-  for (int iFrame = nFrame-2; iFrame != -1; --iFrame)
-  {
-      _tempPath[iFrame] = psi[iFrame+1][_tempPath[iFrame+1]];
+  // use double for a better precision
+  if (!_decoder.decode(init, obs, _tempPath)) {
+    E_WARNING("WARNING: Viterbi has been fed some zero probabilities, at least they become zero at some frame in combination with the model.");
   }
 
   path = _tempPath;
@@ -21,6 +21,7 @@
 #define ESSENTIA_VITERBI_H
 
 #include "algorithmfactory.h"
+#include "viterbidecoder.h"
 
 namespace essentia {
 namespace standard {
@@ -35,7 +36,12 @@ class Viterbi : public Algorithm {
   Input<std::vector<Real> > _transitionProbabilities;
   Output<std::vector<int> > _path;
 
-  std::vector<int> _tempPath; 
+  std::vector<int> _tempPath;
+
+  std::vector<size_t> _from;
+  std::vector<size_t> _to;
+  std::vector<Real> _transProb;
+  util::ViterbiDecoder<double> _decoder;
 
  public:
   Viterbi() {
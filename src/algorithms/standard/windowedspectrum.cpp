@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "windowedspectrum.h"
+#include "essentiamath.h"
+
+using namespace std;
+using namespace essentia;
+using namespace standard;
+
+const char* WindowedSpectrum::name = "WindowedSpectrum";
+const char* WindowedSpectrum::category = "Spectral";
+const char* WindowedSpectrum::description = DOC("This algorithm applies windowing to an audio frame and computes its spectrum in a single step. It is equivalent to (and gives exactly the same values as) a Windowing algorithm followed by Spectrum, or by PowerSpectrum when spectrumType is 'power'. When spectrumType is 'db', the power spectrum is converted to decibels (see the UnaryOperator 'lin2db' type).\n"
+"\n"
+"Windowing parameters have the same meaning as in the Windowing algorithm. The window is only computed when configuring or when the size of the input frame changes, and the windowed frame and FFT buffers are reused between calls, so that no intermediate vectors have to be passed between algorithms.\n"
+"\n"
+"An exception is thrown if the size of the frame is less than 2, or if the size of the zero-padded frame is odd.\n"
+"\n"
+"References:\n"
+"  [1] F. J. Harris, \"On the use of windows for harmonic analysis with the\n"
+"  discrete Fourier transform, Proceedings of the IEEE, vol. 66, no. 1,\n"
+"  pp. 51-83, Jan. 1978\n\n"
+"  [2] Frequency spectrum - Wikipedia, the free encyclopedia,\n"
+"  http://en.wikipedia.org/wiki/Frequency_spectrum");
+
+
+void WindowedSpectrum::configure() {
+  string spectrumType = parameter("spectrumType").toLower();
+  if (spectrumType == "magnitude") _spectrumType = MAGNITUDE;
+  else if (spectrumType == "power") _spectrumType = POWER;
+  else _spectrumType = DB;
+
+  _zeroPadding = parameter("zeroPadding").toInt();
+  _zeroPhase = parameter("zeroPhase").toBool();
+
+  // the window itself is generated by Windowing, so that both algorithms
+  // always use exactly the same values
+  _windowing->configure("size", parameter("size"),
+                        "type", parameter("type"),
+                        "normalized", parameter("normalized"),
+                        "zeroPhase", false,
+                        "zeroPadding", 0);
+  createWindow(parameter("size").toInt());
+
+  _fft->configure("size", parameter("size").toInt() + _zeroPadding);
+
+  // set temp ports here as they're not gonna change between consecutive
+  // calls to compute()
+  _fft->input("frame").set(_windowedFrame);
+  _fft->output("fft").set(_fftBuffer);
+}
+
+void WindowedSpectrum::createWindow(int size) {
+  // windowing a frame of ones gives the window
+  vector<Real> ones(size, 1.0);
+  _windowing->input("frame").set(ones);
+  _windowing->output("frame").set(_window);
+  _windowing->compute();
+}
+
+void WindowedSpectrum::compute() {
+
+  const vector<Real>& signal = _frame.get();
+  vector<Real>& spectrum = _spectrum.get();
+
+  if (signal.size() <= 1) {
+    throw EssentiaException("WindowedSpectrum: frame size should be larger than 1");
+  }
+
+  if (signal.size() != _window.size()) {
+    createWindow((int)signal.size());
+  }
+
+  int signalSize = (int)signal.size();
+  _windowedFrame.resize(signalSize + _zeroPadding);
+
+  Real* windowed = &_windowedFrame[0];
+  const Real* window = &_window[0];
+
+  if (_zeroPhase) {
+    // first half of the windowed signal is the second half of the signal,
+    // followed by the zero padding and the first half of the signal
+    int half = signalSize/2;
+    for (int j=half; j<signalSize; j++) {
+      *windowed++ = signal[j] * window[j];
+    }
+    for (int j=0; j<_zeroPadding; j++) {
+      *windowed++ = 0.0;
+    }
+    for (int j=0; j<half; j++) {
+      *windowed++ = signal[j] * window[j];
+    }
+  }
+  else {
+    for (int j=0; j<signalSize; j++) {
+      *windowed++ = signal[j] * window[j];
+    }
+    for (int j=0; j<_zeroPadding; j++) {
+      *windowed++ = 0.0;
+    }
+  }
+
+  // the FFT checks the size of the windowed frame
+  _fft->compute();
+
+  int size = (int)_fftBuffer.size();
+  spectrum.resize(size);
+  const complex<Real>* fft = &_fftBuffer[0];
+
+  switch (_spectrumType) {
+    case MAGNITUDE:
+      for (int i=0; i<size; i++) {
+        spectrum[i] = sqrt(fft[i].real()*fft[i].real() + fft[i].imag()*fft[i].imag());
+      }
+      break;
+
+    case POWER:
+      for (int i=0; i<size; i++) {
+        spectrum[i] = fft[i].real()*fft[i].real() + fft[i].imag()*fft[i].imag();
+      }
+      break;
+
+    case DB:
+      for (int i=0; i<size; i++) {
+        spectrum[i] = lin2db(fft[i].real()*fft[i].real() + fft[i].imag()*fft[i].imag());
+      }
+      break;
+  }
+}
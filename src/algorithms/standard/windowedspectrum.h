@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_WINDOWEDSPECTRUM_H
+#define ESSENTIA_WINDOWEDSPECTRUM_H
+
+#include "algorithmfactory.h"
+#include <complex>
+
+namespace essentia {
+namespace standard {
+
+class WindowedSpectrum : public Algorithm {
+
+ protected:
+  Input<std::vector<Real> > _frame;
+  Output<std::vector<Real> > _spectrum;
+
+  Algorithm* _windowing;
+  Algorithm* _fft;
+
+  enum SpectrumType {
+    MAGNITUDE, POWER, DB
+  };
+  SpectrumType _spectrumType;
+
+  std::vector<Real> _window;
+  std::vector<Real> _windowedFrame;
+  std::vector<std::complex<Real> > _fftBuffer;
+  int _zeroPadding;
+  bool _zeroPhase;
+
+  void createWindow(int size);
+
+ public:
+  WindowedSpectrum() {
+    declareInput(_frame, "frame", "the input audio frame");
+    declareOutput(_spectrum, "spectrum", "the spectrum of the windowed audio frame");
+
+    _windowing = AlgorithmFactory::create("Windowing");
+    _fft = AlgorithmFactory::create("FFT");
+  }
+
+  ~WindowedSpectrum() {
+    delete _windowing;
+    delete _fft;
+  }
+
+  void declareParameters() {
+    declareParameter("size", "the window size", "[2,inf)", 1024);
+    declareParameter("zeroPadding", "the size of the zero-padding", "[0,inf)", 0);
+    declareParameter("type", "the window type, which can be 'hamming', 'hann', 'triangular', 'square' or 'blackmanharrisXX'", "{hamming,hann,hannnsgcq,triangular,square,blackmanharris62,blackmanharris70,blackmanharris74,blackmanharris92}", "hann");
+    declareParameter("zeroPhase", "a boolean value that enables zero-phase windowing", "{true,false}", true);
+    declareParameter("normalized", "a boolean value to specify whether to normalize windows (to have an area of 1) and then scale by a factor of 2", "{true,false}", true);
+    declareParameter("spectrumType", "the type of spectrum to output: linear magnitude, power (squared magnitude) or power in dB", "{magnitude,power,db}", "magnitude");
+  }
+
+  void configure();
+  void compute();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+
+};
+
+} // namespace standard
+} // namespace essentia
+
+#include "streamingalgorithmwrapper.h"
+
+namespace essentia {
+namespace streaming {
+
+class WindowedSpectrum : public StreamingAlgorithmWrapper {
+
+ protected:
+  Sink<std::vector<Real> > _frame;
+  Source<std::vector<Real> > _spectrum;
+
+ public:
+  WindowedSpectrum() {
+    declareAlgorithm("WindowedSpectrum");
+    declareInput(_frame, TOKEN, "frame");
+    declareOutput(_spectrum, TOKEN, "spectrum");
+  }
+};
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_WINDOWEDSPECTRUM_H
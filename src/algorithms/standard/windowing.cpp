@@ -38,6 +38,7 @@ const char* Windowing::description = DOC("This algorithm applies windowing to an
 "  http://en.wikipedia.org/wiki/Window_function");
 
 void Windowing::configure() {
+  markConfigured();
   _normalized = parameter("normalized").toBool();
   _window.resize(parameter("size").toInt());
   createWindow(parameter("type").toLower());
@@ -62,6 +63,7 @@ void Windowing::createWindow(const std::string& windowtype) {
 }
 
 void Windowing::compute() {
+  ensureConfigured();
 
   const std::vector<Real>& signal = _frame.get();
   std::vector<Real>& windowedSignal = _windowedFrame.get();
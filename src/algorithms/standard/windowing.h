@@ -46,6 +46,7 @@ class Windowing : public Algorithm {
   }
 
   void configure();
+  bool deferDefaultConfiguration() const { return true; }
 
   void compute();
 
@@ -190,14 +190,14 @@ void PoolAggregator::aggregateSingleVectorRealPool(const Pool& input, Pool& outp
 }
 
 void PoolAggregator::aggregateVectorRealPool(const Pool& input, Pool& output) {
-  PoolOf(vector<Real>) vectorRealPool = input.getVectorRealPool();
+  const PoolOf(vector<Real>)& vectorRealPool = input.getVectorRealRowsPool();
 
   for (PoolOf(vector<Real>)::const_iterator it = vectorRealPool.begin();
        it != vectorRealPool.end();
        ++it) {
 
     string key = it->first;
-    vector<vector<Real> > data = it->second;
+    const vector<vector<Real> >& data = it->second;
     int dsize = data.size();
 
     if (dsize == 0) continue;
@@ -383,6 +383,161 @@ void PoolAggregator::aggregateVectorRealPool(const Pool& input, Pool& output) {
       }
     }
   }
+
+  // descriptors whose frames are stored contiguously all have frames of the
+  // same size, they are aggregated without copying them into rows
+  const map<string, FrameMatrix>& matrixPool = input.getVectorRealMatrixPool();
+
+  for (map<string, FrameMatrix>::const_iterator it = matrixPool.begin();
+       it != matrixPool.end();
+       ++it) {
+    aggregateFrameMatrix(it->first, it->second, output);
+  }
+}
+
+// mean and variance of the given values, computed as meanFrames() and
+// varianceFrames() do for one column of frames
+static void meanVariance(const vector<Real>& values, Real& mean, Real& variance) {
+  int size = values.size();
+  mean = 0.0;
+  for (int i=0; i<size; ++i) mean += values[i];
+  mean /= size;
+
+  variance = 0.0;
+  for (int i=0; i<size; ++i) {
+    Real diff = values[i] - mean;
+    variance += diff*diff;
+  }
+  variance /= size;
+}
+
+void PoolAggregator::aggregateFrameMatrix(const string& key, const FrameMatrix& frames, Pool& output) {
+  int dsize = frames.rows();
+  int vsize = frames.cols();
+
+  if (dsize == 0) return;
+
+  // same statistics as for the frames stored as rows above, computed one
+  // column at a time
+  vector<Real> meanVals(vsize), varVals(vsize), stdevVals(vsize), medianVals(vsize);
+  vector<Real> skewnessVals(vsize), kurtosisVals(vsize), minVals(vsize), maxVals(vsize);
+  vector<Real> dmeanVals(vsize), dvarVals(vsize), d2meanVals(vsize), d2varVals(vsize);
+
+  vector<Real> column(dsize), sorted(dsize);
+  vector<Real> derived(dsize > 1 ? dsize-1 : 1, 0.0), derived2(dsize > 2 ? dsize-2 : 1, 0.0);
+
+  for (int j=0; j<vsize; ++j) {
+    for (int i=0; i<dsize; ++i) column[i] = frames.row(i)[j];
+
+    // mean, var & stdev
+    meanVariance(column, meanVals[j], varVals[j]);
+    stdevVals[j] = sqrt(varVals[j]);
+
+    // median
+    sorted = column;
+    std::sort(sorted.begin(), sorted.end());
+    if (dsize % 2 == 0) medianVals[j] = (sorted[dsize/2 - 1] + sorted[dsize/2]) / 2;
+    else medianVals[j] = sorted[dsize/2];
+
+    // skewness & kurtosis
+    Real m2 = 0.0, m3 = 0.0, m4 = 0.0;
+    for (int i=0; i<dsize; ++i) {
+      Real diff = column[i] - meanVals[j];
+      m2 += diff*diff;
+      m3 += diff*diff*diff;
+      m4 += diff*diff*diff*diff;
+    }
+    m2 /= dsize;
+    m3 /= dsize;
+    m4 /= dsize;
+    skewnessVals[j] = m2 == 0.0 ? 0.0 : m3 / pow(m2, (Real)1.5);
+    kurtosisVals[j] = m2 == 0.0 ? -3.0 : m4 / (m2*m2) - 3;
+
+    // min & max
+    minVals[j] = *std::min_element(column.begin(), column.end());
+    maxVals[j] = *std::max_element(column.begin(), column.end());
+
+    // derived mean & var, of the absolute first and second derivatives
+    for (int i=0; i<dsize-1; ++i) derived[i] = column[i+1] - column[i];
+    for (int i=0; i<dsize-2; ++i) derived2[i] = derived[i+1] - derived[i];
+    for (int i=0; i<int(derived.size()); ++i) derived[i] = abs(derived[i]);
+    for (int i=0; i<int(derived2.size()); ++i) derived2[i] = abs(derived2[i]);
+
+    meanVariance(derived, dmeanVals[j], dvarVals[j]);
+    meanVariance(derived2, d2meanVals[j], d2varVals[j]);
+  }
+
+  // only compute cov and icov matrix if asked, because it could throw an
+  // exception if matrix is singular...
+  const vector<string>& stats = getStats(key);
+
+  vector<vector<Real> > cov(vsize), icov(vsize);
+
+  if (contains(stats, string("cov")) || contains(stats, string("icov"))) {
+    TNT::Array2D<Real> matrix(dsize, vsize);
+    for (int i=0; i<dsize; i++) {
+      std::copy(frames.row(i), frames.row(i) + vsize, matrix[i]);
+    }
+
+    vector<Real> framesMean; // not used
+    TNT::Array2D<Real> covTnt, icovTnt;
+
+    Algorithm* sg = AlgorithmFactory::create("SingleGaussian");
+    sg->input("matrix").set(matrix);
+    sg->output("mean").set(framesMean);
+    sg->output("covariance").set(covTnt);
+    sg->output("inverseCovariance").set(icovTnt);
+
+    sg->compute();
+
+    delete sg;
+
+    int covSize = covTnt.dim1();
+    for (int i=0; i<covSize; ++i) {
+      cov[i].assign(covTnt[i], covTnt[i] + covSize);
+      icov[i].assign(icovTnt[i], icovTnt[i] + covSize);
+    }
+  }
+
+  // Now add all the computed statistics into the output pool
+  for (int i=0; i<(int)stats.size(); ++i) {
+    string subkey = key + "." + stats[i];
+
+    // the statistics are added value by value, as for the frames stored as rows
+    const vector<Real>* values = 0;
+    if (stats[i] == "mean")        values = &meanVals;
+    else if (stats[i] == "median") values = &medianVals;
+    else if (stats[i] == "min")    values = &minVals;
+    else if (stats[i] == "max")    values = &maxVals;
+    else if (stats[i] == "var")    values = &varVals;
+    else if (stats[i] == "stdev")  values = &stdevVals;
+    else if (stats[i] == "skew")   values = &skewnessVals;
+    else if (stats[i] == "kurt")   values = &kurtosisVals;
+    else if (stats[i] == "dmean")  values = &dmeanVals;
+    else if (stats[i] == "dvar")   values = &dvarVals;
+    else if (stats[i] == "dmean2") values = &d2meanVals;
+    else if (stats[i] == "dvar2")  values = &d2varVals;
+
+    if (values) {
+      for (int j=0; j<vsize; ++j) output.add(subkey, (*values)[j]);
+    }
+
+    else if (stats[i] == "cov")
+      for (int j=0; j<vsize; ++j) output.add(subkey, cov[j]);
+
+    else if (stats[i] == "icov")
+      for (int j=0; j<vsize; ++j) output.add(subkey, icov[j]);
+
+    else if (stats[i] == "copy")
+      // don't use the subkey in this case, just key
+      for (int j=0; j<dsize; ++j) output.add(key, vector<Real>(frames.row(j), frames.row(j) + vsize));
+
+    else if (stats[i] == "value")
+      for (int j=0; j<dsize; ++j) output.add(subkey, vector<Real>(frames.row(j), frames.row(j) + vsize));
+
+    else if (stats[i] == "last")
+      output.set(key, vector<Real>(frames.row(dsize-1), frames.row(dsize-1) + vsize));
+  }
 }
 
 
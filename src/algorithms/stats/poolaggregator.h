@@ -37,6 +37,7 @@ class PoolAggregator : public Algorithm {
   void aggregateRealPool(const Pool& input, Pool& output);
   void aggregateSingleVectorRealPool(const Pool& input, Pool& output);
   void aggregateVectorRealPool(const Pool& input, Pool& output);
+  void aggregateFrameMatrix(const std::string& key, const FrameMatrix& frames, Pool& output);
   void aggregateArray2DRealPool(const Pool& input, Pool& output);
   void aggregateSingleStringPool(const Pool& input, Pool& output);
   void aggregateStringPool(const Pool& input, Pool& output);
@@ -50,6 +50,9 @@ Real aWeighting(Real f) {
   );
 }
 
+// peaks further apart than this (in critical bandwidths) are consonant
+const Real plompLeveltWidth = 1.18;
+
 Real plompLevelt(Real df) {
   // df is the frequency difference on with critical bandwidth as  a unit.
   // the cooeficients were fitted with a polynom
@@ -63,7 +66,7 @@ Real plompLevelt(Real df) {
   //       }
   //   }
   if (df < 0) return 1;
-  if (df > 1.18) return 1;
+  if (df > plompLeveltWidth) return 1;
   Real res =
       -6.58977878 * df*df*df*df*df +
       28.58224226 * df*df*df*df +
@@ -76,20 +79,23 @@ Real plompLevelt(Real df) {
   return res;
 }
 
-Real consonance(Real f1, Real f2) {
-  // critical bandwidth between f1, f2:
+Real criticalBandwidth(Real f) {
   // see  http://www.sfu.ca/sonic-studio/handbook/Critical_Band.html for a
   // definition of critical bandwidth between two partials of a complex tone:
-  Real cbwf1 = barkCriticalBandwidth(hz2bark(f1));
-  Real cbwf2 = barkCriticalBandwidth(hz2bark(f2));
-  Real cbw = std::min(cbwf1, cbwf2 );
-  return plompLevelt(fabs(f2-f1)/cbw);
+  return barkCriticalBandwidth(hz2bark(f));
 }
 
+Real criticalBandDistance(Real f1, Real f2, Real cbwf1, Real cbwf2) {
+  // frequency difference between f1 and f2, with the critical bandwidth
+  // between them as a unit
+  Real cbw = std::min(cbwf1, cbwf2);
+  return fabs(f2-f1)/cbw;
+}
 
 
-Real calcDissonance(const vector<Real>& frequencies, const vector<Real>& magnitudes) {
-  vector<Real> loudness = magnitudes;
+Real Dissonance::computeDissonance(const vector<Real>& frequencies, const vector<Real>& magnitudes) {
+  _loudness = magnitudes;
+  vector<Real>& loudness = _loudness;
   Real totalLoudness = 0;
   int size = frequencies.size();
 
@@ -109,8 +115,13 @@ Real calcDissonance(const vector<Real>& frequencies, const vector<Real>& magnitu
     return 0.0;
   }
 
-  //vector<Real> loudness(size);
-  //for (int i=0; i<size; i++) partialLoudness = loudness[i]/totalLoudness;
+  // the critical bandwidth of each peak is only computed once, instead of
+  // once per pair of peaks
+  _bandwidths.resize(size);
+  for (int i = 0; i < size; i++) {
+    _bandwidths[i] = criticalBandwidth(frequencies[i]);
+  }
+  const vector<Real>& bandwidths = _bandwidths;
 
   Real totalDissonance = 0;
   for (int p1 = 0; p1 < size; p1++) {
@@ -118,11 +129,30 @@ Real calcDissonance(const vector<Real>& frequencies, const vector<Real>& magnitu
       Real barkFreq = hz2bark(frequencies[p1]);
       Real startF = bark2hz(barkFreq - 1.18);
       Real endF = bark2hz(barkFreq + 1.18);
-      int p2 = 0;
+
+      // p2 goes through the peaks in [first, last), where first is the first
+      // peak not below both startF and 50 Hz, and last the first one not
+      // below both endF and 10 kHz
+      int first = lower_bound(frequencies.begin(), frequencies.end(), std::min(startF, (Real)50)) - frequencies.begin();
+      int last = lower_bound(frequencies.begin() + first, frequencies.end(), std::min(endF, (Real)10000)) - frequencies.begin();
+
+      // Below 10 kHz, the critical bandwidth grows with the frequency, so the
+      // critical band distance between p1 and p2 grows as p2 moves away from
+      // p1. The peaks that are further than the width of the dissonance curve
+      // are consonant with p1 and can be skipped: only those around p1 are
+      // visited, still in increasing order of frequency
+      int p2 = std::min(p1, last);
+      while (p2 > first &&
+             criticalBandDistance(frequencies[p1], frequencies[p2-1], bandwidths[p1], bandwidths[p2-1]) <= plompLeveltWidth) {
+        p2--;
+      }
+
       Real peakDissonance = 0;
-      while (p2 < size && frequencies[p2] < startF && frequencies[p2] < 50) p2++;
-      while (p2 < size && frequencies[p2] < endF && frequencies[p2] < 10000) {
-        Real d = 1.0 - consonance(frequencies[p1], frequencies[p2]);
+      while (p2 < last) {
+        Real df = criticalBandDistance(frequencies[p1], frequencies[p2], bandwidths[p1], bandwidths[p2]);
+        if (p2 > p1 && df > plompLeveltWidth) break;
+
+        Real d = 1.0 - plompLevelt(df);
         // Dissonance from p1 to p2, should be the same as dissonance from p2
         // to p1, this is the reason for using both peaks' loudness as
         // weight
@@ -156,5 +186,5 @@ void Dissonance::compute() {
     }
   }
 
-  dissonance = calcDissonance(frequencies, magnitudes);
+  dissonance = computeDissonance(frequencies, magnitudes);
 }
@@ -32,6 +32,12 @@ class Dissonance : public Algorithm {
   Input<std::vector<Real> > _magnitudes;
   Output<Real> _dissonance;
 
+  // scratch buffers, reused between calls to compute()
+  std::vector<Real> _loudness;
+  std::vector<Real> _bandwidths;
+
+  Real computeDissonance(const std::vector<Real>& frequencies, const std::vector<Real>& magnitudes);
+
  public:
   Dissonance() {
     declareInput(_frequencies, "frequencies", "the frequencies of the spectral peaks (must be sorted by frequency)");
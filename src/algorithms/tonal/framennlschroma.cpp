@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "framennlschroma.h"
+
+using namespace std;
+
+namespace essentia {
+namespace streaming {
+
+const char* FrameNNLSChroma::name = "FrameNNLSChroma";
+const char* FrameNNLSChroma::category = "Tonal";
+const char* FrameNNLSChroma::description = DOC("This algorithm extracts treble and bass chromagrams from a stream of log-frequency spectrum frames, as computed by the LogSpectrum algorithm. It computes the same descriptors as NNLSChroma (see its documentation for the meaning of the parameters), but outputs them frame by frame instead of waiting for the whole log-spectrogram, so that its memory usage does not depend on the length of the audio.\n"
+"\n"
+"As the tuning of the whole audio is not known until the end of the stream, the global tuning used for each frame is estimated from the frames before it: either all of them (as given by the meanTuning output of LogSpectrum), or only the last tuningFrames frames. In local tuning mode, the local tuning of each frame is used, exactly as in NNLSChroma.\n"
+"\n"
+"Frames are processed in batches of batchSize frames, which are computed in parallel threads when possible.\n"
+"\n"
+"This algorithm is only available in streaming mode.");
+
+const int nBPS = 3; // bins per semitone, as in NNLSChroma
+const int nNote = 256;
+
+
+void FrameNNLSChroma::configure() {
+  _batchSize = parameter("batchSize").toInt();
+  _tuningFrames = parameter("tuningFrames").toInt();
+  _localTuningMode = parameter("tuningMode").toString() == "local";
+
+  // frames are passed to NNLSChroma with the tuning of each of them, as if
+  // it was their local tuning
+  _nnlsChroma->configure("frameSize", parameter("frameSize"),
+                         "sampleRate", parameter("sampleRate"),
+                         "useNNLS", parameter("useNNLS"),
+                         "tuningMode", "local",
+                         "spectralWhitening", parameter("spectralWhitening"),
+                         "spectralShape", parameter("spectralShape"),
+                         "chromaNormalization", parameter("chromaNormalization"));
+
+  _nnlsChroma->input("logSpectrogram").set(_frames);
+  _nnlsChroma->input("meanTuning").set(_unusedMeanTuning);
+  _nnlsChroma->input("localTuning").set(_frameTunings);
+  _nnlsChroma->output("tunedLogfreqSpectrum").set(_tunedFrames);
+  _nnlsChroma->output("semitoneSpectrum").set(_semitoneFrames);
+  _nnlsChroma->output("bassChromagram").set(_bassChromaFrames);
+  _nnlsChroma->output("chromagram").set(_chromaFrames);
+
+  reset();
+}
+
+void FrameNNLSChroma::reset() {
+  Algorithm::reset();
+  _tuningProfiles.assign(nBPS * max(_tuningFrames, 1), 0.0);
+  _tuningProfileCount = 0;
+  setBatchSize(_batchSize);
+}
+
+void FrameNNLSChroma::setBatchSize(int size) {
+  _logSpectrum.setAcquireSize(size);
+  _logSpectrum.setReleaseSize(size);
+  _meanTuning.setAcquireSize(size);
+  _meanTuning.setReleaseSize(size);
+  _localTuning.setAcquireSize(size);
+  _localTuning.setReleaseSize(size);
+  _tunedLogfreqSpectrum.setAcquireSize(size);
+  _tunedLogfreqSpectrum.setReleaseSize(size);
+  _semitoneSpectrum.setAcquireSize(size);
+  _semitoneSpectrum.setReleaseSize(size);
+  _bassChromagram.setAcquireSize(size);
+  _bassChromagram.setReleaseSize(size);
+  _chromagram.setAcquireSize(size);
+  _chromagram.setReleaseSize(size);
+}
+
+Real FrameNNLSChroma::frameTuning(const vector<Real>& logSpectrum, const vector<Real>& meanTuning) {
+  vector<Real> tuning;
+  if (_tuningFrames == 0) {
+    tuning = meanTuning;
+  }
+  else {
+    if ((int)logSpectrum.size() != nNote) {
+      throw EssentiaException("FrameNNLSChroma: log spectrum size should be 256 but it is ",
+                              logSpectrum.size(), ".");
+    }
+    // same profile as the one averaged by LogSpectrum for its meanTuning
+    Real* profile = &_tuningProfiles[nBPS * (_tuningProfileCount % _tuningFrames)];
+    fill(profile, profile + nBPS, (Real)0.0);
+    for (int iTone = 0; iTone < round(nNote * 0.62 / nBPS) * nBPS + 1; iTone += nBPS) {
+      for (int iBPS = 0; iBPS < nBPS; ++iBPS) profile[iBPS] += logSpectrum[iTone + iBPS];
+    }
+    _tuningProfileCount++;
+
+    // the tuning only depends on the direction of the mean profile, its sum
+    // can be used instead
+    tuning.assign(nBPS, 0.0);
+    int frames = min(_tuningProfileCount, _tuningFrames);
+    for (int i = 0; i < frames; ++i) {
+      for (int iBPS = 0; iBPS < nBPS; ++iBPS) tuning[iBPS] += _tuningProfiles[nBPS * i + iBPS];
+    }
+  }
+
+  if ((int)tuning.size() < nBPS) {
+    throw EssentiaException("FrameNNLSChroma: mean tuning size should be ", nBPS);
+  }
+
+  Real tuningImag = 0;
+  Real tuningReal = 0;
+  for (int iBPS = 0; iBPS < nBPS; ++iBPS) {
+    tuningReal += tuning[iBPS] * cos(2 * M_PI * (iBPS * 1.0 / nBPS));
+    tuningImag += tuning[iBPS] * sin(2 * M_PI * (iBPS * 1.0 / nBPS));
+  }
+  return atan2(tuningImag, tuningReal) / (2 * M_PI);
+}
+
+AlgorithmStatus FrameNNLSChroma::process() {
+  EXEC_DEBUG("process()");
+  AlgorithmStatus status = acquireData();
+
+  if (status != OK) {
+    // at the end of the stream, process the frames that are left in a
+    // smaller batch
+    if (!shouldStop()) return status;
+
+    int available = _logSpectrum.available();
+    if (available == 0) return NO_INPUT;
+
+    setBatchSize(available);
+    status = acquireData();
+    if (status != OK) return status;
+  }
+
+  const vector<vector<Real> >& logSpectrum = _logSpectrum.tokens();
+  const vector<vector<Real> >& meanTuning = _meanTuning.tokens();
+  const vector<Real>& localTuning = _localTuning.tokens();
+  int size = (int)logSpectrum.size();
+
+  _frames.resize(size);
+  _frameTunings.resize(size);
+  for (int i = 0; i < size; ++i) {
+    _frames[i] = logSpectrum[i];
+    _frameTunings[i] = _localTuningMode ? localTuning[i] : frameTuning(logSpectrum[i], meanTuning[i]);
+  }
+
+  _nnlsChroma->compute();
+
+  // NNLSChroma rewrites its output frames entirely, they can be swapped
+  // with the output tokens
+  vector<vector<Real> >& tunedLogfreqSpectrum = _tunedLogfreqSpectrum.tokens();
+  vector<vector<Real> >& semitoneSpectrum = _semitoneSpectrum.tokens();
+  vector<vector<Real> >& bassChromagram = _bassChromagram.tokens();
+  vector<vector<Real> >& chromagram = _chromagram.tokens();
+  for (int i = 0; i < size; ++i) {
+    tunedLogfreqSpectrum[i].swap(_tunedFrames[i]);
+    semitoneSpectrum[i].swap(_semitoneFrames[i]);
+    bassChromagram[i].swap(_bassChromaFrames[i]);
+    chromagram[i].swap(_chromaFrames[i]);
+  }
+
+  releaseData();
+  return OK;
+}
+
+} // namespace streaming
+} // namespace essentia
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_FRAMENNLSCHROMA_H
+#define ESSENTIA_FRAMENNLSCHROMA_H
+
+#include "streamingalgorithm.h"
+#include "algorithmfactory.h"
+
+namespace essentia {
+namespace streaming {
+
+class FrameNNLSChroma : public Algorithm {
+ protected:
+
+  Sink<std::vector<Real> > _logSpectrum;
+  Sink<std::vector<Real> > _meanTuning;
+  Sink<Real> _localTuning;
+  Source<std::vector<Real> > _tunedLogfreqSpectrum;
+  Source<std::vector<Real> > _semitoneSpectrum;
+  Source<std::vector<Real> > _bassChromagram;
+  Source<std::vector<Real> > _chromagram;
+
+  standard::Algorithm* _nnlsChroma;
+
+  int _batchSize;
+  int _tuningFrames;
+  bool _localTuningMode;
+
+  // tuning profiles of the last tuningFrames frames (circular buffer)
+  std::vector<Real> _tuningProfiles;
+  int _tuningProfileCount;
+
+  // the frames of the current batch, and the outputs of NNLSChroma
+  std::vector<std::vector<Real> > _frames;
+  std::vector<Real> _frameTunings;
+  std::vector<Real> _unusedMeanTuning;
+  std::vector<std::vector<Real> > _tunedFrames;
+  std::vector<std::vector<Real> > _semitoneFrames;
+  std::vector<std::vector<Real> > _bassChromaFrames;
+  std::vector<std::vector<Real> > _chromaFrames;
+
+  void setBatchSize(int size);
+  Real frameTuning(const std::vector<Real>& logSpectrum, const std::vector<Real>& meanTuning);
+
+ public:
+  FrameNNLSChroma() {
+    declareInput(_logSpectrum, 1, "logSpectrum", "log spectrum frame");
+    declareInput(_meanTuning, 1, "meanTuning", "normalized mean tuning frequency");
+    declareInput(_localTuning, 1, "localTuning", "normalized local tuning frequency");
+    declareOutput(_tunedLogfreqSpectrum, 1, "tunedLogfreqSpectrum", "Log frequency spectrum after tuning");
+    declareOutput(_semitoneSpectrum, 1, "semitoneSpectrum", "a spectral representation with one bin per semitone");
+    declareOutput(_bassChromagram, 1, "bassChromagram", "a 12-dimensional chromagram, restricted to the bass range");
+    declareOutput(_chromagram, 1, "chromagram", "a 12-dimensional chromagram, restricted with mid-range emphasis");
+    _nnlsChroma = standard::AlgorithmFactory::create("NNLSChroma");
+  }
+  ~FrameNNLSChroma() {
+    delete _nnlsChroma;
+  }
+
+  void declareParameters() {
+    declareParameter("frameSize", "the input frame size of the spectrum vector", "(1,inf)", 1025);
+    declareParameter("sampleRate", "the input sample rate", "(0,inf)", 44100.);
+    declareParameter("useNNLS", "toggle between NNLS approximate transcription and linear spectral mapping", "{true,false}", true);
+    declareParameter("tuningMode", "local uses the local tuning of each frame, global uses the tuning of all the frames seen so far (or of the last tuningFrames frames)", "{global,local}", "global");
+    declareParameter("tuningFrames", "the number of past frames used to estimate the tuning in global mode (0 uses all the past frames, as given by the meanTuning input)", "[0,inf)", 0);
+    declareParameter("spectralWhitening", "determines how much the log-frequency spectrum is whitened", "[0,1.0]", 1.0);
+    declareParameter("spectralShape", " the shape of the notes in the NNLS dictionary", "(0.5,0.9)", 0.7);
+    declareParameter("chromaNormalization", "determines whether or how the chromagrams are normalised", "{none,maximum,L1,L2}", "none");
+    declareParameter("batchSize", "the number of frames that are processed together (in parallel when possible)", "[1,inf)", 32);
+  }
+
+  void reset();
+  void configure();
+  AlgorithmStatus process();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+
+};
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_FRAMENNLSCHROMA_H
@@ -47,6 +47,8 @@ const char* Key::description = DOC("This algorithm computes key estimate given a
 "\n"
 "The streaming mode first accumulates a stream of HPCP vectors and computes its mean to provide the estimation. In this mode, the algorithm can apply a tuning correction, based on peaks in the bins of the accumulated HPCP distribution [3] (the `averageDetuningCorrection` parameter). This detuning approach requires a high resolution of the input HPCP vectors (`pcpSize` larger than 12).\n"
 "\n"
+"To estimate the key with several profile types at once, use MultiProfileKey, which scores all the profiles in a single pass.\n"
+"\n"
 "References:\n"
 "  [1] E. Gómez, \"Tonal Description of Polyphonic Audio for Music Content\n"
 "  Processing,\" INFORMS Journal on Computing, vol. 18, no. 3, pp. 294–304,\n"
@@ -285,107 +287,133 @@ void Key::compute() {
   const vector<Real>& pcp = _pcp.get();
 
   int pcpsize = (int)pcp.size();
-  int n = pcpsize/12;
 
   if (pcpsize < 12 || pcpsize % 12 != 0)
     throw EssentiaException("Key: input PCP size is not a positive multiple of 12");
 
-  if (pcpsize != (int)_profile_dom.size()) {
+  if (pcpsize != pcpSize()) {
     resize(pcpsize);
   }
 
-  ///////////////////////////////////////////////////////////////////
-  // compute correlation
+  // calculate the correlation between the profiles and the PCP...
+  // we shift the profile around to find the best match
+  Real pcpNorm = centerPcp(pcp, _centeredPcp);
+  correlate(_centeredPcp, pcpNorm, _shiftedProfiles, _profileNorms, _correlations);
+
+  estimate(pcp, &_correlations[0], _key.get(), _scale.get(), _strength.get(),
+           _firstToSecondRelativeStrength.get());
+}
+
+
+Real Key::centerPcp(const vector<Real>& pcp, vector<Real>& centeredPcp) {
+  int pcpsize = (int)pcp.size();
 
   // Compute means
   Real mean_pcp = mean(pcp);
   Real std_pcp = 0;
 
   // Compute Standard Deviations
-  for (int i=0; i<pcpsize; i++)
-    std_pcp += (pcp[i] - mean_pcp) * (pcp[i] - mean_pcp);
-  std_pcp = sqrt(std_pcp);
+  centeredPcp.resize(pcpsize);
+  for (int i=0; i<pcpsize; i++) {
+    centeredPcp[i] = pcp[i] - mean_pcp;
+    std_pcp += centeredPcp[i] * centeredPcp[i];
+  }
+  return sqrt(std_pcp);
+}
 
-  // Compute correlation matrix
-  int keyIndex = -1; // index of the first maximum
-  Real max     = -1;     // first maximum
-  Real max2    = -1;    // second maximum
-  int scale    = MAJOR;  // scale
 
-  // Compute maximum for major, minor and other.
-  Real maxMajor     = -1;
-  Real max2Major    = -1;
-  int keyIndexMajor = -1;
+// correlation coefficient of the pcp with each shifted profile, just like a
+// cross-correlation: this is a matrix-vector product, followed by the
+// normalization of each row
+void Key::correlate(const vector<Real>& centeredPcp, Real pcpNorm,
+                    const vector<Real>& shiftedProfiles,
+                    const vector<Real>& profileNorms,
+                    vector<Real>& correlations) {
+  int size = (int)centeredPcp.size();
+  int rows = (int)profileNorms.size() * size;
 
-  Real maxMinor     = -1;
-  Real max2Minor    = -1;
-  int keyIndexMinor = -1;
+  if ((int)shiftedProfiles.size() != rows*size) {
+    throw EssentiaException("Key: the size of the PCP does not match the size of the profiles");
+  }
 
-  Real maxOther     = -1;
-  Real max2Other    = -1;
-  int keyIndexOther = -1;
+  correlations.resize(rows);
+  const Real* v1 = &centeredPcp[0];
 
-  // calculate the correlation between the profiles and the PCP...
-  // we shift the profile around to find the best match
-  for (int shift=0; shift<pcpsize; shift++) {
-    /*
-    // Penalization if the Tonic has not a minimum amplitude
-    // max_pcp needs to be calculated...
-    Real factor = pcp[i]/max_pcp;
-    if (factor < 0.6) {
-      corrMajor *= factor / 0.6;
-      corrMinor *= factor / 0.6;
-    }
-    */
-    Real corrMajor = correlation(pcp, mean_pcp, std_pcp, _profile_doM, _mean_profile_M, _std_profile_M, shift);
-    // Compute maximum value for major keys
-    if (corrMajor > maxMajor) {
-      max2Major = maxMajor;
-      maxMajor = corrMajor;
-      keyIndexMajor = shift;
-    }
+  for (int row=0; row<rows; row++) {
+    const Real* v2 = &shiftedProfiles[row*size];
+    Real r = 0.0;
 
-    Real corrMinor = correlation(pcp, mean_pcp, std_pcp, _profile_dom, _mean_profile_m, _std_profile_m, shift);
-    // Compute maximum value for minor keys
-    if (corrMinor > maxMinor) {
-      max2Minor = maxMinor;
-      maxMinor = corrMinor;
-      keyIndexMinor = shift;
+    for (int i=0; i<size; i++) {
+      r += v1[i] * v2[i];
     }
 
-    Real corrOther = 0;
-    if (_useMajMin) {
-      corrOther = correlation(pcp, mean_pcp, std_pcp, _profile_doO, _mean_profile_O, _std_profile_O, shift);
-      // Compute maximum value for other keys
-      if (corrOther > maxOther) {
-        max2Other = maxOther;
-        maxOther = corrOther;
-        keyIndexOther = shift;
+    r /= pcpNorm*profileNorms[row/size];
+    correlations[row] = r;
+  }
+}
+
+
+void Key::estimate(const vector<Real>& pcp, const Real* correlations,
+                   string& key, string& scaleName, Real& strength,
+                   Real& firstToSecondRelativeStrength) const {
+
+  int pcpsize = (int)pcp.size();
+  int n = pcpsize/12;
+
+  // Compute correlation matrix
+  int keyIndex = -1; // index of the first maximum
+  Real max     = -1;     // first maximum
+  Real max2    = -1;    // second maximum
+  int scale    = MAJOR;  // scale
+
+  // Compute maximum for major, minor and other.
+  Real maxScale[3]     = { -1, -1, -1 };
+  Real max2Scale[3]    = { -1, -1, -1 };
+  int keyIndexScale[3] = { -1, -1, -1 };
+
+  for (int s=0; s<numScales(); s++) {
+    const Real* corr = correlations + s*pcpsize;
+
+    for (int shift=0; shift<pcpsize; shift++) {
+      /*
+      // Penalization if the Tonic has not a minimum amplitude
+      // max_pcp needs to be calculated...
+      Real factor = pcp[i]/max_pcp;
+      if (factor < 0.6) {
+        corrMajor *= factor / 0.6;
+        corrMinor *= factor / 0.6;
+      }
+      */
+      if (corr[shift] > maxScale[s]) {
+        max2Scale[s] = maxScale[s];
+        maxScale[s] = corr[shift];
+        keyIndexScale[s] = shift;
       }
     }
   }
 
+  Real maxMajor = maxScale[MAJOR];
+  Real maxMinor = maxScale[MINOR];
+  Real maxOther = maxScale[MAJMIN];
 
   if (maxMajor > maxMinor && maxMajor > maxOther) {
-    keyIndex = (int) (keyIndexMajor *  12 / pcpsize + 0.5);
     scale = MAJOR;
-    max = maxMajor;
-    max2 = max2Major;
   }
-
   else if (maxMinor >= maxMajor && maxMinor >= maxOther) {
-    keyIndex = (int) (keyIndexMinor * 12 / pcpsize + 0.5);
     scale = MINOR;
-    max = maxMinor;
-    max2 = max2Minor;
-    }
-
-	else if (maxOther > maxMajor && maxOther > maxMinor) {
-    keyIndex = (int) (keyIndexOther * 12 / pcpsize + 0.5);
+  }
+  else if (maxOther > maxMajor && maxOther > maxMinor) {
     scale = MAJMIN;
-    max = maxOther;
-    max2 = max2Other;
-    }
+  }
+  else {
+    scale = -1;
+  }
+
+  if (scale >= 0) {
+    keyIndex = (int) (keyIndexScale[scale] * 12 / pcpsize + 0.5);
+    max = maxScale[scale];
+    max2 = max2Scale[scale];
+  }
 
   // In the case of Wei Chai algorithm, the scale is detected in a second step
   // In this point, always the major relative is detected, as it is the first
@@ -395,10 +423,10 @@ void Key::compute() {
       throw EssentiaException("Key: error in Wei Chai algorithm. Wei Chai algorithm does not support minor scales.");
 
     int fifth = keyIndex + 7*n;
-    if (fifth > pcpsize)
+    if (fifth >= pcpsize)
       fifth -= pcpsize;
     int sixth = keyIndex + 9*n;
-    if (sixth > pcpsize)
+    if (sixth >= pcpsize)
       sixth -= pcpsize;
 
     if (pcp[sixth] >  pcp[fifth]) {
@@ -418,26 +446,25 @@ void Key::compute() {
   // Here we calculate the outputs...
 
   // first three outputs are key, scale and strength
-  _key.get() = _keys[keyIndex];
+  key = _keys[keyIndex];
 
   if (scale == MAJOR) {
-    _scale.get() = "major";
+    scaleName = "major";
   }
 
   else if (scale == MINOR) {
-    _scale.get() = "minor";
+    scaleName = "minor";
   }
 
   else if (scale == MAJMIN) {
-    _scale.get() = "majmin";
+    scaleName = "majmin";
   }
 
-  _strength.get() = max;
+  strength = max;
 
   // this one outputs the relative difference between the maximum and the
   // second highest maximum (i.e. Compute second highest correlation peak)
-  _firstToSecondRelativeStrength.get() = (max - max2) / max;
-
+  firstToSecondRelativeStrength = (max - max2) / max;
 }
 
 // this function resizes and interpolates the profiles to fit the
@@ -477,51 +504,39 @@ void Key::resize(int pcpsize) {
     }
   }
 
-  _mean_profile_M = mean(_profile_doM);
-  _mean_profile_m = mean(_profile_dom);
-  _mean_profile_O = mean(_profile_doO);
+  const vector<Real>* profiles[] = { &_profile_doM, &_profile_dom, &_profile_doO };
+  int nScales = numScales();
 
-  _std_profile_M = 0;
-  _std_profile_m = 0;
-  _std_profile_O = 0;
+  _profileNorms.resize(nScales);
+  _shiftedProfiles.resize(nScales*pcpsize*pcpsize);
 
-  // Compute Standard Deviations
-  for (int i=0; i<pcpsize; i++) {
-    _std_profile_M += (_profile_doM[i] - _mean_profile_M) * (_profile_doM[i] - _mean_profile_M);
-    _std_profile_m += (_profile_dom[i] - _mean_profile_m) * (_profile_dom[i] - _mean_profile_m);
-    _std_profile_O += (_profile_doO[i] - _mean_profile_O) * (_profile_doO[i] - _mean_profile_O);
-  }
-
-  _std_profile_M = sqrt(_std_profile_M);
-  _std_profile_m = sqrt(_std_profile_m);
-  _std_profile_O = sqrt(_std_profile_O);
-}
+  for (int s=0; s<nScales; s++) {
+    const vector<Real>& profile = *profiles[s];
+    Real meanProfile = mean(profile);
 
-
-// correlation coefficient with 'shift'
-// on of the vectors is shifted in time, and then the correlation is calculated,
-// just like a cross-correlation
-Real Key::correlation(const vector<Real>& v1, const Real mean1, const Real std1, const vector<Real>& v2, const Real mean2, const Real std2, const int shift) const
-{
-  Real r = 0.0;
-  int size = (int)v1.size();
-
-  for (int i=0; i<size; i++)
-  {
-    int index = (i - shift) % size;
-
-    if (index < 0) {
-      index += size;
+    // Compute Standard Deviations
+    Real stdProfile = 0;
+    for (int i=0; i<pcpsize; i++) {
+      stdProfile += (profile[i] - meanProfile) * (profile[i] - meanProfile);
+    }
+    _profileNorms[s] = sqrt(stdProfile);
+
+    // one of the vectors is shifted in time, and then the correlation is
+    // calculated, so precompute all the shifted versions of the profile
+    for (int shift=0; shift<pcpsize; shift++) {
+      Real* row = &_shiftedProfiles[(s*pcpsize + shift)*pcpsize];
+      for (int i=0; i<pcpsize; i++) {
+        int index = (i - shift) % pcpsize;
+        if (index < 0) {
+          index += pcpsize;
+        }
+        row[i] = profile[index] - meanProfile;
+      }
     }
-
-    r += (v1[i] - mean1) * (v2[index] - mean2);
   }
-
-  r /= std1*std2;
-
-  return r;
 }
 
+
 /**
   Each note contribute to the different harmonics:
   1.- first  harmonic  f   -> i
@@ -693,12 +708,12 @@ void Key::reset() {
 
 void Key::normalizePcpPeak(vector<Real>& pcp) {
   normalize(pcp);
-};
+}
 
 void Key::pcpGate(vector<Real>& pcp, Real threshold) {
   for (int i = 0; i < (int)pcp.size(); i++)
     if (pcp[i] < threshold) pcp[i] = 0.f;
-};
+}
 
 void Key::shiftPcp(vector<Real>& pcp) {
   int tuningResolution = pcp.size() / 12;
@@ -717,7 +732,7 @@ void Key::shiftPcp(vector<Real>& pcp) {
   }
   
   rotate(pcp.begin(), newBegin, pcp.end());
-};
+}
 
 
 } // namespace streaming
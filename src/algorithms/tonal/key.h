@@ -63,6 +63,58 @@ class Key : public Algorithm {
   static const char* category;
   static const char* description;
 
+  // The methods below split compute() in its steps, so that MultiProfileKey
+  // can score the profiles of several Key instances in a single pass.
+
+  /**
+   * Interpolates the profiles to the given pcp size, and builds the matrix
+   * of their shifted versions (see shiftedProfiles()).
+   */
+  void resize(int size);
+
+  int pcpSize() const { return (int)_profile_doM.size(); }
+
+  /**
+   * Number of scales whose profile is correlated with the pcp (major, minor
+   * and, when useMajMin is enabled, majmin).
+   */
+  int numScales() const { return _useMajMin ? 3 : 2; }
+
+  /**
+   * Matrix of numScales()*pcpSize() rows of pcpSize() values. Row
+   * scale*pcpSize() + shift holds the mean-centered profile of the scale
+   * shifted by shift bins.
+   */
+  const std::vector<Real>& shiftedProfiles() const { return _shiftedProfiles; }
+
+  /**
+   * The norm of the mean-centered profile of each scale.
+   */
+  const std::vector<Real>& profileNorms() const { return _profileNorms; }
+
+  /**
+   * Centers the pcp around its mean, and returns the norm of the result.
+   */
+  static Real centerPcp(const std::vector<Real>& pcp, std::vector<Real>& centeredPcp);
+
+  /**
+   * Computes the correlation of a centered pcp with each row of a matrix of
+   * shifted profiles. profileNorms holds the norm of the profiles of each
+   * block of pcp-size rows.
+   */
+  static void correlate(const std::vector<Real>& centeredPcp, Real pcpNorm,
+                        const std::vector<Real>& shiftedProfiles,
+                        const std::vector<Real>& profileNorms,
+                        std::vector<Real>& correlations);
+
+  /**
+   * Estimates the key from the numScales()*pcpSize() correlations of the pcp
+   * with shiftedProfiles().
+   */
+  void estimate(const std::vector<Real>& pcp, const Real* correlations,
+                std::string& key, std::string& scale, Real& strength,
+                Real& firstToSecondRelativeStrength) const;
+
 protected:
   enum Scales {
     MAJOR  = 0,
@@ -78,13 +130,11 @@ protected:
   std::vector<Real> _profile_dom;
   std::vector<Real> _profile_doO;
 
-  Real _mean_profile_M;
-  Real _mean_profile_m;
-  Real _mean_profile_O;
+  std::vector<Real> _shiftedProfiles;
+  std::vector<Real> _profileNorms;
 
-  Real _std_profile_M;
-  Real _std_profile_m;
-  Real _std_profile_O;
+  std::vector<Real> _centeredPcp;
+  std::vector<Real> _correlations;
 
   Real _slope;
   int _numHarmonics;
@@ -93,11 +143,9 @@ protected:
   std::vector<std::string> _keys;
   bool _useMajMin;
 
-  Real correlation(const std::vector<Real>& v1, const Real mean1, const Real std1, const std::vector<Real>& v2, const Real mean2, const Real std2, const int shift) const;
   void addContributionHarmonics(const int pitchclass, const Real contribution, std::vector<Real>& M_chords) const;
   void addMajorTriad(const int root, const Real contribution, std::vector<Real>& M_chords) const;
   void addMinorTriad(int root, Real contribution, std::vector<Real>& M_chords) const;
-  void resize(int size);
 };
 
 } // namespace standard
@@ -124,12 +172,12 @@ class Key : public AlgorithmComposite {
   bool _averageDetuningCorrection;
   Real _pcpThreshold;
 
-  void normalizePcpPeak(std::vector<Real>& pcp);
-  void pcpGate(std::vector<Real>& pcp, Real threshold);
-  void shiftPcp(std::vector<Real>& pcp);
-
-
  public:
+  // preprocessing of the averaged pcp, also used by MultiProfileKey
+  static void normalizePcpPeak(std::vector<Real>& pcp);
+  static void pcpGate(std::vector<Real>& pcp, Real threshold);
+  static void shiftPcp(std::vector<Real>& pcp);
+
   Key();
   ~Key();
 
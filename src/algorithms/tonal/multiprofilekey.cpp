@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "multiprofilekey.h"
+#include "algorithmfactory.h"
+#include "essentiamath.h"
+
+using namespace std;
+
+namespace essentia {
+namespace standard {
+
+const char* MultiProfileKey::name = "MultiProfileKey";
+const char* MultiProfileKey::category = "Tonal";
+const char* MultiProfileKey::description = DOC("This algorithm computes key estimates for several types of key profiles given a pitch class profile (HPCP). It is equivalent to (and gives exactly the same values as) one Key algorithm per profile type, but the correlations of the pcp with all the shifted profiles of all the profile types are computed in a single pass, as one matrix-vector product.\n"
+"\n"
+"Outputs are created for each of the profile types in the \"profileTypes\" parameter, so that the outputs for the profile with index i are \"key_i\", \"scale_i\", \"strength_i\" and \"firstToSecondRelativeStrength_i\".\n"
+"\n"
+"As in Key, the streaming mode first accumulates a stream of HPCP vectors and computes its mean, which is then normalized, gated and corrected for detuning (see the \"pcpThreshold\" and \"averageDetuningCorrection\" parameters) once for all the profile types. The firstToSecondRelativeStrength outputs are only available in standard mode.\n"
+"\n"
+"Exceptions are thrown if the list of profile types is empty or contains an unsupported type, and for the same reasons as in Key.");
+
+
+void MultiProfileKey::clearOutputs() {
+  for (int i=0; i<(int)_keys.size(); i++) {
+    delete _keys[i];
+    delete _scales[i];
+    delete _strengths[i];
+    delete _firstToSecondRelativeStrengths[i];
+  }
+  _keys.clear();
+  _scales.clear();
+  _strengths.clear();
+  _firstToSecondRelativeStrengths.clear();
+  _outputs.clear(); // so that the outputs can be declared again
+}
+
+void MultiProfileKey::clearAlgorithms() {
+  for (int i=0; i<(int)_keyAlgos.size(); i++) delete _keyAlgos[i];
+  _keyAlgos.clear();
+}
+
+void MultiProfileKey::configure() {
+  vector<string> profileTypes = parameter("profileTypes").toVectorString();
+
+  if (profileTypes.empty()) {
+    throw EssentiaException("MultiProfileKey: the list of profile types is empty");
+  }
+
+  clearAlgorithms();
+  for (int i=0; i<(int)profileTypes.size(); i++) {
+    Algorithm* key = AlgorithmFactory::create("Key");
+    _keyAlgos.push_back(static_cast<Key*>(key));
+    key->configure(INHERIT("usePolyphony"),
+                   INHERIT("useThreeChords"),
+                   INHERIT("numHarmonics"),
+                   INHERIT("slope"),
+                   "profileType", profileTypes[i],
+                   INHERIT("pcpSize"),
+                   INHERIT("useMajMin"));
+  }
+
+  clearOutputs();
+  for (int i=0; i<(int)profileTypes.size(); i++) {
+    ostringstream index;
+    index << i;
+    string profile = " using the '" + profileTypes[i] + "' profile (profile #" + index.str() + ")";
+
+    _keys.push_back(new Output<string>());
+    declareOutput(*_keys.back(), "key_" + index.str(), "the estimated key" + profile);
+    _scales.push_back(new Output<string>());
+    declareOutput(*_scales.back(), "scale_" + index.str(), "the scale of the key" + profile);
+    _strengths.push_back(new Output<Real>());
+    declareOutput(*_strengths.back(), "strength_" + index.str(), "the strength of the estimated key" + profile);
+    _firstToSecondRelativeStrengths.push_back(new Output<Real>());
+    declareOutput(*_firstToSecondRelativeStrengths.back(), "firstToSecondRelativeStrength_" + index.str(),
+                  "the relative strength difference between the best estimate and second best estimate of the key" + profile);
+  }
+
+  stackProfiles(parameter("pcpSize").toInt());
+}
+
+void MultiProfileKey::stackProfiles(int pcpSize) {
+  _shiftedProfiles.clear();
+  _profileNorms.clear();
+
+  for (int i=0; i<(int)_keyAlgos.size(); i++) {
+    Key* key = _keyAlgos[i];
+    if (key->pcpSize() != pcpSize) key->resize(pcpSize);
+
+    _shiftedProfiles.insert(_shiftedProfiles.end(), key->shiftedProfiles().begin(), key->shiftedProfiles().end());
+    _profileNorms.insert(_profileNorms.end(), key->profileNorms().begin(), key->profileNorms().end());
+  }
+  _pcpSize = pcpSize;
+}
+
+void MultiProfileKey::compute() {
+  const vector<Real>& pcp = _pcp.get();
+
+  int pcpsize = (int)pcp.size();
+
+  if (pcpsize < 12 || pcpsize % 12 != 0) {
+    throw EssentiaException("MultiProfileKey: input PCP size is not a positive multiple of 12");
+  }
+
+  if (pcpsize != _pcpSize) {
+    stackProfiles(pcpsize);
+  }
+
+  Real pcpNorm = Key::centerPcp(pcp, _centeredPcp);
+  Key::correlate(_centeredPcp, pcpNorm, _shiftedProfiles, _profileNorms, _correlations);
+
+  const Real* correlations = &_correlations[0];
+  for (int i=0; i<(int)_keyAlgos.size(); i++) {
+    _keyAlgos[i]->estimate(pcp, correlations,
+                           _keys[i]->get(), _scales[i]->get(), _strengths[i]->get(),
+                           _firstToSecondRelativeStrengths[i]->get());
+    correlations += _keyAlgos[i]->numScales() * pcpsize;
+  }
+}
+
+} // namespace standard
+} // namespace essentia
+
+
+#include "poolstorage.h"
+#include "algorithmfactory.h"
+
+namespace essentia {
+namespace streaming {
+
+const char* MultiProfileKey::name = standard::MultiProfileKey::name;
+const char* MultiProfileKey::category = standard::MultiProfileKey::category;
+const char* MultiProfileKey::description = standard::MultiProfileKey::description;
+
+MultiProfileKey::MultiProfileKey() : AlgorithmComposite() {
+
+  _keyAlgo = standard::AlgorithmFactory::create("MultiProfileKey");
+  _poolStorage = new PoolStorage<std::vector<Real> >(&_pool, "internal.hpcp");
+
+  declareInput(_poolStorage->input("data"), 1, "pcp", "the input pitch class profile");
+}
+
+MultiProfileKey::~MultiProfileKey() {
+  clearOutputs();
+  delete _keyAlgo;
+  delete _poolStorage;
+}
+
+void MultiProfileKey::clearOutputs() {
+  for (int i=0; i<(int)_keys.size(); i++) {
+    delete _keys[i];
+    delete _scales[i];
+    delete _strengths[i];
+  }
+  _keys.clear();
+  _scales.clear();
+  _strengths.clear();
+  _outputs.clear(); // so that the outputs can be declared again
+}
+
+void MultiProfileKey::configure() {
+  _keyAlgo->configure(INHERIT("profileTypes"),
+                      INHERIT("usePolyphony"),
+                      INHERIT("useThreeChords"),
+                      INHERIT("numHarmonics"),
+                      INHERIT("slope"),
+                      INHERIT("pcpSize"),
+                      INHERIT("useMajMin"));
+
+  _averageDetuningCorrection = parameter("averageDetuningCorrection").toBool();
+  _pcpThreshold = parameter("pcpThreshold").toReal();
+
+  vector<string> profileTypes = parameter("profileTypes").toVectorString();
+
+  clearOutputs();
+  for (int i=0; i<(int)profileTypes.size(); i++) {
+    ostringstream index;
+    index << i;
+    string profile = " using the '" + profileTypes[i] + "' profile (profile #" + index.str() + ")";
+
+    _keys.push_back(new Source<string>());
+    declareOutput(*_keys.back(), 0, "key_" + index.str(), "the estimated key" + profile);
+    _scales.push_back(new Source<string>());
+    declareOutput(*_scales.back(), 0, "scale_" + index.str(), "the scale of the key" + profile);
+    _strengths.push_back(new Source<Real>());
+    declareOutput(*_strengths.back(), 0, "strength_" + index.str(), "the strength of the estimated key" + profile);
+  }
+}
+
+AlgorithmStatus MultiProfileKey::process() {
+  if (!shouldStop()) return PASS;
+
+  const vector<vector<Real> >& hpcpKey = _pool.value<vector<vector<Real> > >("internal.hpcp");
+  vector<Real> hpcpAverage = meanFrames(hpcpKey);
+
+  // same preprocessing as in the streaming Key, done only once for all the
+  // profile types
+  if (_pcpThreshold > 0.f) {
+    Key::normalizePcpPeak(hpcpAverage);
+    Key::pcpGate(hpcpAverage, _pcpThreshold);
+  }
+
+  if (_averageDetuningCorrection == true) {
+    Key::shiftPcp(hpcpAverage);
+  }
+
+  int nProfiles = (int)_keys.size();
+  vector<string> keys(nProfiles), scales(nProfiles);
+  vector<Real> strengths(nProfiles), firstToSecondRelativeStrengths(nProfiles);
+
+  _keyAlgo->input("pcp").set(hpcpAverage);
+  for (int i=0; i<nProfiles; i++) {
+    ostringstream index;
+    index << i;
+    _keyAlgo->output("key_" + index.str()).set(keys[i]);
+    _keyAlgo->output("scale_" + index.str()).set(scales[i]);
+    _keyAlgo->output("strength_" + index.str()).set(strengths[i]);
+    _keyAlgo->output("firstToSecondRelativeStrength_" + index.str()).set(firstToSecondRelativeStrengths[i]);
+  }
+  _keyAlgo->compute();
+
+  for (int i=0; i<nProfiles; i++) {
+    _keys[i]->push(keys[i]);
+    _scales[i]->push(scales[i]);
+    _strengths[i]->push(strengths[i]);
+  }
+
+  return FINISHED;
+}
+
+void MultiProfileKey::reset() {
+  AlgorithmComposite::reset();
+  _keyAlgo->reset();
+}
+
+} // namespace streaming
+} // namespace essentia
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_MULTIPROFILEKEY_H
+#define ESSENTIA_MULTIPROFILEKEY_H
+
+#include "algorithm.h"
+#include "key.h"
+
+namespace essentia {
+namespace standard {
+
+class MultiProfileKey : public Algorithm {
+
+ protected:
+  Input<std::vector<Real> > _pcp;
+
+  std::vector<Output<std::string>*> _keys;
+  std::vector<Output<std::string>*> _scales;
+  std::vector<Output<Real>*> _strengths;
+  std::vector<Output<Real>*> _firstToSecondRelativeStrengths;
+
+  std::vector<Key*> _keyAlgos;
+
+  // shifted profiles and their norms of all the Key instances, stacked
+  std::vector<Real> _shiftedProfiles;
+  std::vector<Real> _profileNorms;
+  int _pcpSize;
+
+  std::vector<Real> _centeredPcp;
+  std::vector<Real> _correlations;
+
+  void stackProfiles(int pcpSize);
+  void clearOutputs();
+  void clearAlgorithms();
+
+ public:
+  MultiProfileKey() : _pcpSize(0) {
+    declareInput(_pcp, "pcp", "the input pitch class profile");
+  }
+
+  ~MultiProfileKey() {
+    clearOutputs();
+    clearAlgorithms();
+  }
+
+  void declareParameters() {
+    const char* profileTypes[] = { "temperley", "krumhansl", "edma" };
+    declareParameter("profileTypes", "the types of polyphic profiles to use for correlation calculation (see the profileType parameter of Key)", "", arrayToVector<std::string>(profileTypes));
+    declareParameter("usePolyphony", "enables the use of polyphonic profiles to define key profiles (this includes the contributions from triads as well as pitch harmonics)", "{true,false}", true);
+    declareParameter("useThreeChords", "consider only the 3 main triad chords of the key (T, D, SD) to build the polyphonic profiles", "{true,false}", true);
+    declareParameter("numHarmonics", "number of harmonics that should contribute to the polyphonic profile (1 only considers the fundamental harmonic)", "[1,inf)", 4);
+    declareParameter("slope", "value of the slope of the exponential harmonic contribution to the polyphonic profile", "[0,inf)", 0.6);
+    declareParameter("pcpSize", "number of array elements used to represent a semitone times 12 (this parameter is only a hint, during computation, the size of the input PCP is used instead)", "[12,inf)", 36);
+    declareParameter("useMajMin", "use a third profile called 'majmin' for ambiguous tracks. Only avalable for the edma, bgate and braw profiles", "{true,false}", false);
+  }
+
+  void configure();
+  void compute();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+};
+
+} // namespace standard
+} // namespace essentia
+
+#include "streamingalgorithmcomposite.h"
+#include "pool.h"
+
+namespace essentia {
+namespace streaming {
+
+class MultiProfileKey : public AlgorithmComposite {
+ protected:
+  std::vector<Source<std::string>*> _keys;
+  std::vector<Source<std::string>*> _scales;
+  std::vector<Source<Real>*> _strengths;
+
+  Pool _pool;
+  Algorithm* _poolStorage;
+  standard::Algorithm* _keyAlgo;
+
+  bool _averageDetuningCorrection;
+  Real _pcpThreshold;
+
+  void clearOutputs();
+
+ public:
+  MultiProfileKey();
+  ~MultiProfileKey();
+
+  void declareParameters() {
+    const char* profileTypes[] = { "temperley", "krumhansl", "edma" };
+    declareParameter("profileTypes", "the types of polyphic profiles to use for correlation calculation (see the profileType parameter of Key)", "", arrayToVector<std::string>(profileTypes));
+    declareParameter("usePolyphony", "enables the use of polyphonic profiles to define key profiles (this includes the contributions from triads as well as pitch harmonics)", "{true,false}", true);
+    declareParameter("useThreeChords", "consider only the 3 main triad chords of the key (T, D, SD) to build the polyphonic profiles", "{true,false}", true);
+    declareParameter("numHarmonics", "number of harmonics that should contribute to the polyphonic profile (1 only considers the fundamental harmonic)", "[1,inf)", 4);
+    declareParameter("slope", "value of the slope of the exponential harmonic contribution to the polyphonic profile", "[0,inf)", 0.6);
+    declareParameter("pcpSize", "number of array elements used to represent a semitone times 12 (this parameter is only a hint, during computation, the size of the input PCP is used instead)", "[12,inf)", 36);
+    declareParameter("pcpThreshold", "pcp bins below this value are set to 0", "[0,1]", 0.2);
+    declareParameter("averageDetuningCorrection", "shifts a pcp to the nearest tempered bin", "{true,false}", true);
+    declareParameter("useMajMin", "use a third profile called 'majmin' for ambiguous tracks. Only avalable for the edma, bgate and braw profiles", "{true,false}", false);
+  }
+
+  void configure();
+
+  void declareProcessOrder() {
+    declareProcessStep(SingleShot(_poolStorage));
+    declareProcessStep(SingleShot(this));
+  }
+
+  AlgorithmStatus process();
+  void reset();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+};
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_MULTIPROFILEKEY_H
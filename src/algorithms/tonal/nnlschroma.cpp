@@ -20,6 +20,15 @@
 #include "nnlschroma.h"
 #include "essentiamath.h"
 
+#ifdef CPP_11
+#  include <thread>
+#  include <mutex>
+#  include <condition_variable>
+#  include <functional>
+#  include <exception>
+#  include <system_error>
+#endif
+
 using namespace std;
 using namespace essentia;
 using namespace standard;
@@ -33,6 +42,8 @@ const char* NNLSChroma::description = DOC("This algorithm extracts treble and ba
 "This code is ported from NNLS Chroma [1, 2]. To achieve similar results follow this processing chain:\n"
 "frame slicing with sample rate = 44100, frame size = 16384, hop size = 2048 -> Windowing with Hann and no normalization -> Spectrum -> LogSpectrum.\n"
 "\n"
+"Frames are processed independently, in parallel threads when possible. To process a stream of frames without accumulating the whole log-spectrogram, use FrameNNLSChroma in streaming mode.\n"
+"\n"
 "References:\n"
 "  [1] Mauch, M., & Dixon, S. (2010, August). Approximate Note Transcription\n"
 "  for the Improved Identification of Difficult Chords. In ISMIR (pp. 135-140).\n"
@@ -114,32 +125,127 @@ void NNLSChroma::configure() {
 
   for (int i = 0; i < hamwinlength; ++i) _hw[i] = _hw[i] / hamwinsum;
 
-  int tempn = nNote * _frameSize;
-
-  vector<Real> tempkernel(tempn);
-
-  logFreqMatrix(_sampleRate, _frameSize, tempkernel);
-  _kernelValue.clear();
-  _kernelFftIndex.clear();
-  _kernelNoteIndex.clear();
-  int countNonzero = 0;
-  for (int iNote = 0; iNote < nNote; ++iNote) {
-    for (int iFFT = 0; iFFT <static_cast<int>(_frameSize); ++iFFT) {
-      if (tempkernel[iFFT + _frameSize * iNote] > 0) {
-        _kernelValue.push_back(tempkernel[iFFT + _frameSize * iNote]);
-        if (tempkernel[iFFT + _frameSize * iNote] > 0) {
-            countNonzero++;
-        }
-        _kernelFftIndex.push_back(iFFT);
-        _kernelNoteIndex.push_back(iNote);				
+  _dict.assign(nNote * 84, 0.f);
+  dictionaryMatrix(_dict, _spectralShape);
+
+  // sparse columns of the dictionary, and their Gram matrix
+  _dictStart.assign(1, 0);
+  _dictBin.clear();
+  _dictValue.clear();
+  for (int iOut = 0; iOut < 84; ++iOut) {
+    for (int iNote = 0; iNote < nNote; ++iNote) {
+      if (_dict[iOut * nNote + iNote] != 0) {
+        _dictBin.push_back(iNote);
+        _dictValue.push_back(_dict[iOut * nNote + iNote]);
       }
     }
+    _dictStart.push_back(_dictBin.size());
   }
 
-  _dict.assign(nNote * 84, 0.f);
-  for (int i = 0; i < nNote * 84; ++i) _dict[i] = 0.0;
+  _gram.assign(84 * 84, 0.0);
+  for (int i = 0; i < 84; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      double g = 0;
+      for (int iNote = 0; iNote < nNote; ++iNote) {
+        g += (double)_dict[i * nNote + iNote] * _dict[j * nNote + iNote];
+      }
+      _gram[i * 84 + j] = _gram[j * 84 + i] = g;
+    }
+  }
 
-  dictionaryMatrix(_dict, _spectralShape);
+  _workspaces.clear();
+}
+
+/**
+  The threads which compute frames along with the one calling compute(). They
+  are created by the first compute() with enough frames to need them, and then
+  wait for the next one, so that short inputs (such as the batches of
+  FrameNNLSChroma) do not pay for creating threads each time.
+**/
+#ifdef CPP_11
+struct NNLSChroma::Workers {
+  // called with the index of the thread, and the number of threads
+  typedef function<void(int, int)> Task;
+
+  vector<thread> _threads;
+  mutex _mutex;
+  condition_variable _started;
+  condition_variable _finished;
+  Task _task;
+  int _active;     // number of threads taking part in the current task
+  int _running;    // number of them which have not finished it yet
+  int _generation; // incremented for each task
+  bool _stopping;
+
+  Workers() : _active(0), _running(0), _generation(0), _stopping(false) {}
+
+  ~Workers() {
+    {
+      lock_guard<mutex> lock(_mutex);
+      _stopping = true;
+    }
+    _started.notify_all();
+    for (int i = 0; i < (int)_threads.size(); ++i) _threads[i].join();
+  }
+
+  // number of threads, including the calling one
+  int size() const { return (int)_threads.size() + 1; }
+
+  // runs the task on n threads (or less if they cannot be created), and
+  // waits for all of them. The task should not throw.
+  void run(int n, const Task& task) {
+    while (size() < n) {
+      try {
+        _threads.push_back(thread(&Workers::loop, this, size()));
+      }
+      catch (system_error&) {
+        // make do with the threads we have
+        n = size();
+      }
+    }
+    n = min(n, size());
+
+    {
+      lock_guard<mutex> lock(_mutex);
+      _task = task;
+      _active = n;
+      _running = n - 1;
+      _generation++;
+    }
+    _started.notify_all();
+
+    task(0, n);
+
+    unique_lock<mutex> lock(_mutex);
+    _finished.wait(lock, [this]() { return _running == 0; });
+  }
+
+  void loop(int index) {
+    int generation = 0;
+    while (true) {
+      int n;
+      {
+        unique_lock<mutex> lock(_mutex);
+        _started.wait(lock, [&]() { return _stopping || _generation != generation; });
+        if (_stopping) return;
+        generation = _generation;
+        n = _active;
+        if (index >= n) continue;
+      }
+
+      _task(index, n);
+
+      lock_guard<mutex> lock(_mutex);
+      if (--_running == 0) _finished.notify_one();
+    }
+  }
+};
+#else
+struct NNLSChroma::Workers {};
+#endif
+
+NNLSChroma::~NNLSChroma() {
+  delete _workers;
 }
 
 void NNLSChroma::reset() {
@@ -155,29 +261,95 @@ void NNLSChroma::compute() {
   vector<vector<Real> >& bassChromagram = _bassChromagram.get();
   vector<vector<Real> >& chromagram = _chromagram.get();
 
-  if (logSpectrum.size() <= 1)
+  if (logSpectrum.empty())
     throw EssentiaException("NNLSChroma: input vector is empty");
 
-  if (logSpectrum[0].size() != 256) {
-    throw EssentiaException("NNLSChroma: log spectrum size should be 256 but it is ", 
-                            logSpectrum[0].size(), ".");
+  for (int i = 0; i < (int)logSpectrum.size(); i++) {
+    if (logSpectrum[i].size() != 256) {
+      throw EssentiaException("NNLSChroma: log spectrum size should be 256 but it is ",
+                              logSpectrum[i].size(), ".");
+    }
+  }
+
+  if (_tuningMode && localTuning.size() < logSpectrum.size()) {
+    throw EssentiaException("NNLSChroma: there should be one local tuning value per frame");
   }
 
   /**  Calculate Tuning
        calculate tuning from (using the angle of the complex number defined by the 
        cumulative mean real and imag values)
   **/
-  Real meanTuningImag = 0;
-  Real meanTuningReal = 0;
-  for (int iBPS = 0; iBPS < nBPS; ++iBPS) {
-    meanTuningReal += meanTuning[iBPS] * _cosvalues[iBPS];
-    meanTuningImag += meanTuning[iBPS] * _sinvalues[iBPS];
+  Real normalisedtuning = 0;
+  if (!_tuningMode) {
+    if ((int)meanTuning.size() < nBPS) {
+      throw EssentiaException("NNLSChroma: mean tuning size should be ", nBPS);
+    }
+    Real meanTuningImag = 0;
+    Real meanTuningReal = 0;
+    for (int iBPS = 0; iBPS < nBPS; ++iBPS) {
+      meanTuningReal += meanTuning[iBPS] * _cosvalues[iBPS];
+      meanTuningImag += meanTuning[iBPS] * _sinvalues[iBPS];
+    }
+    normalisedtuning = atan2(meanTuningImag, meanTuningReal) / (2 * M_PI);
   }
 
-  Real normalisedtuning = atan2(meanTuningImag, meanTuningReal) / (2 * M_PI);
-  int intShift = floor(normalisedtuning * 3);
-  Real RealShift = normalisedtuning * 3 - intShift; // RealShift is a really bad name for this
+  int nFrames = (int)logSpectrum.size();
+  tunedLogfreqSpectrum.resize(nFrames);
+  semitoneSpectrum.resize(nFrames);
+  bassChromagram.resize(nFrames);
+  chromagram.resize(nFrames);
+
+  // frames are independent, and the result of each one only depends on it:
+  // split them in contiguous blocks that are processed in parallel, each with
+  // its own workspace
+  int nThreads = 1;
+#ifdef CPP_11
+  const int minFramesPerThread = 8;
+  nThreads = max(1, min((int)thread::hardware_concurrency(), nFrames / minFramesPerThread));
+#endif
+  if ((int)_workspaces.size() < nThreads) _workspaces.resize(nThreads);
+
+  if (nThreads == 1) {
+    computeFrames(0, nFrames, normalisedtuning, _workspaces[0]);
+    return;
+  }
 
+#ifdef CPP_11
+  if (!_workers) _workers = new Workers();
+
+  vector<exception_ptr> errors(nThreads);
+  _workers->run(nThreads, [&](int t, int n) {
+    int begin = (int)((long)nFrames * t / n);
+    int end = (int)((long)nFrames * (t+1) / n);
+    try {
+      computeFrames(begin, end, normalisedtuning, _workspaces[t]);
+    }
+    catch (...) {
+      errors[t] = current_exception();
+    }
+  });
+  for (int t = 0; t < nThreads; ++t) {
+    if (errors[t]) rethrow_exception(errors[t]);
+  }
+#endif
+}
+
+void NNLSChroma::computeFrames(int begin, int end, Real normalisedTuning, Workspace& ws) {
+  const vector<Real>& localTuning = _localTuning.get();
+  for (int i = begin; i < end; i++) {
+    computeFrame(i, _tuningMode ? localTuning[i] : normalisedTuning, ws);
+  }
+}
+
+void NNLSChroma::computeFrame(int i, Real normalisedTuning, Workspace& ws) {
+  const vector<Real>& logSpectrum = _logSpectrum.get()[i];
+  vector<Real>& tunedLogfreqSpectrum = _tunedLogfreqSpectrum.get()[i];
+  vector<Real>& semitoneSpectrum = _semitoneSpectrum.get()[i];
+  vector<Real>& bassChromagram = _bassChromagram.get()[i];
+  vector<Real>& chromagram = _chromagram.get()[i];
+
+  int intShift = floor(normalisedTuning * 3.f);
+  Real RealShift = normalisedTuning * 3.f - intShift; // RealShift is a really bad name for this
 
   /** Tune Log-Frequency Spectrogram
       calculate a tuned log-frequency spectrogram (tunedLogfreqSpectrum): use the tuning estimated above (kinda f0) to 
@@ -185,46 +357,41 @@ void NNLSChroma::compute() {
   **/   
   Real tempValue = 0;
 
-  tunedLogfreqSpectrum.assign(logSpectrum.size(), vector<Real>(2, 0.f));
-  
-  for (int i = 0; i < (int)logSpectrum.size(); i++) {
-    if (_tuningMode) {
-        intShift = floor(localTuning[i] * 3.f);
-        RealShift = localTuning[i] * 3.f - intShift; // RealShift is a really bad name for this
-    }
-        
-    // Interpolate all inner bins.
-    for (int k = 2; k < (int)logSpectrum[i].size() - 3; ++k) {
-      tempValue = logSpectrum[i][k + intShift] * (1 - RealShift) +
-                  logSpectrum[i][k + intShift + 1] * RealShift;
-      tunedLogfreqSpectrum[i].push_back(tempValue);
-    }
+  tunedLogfreqSpectrum.assign(2, 0.f);
 
-    tunedLogfreqSpectrum[i].push_back(0.0);
-    tunedLogfreqSpectrum[i].push_back(0.0);
-    tunedLogfreqSpectrum[i].push_back(0.0);  // upper edge
+  // Interpolate all inner bins.
+  for (int k = 2; k < (int)logSpectrum.size() - 3; ++k) {
+    tempValue = logSpectrum[k + intShift] * (1 - RealShift) +
+                logSpectrum[k + intShift + 1] * RealShift;
+    tunedLogfreqSpectrum.push_back(tempValue);
+  }
 
-    vector<Real> runningmean = SpecialConvolution(tunedLogfreqSpectrum[i], _hw);
-    vector<Real> runningstd;
+  tunedLogfreqSpectrum.push_back(0.0);
+  tunedLogfreqSpectrum.push_back(0.0);
+  tunedLogfreqSpectrum.push_back(0.0);  // upper edge
 
-    // First step: squared values into vector (variance).
-    for (int j = 0; j < nNote; j++) {
-      runningstd.push_back((tunedLogfreqSpectrum[i][j] - runningmean[j]) *
-                           (tunedLogfreqSpectrum[i][j] - runningmean[j]));
-    }
+  vector<Real>& runningmean = ws.runningmean;
+  vector<Real>& runningstd = ws.runningstd;
+  SpecialConvolution(tunedLogfreqSpectrum, _hw, runningmean);
 
-    // Second step: convolve.
-    runningstd = SpecialConvolution(runningstd, _hw);
+  // First step: squared values into vector (variance).
+  ws.b.resize(nNote);
+  for (int j = 0; j < nNote; j++) {
+    ws.b[j] = (tunedLogfreqSpectrum[j] - runningmean[j]) *
+              (tunedLogfreqSpectrum[j] - runningmean[j]);
+  }
 
-    for (int j = 0; j < nNote; j++) {  
-      runningstd[j] = sqrt(runningstd[j]); // square root to finally have running std
-      if (runningstd[j] > 0) {
-        tunedLogfreqSpectrum[i][j] = (tunedLogfreqSpectrum[i][j] - runningmean[j]) > 0 ?
-          (tunedLogfreqSpectrum[i][j] - runningmean[j]) / pow(runningstd[j], _whitening) : 0;
-      }
-      if (tunedLogfreqSpectrum[i][j] < 0) {
-        throw EssentiaException("ERROR: negative value in log-frequency spectrum");
-      }
+  // Second step: convolve.
+  SpecialConvolution(ws.b, _hw, runningstd);
+
+  for (int j = 0; j < nNote; j++) {  
+    runningstd[j] = sqrt(runningstd[j]); // square root to finally have running std
+    if (runningstd[j] > 0) {
+      tunedLogfreqSpectrum[j] = (tunedLogfreqSpectrum[j] - runningmean[j]) > 0 ?
+        (tunedLogfreqSpectrum[j] - runningmean[j]) / pow(runningstd[j], _whitening) : 0;
+    }
+    if (tunedLogfreqSpectrum[j] < 0) {
+      throw EssentiaException("ERROR: negative value in log-frequency spectrum");
     }
   }
 
@@ -235,153 +402,331 @@ void NNLSChroma::compute() {
       Three different kinds of chromagram are calculated, "treble", "bass", and "both" (which 
       means bass and treble stacked onto each other).
   **/
-  semitoneSpectrum.assign(logSpectrum.size(), vector<Real>());
-  chromagram.assign(logSpectrum.size(), vector<Real>());
-  bassChromagram.assign(logSpectrum.size(), vector<Real>());
+  const vector<Real>& b = tunedLogfreqSpectrum;
 
-  for (int i = 0; i < (int)logSpectrum.size(); i++) {
-    Real b[nNote];
+  bool some_b_greater_zero = false;
+  for (int j = 0; j < nNote; j++) {
+    if (b[j] > 0) {
+      some_b_greater_zero = true;
+      break;
+    }
+  }
 
-    bool some_b_greater_zero = false;
-    Real sumb = 0;
+  // Here's where the non-negative least squares algorithm calculates the note
+  // activation x.
+  vector<Real>& chroma = chromagram;
+  vector<Real>& basschroma = bassChromagram;
+  chroma.assign(12, 0);
+  basschroma.assign(12, 0);
+  semitoneSpectrum.clear();
+  Real currval;
+  int iSemitone = 0;
+
+  if (some_b_greater_zero) {
+    if (!_useNNLS) {
+      for (int iNote = nBPS / 2 + 2; iNote < nNote - nBPS / 2;
+           iNote += nBPS) {
+        currval = 0;
+        for (int iBPS = -nBPS / 2; iBPS < nBPS / 2 + 1; ++iBPS) {
+          currval += b[iNote + iBPS] * (1 - abs(iBPS * 1.0 / (nBPS / 2 + 1)));
+        }
 
-    for (int j = 0; j < nNote; j++) {
-      b[j] = tunedLogfreqSpectrum[i][j];
-      sumb += b[j];
-      if (b[j] > 0) {
-        some_b_greater_zero = true;
+        semitoneSpectrum.push_back(currval);
+        chroma[iSemitone % 12] += currval * treblewindow[iSemitone];
+        basschroma[iSemitone % 12] += currval * basswindow[iSemitone];
+        iSemitone++;
       }
     }
 
-    // Here's where the non-negative least squares algorithm calculates the note
-    // activation x.
-    vector<Real> chroma = vector<Real>(12, 0);
-    vector<Real> basschroma = vector<Real>(12, 0);
-    Real currval;
-    int iSemitone = 0;
-
-    if (some_b_greater_zero) {
-      if (!_useNNLS) {
-        for (int iNote = nBPS / 2 + 2; iNote < nNote - nBPS / 2;
-             iNote += nBPS) {
-          currval = 0;
-          for (int iBPS = -nBPS / 2; iBPS < nBPS / 2 + 1; ++iBPS) {
-            currval += b[iNote + iBPS] * (1 - abs(iBPS * 1.0 / (nBPS / 2 + 1)));
-          }
-
-          semitoneSpectrum[i].push_back(currval);
-          chroma[iSemitone % 12] += currval * treblewindow[iSemitone];
-          basschroma[iSemitone % 12] += currval * basswindow[iSemitone];
-          iSemitone++;
+    else {
+      vector<int>& signifIndex = ws.signifIndex;
+      signifIndex.clear();
+      int index = 0;
+
+      for (int iNote = nBPS / 2 + 2; iNote < nNote - nBPS / 2;
+           iNote += nBPS) {
+        Real currval = 0.f;
+        for (int iBPS = -nBPS / 2; iBPS < nBPS / 2 + 1; ++iBPS) {
+          currval += b[iNote + iBPS];
         }
+        if (currval > 0.f) signifIndex.push_back(index);
+        semitoneSpectrum.push_back(0.f);  // fill the values, change later
+        index++;
       }
 
-      else {
-        Real x[84 + 1000];
-        for (int j = 1; j < 1084; ++j){
-          x[j] = 1.0;
-        } 
-
-        vector<int> signifIndex;
-        int index = 0;
-        sumb /= 84.0;
-
-        for (int iNote = nBPS / 2 + 2; iNote < nNote - nBPS / 2;
-             iNote += nBPS) {
-          Real currval = 0.f;
-          for (int iBPS = -nBPS / 2; iBPS < nBPS / 2 + 1; ++iBPS) {
-            currval += b[iNote + iBPS];
-          }
-          if (currval > 0.f) signifIndex.push_back(index);
-          semitoneSpectrum[i].push_back(0.f);  // fill the values, change later
-          index++;
-        }
-        Real rnorm;
-        Real w[84 + 1000];
-        Real zz[84 + 1000];
-        int indx[84 + 1000];
-        int mode;
-        int dictsize = nNote * signifIndex.size();
-        Real* curr_dict = new Real[dictsize];
-        for (int iNote = 0; iNote < (int)signifIndex.size(); ++iNote) {
-          for (int iBin = 0; iBin < nNote; iBin++) {
-            curr_dict[iNote * nNote + iBin] =
-                1.0 * _dict[signifIndex[iNote] * nNote + iBin];
-          }
-        }
+      solveNNLS(b, ws);
 
-        nnls(curr_dict, nNote, nNote, signifIndex.size(), b, x, &rnorm, w, zz,
-             indx, &mode);
-        delete[] curr_dict;
+      for (int iNote = 0; iNote < (int)signifIndex.size(); ++iNote) {
+        Real x = ws.x[signifIndex[iNote]];
+        semitoneSpectrum[signifIndex[iNote]] = x;
+        chroma[signifIndex[iNote] % 12] += x * treblewindow[signifIndex[iNote]];
+        basschroma[signifIndex[iNote] % 12] += x * basswindow[signifIndex[iNote]];
+      }
+    }
+  }
+
+  else {
+    semitoneSpectrum.assign(84, 0);
+  }
 
-        for (int iNote = 0; iNote < (int)signifIndex.size(); ++iNote) {
-          semitoneSpectrum[i][signifIndex[iNote]] = x[iNote];
-          chroma[signifIndex[iNote] % 12] +=
-              x[iNote] * treblewindow[signifIndex[iNote]];
-          basschroma[signifIndex[iNote] % 12] +=
-              x[iNote] * basswindow[signifIndex[iNote]];
+  if (_doNormalizeChroma > 0) {
+    Real chromanorm[3] = {0, 0, 0};
+
+    switch (_doNormalizeChroma) {
+      case 0:  // should never end up here
+        break;
+      case 1:
+        chromanorm[0] = *max_element(chromagram.begin(), chromagram.end());
+        chromanorm[1] = *max_element(bassChromagram.begin(), bassChromagram.end());
+        chromanorm[2] = max(chromanorm[0], chromanorm[1]);
+        break;
+      case 2:
+        for (vector<Real>::iterator it = chromagram.begin();
+             it != chromagram.end(); ++it) {
+          chromanorm[0] += *it;
         }
+        for (vector<Real>::iterator it = bassChromagram.begin();
+             it != bassChromagram.end(); ++it) {
+          chromanorm[1] += *it;
+        }
+        break;
+      case 3:
+        for (vector<Real>::iterator it = chromagram.begin();
+             it != chromagram.end(); ++it) {
+          chromanorm[0] += pow(*it, 2);
+        }
+        chromanorm[0] = sqrt(chromanorm[0]);
+        for (vector<Real>::iterator it = bassChromagram.begin();
+             it != bassChromagram.end(); ++it) {
+          chromanorm[1] += pow(*it, 2);
+        }
+        chromanorm[1] = sqrt(chromanorm[1]);
+        chromanorm[2] = sqrt(chromanorm[2]);
+        break;
+    }
+    if (chromanorm[0] > 0) {
+      for (int j = 0; j < (int)chromagram.size(); j++) {
+        chromagram[j] /= chromanorm[0];
       }
     }
+    if (chromanorm[1] > 0) {
+      for (int j = 0; j < (int)bassChromagram.size(); j++) {
+        bassChromagram[j] /= chromanorm[1];
+      }
+    }
+  }
+}
+
+
+void NNLSChroma::Workspace::reset() {
+  significant.assign(84, 0);
+  passive.assign(84, 0);
+  atb.assign(84, 0.0);
+  x.assign(84, 0.0);
+  z.assign(84, 0.0);
+  cholesky.assign(84 * 84, 0.0);
+}
+
+/**
+  Computes the note activations ws.x of the significant notes (ws.signifIndex)
+  that best explain the tuned spectrum b, under the constraint that they are
+  non-negative.
+  This is the active set algorithm of Lawson and Hanson, written in terms of
+  the normal equations as suggested by Bro and De Jong [*]: the Gram matrix of
+  the dictionary is computed once at configure time, and each iteration only
+  solves a small system for the notes of the passive set. Instead of starting
+  from an empty passive set, the solver starts from the notes which are
+  positively correlated with the spectrum, and removes the ones which do not
+  belong to the solution.
+  If this fails for numerical reasons, the original Lawson and Hanson solver
+  is used instead.
+
+  [*] Bro, R., & De Jong, S. (1997). A fast non-negativity-constrained least
+  squares algorithm. Journal of Chemometrics, 11(5), 393-401.
+**/
+void NNLSChroma::solveNNLS(const vector<Real>& b, Workspace& ws) {
+  if (ws.x.empty()) ws.reset();
+
+  const vector<int>& signifIndex = ws.signifIndex;
+  int nSignif = (int)signifIndex.size();
+
+  fill(ws.significant.begin(), ws.significant.end(), 0);
+  for (int iNote = 0; iNote < nSignif; ++iNote) {
+    int k = signifIndex[iNote];
+    ws.significant[k] = 1;
+    double atb = 0;
+    for (int e = _dictStart[k]; e < _dictStart[k+1]; ++e) {
+      atb += (double)_dictValue[e] * b[_dictBin[e]];
+    }
+    ws.atb[k] = atb;
+  }
+
+  if (activeSetNNLS(ws)) return;
+
+  // fallback: Lawson and Hanson's solver on the significant columns of the
+  // dictionary, which it needs as a dense matrix
+  ws.currDict.resize(nNote * max(nSignif, 1));
+  for (int iNote = 0; iNote < nSignif; ++iNote) {
+    copy(_dict.begin() + signifIndex[iNote] * nNote,
+         _dict.begin() + (signifIndex[iNote] + 1) * nNote,
+         ws.currDict.begin() + iNote * nNote);
+  }
+  // nnls overwrites b
+  vector<Real> bCopy(b.begin(), b.begin() + nNote);
+  ws.nnlsX.assign(84, 0.f);
+  ws.nnlsW.resize(84);
+  ws.nnlsZz.resize(nNote);
+  ws.nnlsIndex.resize(84);
+  Real rnorm;
+  int mode;
+  nnls(&ws.currDict[0], nNote, nNote, nSignif, &bCopy[0], &ws.nnlsX[0], &rnorm,
+       &ws.nnlsW[0], &ws.nnlsZz[0], &ws.nnlsIndex[0], &mode);
+
+  fill(ws.x.begin(), ws.x.end(), 0.0);
+  fill(ws.passive.begin(), ws.passive.end(), 0);
+  for (int iNote = 0; iNote < nSignif; ++iNote) {
+    ws.x[signifIndex[iNote]] = ws.nnlsX[iNote];
+    ws.passive[signifIndex[iNote]] = ws.nnlsX[iNote] > 0;
+  }
+}
+
+bool NNLSChroma::activeSetNNLS(Workspace& ws) {
+  const vector<int>& signifIndex = ws.signifIndex;
+  int nSignif = (int)signifIndex.size();
+
+  double maxAtb = 0;
+  for (int iNote = 0; iNote < nSignif; ++iNote) {
+    maxAtb = max(maxAtb, ws.atb[signifIndex[iNote]]);
+  }
+  fill(ws.x.begin(), ws.x.end(), 0.0);
+  ws.passiveIndex.clear();
+  if (maxAtb <= 0) {
+    // x = 0 satisfies the optimality conditions
+    fill(ws.passive.begin(), ws.passive.end(), 0);
+    return true;
+  }
+  const double tolerance = 1e-9 * maxAtb;
+
+  // warm start from the notes which are positively correlated with the
+  // spectrum. This guess only depends on the frame, so that the solution does
+  // not depend on the order in which the frames are processed.
+  bool warmStart = false;
+  fill(ws.passive.begin(), ws.passive.end(), 0);
+  for (int iNote = 0; iNote < nSignif; ++iNote) {
+    int k = signifIndex[iNote];
+    ws.passive[k] = ws.atb[k] > tolerance;
+    warmStart = warmStart || ws.passive[k];
+  }
 
+  int maxIterations = 3 * nSignif + 10;
+  for (int iteration = 0; ; ++iteration) {
+    if (warmStart) {
+      warmStart = false;
+    }
     else {
-      for (int j = 0; j < 84; ++j) semitoneSpectrum[i].push_back(0);
+      // add the note with the largest gradient to the passive set, if any
+      int best = -1;
+      double bestGradient = tolerance;
+      for (int iNote = 0; iNote < nSignif; ++iNote) {
+        int k = signifIndex[iNote];
+        if (ws.passive[k]) continue;
+        double gradient = ws.atb[k];
+        const double* gram = &_gram[k * 84];
+        for (int j = 0; j < (int)ws.passiveIndex.size(); ++j) {
+          gradient -= gram[ws.passiveIndex[j]] * ws.x[ws.passiveIndex[j]];
+        }
+        if (gradient > bestGradient) {
+          bestGradient = gradient;
+          best = k;
+        }
+      }
+      if (best < 0) return true;
+      if (iteration > maxIterations) return false;
+      ws.passive[best] = 1;
     }
 
-    chromagram[i] = chroma;
-    bassChromagram[i] = basschroma;
-
-    if (_doNormalizeChroma > 0) {
-      vector<Real> chromanorm = vector<Real>(3, 0);
-
-      switch (_doNormalizeChroma) {
-        case 0:  // should never end up here
-          break;
-        case 1:
-          chromanorm[0] =
-              *max_element(chromagram[i].begin(), chromagram[i].end());
-          chromanorm[1] =
-              *max_element(bassChromagram[i].begin(), bassChromagram[i].end());
-          chromanorm[2] = max(chromanorm[0], chromanorm[1]);
-          break;
-        case 2:
-          for (vector<Real>::iterator it = chromagram[i].begin();
-               it != chromagram[i].end(); ++it) {
-            chromanorm[0] += *it;
-          }
-          for (vector<Real>::iterator it = bassChromagram[i].begin();
-               it != bassChromagram[i].end(); ++it) {
-            chromanorm[1] += *it;
-          }
-          break;
-        case 3:
-          for (vector<Real>::iterator it = chromagram[i].begin();
-               it != chromagram[i].end(); ++it) {
-            chromanorm[0] += pow(*it, 2);
+    // solve for the passive set, moving back towards the feasible region and
+    // removing notes from the passive set as long as the solution has
+    // non-positive values
+    while (true) {
+      if (!solvePassiveSet(ws)) return false;
+
+      double alpha = 1;
+      int limiting = -1;
+      for (int j = 0; j < (int)ws.passiveIndex.size(); ++j) {
+        int k = ws.passiveIndex[j];
+        if (ws.z[k] <= 0) {
+          double a = ws.x[k] <= 0 ? 0 : ws.x[k] / (ws.x[k] - ws.z[k]);
+          if (a < alpha || limiting < 0) {
+            alpha = a;
+            limiting = k;
           }
-          chromanorm[0] = sqrt(chromanorm[0]);
-          for (vector<Real>::iterator it = bassChromagram[i].begin();
-               it != bassChromagram[i].end(); ++it) {
-            chromanorm[1] += pow(*it, 2);
-          }
-          chromanorm[1] = sqrt(chromanorm[1]);
-          chromanorm[2] = sqrt(chromanorm[2]);
-          break;
+        }
       }
-      if (chromanorm[0] > 0) {
-        for (int j = 0; j < (int)chromagram[i].size(); j++) {
-          chromagram[i][j] /= chromanorm[0];
+
+      if (limiting < 0) {
+        for (int j = 0; j < (int)ws.passiveIndex.size(); ++j) {
+          ws.x[ws.passiveIndex[j]] = ws.z[ws.passiveIndex[j]];
         }
+        break;
       }
-      if (chromanorm[1] > 0) {
-        for (int j = 0; j < (int)bassChromagram[i].size(); j++) {
-          bassChromagram[i][j] /= chromanorm[1];
+
+      for (int j = 0; j < (int)ws.passiveIndex.size(); ++j) {
+        int k = ws.passiveIndex[j];
+        ws.x[k] += alpha * (ws.z[k] - ws.x[k]);
+        // notes which were already at zero (warm start) only leave the
+        // passive set if they would become negative
+        if (k == limiting || (ws.x[k] <= 0 && ws.z[k] <= 0)) {
+          ws.x[k] = 0;
+          ws.passive[k] = 0;
         }
       }
     }
   }
 }
 
+/**
+  Solves the normal equations restricted to the passive set (in ws.z), using
+  the Cholesky decomposition of the corresponding block of the Gram matrix.
+  Returns false if the block is not positive definite.
+**/
+bool NNLSChroma::solvePassiveSet(Workspace& ws) {
+  vector<int>& p = ws.passiveIndex;
+  p.clear();
+  for (int k = 0; k < 84; ++k) {
+    if (ws.passive[k]) p.push_back(k);
+  }
+  int n = (int)p.size();
+  double* L = &ws.cholesky[0];
+
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      double sum = _gram[p[i] * 84 + p[j]];
+      for (int k = 0; k < j; ++k) sum -= L[i * 84 + k] * L[j * 84 + k];
+      if (i == j) {
+        if (sum <= 1e-12 * _gram[p[i] * 84 + p[i]]) return false;
+        L[i * 84 + i] = sqrt(sum);
+      }
+      else {
+        L[i * 84 + j] = sum / L[j * 84 + j];
+      }
+    }
+  }
+
+  // forward and back substitution, using z[p[i]] as temporary storage
+  for (int i = 0; i < n; ++i) {
+    double sum = ws.atb[p[i]];
+    for (int k = 0; k < i; ++k) sum -= L[i * 84 + k] * ws.z[p[k]];
+    ws.z[p[i]] = sum / L[i * 84 + i];
+  }
+  for (int i = n - 1; i >= 0; --i) {
+    double sum = ws.z[p[i]];
+    for (int k = i + 1; k < n; ++k) sum -= L[k * 84 + i] * ws.z[p[k]];
+    ws.z[p[i]] = sum / L[i * 84 + i];
+  }
+  return true;
+}
+
 
 /** Special Convolution
     Special convolution is as long as the convolvee, i.e. the first argument. 
@@ -390,13 +735,13 @@ void NNLSChroma::compute() {
   	calculated using zero padding simply have the same values as the first 
   	(last) valid convolution bin.
 **/
-vector<Real> NNLSChroma::SpecialConvolution(vector<Real> convolvee, vector<Real> kernel) {
+void NNLSChroma::SpecialConvolution(const vector<Real>& convolvee, const vector<Real>& kernel, vector<Real>& Z) {
   Real s;
   int m, n;
   int lenConvolvee = convolvee.size();
   int lenKernel = kernel.size();
 
-  vector<Real> Z(nNote, 0);
+  Z.assign(nNote, 0);
   assert(lenKernel % 2 != 0);  // no exception handling !!!
 
   for (n = lenKernel - 1; n < lenConvolvee; n++) {
@@ -414,86 +759,6 @@ vector<Real> NNLSChroma::SpecialConvolution(vector<Real> convolvee, vector<Real>
   for (n = lenConvolvee; n < lenConvolvee + lenKernel / 2; n++) {
     Z[n - lenKernel / 2] = Z[lenConvolvee - lenKernel / 2 - 1];
   }  
-  return Z;
-}
-
-
-/**
-  Calculates a matrix that can be used to linearly map from the magnitude spectrum to a pitch-scale spectrum.
-  return this always returns true, which is a bit stupid, really. The main purpose of the function is to change the values in the "matrix" pointed to by *outmatrix
-*/
-bool NNLSChroma::logFreqMatrix(Real fs, int frameSize, vector<Real> outmatrix) {
-  // TODO: rewrite so that everyone understands what is done here.
-  // TODO: make this more general, such that it works with all minoctave,
-  // maxoctave and whatever nBPS (or check if it already does)
-
-  int binspersemitone = nBPS;
-  int minoctave = 0;  // this must be 0
-  int maxoctave = 7;  // this must be 7
-  int oversampling = 80;
-
-  // Linear frequency vector.
-  vector<Real> fft_f;
-  for (int i = 0; i < frameSize; ++i) {
-    fft_f.push_back(i * (fs * 1.0 / ((frameSize - 1.f) * 2.f)));
-  }
-
-  Real fft_width = fs / (frameSize - 1.f);
-
-  // Linear oversampled frequency vector.
-  vector<Real> oversampled_f;
-  for (int i = 0; i < oversampling * frameSize; ++i) {
-    oversampled_f.push_back(
-        i * ((fs * 1.0 / ((frameSize - 1.f) * 2.f)) / oversampling));
-  }
-
-  // Pitch-spaced frequency vector.
-  int minMIDI =
-      21 + minoctave * 12 - 1;        // this includes one additional semitone!
-  int maxMIDI = 21 + maxoctave * 12;  // this includes one additional semitone!
-  vector<Real> cq_f;
-  Real oob = 1.0 / binspersemitone;  // one over binspersemitone
-  for (int i = minMIDI; i < maxMIDI; ++i) {
-    for (int k = 0; k < binspersemitone; ++k) {
-      cq_f.push_back(440 * pow(2.0, 0.083333333333 * (i + oob * k - 69)));
-    }
-  }
-  cq_f.push_back(440 * pow(2.0, 0.083333 * (maxMIDI - 69)));
-
-  int nFFT = fft_f.size();
-
-  vector<Real> fft_activation;
-  for (int iOS = 0; iOS < 2 * oversampling; ++iOS) {
-    Real cosp = cospuls(oversampled_f[iOS], fft_f[1], fft_width);
-    fft_activation.push_back(cosp);
-  }
-
-  for (int i = 0; i < nFFT * (int)cq_f.size(); ++i) {
-    outmatrix[i] = 0.f;
-  }
-
-  Real cq_activation;
-  for (int iFFT = 1; iFFT < nFFT; ++iFFT) {
-    // Find frequency stretch where the oversampled vector can be non-zero
-    // (i.e. in a window of width fft_width around the current frequency)
-    int curr_start = oversampling * iFFT - oversampling;
-    int curr_end = oversampling * iFFT +
-                   oversampling;  // don't know if I should add "+1" here
-    // oversampled_f[curr_end] << endl;
-    for (int iCQ = 0; iCQ < (int)cq_f.size(); ++iCQ) {
-      if (cq_f[iCQ] * pow(2.0, 0.084) + fft_width > fft_f[iFFT] &&
-          cq_f[iCQ] * pow(2.0, -0.084 * 2) - fft_width < fft_f[iFFT]) {
-        // within a generous neighbourhood
-        for (int iOS = curr_start; iOS < curr_end; ++iOS) {
-          cq_activation =
-              pitchCospuls(oversampled_f[iOS], cq_f[iCQ], binspersemitone * 12);
-          outmatrix[iFFT + nFFT * iCQ] +=
-              cq_activation * fft_activation[iOS - curr_start];
-        }
-      }
-    }
-  }
-  return true;
 }
 
 
@@ -505,23 +770,7 @@ Real NNLSChroma::cospuls(Real x, Real centre, Real width) {
   return 0.0;
 }
 
-Real NNLSChroma::pitchCospuls(Real x, Real centre, int binsperoctave) {
-  Real warpedf = -binsperoctave * (log2(centre) - log2(x));
-  Real out = cospuls(warpedf, 0.0, 2.0);
-
-  // Now scale to correct for note density.
-  Real c = log(2.0)/binsperoctave;
-  if (x > 0) {
-    out = out / (c * x);
-  } 
-  else {
-    out = 0;
-  }
-
-  return out;
-}
-
-void NNLSChroma::dictionaryMatrix(vector<Real> dm, Real s_param) {
+void NNLSChroma::dictionaryMatrix(vector<Real>& dm, Real s_param) {
   // TODO: make this more general, such that it works with all minoctave,
   // maxoctave and even more than one note per semitone
   int binspersemitone = nBPS;
@@ -547,7 +796,7 @@ void NNLSChroma::dictionaryMatrix(vector<Real> dm, Real s_param) {
   for (int iOut = 0; iOut < 12 * (maxoctave - minoctave); ++iOut) {
     for (int iHarm = 1; iHarm <= 20; ++iHarm) {
       Realbin = ((iOut + 1) * binspersemitone + 1) +
-                binspersemitone * 12 * log2(iHarm);
+                binspersemitone * 12 * log2((Real)iHarm);
       curr_amp = pow(s_param, Real(iHarm - 1));
       for (int iNote = 0; iNote < nNote; ++iNote) {
         if (abs(iNote + 1.0 - Realbin) < 2) {
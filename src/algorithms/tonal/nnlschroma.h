@@ -39,7 +39,7 @@ class NNLSChroma : public Algorithm {
   Output<std::vector<std::vector<Real> > > _chromagram;
 
  public:
-  NNLSChroma() {
+  NNLSChroma() : _workers(0) {
     declareInput(_logSpectrum, "logSpectrogram", "log spectrum frames");
     declareInput(_meanTuning, "meanTuning", "mean tuning frames");
     declareInput(_localTuning, "localTuning", "local tuning frames");
@@ -59,6 +59,8 @@ class NNLSChroma : public Algorithm {
     declareParameter("chromaNormalization", "determines whether or how the chromagrams are normalised", "{none,maximum,L1,L2}", "none");
   }
 
+  ~NNLSChroma();
+
   void configure();
   void compute();
   void reset();
@@ -76,19 +78,57 @@ class NNLSChroma : public Algorithm {
   Real _sampleRate;
   Real _whitening;
   Real _spectralShape;
-  std::vector<int> _kernelFftIndex;
-  std::vector<int> _kernelNoteIndex;
-  std::vector<Real> _kernelValue;
   std::vector<Real> _hw;
   std::vector<Real> _sinvalues;
   std::vector<Real> _cosvalues;
   std::vector<Real> _dict;
 
-  bool logFreqMatrix(Real fs, int frameSize, std::vector<Real> outmatrix);
+  // sparse columns of the dictionary and their Gram matrix, used by the NNLS
+  // solver so that the dictionary does not have to be copied for each frame
+  std::vector<int> _dictStart;
+  std::vector<int> _dictBin;
+  std::vector<Real> _dictValue;
+  std::vector<double> _gram;
+
+  /**
+   * Buffers used to process a frame, so that they are not allocated for
+   * each one.
+   */
+  struct Workspace {
+    std::vector<int> signifIndex;
+    std::vector<char> significant;
+    std::vector<char> passive;
+    std::vector<int> passiveIndex;
+    std::vector<double> atb;
+    std::vector<double> x;
+    std::vector<double> z;
+    std::vector<double> cholesky;
+    std::vector<Real> runningmean;
+    std::vector<Real> runningstd;
+    // for the fallback solver
+    std::vector<Real> currDict;
+    std::vector<Real> b;
+    std::vector<Real> nnlsX;
+    std::vector<Real> nnlsW;
+    std::vector<Real> nnlsZz;
+    std::vector<int> nnlsIndex;
+
+    void reset();
+  };
+  std::vector<Workspace> _workspaces;
+
+  // threads computing frames along with the one calling compute()
+  struct Workers;
+  Workers* _workers;
+
+  void computeFrames(int begin, int end, Real normalisedTuning, Workspace& ws);
+  void computeFrame(int i, Real normalisedTuning, Workspace& ws);
+  void solveNNLS(const std::vector<Real>& b, Workspace& ws);
+  bool activeSetNNLS(Workspace& ws);
+  bool solvePassiveSet(Workspace& ws);
   Real cospuls(Real x, Real centre, Real width);
-  Real pitchCospuls(Real x, Real centre, int binsperoctave);
-  std::vector<Real> SpecialConvolution(std::vector<Real> convolvee, std::vector<Real> kernel);
-  void dictionaryMatrix(std::vector<Real> dm, Real s_param);
+  void SpecialConvolution(const std::vector<Real>& convolvee, const std::vector<Real>& kernel, std::vector<Real>& Z);
+  void dictionaryMatrix(std::vector<Real>& dm, Real s_param);
 
 };
 
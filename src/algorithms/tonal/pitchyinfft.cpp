@@ -78,6 +78,17 @@ void PitchYinFFT::configure() {
                         "minPosition", _tauMin,
                         "maxPosition", _tauMax,
                         "orderBy", "amplitude");
+
+  // set temp ports here as they are not gonna change between consecutive
+  // calls to compute()
+  _fft->input("frame").set(_sqrMag);
+  _fft->output("fft").set(_frameFFT);
+  _cart2polar->input("complex").set(_frameFFT);
+  _cart2polar->output("magnitude").set(_resNorm);
+  _cart2polar->output("phase").set(_resPhase);
+  _peakDetect->input("array").set(_yin);
+  _peakDetect->output("positions").set(_positions);
+  _peakDetect->output("amplitudes").set(_amplitudes);
 }
 
 void PitchYinFFT::spectralWeights() {
@@ -126,15 +137,6 @@ void PitchYinFFT::compute() {
 
   // build modified squared difference function using a weighted
   // input norm spectrum
-  vector<complex<Real> > frameFFT;
-  _fft->input("frame").set(_sqrMag);
-  _fft->output("fft").set(frameFFT);
-
-  // used to get phase and norm
-  _cart2polar->input("complex").set(frameFFT);
-  _cart2polar->output("magnitude").set(_resNorm);
-  _cart2polar->output("phase").set(_resPhase);
-
   _sqrMag[0] = spectrum[0]*spectrum[0]*_weight[0];
   sum += _sqrMag[0];
   for (l=1; l < (int)spectrum.size(); l++) {
@@ -180,9 +182,6 @@ void PitchYinFFT::compute() {
       _yin[n] = -_yin[n];
     }
     // use interal peak detection algorithm
-    _peakDetect->input("array").set(_yin);
-    _peakDetect->output("positions").set(_positions);
-    _peakDetect->output("amplitudes").set(_amplitudes);
     _peakDetect->compute();
     try {
       tau = _positions[0];
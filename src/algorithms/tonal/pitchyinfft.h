@@ -44,6 +44,7 @@ class PitchYinFFT : public Algorithm {
   Algorithm* _cart2polar;
   Algorithm* _peakDetect;
 
+  std::vector<std::complex<Real> > _frameFFT; /** FFT of the weighted squared spectrum */
   std::vector<Real> _resPhase;    /** complex vector to compute square difference function */
   std::vector<Real> _resNorm;
   std::vector<Real> _sqrMag;      /** square difference function */
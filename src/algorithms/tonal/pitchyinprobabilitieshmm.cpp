@@ -39,8 +39,6 @@ const char* PitchYinProbabilitiesHMM::description = DOC("This algorithm estimate
 "  (ICASSP 2014)Project Report, 2004");
 
 void PitchYinProbabilitiesHMM::configure() {
-  _viterbi->configure();
-
   _minFrequency = parameter("minFrequency").toReal();
   _numberBinsPerSemitone = parameter("numberBinsPerSemitone").toInt();
   _selfTransition = parameter("selfTransition").toReal();
@@ -103,6 +101,10 @@ void PitchYinProbabilitiesHMM::configure() {
       _transProb.push_back(weights[i - minNextPitch] / weightSum * (1 - _selfTransition));
     }
   }
+
+  // the transition structure only depends on the parameters, so the decoder
+  // is set up once here rather than on every call
+  _viterbi.setTransitions(2 * _nPitch, _from, _to, _transProb);
 }
 
 const vector<Real> PitchYinProbabilitiesHMM::calculateObsProb(const vector<Real> pitchCandidates, const vector<Real> probabilities) {
@@ -153,13 +155,9 @@ void PitchYinProbabilitiesHMM::compute() {
   }
 
   vector<int> path;
-  _viterbi->input("observationProbabilities").set(obsProb);
-  _viterbi->input("initialization").set(_init);
-  _viterbi->input("fromIndex").set(_from);
-  _viterbi->input("toIndex").set(_to);
-  _viterbi->input("transitionProbabilities").set(_transProb);
-  _viterbi->output("path").set(path);
-  _viterbi->compute();
+  if (!_viterbi.decode(_init, obsProb, path)) {
+    E_WARNING("PitchYinProbabilitiesHMM: the observation probabilities become zero at some frame in combination with the model.");
+  }
 
   _tempPitch.resize(path.size());
 
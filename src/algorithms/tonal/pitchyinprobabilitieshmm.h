@@ -21,6 +21,7 @@
 #define ESSENTIA_PITCHYINPROBABILITIESHMM_H
 
 #include "algorithmfactory.h"
+#include "viterbidecoder.h"
 
 namespace essentia {
 namespace standard {
@@ -32,7 +33,7 @@ class PitchYinProbabilitiesHMM : public Algorithm {
   Input<std::vector<std::vector<Real> > > _probabilities;
   Output<std::vector<Real> > _pitch;
 
-  Algorithm* _viterbi;
+  util::ViterbiDecoder<double> _viterbi;
 
   Real _minFrequency;
   size_t _numberBinsPerSemitone;
@@ -54,8 +55,6 @@ class PitchYinProbabilitiesHMM : public Algorithm {
     declareInput(_pitchCandidates, "pitchCandidates", "the pitch candidates");
     declareInput(_probabilities, "probabilities", "the pitch probabilities");
     declareOutput(_pitch, "pitch", "pitch frequencies in Hz");
-
-    _viterbi = AlgorithmFactory::create("Viterbi");
   }
 
   void declareParameters() {
@@ -59,6 +59,25 @@ class ESSENTIA_API Algorithm : public Configurable {
    */
   OutputBase& output(const std::string& name);
 
+  /**
+   * Return a typed handle on the input with the given name. The name lookup
+   * and the type check are done here, once, so that binding data through
+   * the handle afterwards costs no more than a pointer assignment. This is
+   * meant for algorithms which call another algorithm for each frame: they
+   * should get the handles when configured, instead of calling
+   * input(name).set(data) in their compute() method.
+   * Implementation in iotypewrappers_impl.h
+   */
+  template <typename Type>
+  InputHandle<Type> inputHandle(const std::string& name);
+
+  /**
+   * Return a typed handle on the output with the given name.
+   * @see inputHandle()
+   */
+  template <typename Type>
+  OutputHandle<Type> outputHandle(const std::string& name);
+
   /**
    * Return the names of all the inputs that have been defined for this object.
    */
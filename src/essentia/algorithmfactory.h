@@ -87,6 +87,14 @@ class ESSENTIA_API EssentiaFactory {
     return instance().create_i(id);
   }
 
+  /**
+   * Creates an instance of the algorithm specified by its name, configured
+   * with the given parameters.
+   */
+  static BaseAlgorithm* create(const std::string& id, const ParameterMap& params) {
+    return instance().create_i(id, params);
+  }
+
   /**
    * Deletes the specified Algorithm object and frees its memory.
    * @todo make sure this actually works through dynamic libraries' boundaries.
@@ -150,6 +158,7 @@ class ESSENTIA_API EssentiaFactory {
   EssentiaFactory(EssentiaFactory&);
 
   BaseAlgorithm* create_i(const std::string& id) const;
+  BaseAlgorithm* create_i(const std::string& id, const ParameterMap& params) const;
 
   typedef EssentiaMap<std::string, AlgorithmInfo<BaseAlgorithm>, string_cmp> CreatorMap;
   CreatorMap _map;
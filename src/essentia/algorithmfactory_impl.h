@@ -67,6 +67,15 @@ BaseAlgorithm* EssentiaFactory<BaseAlgorithm>::create_i(const std::string& id) c
   // call  abstract virtual functions from the base constructor.
   algo->declareParameters();
 
+  // algorithms with an expensive configuration can ask for it to be done
+  // when they are first used, as they are most of the time reconfigured
+  // before that
+  if (algo->deferDefaultConfiguration()) {
+    E_DEBUG(EFactory, BaseAlgorithm::processingMode << ": Deferring configuration of " << id << " with default parameters");
+    algo->_configurePending = true;
+    return algo;
+  }
+
   // configure with default parameters to ensure we're not in an undefined state.
   // This should never throw an exception. If it does, explain why it should
   // absolutely be fixed.
@@ -103,30 +112,35 @@ BaseAlgorithm* EssentiaFactory<BaseAlgorithm>::create_i(const std::string& id) c
 #define AP(n) params.add(name##n, value##n);
 
 #define CREATE_I_BEG ) const {                                                                              \
-  E_DEBUG(EFactory, BaseAlgorithm::processingMode << ": Creating algorithm: " << id);                       \
-  typename CreatorMap::const_iterator it = _map.find(id);                                                   \
-  if (it == _map.end()) {                                                                                   \
-    std::ostringstream msg;                                                                                 \
-    msg << "Identifier '" << id << "' not found in registry...\n";                                          \
-    msg << "Available algorithms:";                                                                         \
-    for (it=_map.begin(); it!=_map.end(); ++it) {                                                           \
-      msg << ' ' << it->first;                                                                              \
-    }                                                                                                       \
-    throw EssentiaException(msg);                                                                           \
-  }                                                                                                         \
-  E_DEBUG_INDENT;                                                                                           \
-  BaseAlgorithm* algo = it->second.create();                                                                \
-  E_DEBUG_OUTDENT;                                                                                          \
-  algo->setName(id);                                                                                        \
-  algo->declareParameters();                                                                                \
   ParameterMap params;
 
 #define CREATE_I_END                                                                                        \
-  algo->setParameters(params);                                                                              \
-  E_DEBUG(EFactory, BaseAlgorithm::processingMode << ": Configuring " << id << " with default parameters"); \
-  algo->configure();                                                                                        \
-  E_DEBUG(EFactory, BaseAlgorithm::processingMode << ": Creating " << id << " ok!");                        \
-  return algo;                                                                                              \
+  return create_i(id, params);                                                                              \
+}
+
+template <typename BaseAlgorithm>
+BaseAlgorithm* EssentiaFactory<BaseAlgorithm>::create_i(const std::string& id, const ParameterMap& params) const {
+  E_DEBUG(EFactory, BaseAlgorithm::processingMode << ": Creating algorithm: " << id);
+  typename CreatorMap::const_iterator it = _map.find(id);
+  if (it == _map.end()) {
+    std::ostringstream msg;
+    msg << "Identifier '" << id << "' not found in registry...\n";
+    msg << "Available algorithms:";
+    for (it=_map.begin(); it!=_map.end(); ++it) {
+      msg << ' ' << it->first;
+    }
+    throw EssentiaException(msg);
+  }
+  E_DEBUG_INDENT;
+  BaseAlgorithm* algo = it->second.create();
+  E_DEBUG_OUTDENT;
+  algo->setName(id);
+  algo->declareParameters();
+  algo->setParameters(params);
+  E_DEBUG(EFactory, BaseAlgorithm::processingMode << ": Configuring " << id << " with default parameters");
+  algo->configure();
+  E_DEBUG(EFactory, BaseAlgorithm::processingMode << ": Creating " << id << " ok!");
+  return algo;
 }
 
 
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_ALGORITHMPOOL_H
+#define ESSENTIA_ALGORITHMPOOL_H
+
+#include <map>
+#include <list>
+#include <vector>
+#include <algorithm>
+#include "algorithmfactory.h"
+#include "utils/kernelcache.h"
+
+namespace essentia {
+
+/**
+ * Pool of configured algorithm instances, so that code which creates the same
+ * algorithms with the same parameters over and over (typically once for each
+ * file in a batch) does not have to construct and configure them every time.
+ *
+ * acquire() returns an instance configured with the given parameters: an
+ * instance which has been released with the same parameters if there is one,
+ * or a new one otherwise, which is configured only once. release() resets
+ * the instance and keeps it for a later acquire(), unless it has been
+ * reconfigured in the meantime. Recycled instances keep their inputs and
+ * outputs bound to whatever they were bound to before, so they have to be
+ * bound again before calling compute().
+ *
+ * The pools are per-thread, so that they do not need any locking: an
+ * instance has to be released by the thread which acquired it. When not
+ * compiled as C++11, there is no pooling, acquire() creates a new instance
+ * and release() deletes it.
+ */
+template <typename BaseAlgorithm>
+class AlgorithmInstancePool {
+
+ public:
+  /**
+   * Returns an instance of the given algorithm, configured with the given
+   * parameters.
+   */
+  static BaseAlgorithm* acquire(const std::string& id, const ParameterMap& params = ParameterMap()) {
+#ifdef CPP_11
+    std::string key = util::kernelKey(id, params);
+    Instances& instances = local();
+
+    typename std::map<std::string, std::vector<BaseAlgorithm*> >::iterator it = instances.free.find(key);
+    if (it != instances.free.end() && !it->second.empty()) {
+      BaseAlgorithm* algo = it->second.back();
+      it->second.pop_back();
+      if (it->second.empty()) instances.free.erase(it);
+
+      Instance& instance = instances.all[algo];
+      instances.released.erase(instance.position);
+      instance.acquired = true;
+      return algo;
+    }
+
+    BaseAlgorithm* algo = EssentiaFactory<BaseAlgorithm>::create(id, params);
+    Instance& instance = instances.all[algo];
+    instance.key = key;
+    instance.parameters = currentParameters(algo);
+    instance.acquired = true;
+    return algo;
+#else
+    return EssentiaFactory<BaseAlgorithm>::create(id, params);
+#endif
+  }
+
+  /**
+   * Gives back an instance obtained from acquire(). It is reset and kept for
+   * a later acquire() with the same parameters. It is deleted instead if it
+   * has been reconfigured with other parameters since it was created, or if
+   * there are already maxFree() instances with the same configuration. When
+   * there are more than maxFreeTotal() released instances, the ones released
+   * the longest time ago are deleted.
+   */
+  static void release(BaseAlgorithm* algo) {
+    if (!algo) return;
+#ifdef CPP_11
+    Instances& instances = local();
+
+    typename std::map<BaseAlgorithm*, Instance>::iterator it = instances.all.find(algo);
+    if (it == instances.all.end() || !it->second.acquired) {
+      throw EssentiaException("AlgorithmPool: cannot release ", algo->name(),
+                              ", it has not been acquired from the pool of this thread");
+    }
+    Instance& instance = it->second;
+
+    if (!hasParameters(algo, instance.parameters)) {
+      // would be given back for a configuration it does not have anymore
+      instances.all.erase(it);
+      delete algo;
+      return;
+    }
+
+    std::vector<BaseAlgorithm*>& free = instances.free[instance.key];
+    if (free.size() >= maxFree()) {
+      instances.all.erase(it);
+      delete algo;
+      return;
+    }
+
+    algo->reset();
+    free.push_back(algo);
+    instance.acquired = false;
+    instance.position = instances.released.insert(instances.released.end(), algo);
+
+    while (instances.released.size() > maxFreeTotal()) {
+      instances.remove(instances.released.front());
+    }
+#else
+    delete algo;
+#endif
+  }
+
+  /**
+   * Deletes all the released instances of the current thread.
+   */
+  static void clear() {
+#ifdef CPP_11
+    local().clear();
+#endif
+  }
+
+  /**
+   * Maximum number of released instances kept for each configuration.
+   */
+  static size_t maxFree() { return 8; }
+
+  /**
+   * Maximum number of released instances kept for all the configurations,
+   * as code computing the parameters from its input (a size, a range) uses
+   * another configuration for almost every call.
+   */
+  static size_t maxFreeTotal() { return 64; }
+
+ protected:
+  struct Instance {
+    std::string key;
+    ParameterMap parameters;   // the ones set when creating the instance
+    bool acquired;
+    typename std::list<BaseAlgorithm*>::iterator position;  // in released, if not acquired
+  };
+
+  // all the parameters of an algorithm, including the default ones
+  static ParameterMap currentParameters(const BaseAlgorithm* algo) {
+    ParameterMap params;
+    const ParameterMap& declared = algo->defaultParameters();
+    for (ParameterMap::const_iterator it = declared.begin(); it != declared.end(); ++it) {
+      params.add(it->first, algo->parameter(it->first));
+    }
+    return params;
+  }
+
+  static bool hasParameters(const BaseAlgorithm* algo, const ParameterMap& params) {
+    for (ParameterMap::const_iterator it = params.begin(); it != params.end(); ++it) {
+      if (algo->parameter(it->first) != it->second) return false;
+    }
+    return true;
+  }
+
+  struct Instances {
+    std::map<std::string, std::vector<BaseAlgorithm*> > free;
+    std::map<BaseAlgorithm*, Instance> all;   // acquired and released instances
+    std::list<BaseAlgorithm*> released;       // in the order they were released
+
+    // deletes a released instance
+    void remove(BaseAlgorithm* algo) {
+      typename std::map<BaseAlgorithm*, Instance>::iterator it = all.find(algo);
+      std::vector<BaseAlgorithm*>& instances = free[it->second.key];
+      instances.erase(std::find(instances.begin(), instances.end(), algo));
+      if (instances.empty()) free.erase(it->second.key);
+      released.erase(it->second.position);
+      all.erase(it);
+      delete algo;
+    }
+
+    void clear() {
+      while (!released.empty()) remove(released.front());
+    }
+
+    ~Instances() { clear(); }
+  };
+
+#ifdef CPP_11
+  static Instances& local() {
+    static thread_local Instances instances;
+    return instances;
+  }
+#endif
+};
+
+namespace standard {
+  typedef AlgorithmInstancePool<Algorithm> AlgorithmPool;
+}
+
+} // namespace essentia
+
+#endif // ESSENTIA_ALGORITHMPOOL_H
@@ -27,6 +27,7 @@ namespace essentia {
 
 void Configurable::configure(const ParameterMap& params) {
   setParameters(params);
+  markConfigured();
   configure();
 }
 
@@ -64,7 +65,10 @@ void Configurable::setParameters(const ParameterMap& params) {
   // ones that are already in there and are not in the new map
   for (ParameterMap::const_iterator it = params.begin(); it != params.end(); ++it) {
     const string& name = it->first;
-    Parameter value = it->second;
+    // only scalars can be coerced to another type, so that the (possibly
+    // large) vector and matrix parameters are only copied once, when added
+    const Parameter* value = &it->second;
+    Parameter coerced(Parameter::UNDEFINED);
 
     // throw an exception if a parameter is not recognized by the algorithm
     if (!contains(_params, name)) {
@@ -75,7 +79,7 @@ void Configurable::setParameters(const ParameterMap& params) {
       throw EssentiaException(msg);
     }
 
-    Parameter::ParamType valueType = value.type();
+    Parameter::ParamType valueType = value->type();
     Parameter::ParamType definedType = _params.find(name)->second.type();
 
     // throw an exception if the parameter exists, but is of the wrong type
@@ -86,7 +90,8 @@ void Configurable::setParameters(const ParameterMap& params) {
       // make special case that ints can be configured to Reals
       if (definedType == Parameter::REAL &&
           valueType == Parameter::INT) {
-        value = Parameter(value.toReal());
+        coerced = Parameter(value->toReal());
+        value = &coerced;
       }
       // make special case that reals can be configured to ints
       else if (definedType == Parameter::INT &&
@@ -98,7 +103,8 @@ void Configurable::setParameters(const ParameterMap& params) {
             << " but the required parameter type is '" << definedType
             << ". Losing resolution while truncating to integer.";
         E_WARNING(msg.str());
-        value = Parameter(value.toInt());
+        coerced = Parameter(value->toInt());
+        value = &coerced;
       }
       else {
         ostringstream msg;
@@ -114,14 +120,14 @@ void Configurable::setParameters(const ParameterMap& params) {
     const string& srange = parameterRange[name];
     unique_ptr<Range> r(Range::create(srange));
 
-    if (!r->contains(value)) {
+    if (!r->contains(*value)) {
       ostringstream msg;
-      msg << "Parameter " << name << " = " << value << " is not within specified range: " << srange;
+      msg << "Parameter " << name << " = " << *value << " is not within specified range: " << srange;
       throw EssentiaException(msg);
     }
 
     // otherwise, just set the new value
-    _params.add(name, value);
+    _params.add(name, *value);
   }
 }
 
@@ -24,6 +24,8 @@
 
 namespace essentia {
 
+template <typename BaseAlgorithm> class EssentiaFactory;
+
 /**
  * A Configurable instance is an object that has a given name, and can be
  * configured using a certain number of @c Parameters. These parameters have
@@ -39,6 +41,8 @@ class ESSENTIA_API Configurable {
 
  public:
 
+  Configurable() : _configurePending(false) {}
+
   // NB: virtual destructor needed because of virtual methods.
   virtual ~Configurable() {}
 
@@ -89,6 +93,38 @@ class ESSENTIA_API Configurable {
    */
   virtual void configure() {}
 
+  /**
+   * Return whether this object defers its configuration with the default
+   * parameters until it is actually used. The factory does not configure
+   * such objects when creating them without parameters, so that the default
+   * configuration is skipped entirely if the object is reconfigured before
+   * being used, which is the common case.
+   *
+   * Objects returning true have to call ensureConfigured() before doing any
+   * work relying on their configuration, typically at the beginning of
+   * compute(), and markConfigured() at the beginning of their configure().
+   * Explicit calls to configure() are never deferred.
+   */
+  virtual bool deferDefaultConfiguration() const { return false; }
+
+  /**
+   * Run the default configuration if it has been deferred.
+   * @see deferDefaultConfiguration
+   */
+  void ensureConfigured() {
+    if (_configurePending) {
+      _configurePending = false;
+      configure();
+    }
+  }
+
+  /**
+   * Cancel the deferred default configuration, as the object is being
+   * configured explicitly.
+   * @see deferDefaultConfiguration
+   */
+  void markConfigured() { _configurePending = false; }
+
 
   /**
    * Return a map filled with the parameters that have been declared, along with
@@ -172,6 +208,10 @@ class ESSENTIA_API Configurable {
   ParameterMap _params;
   ParameterMap _defaultParams;
 
+  // the default configuration has been deferred, see deferDefaultConfiguration()
+  bool _configurePending;
+  template <typename BaseAlgorithm> friend class EssentiaFactory;
+
  public:
   DescriptionMap parameterDescription;
   DescriptionMap parameterRange;
@@ -19,6 +19,7 @@
 
 #include "essentia.h"
 #include "algorithmfactory.h"
+#include "algorithmpool.h"
 // Need to do this to keep essentia FFT "agnostic"
 // #include <fftw3.h>
 
@@ -59,6 +60,7 @@ void init() {
 void shutdown() {
   // Need to do this to keep essentia FFT "agnostic", and shouldn't the class destructor do that anyway?
   // fftwf_cleanup();
+  standard::AlgorithmPool::clear();
   standard::AlgorithmFactory::shutdown();
   streaming::AlgorithmFactory::shutdown();
   TypeMap::shutdown();
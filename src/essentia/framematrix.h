@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_FRAMEMATRIX_H
+#define ESSENTIA_FRAMEMATRIX_H
+
+#include <vector>
+#include <algorithm>
+#include "types.h"
+
+namespace essentia {
+
+/**
+ * Sequence of frames of Real values which all have the same size, stored
+ * contiguously in a single buffer, one frame after the other (row-major).
+ * This is how the Pool stores the frame-level vector descriptors, so that
+ * adding a frame does not allocate memory most of the time, and so that all
+ * the frames can be processed (or exported) without following one pointer
+ * per frame.
+ */
+class FrameMatrix {
+
+ public:
+  FrameMatrix() : _cols(0) {}
+  explicit FrameMatrix(int cols) : _cols(cols) {}
+
+  /**
+   * Number of frames.
+   */
+  int rows() const { return _cols > 0 ? int(_data.size() / _cols) : 0; }
+
+  /**
+   * Size of the frames.
+   */
+  int cols() const { return _cols; }
+
+  bool empty() const { return _data.empty(); }
+
+  /**
+   * @returns a pointer to the cols() values of frame @e i
+   */
+  const Real* row(int i) const { return &_data[(size_t)i*_cols]; }
+  Real* row(int i) { return &_data[(size_t)i*_cols]; }
+
+  /**
+   * @returns the values of all the frames, one after the other
+   */
+  const std::vector<Real>& values() const { return _data; }
+
+  /**
+   * Appends a frame, which should have cols() values.
+   */
+  void appendRow(const Real* values) {
+    _data.insert(_data.end(), values, values + _cols);
+  }
+
+  void appendRow(const std::vector<Real>& values) {
+    if ((int)values.size() != _cols) {
+      throw EssentiaException("FrameMatrix: cannot append a frame of size ", values.size(),
+                              " to frames of size ", _cols);
+    }
+    appendRow(values.empty() ? 0 : &values[0]);
+  }
+
+  void reserveRows(int n) { _data.reserve((size_t)n*_cols); }
+
+  /**
+   * @returns a copy of the frames, as one vector per frame
+   */
+  std::vector<std::vector<Real> > toRows() const {
+    std::vector<std::vector<Real> > result(rows());
+    for (int i=0; i<(int)result.size(); ++i) {
+      result[i].assign(row(i), row(i) + _cols);
+    }
+    return result;
+  }
+
+  void swap(FrameMatrix& m) {
+    _data.swap(m._data);
+    std::swap(_cols, m._cols);
+  }
+
+ protected:
+  std::vector<Real> _data;
+  int _cols;
+};
+
+} // namespace essentia
+
+#endif // ESSENTIA_FRAMEMATRIX_H
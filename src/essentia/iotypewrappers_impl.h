@@ -91,6 +91,67 @@ class Output : public OutputBase {
 };
 
 
+/**
+ * Handle on the input of an algorithm whose type has been checked when the
+ * handle was created (see Algorithm::inputHandle()), so that set() does no
+ * lookup nor type check. A default-constructed handle is not bound to any
+ * input and must not be used.
+ */
+template <typename Type>
+class InputHandle {
+ public:
+  InputHandle() : _input(0) {}
+
+  explicit InputHandle(InputBase& input) : _input(&input) {
+    try {
+      input.checkType<Type>();
+    }
+    catch (EssentiaException& e) {
+      throw EssentiaException("In ", input.fullName(), "::inputHandle(): ", e.what());
+    }
+  }
+
+  void set(const Type& data) { _input->_data = &data; }
+
+ protected:
+  InputBase* _input;
+};
+
+/**
+ * Handle on the output of an algorithm, see InputHandle.
+ */
+template <typename Type>
+class OutputHandle {
+ public:
+  OutputHandle() : _output(0) {}
+
+  explicit OutputHandle(OutputBase& output) : _output(&output) {
+    try {
+      output.checkType<Type>();
+    }
+    catch (EssentiaException& e) {
+      throw EssentiaException("In ", output.fullName(), "::outputHandle(): ", e.what());
+    }
+  }
+
+  void set(Type& data) { _output->_data = &data; }
+
+ protected:
+  OutputBase* _output;
+};
+
+
+template <typename Type>
+InputHandle<Type> Algorithm::inputHandle(const std::string& name) {
+  return InputHandle<Type>(input(name));
+}
+
+template <typename Type>
+OutputHandle<Type> Algorithm::outputHandle(const std::string& name) {
+  return OutputHandle<Type>(output(name));
+}
+
+
 } // namespace standard
 } // namespace essentia
 
@@ -47,6 +47,8 @@ void Parameter::clear() {
   // delete all the values from vector
   for (int i=0; i<(int)_vec.size(); i++) delete _vec[i];
   _vec.clear();
+  _dense.clear();
+  _denseInt.clear();
 
   // delete all the values from map
   for (map<string, Parameter*>::const_iterator it = _map.begin();
@@ -78,6 +80,11 @@ Parameter& Parameter::operator=(const Parameter& p) {
     _vec[i] = new Parameter(*(p._vec[i]));
   }
 
+  _dense = p._dense;
+  _denseInt = p._denseInt;
+  _rows = p._type == MATRIX_REAL ? p._rows : 0;
+  _cols = p._type == MATRIX_REAL ? p._cols : 0;
+
   return *this;
 }
 
@@ -86,6 +93,19 @@ Parameter::~Parameter() {
 }
 
 
+// writes the values the same way as if each of them was a Parameter
+template <typename T>
+static void writeDenseValues(ostream& out, const T* values, int size) {
+  streamsize precision = out.precision(12);
+  out << "[";
+  for (int i=0; i<size; ++i) {
+    if (i > 0) out << ", ";
+    out << values[i];
+  }
+  out << "]";
+  out.precision(precision);
+}
+
 string Parameter::toString(int precision) const {
   if (!_configured) {
     throw EssentiaException("Parameter: parameter has not been configured yet (ParamType=", _type, ")");
@@ -117,13 +137,27 @@ string Parameter::toString(int precision) const {
       break;
 
     case VECTOR_REAL:
+      writeDenseValues(result, _dense.empty() ? 0 : &_dense[0], (int)_dense.size());
+      break;
+
+    case VECTOR_INT:
+      writeDenseValues(result, _denseInt.empty() ? 0 : &_denseInt[0], (int)_denseInt.size());
+      break;
+
+    case MATRIX_REAL:
+      result << "[";
+      for (int i=0; i<_rows; ++i) {
+        if (i > 0) result << ", ";
+        writeDenseValues(result, _dense.empty() ? 0 : &_dense[i*_cols], _cols);
+      }
+      result << "]";
+      break;
+
     case VECTOR_STRING:
     case VECTOR_BOOL:
-    case VECTOR_INT:
     case VECTOR_STEREOSAMPLE:
     case VECTOR_VECTOR_REAL:
     case VECTOR_VECTOR_STRING:
-    case MATRIX_REAL:
     case VECTOR_MATRIX_REAL:
     case VECTOR_VECTOR_STEREOSAMPLE:
       result << "[";
@@ -181,13 +215,19 @@ bool Parameter::operator==(const Parameter& p) const {
              _ssamp.right() == p._ssamp.right();
 
     case VECTOR_REAL:
+      return _dense == p._dense;
+
+    case VECTOR_INT:
+      return _denseInt == p._denseInt;
+
+    case MATRIX_REAL:
+      return _rows == p._rows && _cols == p._cols && _dense == p._dense;
+
     case VECTOR_STRING:
     case VECTOR_BOOL:
-    case VECTOR_INT:
     case VECTOR_STEREOSAMPLE:
     case VECTOR_VECTOR_REAL:
     case VECTOR_VECTOR_STRING:
-    case MATRIX_REAL:
     case VECTOR_MATRIX_REAL:
     case VECTOR_VECTOR_STEREOSAMPLE:
       if (_vec.size() != p._vec.size()) {
@@ -23,6 +23,7 @@
 #include <map>
 #include <vector>
 #include "types.h"
+#include "framematrix.h"
 #include "utils/tnt/tnt_array2d.h"
 
 namespace essentia {
@@ -68,6 +69,13 @@ class ESSENTIA_API Parameter {
   Real _real;
   bool _boolean;
   std::vector<Parameter*> _vec;
+  // values of the numeric vector and matrix parameters (VECTOR_REAL,
+  // MATRIX_REAL), stored contiguously (row-major for matrices) instead of one
+  // Parameter per element in _vec. VECTOR_INT values are kept as ints, so
+  // that they are not rounded to the precision of a Real
+  std::vector<Real> _dense;
+  std::vector<int> _denseInt;
+  int _rows, _cols; // only set for MATRIX_REAL
   std::map<std::string, Parameter*> _map;
   StereoSample _ssamp;
   bool _configured;
@@ -75,7 +83,7 @@ class ESSENTIA_API Parameter {
  public:
 
   // Constructor for just declaring type (not providing a value)
-  Parameter(ParamType tp) : _type(tp), _configured(false) {}
+  Parameter(ParamType tp) : _type(tp), _rows(0), _cols(0), _configured(false) {}
 
   // Constructor for simple parameters
   #define SPECIALIZE_CTOR(valueType, paramType, mName)                         \
@@ -98,16 +106,21 @@ class ESSENTIA_API Parameter {
     for (int i=0; i<int(v.size()); ++i) { _vec[i] = new Parameter(v[i]); }     \
   }
 
-  SPECIALIZE_VECTOR_CTOR(Real,                      VECTOR_REAL);
   SPECIALIZE_VECTOR_CTOR(std::string,               VECTOR_STRING);
   SPECIALIZE_VECTOR_CTOR(bool,                      VECTOR_BOOL);
-  SPECIALIZE_VECTOR_CTOR(int,                       VECTOR_INT);
   SPECIALIZE_VECTOR_CTOR(StereoSample,              VECTOR_STEREOSAMPLE);
   SPECIALIZE_VECTOR_CTOR(std::vector<Real>,         VECTOR_VECTOR_REAL);
   SPECIALIZE_VECTOR_CTOR(std::vector<std::string>,  VECTOR_VECTOR_STRING);
   SPECIALIZE_VECTOR_CTOR(std::vector<StereoSample>, VECTOR_VECTOR_STEREOSAMPLE);
   SPECIALIZE_VECTOR_CTOR(TNT::Array2D<Real>,        VECTOR_MATRIX_REAL);
 
+  // Constructor for numeric vector parameters, which use dense storage
+  #define SPECIALIZE_DENSE_VECTOR_CTOR(valueType, paramType, mName)            \
+  Parameter(const std::vector<valueType>& v) : _type(paramType), _##mName(v), _configured(true) {}
+
+  SPECIALIZE_DENSE_VECTOR_CTOR(Real, VECTOR_REAL, dense);
+  SPECIALIZE_DENSE_VECTOR_CTOR(int,  VECTOR_INT,  denseInt);
+
   // Constructor for map parameters
   #define SPECIALIZE_MAP_CTOR(valueType, paramType)                            \
   Parameter(const std::map<std::string, valueType>& m) : _type(paramType), _configured(true) { \
@@ -123,20 +136,21 @@ class ESSENTIA_API Parameter {
 
   // Constructor for TNT::Array2D aka MATRIX parameters
   #define SPECIALIZE_MATRIX_CTOR(valueType, innerType)                         \
-  Parameter(const TNT::Array2D<valueType>& mat) : _type(MATRIX_##innerType), _configured(true) { \
-    _vec.resize(mat.dim1());                                                   \
-    for (int i=0; i<mat.dim1(); ++i) {                                         \
-      _vec[i] = new Parameter(VECTOR_##innerType);                             \
-      _vec[i]->_configured = true;                                             \
-      _vec[i]->_vec.resize(mat.dim2());                                        \
-      for (int j=0; j<mat.dim2(); ++j) {                                       \
-        _vec[i]->_vec[j] = new Parameter(mat[i][j]);                           \
+  Parameter(const TNT::Array2D<valueType>& mat) : _type(MATRIX_##innerType), _rows(mat.dim1()), _cols(mat.dim2()), _configured(true) { \
+    _dense.resize(_rows*_cols);                                                \
+    for (int i=0; i<_rows; ++i) {                                              \
+      for (int j=0; j<_cols; ++j) {                                            \
+        _dense[i*_cols + j] = mat[i][j];                                       \
       }                                                                        \
     }                                                                          \
   }
 
   SPECIALIZE_MATRIX_CTOR(Real, REAL)
 
+  // Constructor for the frames of a descriptor stored contiguously in a Pool,
+  // which are a MATRIX_REAL parameter
+  Parameter(const FrameMatrix& frames) : _type(MATRIX_REAL), _dense(frames.values()), _rows(frames.rows()), _cols(frames.cols()), _configured(true) {}
+
   Parameter(const Parameter& p);
 
   // also define ctor with a ptr, which allows a nice trick: we can now construct
@@ -206,9 +220,7 @@ class ESSENTIA_API Parameter {
     return result;                                                            \
   }
 
-  TOVECTOR(Real, Real, VECTOR_REAL)
   TOVECTOR(String, std::string, VECTOR_STRING)
-  TOVECTOR(Int, int, VECTOR_INT)
   TOVECTOR(Bool, bool, VECTOR_BOOL)
   TOVECTOR(StereoSample, StereoSample, VECTOR_STEREOSAMPLE)
   TOVECTOR(VectorReal, std::vector<Real>, VECTOR_VECTOR_REAL)
@@ -217,6 +229,48 @@ class ESSENTIA_API Parameter {
   TOVECTOR(MatrixReal, TNT::Array2D<Real>, VECTOR_MATRIX_REAL)
 //  TOVECTOR(MatrixInt, TNT::Array2D<int>, VECTOR_MATRIX_INT)
 
+  #define TODENSEVECTOR(fname, valueType, paramType, mName)                   \
+  std::vector<valueType > toVector##fname() const {                           \
+    if (!_configured)                                                         \
+      throw EssentiaException("Parameter: parameter has not been configured yet (ParamType=", _type, ")"); \
+    if (_type != paramType)                                                   \
+      throw EssentiaException("Parameter: parameter is not of type: ", paramType); \
+                                                                              \
+    return _##mName;                                                          \
+  }
+
+  TODENSEVECTOR(Real, Real, VECTOR_REAL, dense)
+  TODENSEVECTOR(Int, int, VECTOR_INT, denseInt)
+
+  /**
+   * Returns the values of a VECTOR_REAL or MATRIX_REAL parameter without
+   * copying them. Matrices are stored row-major, their dimensions are given
+   * by matrixRows() and matrixCols().
+   */
+  const std::vector<Real>& denseValues() const {
+    if (!_configured)
+      throw EssentiaException("Parameter: parameter has not been configured yet (ParamType=", _type, ")");
+    if (_type != VECTOR_REAL && _type != MATRIX_REAL)
+      throw EssentiaException("Parameter: parameter is not a real vector nor a matrix, it is a ", _type);
+
+    return _dense;
+  }
+
+  /**
+   * Returns the values of a VECTOR_INT parameter without copying them.
+   */
+  const std::vector<int>& denseIntValues() const {
+    if (!_configured)
+      throw EssentiaException("Parameter: parameter has not been configured yet (ParamType=", _type, ")");
+    if (_type != VECTOR_INT)
+      throw EssentiaException("Parameter: parameter is not of type: ", VECTOR_INT);
+
+    return _denseInt;
+  }
+
+  int matrixRows() const { return _type == MATRIX_REAL ? _rows : 0; }
+  int matrixCols() const { return _type == MATRIX_REAL ? _cols : 0; }
+
   #define TOMAP(fname, valueType, paramType)                                   \
   std::map<std::string, valueType > toMap##fname() const {                     \
     if (!_configured)                                                          \
@@ -250,11 +304,11 @@ class ESSENTIA_API Parameter {
       throw EssentiaException("Parameter: parameter has not been configured yet (ParamType=", _type, ")");\
     if (_type != paramType)                                                    \
       throw EssentiaException("Parameter: parameter is not of type: ", paramType);\
-    TNT::Array2D<valueType> result(_vec.size(), _vec[0]->_vec.size());         \
+    TNT::Array2D<valueType> result(_rows, _cols);                              \
                                                                                \
-    for (int i=0; i<result.dim1(); ++i) {                                      \
-      for (int j=0; j<result.dim2(); ++j) {                                    \
-        result[i][j] = _vec[i]->_vec[j]->to##fname();                          \
+    for (int i=0; i<_rows; ++i) {                                              \
+      for (int j=0; j<_cols; ++j) {                                            \
+        result[i][j] = (valueType)_dense[i*_cols + j];                         \
       }                                                                        \
     }                                                                          \
     return result;                                                             \
@@ -32,6 +32,7 @@ void Pool::clear() {
 
   _poolReal.clear();
   _poolVectorReal.clear();
+  _poolVectorRealMatrix.clear();
   _poolString.clear();
   _poolVectorString.clear();
   _poolArray2DReal.clear();
@@ -40,6 +41,194 @@ void Pool::clear() {
   _poolSingleString.clear();
   _poolSingleVectorReal.clear();
   _poolSingleVectorString.clear();  
+
+  // keep the interned names, so that the ids given out stay valid
+  MutexLocker lockKeys(mutexKeys);
+  _keyInfo.assign(_keyInfo.size(), KeyInfo());
+}
+
+Pool::Pool(const Pool& p) {
+  *this = p;
+}
+
+// locks all the sub-pools of the given pool, as GLOBAL_LOCK does for this one
+#define POOL_LOCK(pool, prefix)                                              \
+MutexLocker prefix##Real((pool).mutexReal);                                  \
+MutexLocker prefix##VectorReal((pool).mutexVectorReal);                      \
+MutexLocker prefix##VectorRealMatrix((pool).mutexVectorRealMatrix);          \
+MutexLocker prefix##String((pool).mutexString);                              \
+MutexLocker prefix##VectorString((pool).mutexVectorString);                  \
+MutexLocker prefix##Array2DReal((pool).mutexArray2DReal);                    \
+MutexLocker prefix##StereoSample((pool).mutexStereoSample);                  \
+MutexLocker prefix##SingleReal((pool).mutexSingleReal);                      \
+MutexLocker prefix##SingleString((pool).mutexSingleString);                  \
+MutexLocker prefix##SingleVectorReal((pool).mutexSingleVectorReal);          \
+MutexLocker prefix##SingleVectorString((pool).mutexSingleVectorString);
+
+Pool& Pool::operator=(const Pool& p) {
+  if (this == &p) return *this;
+
+  {
+    // same locking order as in swap(), so that a = b running concurrently
+    // with b = a or with b.swap(a) cannot deadlock
+    const Pool& first = this < &p ? *this : p;
+    const Pool& second = this < &p ? p : *this;
+    POOL_LOCK(first, lockFirst);
+    POOL_LOCK(second, lockSecond);
+    // p may be a const pool whose descriptors are converted by another thread
+    ForcedMutexLocker lockConversion(p.mutexConversion);
+
+    _poolReal = p._poolReal;
+    _poolVectorReal = p._poolVectorReal;
+    _poolVectorRealMatrix = p._poolVectorRealMatrix;
+    _poolString = p._poolString;
+    _poolVectorString = p._poolVectorString;
+    _poolArray2DReal = p._poolArray2DReal;
+    _poolStereoSample = p._poolStereoSample;
+    _poolSingleReal = p._poolSingleReal;
+    _poolSingleString = p._poolSingleString;
+    _poolSingleVectorReal = p._poolSingleVectorReal;
+    _poolSingleVectorString = p._poolSingleVectorString;
+  }
+
+  // the values have moved, the ids of this pool are kept
+  rebuildKeys();
+  return *this;
+}
+
+#ifdef CPP_11
+Pool::Pool(Pool&& p) {
+  swap(p);
+}
+
+Pool& Pool::operator=(Pool&& p) {
+  if (this == &p) return *this;
+  swap(p);
+  p.clear();
+  return *this;
+}
+#endif
+
+void Pool::swap(Pool& p) {
+  if (this == &p) return;
+
+  // the pools are locked in the order of their addresses, so that a.swap(b)
+  // and b.swap(a) running concurrently cannot deadlock
+  Pool& first = this < &p ? *this : p;
+  Pool& second = this < &p ? p : *this;
+  POOL_LOCK(first, lockFirst);
+  POOL_LOCK(second, lockSecond);
+
+  _poolReal.swap(p._poolReal);
+  _poolVectorReal.swap(p._poolVectorReal);
+  _poolVectorRealMatrix.swap(p._poolVectorRealMatrix);
+  _poolString.swap(p._poolString);
+  _poolVectorString.swap(p._poolVectorString);
+  _poolArray2DReal.swap(p._poolArray2DReal);
+  _poolStereoSample.swap(p._poolStereoSample);
+  _poolSingleReal.swap(p._poolSingleReal);
+  _poolSingleString.swap(p._poolSingleString);
+  _poolSingleVectorReal.swap(p._poolSingleVectorReal);
+  _poolSingleVectorString.swap(p._poolSingleVectorString);
+
+  // each pool keeps its own ids
+  p.rebuildKeys();
+  rebuildKeys();
+}
+
+DescriptorId Pool::internKey(const string& name) {
+  // WARNING: assumes mutexKeys is locked
+  DescriptorId id = _keys.insert(name);
+  if (id >= (int)_keyInfo.size()) _keyInfo.resize(id+1);
+  return id;
+}
+
+DescriptorId Pool::descriptorId(const string& name) {
+  MutexLocker lock(mutexKeys);
+  return internKey(name);
+}
+
+string Pool::descriptorName(DescriptorId id) const {
+  MutexLocker lock(mutexKeys);
+  return _keys.str(id);
+}
+
+void Pool::registerKey(const string& name, KeyType type, void* values) {
+  MutexLocker lock(mutexKeys);
+  DescriptorId id = internKey(name);
+  bool added = _keyInfo[id].kind == NoKey;
+  _keyInfo[id].kind = type;
+  _keyInfo[id].values = values;
+  if (!added) return;
+
+  for (string::size_type pos = name.find('.'); pos != string::npos; pos = name.find('.', pos+1)) {
+    _keyInfo[internKey(name.substr(0, pos))].children++;
+  }
+}
+
+void Pool::unregisterKey(const string& name) {
+  MutexLocker lock(mutexKeys);
+  DescriptorId id = _keys.find(name);
+  if (id < 0 || _keyInfo[id].kind == NoKey) return;
+  _keyInfo[id].kind = NoKey;
+  _keyInfo[id].values = 0;
+
+  for (string::size_type pos = name.find('.'); pos != string::npos; pos = name.find('.', pos+1)) {
+    _keyInfo[_keys.find(name.substr(0, pos))].children--;
+  }
+}
+
+void Pool::convertToRows(const string& name) const {
+  map<string, FrameMatrix>::iterator it = _poolVectorRealMatrix.find(name);
+  if (it == _poolVectorRealMatrix.end()) return;
+
+  vector<vector<Real> >& rows = _poolVectorReal[name];
+  rows = it->second.toRows();
+  _poolVectorRealMatrix.erase(it);
+
+  // the name is not registered again, only the storage of its values changes
+  MutexLocker lock(mutexKeys);
+  DescriptorId id = _keys.find(name);
+  _keyInfo[id].kind = KeyVectorReal;
+  _keyInfo[id].values = &rows;
+}
+
+const PoolOf(vector<Real>)& Pool::getVectorRealPool() const {
+  MutexLocker lock(mutexVectorReal);
+  MutexLocker lockMatrix(mutexVectorRealMatrix);
+  ForcedMutexLocker lockConversion(mutexConversion);
+  while (!_poolVectorRealMatrix.empty()) {
+    convertToRows(_poolVectorRealMatrix.begin()->first);
+  }
+  return _poolVectorReal;
+}
+
+// WARNING: this function assumes that all sub-pools are locked
+void Pool::rebuildKeys() {
+  {
+    MutexLocker lock(mutexKeys);
+    _keyInfo.assign(_keyInfo.size(), KeyInfo());
+  }
+
+  #define REGISTER_KEYS(type, tname)                                           \
+  for (map<string, type >::iterator it = _pool##tname.begin();                 \
+       it != _pool##tname.end(); ++it) {                                       \
+    registerKey(it->first, Key##tname, &it->second);                           \
+  }
+
+  REGISTER_KEYS(vector<Real>, Real);
+  REGISTER_KEYS(vector<vector<Real> >, VectorReal);
+  REGISTER_KEYS(FrameMatrix, VectorRealMatrix);
+  REGISTER_KEYS(vector<string>, String);
+  REGISTER_KEYS(vector<vector<string> >, VectorString);
+  REGISTER_KEYS(vector<TNT::Array2D<Real> >, Array2DReal);
+  REGISTER_KEYS(vector<StereoSample>, StereoSample);
+  REGISTER_KEYS(Real, SingleReal);
+  REGISTER_KEYS(string, SingleString);
+  REGISTER_KEYS(vector<Real>, SingleVectorReal);
+  REGISTER_KEYS(vector<string>, SingleVectorString);
+
+  #undef REGISTER_KEYS
 }
 
 void Pool::checkIntegrity() const {
@@ -70,6 +259,7 @@ void Pool::remove(const string& name) {
     map<string, t >::iterator i = _pool##tname.find(name);                     \
     if (i != _pool##tname.end()) {                                             \
       _pool##tname.erase(i);                                                   \
+      unregisterKey(name);                                                     \
       return;                                                                  \
     }                                                                          \
   }
@@ -78,6 +268,7 @@ void Pool::remove(const string& name) {
   SEARCH_AND_DESTROY(vector<Real>, Real);
   SEARCH_AND_DESTROY(vector<Real>, SingleVectorReal);
   SEARCH_AND_DESTROY(vector<vector<Real> >, VectorReal);
+  SEARCH_AND_DESTROY(FrameMatrix, VectorRealMatrix);
 
   SEARCH_AND_DESTROY(string, SingleString);
   SEARCH_AND_DESTROY(vector<string>, String);
@@ -90,6 +281,39 @@ void Pool::remove(const string& name) {
   #undef SEARCH_AND_DESTROY
 }
 
+void Pool::take(const string& name, FrameMatrix& frames) {
+  bool found;
+  {
+    MutexLocker lock(mutexVectorRealMatrix);
+    map<string, FrameMatrix>::iterator it = _poolVectorRealMatrix.find(name);
+    found = it != _poolVectorRealMatrix.end();
+    if (found) frames.swap(it->second);
+  }
+  if (!found) {
+    throw EssentiaException("Pool::take: the frames of '", name, "' are not stored contiguously");
+  }
+  remove(name);
+}
+
+template <>
+void Pool::take(const string& name, vector<vector<Real> >& value) {
+  bool isMatrix;
+  {
+    MutexLocker lock(mutexVectorRealMatrix);
+    isMatrix = _poolVectorRealMatrix.find(name) != _poolVectorRealMatrix.end();
+  }
+  if (isMatrix) {
+    FrameMatrix frames;
+    take(name, frames);
+    value = frames.toRows();
+    return;
+  }
+
+  vector<vector<Real> >& stored = const_cast<vector<vector<Real> >&>(this->value<vector<vector<Real> > >(name));
+  value.swap(stored);
+  remove(name);
+}
+
 void Pool::removeNamespace(const string& ns) {
 
   #define SEARCH_AND_DESTROY(t, tname)                              \
@@ -103,6 +327,7 @@ void Pool::removeNamespace(const string& ns) {
     while (it != _pool##tname.end()) {                              \
       string::size_type strIdx = it->first.find(ns+".");            \
       if (strIdx==0) {                                              \
+        unregisterKey(it->first);                                   \
         _pool##tname.erase(it);                                     \
         if (pos == 0) it = _pool##tname.begin();                    \
         else it = tmpIt;                                            \
@@ -119,6 +344,7 @@ void Pool::removeNamespace(const string& ns) {
   SEARCH_AND_DESTROY(vector<Real>, Real);
   SEARCH_AND_DESTROY(vector<Real>, SingleVectorReal);
   SEARCH_AND_DESTROY(vector<vector<Real> >, VectorReal);
+  SEARCH_AND_DESTROY(FrameMatrix, VectorRealMatrix);
 
   SEARCH_AND_DESTROY(string, SingleString);
   SEARCH_AND_DESTROY(vector<string>, String);
@@ -151,6 +377,7 @@ vector<string> Pool::descriptorNames() const {
   ADD_DESC_NAMES(vector<Real>, Real);
   ADD_DESC_NAMES(vector<Real>, SingleVectorReal);
   ADD_DESC_NAMES(vector<vector<Real> >, VectorReal);
+  ADD_DESC_NAMES(FrameMatrix, VectorRealMatrix);
   ADD_DESC_NAMES(string, SingleString);
   ADD_DESC_NAMES(vector<string>, String);
   ADD_DESC_NAMES(vector<string>, SingleVectorString);  
@@ -180,6 +407,7 @@ vector<string> Pool::descriptorNames(const std::string& ns) const {
   ADD_DESC_NAMES(vector<Real>, Real);
   ADD_DESC_NAMES(vector<Real>, SingleVectorReal);
   ADD_DESC_NAMES(vector<vector<Real> >, VectorReal);
+  ADD_DESC_NAMES(FrameMatrix, VectorRealMatrix);
   ADD_DESC_NAMES(string, SingleString);
   ADD_DESC_NAMES(vector<string>, String);
   ADD_DESC_NAMES(vector<string>, SingleVectorString);
@@ -197,6 +425,7 @@ vector<string> Pool::descriptorNames(const std::string& ns) const {
 vector<string> Pool::descriptorNamesNoLocking() const {
   vector<string> descNames(_poolReal.size()         +
                            _poolVectorReal.size()   +
+                           _poolVectorRealMatrix.size() +
                            _poolString.size()       +
                            _poolVectorString.size() +
                            _poolArray2DReal.size()  +
@@ -218,6 +447,7 @@ vector<string> Pool::descriptorNamesNoLocking() const {
   ADD_DESC_NAMES(vector<Real>, Real);
   ADD_DESC_NAMES(vector<Real>, SingleVectorReal);
   ADD_DESC_NAMES(vector<vector<Real> >, VectorReal);
+  ADD_DESC_NAMES(FrameMatrix, VectorRealMatrix);
   ADD_DESC_NAMES(string, SingleString);
   ADD_DESC_NAMES(vector<string>, String);
   ADD_DESC_NAMES(vector<string>, SingleVectorString);
@@ -232,28 +462,54 @@ vector<string> Pool::descriptorNamesNoLocking() const {
 }
 
 void Pool::validateKey(const string& name) {
-  std::vector<std::string> allNames = descriptorNamesNoLocking();
-  for (int i=0; i<int(allNames.size()); ++i) {
-    /* first check if name already exists in another sub-pool */
-    if (name == allNames[i]) {
-      throw EssentiaException("Pool: Cannot set/add/merge value to the pool under "
-                              "the name '"+name+"' because that name already exists but "
-                              "contains a different data type than value");
+  // the interned names tell us whether the name or any of its parents is
+  // used, and whether it has children, without having to look at all the
+  // other names
+  bool exists = false, hasChildren = false;
+  string parent;
+  {
+    MutexLocker lock(mutexKeys);
+    DescriptorId id = _keys.find(name);
+    if (id >= 0) {
+      exists = _keyInfo[id].kind != NoKey;
+      hasChildren = _keyInfo[id].children > 0;
     }
-    /* now check if adding this new key will result in a parent descriptor
-     * having a value and child descriptors (there are 2 cases where this can
-     * happen)*/
-    if ( name.find(allNames[i] + ".") == 0 ) {
-      throw EssentiaException("Pool: Cannot set/add/merge value to the pool under the name '"+name+
-                              "' because '"+name+"' has a parent descriptor name already in "
-                              "the pool (e.g. '"+allNames[i]+"')");
+    for (string::size_type pos = name.find('.'); pos != string::npos; pos = name.find('.', pos+1)) {
+      DescriptorId pid = _keys.find(name.substr(0, pos));
+      if (pid >= 0 && _keyInfo[pid].kind != NoKey) {
+        parent = name.substr(0, pos);
+        break;
+      }
     }
+  }
+
+  /* first check if name already exists in another sub-pool */
+  if (exists) {
+    throw EssentiaException("Pool: Cannot set/add/merge value to the pool under "
+                            "the name '"+name+"' because that name already exists but "
+                            "contains a different data type than value");
+  }
+  /* now check if adding this new key will result in a parent descriptor
+   * having a value and child descriptors (there are 2 cases where this can
+   * happen)*/
+  if (!parent.empty()) {
+    throw EssentiaException("Pool: Cannot set/add/merge value to the pool under the name '"+name+
+                            "' because '"+name+"' has a parent descriptor name already in "
+                            "the pool (e.g. '"+parent+"')");
+  }
 
-    if ( allNames[i].find(name+".") == 0 ) {
-      throw EssentiaException("Pool: Cannot add/set/merge value to the pool under "
-                              "the name '"+name+"' because '"+name+"' has child descriptor "
-                              "names (e.g. '"+allNames[i]+"')");
+  if (hasChildren) {
+    std::vector<std::string> allNames = descriptorNamesNoLocking();
+    std::string child;
+    for (int i=0; i<int(allNames.size()); ++i) {
+      if (allNames[i].find(name+".") == 0) {
+        child = allNames[i];
+        break;
+      }
     }
+    throw EssentiaException("Pool: Cannot add/set/merge value to the pool under "
+                            "the name '"+name+"' because '"+name+"' has child descriptor "
+                            "names (e.g. '"+child+"')");
   }
 }
 
@@ -276,15 +532,190 @@ void Pool::add(const string& name, const type& value, bool validityCheck) {  \
   GLOBAL_LOCK                                                                \
   validateKey(name);                                                         \
   _pool##tname[name].push_back(value);                                       \
+  registerKey(name, Key##tname, &_pool##tname[name]);                        \
+}                                                                            \
+                                                                             \
+void Pool::add(DescriptorId id, const type& value, bool validityCheck) {     \
+  {                                                                          \
+    MutexLocker lock(mutex##tname);                                          \
+    if (validityCheck && !isValid(value)) {                                  \
+      throw EssentiaException("Pool::add value contains invalid numbers (NaN or inf)");\
+    }                                                                        \
+    vector<type >* values = 0;                                               \
+    {                                                                        \
+      MutexLocker lockKeys(mutexKeys);                                       \
+      if (id < 0 || id >= (int)_keyInfo.size()) {                            \
+        throw EssentiaException("Pool::add invalid descriptor id: ", id);    \
+      }                                                                      \
+      if (_keyInfo[id].kind == Key##tname) {                                 \
+        values = (vector<type >*)_keyInfo[id].values;                        \
+      }                                                                      \
+    }                                                                        \
+    if (values) {                                                            \
+      values->push_back(value);                                              \
+      return;                                                                \
+    }                                                                        \
+  }                                                                          \
+  /* first value for this descriptor, go through the validation */           \
+  add(descriptorName(id), value);                                            \
 }
 
 
 SPECIALIZE_ADD_IMPL(Real, Real);
-SPECIALIZE_ADD_IMPL(vector<Real>, VectorReal);
 SPECIALIZE_ADD_IMPL(string, String);
 SPECIALIZE_ADD_IMPL(vector<string>, VectorString);
 SPECIALIZE_ADD_IMPL(StereoSample, StereoSample);
 
+// special add for vector<Real>
+// the frames are stored in a FrameMatrix as long as they all have the same
+// size, and converted to one vector per frame otherwise
+void Pool::add(const string& name, const vector<Real>& value, bool validityCheck) {
+  {
+    MutexLocker lock(mutexVectorReal);
+    MutexLocker lockMatrix(mutexVectorRealMatrix);
+    if (validityCheck && !isValid(value)) {
+      throw EssentiaException("Pool::add value contains invalid numbers (NaN or inf)");
+    }
+    map<string, FrameMatrix>::iterator matrix = _poolVectorRealMatrix.find(name);
+    if (matrix != _poolVectorRealMatrix.end()) {
+      if ((int)value.size() == matrix->second.cols()) {
+        matrix->second.appendRow(&value[0]);
+        return;
+      }
+      ForcedMutexLocker lockConversion(mutexConversion);
+      convertToRows(name);
+    }
+    PoolOf(vector<Real>)::iterator rows = _poolVectorReal.find(name);
+    if (rows != _poolVectorReal.end()) {
+      rows->second.push_back(value);
+      return;
+    }
+  }
+  GLOBAL_LOCK
+  validateKey(name);
+  if (value.empty()) {
+    _poolVectorReal[name].push_back(value);
+    registerKey(name, KeyVectorReal, &_poolVectorReal[name]);
+    return;
+  }
+  FrameMatrix& matrix = _poolVectorRealMatrix[name];
+  matrix = FrameMatrix(value.size());
+  matrix.appendRow(&value[0]);
+  registerKey(name, KeyVectorRealMatrix, &matrix);
+}
+
+void Pool::add(DescriptorId id, const vector<Real>& value, bool validityCheck) {
+  {
+    MutexLocker lock(mutexVectorReal);
+    MutexLocker lockMatrix(mutexVectorRealMatrix);
+    if (validityCheck && !isValid(value)) {
+      throw EssentiaException("Pool::add value contains invalid numbers (NaN or inf)");
+    }
+    KeyInfo info;
+    {
+      MutexLocker lockKeys(mutexKeys);
+      if (id < 0 || id >= (int)_keyInfo.size()) {
+        throw EssentiaException("Pool::add invalid descriptor id: ", id);
+      }
+      info = _keyInfo[id];
+    }
+    if (info.kind == KeyVectorRealMatrix) {
+      FrameMatrix* matrix = (FrameMatrix*)info.values;
+      if ((int)value.size() == matrix->cols()) {
+        matrix->appendRow(&value[0]);
+        return;
+      }
+    }
+    else if (info.kind == KeyVectorReal) {
+      ((vector<vector<Real> >*)info.values)->push_back(value);
+      return;
+    }
+  }
+  /* first value for this descriptor or frame of a different size, go
+   * through the slow path */
+  add(descriptorName(id), value);
+}
+
+// true if all the frames have the given size, which is not 0
+static bool haveSize(const vector<vector<Real> >& frames, int size) {
+  if (size <= 0) return false;
+  for (int i=0; i<(int)frames.size(); ++i) {
+    if ((int)frames[i].size() != size) return false;
+  }
+  return true;
+}
+
+template <>
+void Pool::append(const string& name, const vector<vector<Real> >& values) {
+  {
+    MutexLocker lock(mutexVectorReal);
+    MutexLocker lockMatrix(mutexVectorRealMatrix);
+    map<string, FrameMatrix>::iterator matrix = _poolVectorRealMatrix.find(name);
+    if (matrix != _poolVectorRealMatrix.end()) {
+      if (haveSize(values, matrix->second.cols())) {
+        for (int i=0; i<(int)values.size(); ++i) matrix->second.appendRow(&values[i][0]);
+        return;
+      }
+      ForcedMutexLocker lockConversion(mutexConversion);
+      convertToRows(name);
+    }
+    PoolOf(vector<Real>)::iterator rows = _poolVectorReal.find(name);
+    if (rows != _poolVectorReal.end()) {
+      rows->second.insert(rows->second.end(), values.begin(), values.end());
+      return;
+    }
+  }
+
+  GLOBAL_LOCK
+  validateKey(name);
+  if (values.empty() || !haveSize(values, values[0].size())) {
+    _poolVectorReal[name] = values;
+    registerKey(name, KeyVectorReal, &_poolVectorReal[name]);
+    return;
+  }
+  FrameMatrix& matrix = _poolVectorRealMatrix[name];
+  matrix = FrameMatrix(values[0].size());
+  matrix.reserveRows(values.size());
+  for (int i=0; i<(int)values.size(); ++i) matrix.appendRow(&values[i][0]);
+  registerKey(name, KeyVectorRealMatrix, &matrix);
+}
+
+#ifdef CPP_11
+template <>
+void Pool::append(const string& name, vector<vector<Real> >&& values) {
+  {
+    MutexLocker lock(mutexVectorReal);
+    PoolOf(vector<Real>)::iterator rows = _poolVectorReal.find(name);
+    if (rows != _poolVectorReal.end()) {
+      rows->second.insert(rows->second.end(), make_move_iterator(values.begin()),
+                          make_move_iterator(values.end()));
+      values.clear();
+      return;
+    }
+  }
+
+  bool isMatrix;
+  {
+    MutexLocker lock(mutexVectorRealMatrix);
+    isMatrix = _poolVectorRealMatrix.find(name) != _poolVectorRealMatrix.end();
+  }
+  if (isMatrix) {
+    // the frames are copied anyway when they are stored in a FrameMatrix
+    append(name, static_cast<const vector<vector<Real> >&>(values));
+    values.clear();
+    return;
+  }
+
+  // new descriptor: keep the moved frames as they are rather than copying
+  // them into a FrameMatrix
+  GLOBAL_LOCK
+  validateKey(name);
+  _poolVectorReal[name] = std::move(values);
+  values.clear();
+  registerKey(name, KeyVectorReal, &_poolVectorReal[name]);
+}
+#endif
+
 // special add for Array2d<Real>
 // Array2D needs a special add that cannot be implemented in the macro because
 // we need to call the function copy(), or otherwise we only get references
@@ -304,6 +735,31 @@ void Pool::add(const string& name, const Array2D<Real>& value, bool validityChec
   GLOBAL_LOCK
   validateKey(name);
   _poolArray2DReal[name].push_back(value.copy());
+  registerKey(name, KeyArray2DReal, &_poolArray2DReal[name]);
+}
+
+void Pool::add(DescriptorId id, const Array2D<Real>& value, bool validityCheck) {
+  {
+    MutexLocker lock(mutexArray2DReal);
+    if (validityCheck && !isValid(value)) {
+      throw EssentiaException("Pool::add array contains invalid numbers (NaN or inf)");
+    }
+    vector<Array2D<Real> >* values = 0;
+    {
+      MutexLocker lockKeys(mutexKeys);
+      if (id < 0 || id >= (int)_keyInfo.size()) {
+        throw EssentiaException("Pool::add invalid descriptor id: ", id);
+      }
+      if (_keyInfo[id].kind == KeyArray2DReal) {
+        values = (vector<Array2D<Real> >*)_keyInfo[id].values;
+      }
+    }
+    if (values) {
+      values->push_back(value.copy());
+      return;
+    }
+  }
+  add(descriptorName(id), value);
 }
 
 #define SPECIALIZE_SET_IMPL(type, tname)                                     \
@@ -324,6 +780,7 @@ void Pool::set(const string& name, const type& value, bool validityCheck) {  \
   GLOBAL_LOCK                                                                \
   validateKey(name);                                                         \
   _poolSingle##tname[name] = value;                                          \
+  registerKey(name, KeySingle##tname, &_poolSingle##tname[name]);            \
 }
 
 SPECIALIZE_SET_IMPL(Real, Real)
@@ -336,11 +793,11 @@ void Pool::merge(Pool& p, const string& mergeType) {
 
   #define MERGE_POOL(t, tname) {                                                     \
     vector<string> descNames;                                                        \
-    descNames.reserve(p.get##tname##Pool().size());                                  \
     {                                                                                \
       MutexLocker lock(p.mutex##tname);                                              \
-      for (map<string, vector<t> >::const_iterator it = p.get##tname##Pool().begin();\
-           it != p.get##tname##Pool().end();                                         \
+      descNames.reserve(p._pool##tname.size());                                      \
+      for (map<string, vector<t> >::const_iterator it = p._pool##tname.begin();      \
+           it != p._pool##tname.end();                                               \
            ++it) {                                                                   \
         descNames.push_back(it->first);                                              \
       }                                                                              \
@@ -376,6 +833,31 @@ void Pool::merge(Pool& p, const string& mergeType) {
   MERGE_POOL(Real, Real);
   MERGE_POOL(string, String);
   MERGE_POOL(vector<Real>, VectorReal);
+  // the descriptors stored in a FrameMatrix are merged as one vector per frame,
+  // without converting them in p
+  {
+    vector<string> descNames;
+    {
+      MutexLocker lock(p.mutexVectorRealMatrix);
+      for (map<string, FrameMatrix>::const_iterator it = p._poolVectorRealMatrix.begin();
+           it != p._poolVectorRealMatrix.end(); ++it) {
+        descNames.push_back(it->first);
+      }
+    }
+    for (int i=0; i < int(descNames.size()); ++i) {
+      vector<vector<Real> > frames;
+      bool converted;
+      {
+        MutexLocker lock(p.mutexVectorRealMatrix);
+        ForcedMutexLocker lockConversion(p.mutexConversion);
+        map<string, FrameMatrix>::const_iterator it = p._poolVectorRealMatrix.find(descNames[i]);
+        converted = it == p._poolVectorRealMatrix.end();
+        if (!converted) frames = it->second.toRows();
+      }
+      if (converted) frames = p.value<vector<vector<Real> > >(descNames[i]);
+      merge(descNames[i], frames, mergeType);
+    }
+  }
   MERGE_POOL(vector<string>, VectorString);
   MERGE_POOL(StereoSample, StereoSample);
   MERGE_POOL(TNT::Array2D<Real>, Array2DReal);
@@ -384,6 +866,98 @@ void Pool::merge(Pool& p, const string& mergeType) {
   #undef MERGE_POOL
 }
 
+void Pool::absorb(Pool& p, const string& mergeType) {
+  if (this == &p) return;
+
+  // the values are first moved out of p, so that the locks of p are never
+  // held together with the ones of this pool, as another thread may be
+  // absorbing this pool into p. The local pool needs no locking.
+  Pool source;
+  source.swap(p);
+
+  // descriptors which are not in this pool yet are moved, the other ones are
+  // merged as usual (which also throws if the merge type does not allow it).
+  // Each descriptor is removed from the source once it has been absorbed.
+  #define ABSORB_POOL(t, tname)                                                      \
+  for (map<string, vector<t> >::iterator it = source._pool##tname.begin();           \
+       it != source._pool##tname.end(); source._pool##tname.erase(it++)) {           \
+    bool exists;                                                                     \
+    {                                                                                \
+      MutexLocker lock(mutex##tname);                                                \
+      if (Key##tname == KeyVectorReal) {                                             \
+        MutexLocker lockMatrix(mutexVectorRealMatrix);                               \
+        ForcedMutexLocker lockConversion(mutexConversion);                           \
+        convertToRows(it->first);                                                    \
+      }                                                                              \
+      exists = _pool##tname.find(it->first) != _pool##tname.end();                   \
+    }                                                                                \
+    if (exists || it->second.empty()) {                                              \
+      merge(it->first, it->second, mergeType);                                       \
+      continue;                                                                      \
+    }                                                                                \
+    GLOBAL_LOCK                                                                      \
+    validateKey(it->first);                                                          \
+    vector<t>& values = _pool##tname[it->first];                                     \
+    values.swap(it->second);                                                         \
+    registerKey(it->first, Key##tname, &values);                                     \
+  }
+
+  #define ABSORB_SINGLE_POOL(t, tname)                                       \
+  for (map<string, t>::iterator it = source._pool##tname.begin();            \
+       it != source._pool##tname.end(); source._pool##tname.erase(it++)) {   \
+    bool exists;                                                             \
+    {                                                                        \
+      MutexLocker lock(mutex##tname);                                        \
+      exists = _pool##tname.find(it->first) != _pool##tname.end();           \
+    }                                                                        \
+    if (exists) {                                                            \
+      mergeSingle(it->first, it->second, mergeType);                         \
+      continue;                                                              \
+    }                                                                        \
+    GLOBAL_LOCK                                                              \
+    validateKey(it->first);                                                  \
+    t& value = _pool##tname[it->first];                                      \
+    std::swap(value, it->second);                                            \
+    registerKey(it->first, Key##tname, &value);                              \
+  }
+
+  try {
+    // single value:
+    ABSORB_SINGLE_POOL(Real, SingleReal);
+    ABSORB_SINGLE_POOL(string, SingleString);
+    ABSORB_SINGLE_POOL(vector<Real>, SingleVectorReal);
+    ABSORB_SINGLE_POOL(vector<string>, SingleVectorString);
+
+    // multiple value:
+    ABSORB_POOL(Real, Real);
+    ABSORB_POOL(string, String);
+    ABSORB_POOL(vector<Real>, VectorReal);
+    for (map<string, FrameMatrix>::iterator it = source._poolVectorRealMatrix.begin();
+         it != source._poolVectorRealMatrix.end(); source._poolVectorRealMatrix.erase(it++)) {
+      if (contains<vector<vector<Real> > >(it->first)) {
+        merge(it->first, it->second.toRows(), mergeType);
+        continue;
+      }
+      GLOBAL_LOCK
+      validateKey(it->first);
+      FrameMatrix& matrix = _poolVectorRealMatrix[it->first];
+      matrix.swap(it->second);
+      registerKey(it->first, KeyVectorRealMatrix, &matrix);
+    }
+    ABSORB_POOL(vector<string>, VectorString);
+    ABSORB_POOL(StereoSample, StereoSample);
+    ABSORB_POOL(TNT::Array2D<Real>, Array2DReal);
+  }
+  catch (...) {
+    // the descriptors which have not been absorbed go back to p
+    p.absorb(source);
+    throw;
+  }
+
+  #undef ABSORB_SINGLE_POOL
+  #undef ABSORB_POOL
+}
+
 #define SPECIALIZE_MERGE_IMPL(type, tname)                                                             \
 void Pool::merge(const string& name, const vector<type>& value, const string& mergeType) {             \
   if (value.empty()) return;                                                                           \
@@ -392,6 +966,12 @@ void Pool::merge(const string& name, const vector<type>& value, const string& me
    * just add it, if not, we need to run some validation tests */                                      \
   {                                                                                                    \
     MutexLocker lock(mutex##tname);                                                                    \
+    if (Key##tname == KeyVectorReal) {                                                                 \
+      /* the values are merged as one vector per frame */                                              \
+      MutexLocker lockMatrix(mutexVectorRealMatrix);                                                   \
+      ForcedMutexLocker lockConversion(mutexConversion);                                               \
+      convertToRows(name);                                                                             \
+    }                                                                                                  \
     map<string, vector<type> >::iterator it = _pool##tname.find(name);                                 \
     if (it != _pool##tname.end()) {                                                                    \
       if (mergeType == "") {                                                                           \
@@ -408,6 +988,7 @@ void Pool::merge(const string& name, const vector<type>& value, const string& me
       else if (mergeType == "replace") {                                                               \
         _pool##tname.erase(it);                                                                        \
         _pool##tname.insert(make_pair(name, value));                                                   \
+        registerKey(name, Key##tname, &_pool##tname[name]);                                            \
       }                                                                                                \
       else if (mergeType=="interleave") {                                                              \
         if (value.size() != _pool##tname[name].size()) {                                               \
@@ -422,6 +1003,7 @@ void Pool::merge(const string& name, const vector<type>& value, const string& me
           _pool##tname[name].push_back(temp[i]);                                                       \
           _pool##tname[name].push_back(value[i]);                                                      \
         }                                                                                              \
+        registerKey(name, Key##tname, &_pool##tname[name]);                                            \
         return;\
       }                                                                                                \
       else {                                                                                           \
@@ -437,6 +1019,7 @@ void Pool::merge(const string& name, const vector<type>& value, const string& me
   for (int i=1; i<(int)value.size(); ++i) {                                                            \
     _pool##tname[name].push_back(value[i]);                                                            \
   }                                                                                                    \
+  registerKey(name, Key##tname, &_pool##tname[name]);                                                  \
 }
 
 SPECIALIZE_MERGE_IMPL(Real, Real);
@@ -457,6 +1040,7 @@ void Pool::mergeSingle(const string& name, const type& value, const string& merg
       if (mergeType == "replace") {                                                                    \
         _poolSingle##tname.erase(it);                                                                  \
         _poolSingle##tname.insert(make_pair(name, value));                                             \
+        registerKey(name, KeySingle##tname, &_poolSingle##tname[name]);                                \
       }                                                                                                \
       else {                                                                                           \
         throw EssentiaException("Pool::mergeSingle, values for single value descriptors can only be"   \
@@ -469,6 +1053,7 @@ void Pool::mergeSingle(const string& name, const type& value, const string& merg
   GLOBAL_LOCK                                                                                          \
   validateKey(name);                                                                                   \
   _poolSingle##tname.insert(make_pair(name, value));                                                   \
+  registerKey(name, KeySingle##tname, &_poolSingle##tname[name]);                                      \
 }
 
 SPECIALIZE_MERGE_SINGLE_IMPL(Real, Real)
@@ -501,6 +1086,7 @@ void Pool::merge(const string& name, const vector<Array2D<Real> >& value, const
         for(int i=0; i<int(value.size()); i++) {
           _poolArray2DReal[name].push_back(value[i].copy());
         }
+        registerKey(name, KeyArray2DReal, &_poolArray2DReal[name]);
       }
       else if (mergeType=="interleave") {
         if (value.size() != _poolArray2DReal[name].size()) {
@@ -515,6 +1101,7 @@ void Pool::merge(const string& name, const vector<Array2D<Real> >& value, const
           _poolArray2DReal[name].push_back(temp[i].copy());
           _poolArray2DReal[name].push_back(value[i].copy());
         }
+        registerKey(name, KeyArray2DReal, &_poolArray2DReal[name]);
         return;
       }
       else {
@@ -530,6 +1117,7 @@ void Pool::merge(const string& name, const vector<Array2D<Real> >& value, const
   for (int i=1; i<(int)value.size(); ++i) {
     _poolArray2DReal[name].push_back(value[i].copy());
   }
+  registerKey(name, KeyArray2DReal, &_poolArray2DReal[name]);
 }
 
 bool Pool::isSingleValue(const string& name) {
@@ -20,10 +20,13 @@
 #ifndef ESSENTIA_POOL_H
 #define ESSENTIA_POOL_H
 
+#include <iterator>
 #include "types.h"
 #include "threading.h"
 #include "utils/tnt/tnt.h"
 #include "essentiautil.h"
+#include "utils/stringindex.h"
+#include "framematrix.h"
 
 namespace essentia {
 
@@ -34,6 +37,11 @@ namespace essentia {
 
 typedef std::string DescriptorName;
 
+/**
+ * Integer handle to a descriptor name of a given Pool, see Pool::descriptorId.
+ */
+typedef int DescriptorId;
+
 /**
  * The pool is a storage structure which can hold frames of all kinds of
  * descriptors. A Pool instance is thread-safe.
@@ -81,6 +89,7 @@ typedef std::string DescriptorName;
  *
  *         MutexLocker lockReal(mutexReal)
  *         MutexLocker lockVectorReal(mutexVectorReal)
+ *         MutexLocker lockVectorRealMatrix(mutexVectorRealMatrix)
  *         MutexLocker lockString(mutexString)
  *         MutexLocker lockVectorString(mutexVectorString)
  *         MutexLocker lockArray2DReal(mutexArray2DReal)
@@ -92,6 +101,22 @@ typedef std::string DescriptorName;
  *
  * To release the locks, the order should be reversed!
  *
+ * The descriptor names are also interned: each name gets an integer id
+ * (DescriptorId), which can be used instead of the name to add values to the
+ * pool. Adding by id does not need to look the name up nor to validate it,
+ * which is what PoolStorage does for each frame. The index of names is
+ * protected by mutexKeys, which should be acquired after all the other
+ * mutexes.
+ *
+ * The frames of a vector of Reals descriptor are stored contiguously in a
+ * FrameMatrix as long as they all have the same size, which is the case of
+ * most frame-level descriptors (MFCC, mel bands, HPCP...). When a frame of a
+ * different size is added, the descriptor is converted to one vector per
+ * frame. It is also converted when its values are requested as a vector of
+ * vectors with value() or getVectorRealPool(), so code which does not want to
+ * pay for the conversion should use getVectorRealMatrixPool() and
+ * getVectorRealRowsPool() instead.
+ *
  */
 class Pool {
 
@@ -104,12 +129,64 @@ class Pool {
 
   // maps for vectors of values:
   PoolOf(Real) _poolReal;
-  PoolOf(std::vector<Real>) _poolVectorReal;
+  // the vector of Reals descriptors are converted from a FrameMatrix to one
+  // vector per frame when needed, even in a const pool, see convertToRows()
+  mutable PoolOf(std::vector<Real>) _poolVectorReal;                // frames of different sizes
+  mutable std::map<std::string, FrameMatrix> _poolVectorRealMatrix; // frames of the same size
   PoolOf(std::string) _poolString;
   PoolOf(std::vector<std::string>) _poolVectorString;
   PoolOf(TNT::Array2D<Real>) _poolArray2DReal;
   PoolOf(StereoSample) _poolStereoSample;
 
+  // sub-pool in which a descriptor is stored
+  enum KeyType {
+    NoKey, KeyReal, KeyVectorReal, KeyString, KeyVectorString, KeyArray2DReal,
+    KeyStereoSample, KeySingleReal, KeySingleString, KeySingleVectorReal,
+    KeySingleVectorString, KeyVectorRealMatrix
+  };
+
+  struct KeyInfo {
+    KeyType kind;
+    void* values;  // the value stored in the sub-pool, or 0 if the name is not used
+    int children;  // number of descriptors whose name starts with this name + "."
+    KeyInfo() : kind(NoKey), values(0), children(0) {}
+  };
+
+  // interned descriptor names (and their parents), indexed by DescriptorId
+  util::StringIndex _keys;
+  mutable std::vector<KeyInfo> _keyInfo;
+
+  DescriptorId internKey(const std::string& name);
+
+  /**
+   * Records that the descriptor @e name is now stored in the given sub-pool,
+   * or updates where its value is stored.
+   */
+  void registerKey(const std::string& name, KeyType type, void* values);
+
+  /**
+   * Records that the descriptor @e name has been removed from its sub-pool.
+   */
+  void unregisterKey(const std::string& name);
+
+  /**
+   * Converts the vector of Reals descriptor @e name from a FrameMatrix to one
+   * vector per frame, if it is stored as a FrameMatrix. This does not change
+   * the values of the descriptor, which is why it is allowed on a const pool.
+   * WARNING: this function assumes that mutexVectorReal,
+   * mutexVectorRealMatrix and mutexConversion are locked
+   */
+  void convertToRows(const std::string& name) const;
+
+  // the conversions from a FrameMatrix happen in const functions, which may be
+  // called from several threads at the same time, so the sub-pools of vector
+  // of Reals are always protected by a real mutex when they are converted
+  mutable ForcedMutex mutexConversion;
+
+  // registers all the descriptors of the sub-pools, keeping the existing ids
+  // WARNING: this function assumes that all sub-pools are locked
+  void rebuildKeys();
+
   // WARNING: this function assumes that all sub-pools are locked
   std::vector<std::string> descriptorNamesNoLocking() const;
 
@@ -122,9 +199,33 @@ class Pool {
 
  public:
 
-  mutable Mutex mutexReal, mutexVectorReal, mutexString, mutexVectorString,
+  mutable Mutex mutexReal, mutexVectorReal, mutexVectorRealMatrix, mutexString, mutexVectorString,
                 mutexArray2DReal, mutexStereoSample,
-                mutexSingleReal, mutexSingleString, mutexSingleVectorReal, mutexSingleVectorString;
+                mutexSingleReal, mutexSingleString, mutexSingleVectorReal, mutexSingleVectorString,
+                mutexKeys;
+
+  Pool() {}
+  Pool(const Pool& p);
+  Pool& operator=(const Pool& p);
+
+#ifdef CPP_11
+  /**
+   * Moves the descriptors of @e p into a new pool, @e p is empty afterwards.
+   */
+  Pool(Pool&& p);
+
+  /**
+   * Replaces the descriptors of this pool with the ones of @e p, without
+   * copying them. @e p is empty afterwards.
+   */
+  Pool& operator=(Pool&& p);
+#endif
+
+  /**
+   * Exchanges the descriptors of this pool with the ones of @e p, without
+   * copying any value. The descriptor ids of both pools stay the same.
+   */
+  void swap(Pool& p);
 
   /**
    * Adds @e value to the Pool under @e name
@@ -165,6 +266,41 @@ class Pool {
   /** @copydoc add(const std::string&,const Real&,bool) */
   void add(const std::string& name, const StereoSample& value, bool validityCheck = false);
 
+  /**
+   * @returns the id of the descriptor name @e name, which can be used instead
+   *          of it to add values to this pool. Ids are specific to a pool,
+   *          and stay valid for the lifetime of the pool, even if the
+   *          descriptor is removed or the pool is cleared.
+   */
+  DescriptorId descriptorId(const std::string& name);
+
+  /**
+   * @returns the descriptor name of the given id
+   */
+  std::string descriptorName(DescriptorId id) const;
+
+  /**
+   * Adds @e value to the Pool under the descriptor name of the given @e id.
+   * This is equivalent to add(descriptorName(id), value, validityCheck), but
+   * does not need to look the name up once the descriptor exists.
+   */
+  void add(DescriptorId id, const Real& value, bool validityCheck = false);
+
+  /** @copydoc add(DescriptorId,const Real&,bool) */
+  void add(DescriptorId id, const std::vector<Real>& value, bool validityCheck = false);
+
+  /** @copydoc add(DescriptorId,const Real&,bool) */
+  void add(DescriptorId id, const std::string& value, bool validityCheck = false);
+
+  /** @copydoc add(DescriptorId,const Real&,bool) */
+  void add(DescriptorId id, const std::vector<std::string>& value, bool validityCheck = false);
+
+  /** @copydoc add(DescriptorId,const Real&,bool) */
+  void add(DescriptorId id, const TNT::Array2D<Real>& value, bool validityCheck = false);
+
+  /** @copydoc add(DescriptorId,const Real&,bool) */
+  void add(DescriptorId id, const StereoSample& value, bool validityCheck = false);
+
   /**
    * WARNING: this is an utility method that might fail in weird ways if not used
    * correctly. When in doubt, always use the add() method. This is provided for
@@ -173,6 +309,15 @@ class Pool {
   template <typename T>
   void append(const std::string& name, const std::vector<T>& values);
 
+#ifdef CPP_11
+  /**
+   * Same as append(const std::string&, const std::vector<T>&), but moves the
+   * values out of @e values instead of copying them.
+   */
+  template <typename T>
+  void append(const std::string& name, std::vector<T>&& values);
+#endif
+
   /**
    * \brief Sets the value of a descriptor name.
    *
@@ -226,6 +371,19 @@ class Pool {
 
   void merge(Pool& p, const std::string& type="");
 
+  /**
+   * \brief Merges the given pool @e p into the current pool, moving its values
+   * instead of copying them.
+   *
+   * \details This is the same as merge(Pool&, const std::string&), except that
+   * @e p is empty afterwards. The values of the descriptors which are not in
+   * the current pool yet are moved without copying them, the other ones are
+   * merged as with merge(Pool&, const std::string&). If an exception is
+   * thrown, the descriptors which have already been merged are no longer in
+   * @e p.
+   */
+  void absorb(Pool& p, const std::string& type="");
+
   /**
    * \brief Merges the values given in @e value into the current pool's
    * descriptor given by @e name.
@@ -272,6 +430,25 @@ class Pool {
    */
   void removeNamespace(const std::string& ns);
 
+  /**
+   * Moves the data associated with @e name out of the Pool into @e value,
+   * without copying it, and removes the descriptor name @e name from the
+   * Pool. An EssentiaException is thrown if @e name does not exist in the
+   * Pool.
+   * @param name is the descriptor name that points to the data to take
+   * @tparam T is the type of data that @e name points to, as for value()
+   */
+  template <typename T>
+  void take(const std::string& name, T& value);
+
+  /**
+   * Same as take(), for a descriptor whose frames are stored contiguously
+   * (see getVectorRealMatrixPool()): the storage of the frames is moved out
+   * of the Pool as it is. An EssentiaException is thrown if the frames of
+   * @e name are not stored contiguously.
+   */
+  void take(const std::string& name, FrameMatrix& frames);
+
   /**
    * @returns a the data that is associated with @e name
    * @param name is the descriptor name that points to the data to return
@@ -308,8 +485,26 @@ class Pool {
   /**
    * @returns a map where the key is a descriptor name and the values are
    *          of type vector<Real>
+   * @remark all the descriptors stored as a FrameMatrix are converted to one
+   *         vector per frame first, use getVectorRealMatrixPool() and
+   *         getVectorRealRowsPool() to avoid that. The returned map should not
+   *         be read while another thread converts a descriptor of this pool.
    */
-  const PoolOf(std::vector<Real>)& getVectorRealPool() const { return _poolVectorReal; }
+  const PoolOf(std::vector<Real>)& getVectorRealPool() const;
+
+  /**
+   * @returns a map where the key is a descriptor name and the values are the
+   *          frames of type vector<Real> of the descriptors whose frames all
+   *          have the same size, stored contiguously
+   */
+  const std::map<std::string, FrameMatrix>& getVectorRealMatrixPool() const { return _poolVectorRealMatrix; }
+
+  /**
+   * @returns a map where the key is a descriptor name and the values are of
+   *          type vector<Real>, for the descriptors which are not in
+   *          getVectorRealMatrixPool()
+   */
+  const PoolOf(std::vector<Real>)& getVectorRealRowsPool() const { return _poolVectorReal; }
 
   /**
    * @returns a std::map where the key is a descriptor name and the values are
@@ -399,11 +594,28 @@ inline const type& Pool::value(const std::string& name) const {                \
 SPECIALIZE_VALUE(Real, SingleReal);
 SPECIALIZE_VALUE(std::string, SingleString);
 //SPECIALIZE_VALUE(std::vector<std::string>, String);
-SPECIALIZE_VALUE(std::vector<std::vector<Real> >, VectorReal);
 SPECIALIZE_VALUE(std::vector<std::vector<std::string> >, VectorString);
 SPECIALIZE_VALUE(std::vector<TNT::Array2D<Real> >, Array2DReal);
 SPECIALIZE_VALUE(std::vector<StereoSample>, StereoSample);
 
+// This value function is not under the macro above because the descriptor may
+// have to be converted from a FrameMatrix first
+template<>
+inline const std::vector<std::vector<Real> >& Pool::value(const std::string& name) const {
+  MutexLocker lock(mutexVectorReal);
+  MutexLocker lockMatrix(mutexVectorRealMatrix);
+  ForcedMutexLocker lockConversion(mutexConversion);
+  convertToRows(name);
+  PoolOf(std::vector<Real>)::const_iterator result = _poolVectorReal.find(name);
+  if (result == _poolVectorReal.end()) {
+    std::ostringstream msg;
+    msg << "Descriptor name '" << name << "' of type "
+        << nameOfType(typeid(std::vector<std::vector<Real> >)) << " not found";
+    throw EssentiaException(msg);
+  }
+  return result->second;
+}
+
 // This value function is not under the macro above because it needs to check
 // in two separate sub-pools (poolReal and poolSingleVectorReal)
 template<>
@@ -473,11 +685,21 @@ inline bool Pool::contains<type>(const std::string& name) const {              \
 SPECIALIZE_CONTAINS(Real, SingleReal);
 SPECIALIZE_CONTAINS(std::string, SingleString);
 //SPECIALIZE_CONTAINS(std::vector<std::string>, String);
-SPECIALIZE_CONTAINS(std::vector<std::vector<Real> >, VectorReal);
 SPECIALIZE_CONTAINS(std::vector<std::vector<std::string> >, VectorString);
 SPECIALIZE_CONTAINS(std::vector<TNT::Array2D<Real> >, Array2DReal);
 SPECIALIZE_CONTAINS(std::vector<StereoSample>, StereoSample);
 
+// This function is not under the macro above because it needs to check in two
+// separate sub-pools (poolVectorReal and poolVectorRealMatrix)
+template<>
+inline bool Pool::contains<std::vector<std::vector<Real> > >(const std::string& name) const {
+  MutexLocker lock(mutexVectorReal);
+  MutexLocker lockMatrix(mutexVectorRealMatrix);
+  ForcedMutexLocker lockConversion(mutexConversion);
+  return _poolVectorReal.find(name) != _poolVectorReal.end() ||
+         _poolVectorRealMatrix.find(name) != _poolVectorRealMatrix.end();
+}
+
 // This value function is not under the macro above because it needs to check
 // in two separate sub-pools (poolReal and poolSingleVectorReal)
 template<>
@@ -532,6 +754,7 @@ inline bool Pool::contains<std::vector<std::string> >(const std::string& name) c
 #define GLOBAL_LOCK                                         \
 MutexLocker lockReal(mutexReal);                            \
 MutexLocker lockVectorReal(mutexVectorReal);                \
+MutexLocker lockVectorRealMatrix(mutexVectorRealMatrix);    \
 MutexLocker lockString(mutexString);                        \
 MutexLocker lockVectorString(mutexVectorString);            \
 MutexLocker lockArray2DReal(mutexArray2DReal);              \
@@ -567,15 +790,72 @@ inline void Pool::append(const std::string& name, const std::vector<type>& value
   GLOBAL_LOCK                                                                         \
   validateKey(name);                                                                  \
   _pool##tname[name] = values;                                                        \
+  registerKey(name, Key##tname, &_pool##tname[name]);                                 \
 }
 
 
 SPECIALIZE_APPEND(Real, Real);
-SPECIALIZE_APPEND(std::vector<Real>, VectorReal);
 SPECIALIZE_APPEND(std::string, String);
 SPECIALIZE_APPEND(std::vector<std::string>, VectorString);
 SPECIALIZE_APPEND(StereoSample, StereoSample);
 
+// the frames may have to be stored in a FrameMatrix, see pool.cpp
+template <>
+void Pool::append(const std::string& name, const std::vector<std::vector<Real> >& values);
+
+#ifdef CPP_11
+
+template<typename T>
+inline void Pool::append(const std::string& name, std::vector<T>&& values) {
+  throw EssentiaException("Pool::append not implemented for type: ", nameOfType(typeid(T)));
+}
+
+#define SPECIALIZE_APPEND_MOVE(type, tname)                                           \
+template <>                                                                           \
+inline void Pool::append(const std::string& name, std::vector<type>&& values) {       \
+  {                                                                                   \
+    MutexLocker lock(mutex##tname);                                                   \
+    PoolOf(type)::iterator result = _pool##tname.find(name);                          \
+    if (result != _pool##tname.end()) {                                               \
+      std::vector<type>& v = result->second;                                          \
+      v.insert(v.end(), std::make_move_iterator(values.begin()),                      \
+               std::make_move_iterator(values.end()));                                \
+      values.clear();                                                                 \
+      return;                                                                         \
+    }                                                                                 \
+  }                                                                                   \
+                                                                                      \
+  GLOBAL_LOCK                                                                         \
+  validateKey(name);                                                                  \
+  _pool##tname[name] = std::move(values);                                             \
+  registerKey(name, Key##tname, &_pool##tname[name]);                                 \
+}
+
+SPECIALIZE_APPEND_MOVE(Real, Real);
+SPECIALIZE_APPEND_MOVE(std::string, String);
+SPECIALIZE_APPEND_MOVE(std::vector<std::string>, VectorString);
+SPECIALIZE_APPEND_MOVE(StereoSample, StereoSample);
+
+template <>
+void Pool::append(const std::string& name, std::vector<std::vector<Real> >&& values);
+
+#endif // CPP_11
+
+template <typename T>
+inline void Pool::take(const std::string& name, T& value) {
+  // value() finds the sub-pool in which the descriptor is stored, and throws
+  // if there is none
+  T& stored = const_cast<T&>(this->value<T>(name));
+  using std::swap;
+  swap(value, stored);
+  remove(name);
+}
+
+// frames stored in a FrameMatrix are taken out of it rather than converted
+// to rows in the pool first, see pool.cpp
+template <>
+void Pool::take(const std::string& name, std::vector<std::vector<Real> >& value);
+
 /// @endcond
 
 } // namespace essentia
@@ -167,6 +167,7 @@ vector<NetworkNode*> NetworkNode::addVisibleDependencies(map<Algorithm*, Network
 Network* Network::lastCreated = 0;
 
 Network::Network(Algorithm* generator, bool takeOwnership) : _takeOwnership(takeOwnership),
+                                                             _cacheExecutionNetwork(false),
                                                              _generator(generator),
                                                              _visibleNetworkRoot(0),
                                                              _executionNetworkRoot(0) {
@@ -244,10 +245,8 @@ void Network::run() {
 void Network::runPrepare() {
   // 1- build the execution network here as internal configuration of some
   //    algorithms might have changed since we constructed the Network
-  buildExecutionNetwork();
-
   // 2- get a linear ordering on the newly constructed execution network
-  topologicalSortExecutionNetwork();
+  compileExecutionNetwork();
 
   // 3- make sure all inputs/outputs are correctly connected
   checkConnections();
@@ -255,6 +254,10 @@ void Network::runPrepare() {
   // 4- resize the buffers depending on the requirements of the connected sinks
   checkBufferSizes();
 
+  // 5- make room for rescheduling every algorithm at least once
+  _runStack.clear();
+  _runStack.reserve(_toposortedNetwork.size());
+
 #if DEBUGGING_ENABLED
   for (int i=0; i<(int)_toposortedNetwork.size(); i++) _toposortedNetwork[i]->nProcess = 0;
 #endif
@@ -298,11 +301,12 @@ bool Network::runStep() {
 #endif
 
   // then run each algorithm as many times as needed for them to consume everything on their input
-  stack<int> runStack;
-  runStack.push(1);
+  vector<int>& runStack = _runStack;
+  runStack.clear();
+  runStack.push_back(1);
   while (!runStack.empty()) {
-    int startIndex = runStack.top();
-    runStack.pop();
+    int startIndex = runStack.back();
+    runStack.pop_back();
 
     for (int i=startIndex; i<(int)_toposortedNetwork.size(); i++) {
       // only propagate the end of stream marker as long as we don't have any
@@ -322,7 +326,7 @@ bool Network::runStep() {
         // NOTE: be careful with endOfStream, it should not be propagated
         // as long as we have at least 1 index value on the stack
         if (status == NO_OUTPUT) {
-          runStack.push(i);
+          runStack.push_back(i);
           E_DEBUG(EScheduler, "Rescheduling algorithm " << _toposortedNetwork[i]->name() <<
                   " on generator frame " << gen->nProcess <<
                   " to run later, output buffers temporarily full");
@@ -344,6 +348,98 @@ bool Network::runStep() {
   return true;
 }
 
+// number of tokens produced so far by the given generator
+static int generatorProduced(Algorithm* gen) {
+  int produced = 0;
+  for (int i=0; i<(int)gen->outputs().size(); i++) {
+    produced = max(produced, gen->output(i).totalProduced());
+  }
+  return produced;
+}
+
+int Network::runFor(int tokens) {
+  if (_toposortedNetwork.empty()) return 0;
+  Algorithm* gen = _toposortedNetwork[0];
+
+  int produced = 0;
+  while (produced < tokens) {
+    int before = generatorProduced(gen);
+    if (!runStep()) break;
+
+    int now = generatorProduced(gen);
+    if (now == before) break; // nothing to process for now
+    produced += now - before;
+  }
+
+  return produced;
+}
+
+vector<AlgorithmLatency> Network::latencyReport() {
+  if (_toposortedNetwork.empty()) compileExecutionNetwork();
+
+  // the algorithms which are executed right before each algorithm
+  map<Algorithm*, AlgoVector> parents;
+  NodeVector nodes = depthFirstSearch(_executionNetworkRoot);
+  for (int i=0; i<(int)nodes.size(); i++) {
+    const NodeVector& children = nodes[i]->children();
+    for (int j=0; j<(int)children.size(); j++) {
+      parents[children[j]->algorithm()].push_back(nodes[i]->algorithm());
+    }
+  }
+
+  vector<AlgorithmLatency> report;
+  // number of tokens of the generator before the first token of an algorithm
+  // is produced, and number of tokens of the generator per token it produces
+  map<Algorithm*, int> firstToken;
+  map<Algorithm*, int> outputTokenSize;
+
+  for (int i=0; i<(int)_toposortedNetwork.size(); i++) {
+    Algorithm* algo = _toposortedNetwork[i];
+    AlgorithmLatency latency;
+    latency.algorithm = algo;
+    latency.acquireSize = 0;
+    latency.lookahead = 0;
+
+    for (int j=0; j<(int)algo->inputs().size(); j++) {
+      const SinkBase& input = algo->input(j);
+      latency.acquireSize = max(latency.acquireSize, input.acquireSize());
+      latency.lookahead = max(latency.lookahead, input.acquireSize() - input.releaseSize());
+    }
+
+    // parents come first in the execution order, so their latency is known
+    int longest = 0;
+    latency.tokenSize = 1;
+    const AlgoVector& algoParents = parents[algo];
+    for (int j=0; j<(int)algoParents.size(); j++) {
+      longest = max(longest, firstToken[algoParents[j]]);
+      latency.tokenSize = max(latency.tokenSize, outputTokenSize[algoParents[j]]);
+    }
+    // once the first token of its inputs has been produced, each of the
+    // following ones takes tokenSize tokens of the generator
+    latency.pathLatency = longest + max(0, latency.acquireSize - 1) * latency.tokenSize;
+
+    // the generator produces its first token with the first one it is fed
+    firstToken[algo] = (algo == _generator) ? 1 : latency.pathLatency;
+
+    // the algorithms with a hop size produce one token per hop of their input.
+    // Only an integer hop size is a number of tokens, a real one is usually in
+    // seconds and is ignored (see latencyReport())
+    int hopSize = 1;
+    const ParameterMap& params = algo->defaultParameters();
+    if (params.find("hopSize") != params.end()) {
+      const Parameter& hop = algo->parameter("hopSize");
+      if (hop.isConfigured() && hop.type() == Parameter::INT) {
+        hopSize = max(1, hop.toInt());
+      }
+    }
+    outputTokenSize[algo] = latency.tokenSize * hopSize;
+
+    report.push_back(latency);
+  }
+
+  return report;
+}
+
 Algorithm* Network::findAlgorithm(const std::string& name) {
   NodeVector nodes = depthFirstSearch(_visibleNetworkRoot);
   for (NodeVector::iterator node = nodes.begin(); node != nodes.end(); ++node) {
@@ -915,6 +1011,208 @@ void Network::topologicalSortExecutionNetwork() {
 }
 
 
+void Network::compileExecutionNetwork() {
+  if (!_cacheExecutionNetwork) {
+    buildExecutionNetwork();
+    topologicalSortExecutionNetwork();
+    return;
+  }
+
+  AlgoVector algos;
+  string signature = structuralSignature(_generator, algos);
+
+  CompiledNetworkCache::KernelPtr cached = CompiledNetworkCache::instance().get(signature);
+  if (cached && loadExecutionNetwork(*cached, algos)) {
+    E_DEBUG(ENetwork, "execution network taken from the cache of compiled networks");
+    return;
+  }
+
+  buildExecutionNetwork();
+  topologicalSortExecutionNetwork();
+
+  CompiledNetwork compiled;
+  if (saveExecutionNetwork(compiled, algos)) {
+    CompiledNetworkCache::instance().insert(signature, compiled);
+  }
+}
+
+
+bool Network::loadExecutionNetwork(const CompiledNetwork& compiled, const AlgoVector& algos) {
+  // the cache might have been loaded from a file, check everything before
+  // building anything
+  int nnodes = compiled.nodeAlgos.size();
+  if (nnodes == 0 || (int)compiled.nodeChildren.size() != nnodes ||
+      compiled.root < 0 || compiled.root >= nnodes) return false;
+
+  for (int i=0; i<nnodes; i++) {
+    if (compiled.nodeAlgos[i] < 0 || compiled.nodeAlgos[i] >= (int)algos.size()) return false;
+    for (int j=0; j<(int)compiled.nodeChildren[i].size(); j++) {
+      int child = compiled.nodeChildren[i][j];
+      if (child < 0 || child >= nnodes) return false;
+    }
+  }
+  for (int i=0; i<(int)compiled.executionOrder.size(); i++) {
+    if (compiled.executionOrder[i] < 0 || compiled.executionOrder[i] >= (int)algos.size()) return false;
+  }
+
+  clearExecutionNetwork();
+
+  NodeVector nodes(nnodes);
+  for (int i=0; i<nnodes; i++) nodes[i] = new NetworkNode(algos[compiled.nodeAlgos[i]]);
+
+  for (int i=0; i<nnodes; i++) {
+    NodeVector children(compiled.nodeChildren[i].size());
+    for (int j=0; j<(int)children.size(); j++) children[j] = nodes[compiled.nodeChildren[i][j]];
+    nodes[i]->setChildren(children);
+  }
+  _executionNetworkRoot = nodes[compiled.root];
+
+  _toposortedNetwork.resize(compiled.executionOrder.size());
+  for (int i=0; i<(int)_toposortedNetwork.size(); i++) {
+    _toposortedNetwork[i] = algos[compiled.executionOrder[i]];
+  }
+
+  return true;
+}
+
+
+bool Network::saveExecutionNetwork(CompiledNetwork& compiled, const AlgoVector& algos) const {
+  map<Algorithm*, int> algoIndex;
+  for (int i=0; i<(int)algos.size(); i++) algoIndex[algos[i]] = i;
+
+  NodeVector nodes = depthFirstSearch(_executionNetworkRoot);
+  map<NetworkNode*, int> nodeIndex;
+  for (int i=0; i<(int)nodes.size(); i++) nodeIndex[nodes[i]] = i;
+
+  compiled.nodeAlgos.resize(nodes.size());
+  compiled.nodeChildren.resize(nodes.size());
+  for (int i=0; i<(int)nodes.size(); i++) {
+    map<Algorithm*, int>::const_iterator algo = algoIndex.find(nodes[i]->algorithm());
+    if (algo == algoIndex.end()) return false;
+    compiled.nodeAlgos[i] = algo->second;
+
+    const NodeVector& children = nodes[i]->children();
+    compiled.nodeChildren[i].resize(children.size());
+    for (int j=0; j<(int)children.size(); j++) {
+      compiled.nodeChildren[i][j] = nodeIndex[children[j]];
+    }
+  }
+  compiled.root = nodes.empty() ? -1 : nodeIndex[_executionNetworkRoot];
+
+  compiled.executionOrder.resize(_toposortedNetwork.size());
+  for (int i=0; i<(int)_toposortedNetwork.size(); i++) {
+    map<Algorithm*, int>::const_iterator algo = algoIndex.find(_toposortedNetwork[i]);
+    if (algo == algoIndex.end()) return false;
+    compiled.executionOrder[i] = algo->second;
+  }
+
+  return !nodes.empty();
+}
+
+
+void CompiledNetwork::write(ostream& out) const {
+  size_t nnodes = nodeAlgos.size();
+  out.write((const char*)&nnodes, sizeof(nnodes));
+  for (size_t i=0; i<nnodes; i++) {
+    out.write((const char*)&nodeAlgos[i], sizeof(nodeAlgos[i]));
+    util::writeBinary(out, nodeChildren[i]);
+  }
+  out.write((const char*)&root, sizeof(root));
+  util::writeBinary(out, executionOrder);
+}
+
+void CompiledNetwork::read(istream& in) {
+  // each node takes at least its algorithm and the size of its children
+  size_t nnodes = util::readSize(in, sizeof(int) + sizeof(size_t));
+  nodeAlgos.resize(nnodes);
+  nodeChildren.resize(nnodes);
+  for (size_t i=0; i<nnodes; i++) {
+    in.read((char*)&nodeAlgos[i], sizeof(nodeAlgos[i]));
+    util::readBinary(in, nodeChildren[i]);
+  }
+  in.read((char*)&root, sizeof(root));
+  util::readBinary(in, executionOrder);
+  if (!in) throw EssentiaException("CompiledNetwork: unexpected end of file");
+}
+
+
+string structuralSignature(Algorithm* generator, AlgoVector& algos) {
+  // 1- number the algorithms in the order of a depth-first traversal which
+  //    follows the connections and enters the composites through their
+  //    process order, so that the numbering only depends on the structure
+  algos.clear();
+  map<Algorithm*, int> algoIndex;
+  stack<Algorithm*> toVisit;
+  toVisit.push(generator);
+
+  while (!toVisit.empty()) {
+    Algorithm* algo = toVisit.top();
+    toVisit.pop();
+    if (!algo || contains(algoIndex, algo)) continue;
+    algoIndex[algo] = algos.size();
+    algos.push_back(algo);
+
+    AlgoVector next;
+    for (int i=0; i<(int)algo->outputs().size(); i++) {
+      SourceBase& output = algo->output(i);
+      SourceProxyBase* proxy = dynamic_cast<SourceProxyBase*>(&output);
+      if (proxy && proxy->proxiedSource()) next.push_back(proxy->proxiedSource()->parent());
+      for (int j=0; j<(int)output.sinks().size(); j++) next.push_back(output.sinks()[j]->parent());
+    }
+
+    AlgorithmComposite* composite = dynamic_cast<AlgorithmComposite*>(algo);
+    if (composite) {
+      vector<ProcessStep> processOrder = composite->processOrder();
+      for (int i=0; i<(int)processOrder.size(); i++) next.push_back(processOrder[i].algorithm());
+    }
+
+    // push them in reverse order so that they are visited in order
+    for (int i=(int)next.size()-1; i>=0; i--) toVisit.push(next[i]);
+  }
+
+  // 2- describe each algorithm using these numbers
+  ostringstream signature;
+  for (int a=0; a<(int)algos.size(); a++) {
+    Algorithm* algo = algos[a];
+    signature << a;
+
+    AlgorithmComposite* composite = dynamic_cast<AlgorithmComposite*>(algo);
+    if (composite) {
+      vector<ProcessStep> processOrder = composite->processOrder();
+      signature << '{';
+      for (int i=0; i<(int)processOrder.size(); i++) {
+        Algorithm* step = processOrder[i].algorithm();
+        signature << processOrder[i].type() << ' '
+                  << (step ? algoIndex[step] : -1) << ',';
+      }
+      signature << '}';
+    }
+
+    for (int i=0; i<(int)algo->outputs().size(); i++) {
+      SourceBase& output = algo->output(i);
+      signature << '|' << output.name();
+
+      SourceProxyBase* proxy = dynamic_cast<SourceProxyBase*>(&output);
+      if (proxy && proxy->proxiedSource()) {
+        signature << '<' << algoIndex[proxy->proxiedSource()->parent()]
+                  << '.' << proxy->proxiedSource()->name();
+      }
+
+      signature << (output.isProxied() ? "^>" : "->");
+      for (int j=0; j<(int)output.sinks().size(); j++) {
+        SinkBase* sink = output.sinks()[j];
+        bool proxied = output.isProxied() && indexOf(output.proxiedSinks(), sink) != -1;
+        signature << (sink->parent() ? algoIndex[sink->parent()] : -1)
+                  << '.' << sink->name() << (proxied ? "* " : " ");
+      }
+    }
+    signature << ";";
+  }
+
+  return signature.str();
+}
+
+
 void Network::checkConnections() {
   vector<Algorithm*> algos = depthFirstMap(_visibleNetworkRoot, returnAlgorithm);
 
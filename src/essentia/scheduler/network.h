@@ -25,6 +25,7 @@
 #include <stack>
 #include "../streaming/streamingalgorithm.h"
 #include "../essentiautil.h"
+#include "../utils/kernelcache.h"
 
 namespace essentia {
 namespace streaming {
@@ -80,6 +81,58 @@ typedef std::stack<NetworkNode*> NodeStack;
 
 
 
+/**
+ * Execution network of a Network, in a form which does not point to any
+ * algorithm instance: the algorithms are referred to by their index in the
+ * list returned by structuralSignature(). It can thus be reused for any other
+ * network which has the same structural signature, without expanding the
+ * composites and sorting the execution network again.
+ */
+struct CompiledNetwork {
+  // index of the algorithm of each node of the execution network
+  std::vector<int> nodeAlgos;
+  // indices of the children of each node of the execution network
+  std::vector<std::vector<int> > nodeChildren;
+  int root;
+  // indices of the algorithms in the order in which they are executed
+  std::vector<int> executionOrder;
+
+  static const char* cacheTag() { return "CompiledNetwork"; }
+  static int cacheVersion() { return 2; }
+  void write(std::ostream& out) const;
+  void read(std::istream& in);
+};
+
+/**
+ * Process-wide cache of the compiled execution networks, keyed by their
+ * structural signature. It can be saved to disk and loaded in another process.
+ */
+typedef util::KernelCache<CompiledNetwork> CompiledNetworkCache;
+
+
+/**
+ * Latency of an algorithm in the execution network of a Network, as reported
+ * by Network::latencyReport(). The acquire size and the lookahead are in
+ * tokens of its inputs, the path latency in tokens of the generator (samples,
+ * usually): one token of an input stands for tokenSize tokens of the
+ * generator, the hop size of the algorithms producing one token per hop
+ * (FrameCutter...) upstream.
+ */
+struct AlgorithmLatency {
+  streaming::Algorithm* algorithm;
+  // largest number of tokens one of its inputs needs before it can process them
+  int acquireSize;
+  // largest number of tokens one of its inputs keeps for the next call to
+  // process() (acquire size minus release size)
+  int lookahead;
+  // number of tokens of the generator one token of its inputs stands for
+  int tokenSize;
+  // number of tokens the generator has to produce before it can process its
+  // inputs for the first time, along the longest path from the generator
+  int pathLatency;
+};
+
+
 /**
  * A Network is a structure that holds all algorithms that have been connected
  * together and is able to run them.
@@ -131,13 +184,38 @@ class Network {
    */
   bool runStep();
 
+  /**
+   * Runs the network until the generator has produced at least the given
+   * number of tokens, or until it does not produce anything anymore. It is
+   * meant for real-time use, with a generator which never waits for data
+   * (e.g. a RingBufferInput with blocking=false): runPrepare() needs to have
+   * been called before, and the scheduling itself then never blocks nor
+   * allocates memory.
+   *
+   * Returns the number of tokens produced by the generator, which can exceed
+   * the given number by the size of one of its productions.
+   */
+  int runFor(int tokens);
+
+  /**
+   * Returns the latency of each algorithm of the execution network, in the
+   * order in which they are executed. The largest path latency is the number
+   * of tokens (samples) which have to be fed to the generator before all the
+   * algorithms of the network have run at least once.
+   *
+   * The hop size of an algorithm is taken from its "hopSize" parameter, and
+   * only when it is an integer (a number of tokens). Hop sizes given in
+   * seconds (e.g. the REAL hopSize of LoudnessEBUR128) are ignored, so the
+   * latencies downstream of such an algorithm are underestimated.
+   */
+  std::vector<AlgorithmLatency> latencyReport();
+
   /**
    * Rebuilds the visible and execution network.
    */
   void update() {
     buildVisibleNetwork();
-    buildExecutionNetwork();
-    topologicalSortExecutionNetwork();
+    compileExecutionNetwork();
   }
 
   /**
@@ -202,13 +280,25 @@ class Network {
    */
   static Network* lastCreated;
 
+  /**
+   * Sets whether runPrepare() and update() reuse the execution network
+   * compiled for a previous network with the same structure, from the
+   * CompiledNetworkCache, and store it there otherwise. False by default.
+   */
+  void setCacheExecutionNetwork(bool cache) { _cacheExecutionNetwork = cache; }
+
  protected:
   bool _takeOwnership;
+  bool _cacheExecutionNetwork;
   streaming::Algorithm* _generator;
   NetworkNode* _visibleNetworkRoot;
   NetworkNode* _executionNetworkRoot;
   std::vector<streaming::Algorithm*> _toposortedNetwork;
 
+  // indices of the algorithms to run again in runStep(), kept here so that
+  // runStep() does not allocate memory
+  std::vector<int> _runStack;
+
   /**
    * Build the network of visibly connected algorithms (ie: do not enter composite
    * algorithms) and stores its root in @c _visibleNetworkRoot.
@@ -228,6 +318,25 @@ class Network {
    */
   void topologicalSortExecutionNetwork();
 
+  /**
+   * Build and sort the execution network, or take them from the
+   * CompiledNetworkCache if a network with the same structure has already
+   * been compiled.
+   */
+  void compileExecutionNetwork();
+
+  /**
+   * Build the execution network and its topological sort from a compiled one.
+   * Return false if it does not fit the given algorithms.
+   */
+  bool loadExecutionNetwork(const CompiledNetwork& compiled, const AlgoVector& algos);
+
+  /**
+   * Store the execution network and its topological sort in compiled.
+   * Return false if they contain algorithms which are not in algos.
+   */
+  bool saveExecutionNetwork(CompiledNetwork& compiled, const AlgoVector& algos) const;
+
   /**
    * Execution dependencies are stored inside the network nodes themselves, and
    * might enter/exit CompositeAlgorithms boundaries.
@@ -278,6 +387,16 @@ void deleteNetwork(const streaming::Algorithm* algo);
  */
 void printNetworkBufferFillState();
 
+/**
+ * Returns a string describing the structure of the network starting at the
+ * given generator: how the outputs of its algorithms (and of the algorithms
+ * inside its composites) are connected, and the process order of its
+ * composites. The algorithms are listed in algos, in the order in which the
+ * signature refers to them. Networks with the same signature have the same
+ * execution network, whatever the names and parameters of their algorithms.
+ */
+std::string structuralSignature(streaming::Algorithm* generator, AlgoVector& algos);
+
 AlgoVector computeDependencies(const streaming::Algorithm* algo);
 AlgoVector computeNormalDependencies(const streaming::Algorithm* algo);
 AlgoVector computeCompositeDependencies(const streaming::Algorithm* algo);
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "audiocachestorage.h"
+#include <cstring>
+
+using namespace std;
+
+namespace essentia {
+namespace streaming {
+
+AudioCacheStorage::AudioCacheStorage() : _position(0), _decoder(0), _sampleRate(0),
+                                         _originalSampleRate(0), _recorded(false) {
+  setName("AudioCacheStorage");
+  declareInput(_input, 1, "signal", "the input signal");
+  declareOutput(_output, 1, "signal", "the output signal");
+
+  _output.setBufferType(BufferUsage::forLargeAudioStream);
+}
+
+void AudioCacheStorage::passThrough() {
+  _entry.close();
+  _path.clear();
+  _decoder = 0;
+  reset();
+}
+
+void AudioCacheStorage::record(const string& path, Algorithm* decoder,
+                               Real sampleRate, Real originalSampleRate) {
+  passThrough();
+  _path = path;
+  _decoder = decoder;
+  _sampleRate = sampleRate;
+  _originalSampleRate = originalSampleRate;
+}
+
+bool AudioCacheStorage::serve(const string& path) {
+  passThrough();
+  return _entry.open(path);
+}
+
+AlgorithmStatus AudioCacheStorage::process() {
+  return serving() ? generate() : forward();
+}
+
+AlgorithmStatus AudioCacheStorage::forward() {
+  int available = _input.available();
+
+  if (available == 0) {
+    if (shouldStop() && !_path.empty() && !_recorded && _decoder && _decoder->shouldStop()) {
+      _recorded = true;
+      try {
+        if (!_writer.isOpen()) _writer.open(_path);
+        _writer.commit(_sampleRate, _originalSampleRate);
+      }
+      catch (EssentiaException& e) {
+        // not being able to cache the audio should not prevent loading it
+        E_WARNING(e.what());
+      }
+    }
+    return NO_INPUT;
+  }
+
+  // as in PoolStorage, the phantom zone of the buffers may be empty, in which
+  // case we can still take tokens one by one
+  int n = min(available, _input.buffer().bufferInfo().maxContiguousElements);
+  n = min(n, _output.bufferInfo().maxContiguousElements);
+  n = max(n, 1);
+
+  if (!_output.acquire(n)) return NO_OUTPUT;
+  _input.acquire(n);
+
+  const Real* input = &_input.tokens()[0];
+  fastcopy(&_output.tokens()[0], input, n);
+  if (!_path.empty() && !_recorded) recordSamples(input, n);
+
+  _input.release(n);
+  _output.release(n);
+
+  return OK;
+}
+
+void AudioCacheStorage::recordSamples(const Real* samples, int size) {
+  try {
+    if (!_writer.isOpen()) _writer.open(_path);
+    _writer.append(samples, size);
+  }
+  catch (EssentiaException& e) {
+    E_WARNING(e.what());
+    _writer.abort();
+    _recorded = true;
+  }
+}
+
+AlgorithmStatus AudioCacheStorage::generate() {
+  if (_position >= _entry.size()) {
+    shouldStop(true);
+    return FINISHED;
+  }
+
+  int n = (int)min(_entry.size() - _position, (size_t)_output.bufferInfo().maxContiguousElements);
+  if (!_output.acquire(n)) {
+    throw EssentiaException("AudioCacheStorage: could not acquire output for audio");
+  }
+
+  fastcopy(&_output.tokens()[0], _entry.data() + _position, n);
+  _output.release(n);
+  _position += n;
+
+  if (_position == _entry.size()) shouldStop(true);
+
+  return OK;
+}
+
+void AudioCacheStorage::reset() {
+  Algorithm::reset();
+  _position = 0;
+  _recorded = false;
+  // an entry which has not been committed is incomplete
+  _writer.abort();
+}
+
+} // namespace streaming
+} // namespace essentia
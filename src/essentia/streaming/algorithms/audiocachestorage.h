@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_STREAMING_AUDIOCACHESTORAGE_H
+#define ESSENTIA_STREAMING_AUDIOCACHESTORAGE_H
+
+#include "../streamingalgorithm.h"
+#include "../../utils/audiocache.h"
+
+namespace essentia {
+namespace streaming {
+
+/**
+ * Last algorithm of the loaders which use the audio cache (see
+ * util::AudioCache). Depending on how it has been set up, it either:
+ *  - forwards its input to its output (passThrough()),
+ *  - forwards its input to its output, and writes everything that goes through
+ *    it to a cache entry, which is committed at the end of the stream
+ *    (record()),
+ *  - ignores its input and acts as a generator that produces the samples of a
+ *    cache entry (serve()). The loader should then schedule it as the first
+ *    algorithm of its process order.
+ */
+class AudioCacheStorage : public Algorithm {
+ protected:
+  Sink<Real> _input;
+  Source<Real> _output;
+
+  util::AudioCache::Entry _entry;
+  size_t _position;
+
+  std::string _path;
+  Algorithm* _decoder;
+  Real _sampleRate;
+  Real _originalSampleRate;
+  util::AudioCache::Writer _writer;
+  bool _recorded; // the entry has been written, or could not be
+
+  AlgorithmStatus forward();
+  AlgorithmStatus generate();
+  void recordSamples(const Real* samples, int size);
+
+ public:
+  AudioCacheStorage();
+
+  void declareParameters() {}
+
+  void passThrough();
+
+  /**
+   * Records the stream into the cache entry at the given path. The entry is
+   * only written if the decoder reached the end of the file, so that a stream
+   * which has been stopped early is not cached.
+   */
+  void record(const std::string& path, Algorithm* decoder,
+              Real sampleRate, Real originalSampleRate);
+
+  /**
+   * Returns false (and passes through) if there is no valid entry at the
+   * given path.
+   */
+  bool serve(const std::string& path);
+
+  bool serving() const { return _entry.isOpen(); }
+  const util::AudioCache::Entry& entry() const { return _entry; }
+
+  AlgorithmStatus process();
+  void reset();
+};
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_STREAMING_AUDIOCACHESTORAGE_H
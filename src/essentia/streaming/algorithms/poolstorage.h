@@ -30,11 +30,13 @@ class PoolStorageBase : public Algorithm {
  protected:
   Pool* _pool;
   std::string _descriptorName;
+  DescriptorId _descriptorId; // used to add values without looking up the name
   bool _setSingle;
 
  public:
   PoolStorageBase(Pool* pool, const std::string& descriptorName, bool setSingle = false) :
-    _pool(pool), _descriptorName(descriptorName), _setSingle(setSingle) {}
+    _pool(pool), _descriptorName(descriptorName),
+    _descriptorId(pool->descriptorId(descriptorName)), _setSingle(setSingle) {}
 
   ~PoolStorageBase() {}
 
@@ -97,25 +99,25 @@ class PoolStorage : public PoolStorageBase {
   void addToPool(const std::vector<T>& value) {
     if (_setSingle) {
       for (int i=0; i<(int)value.size();++i)
-      _pool->add(_descriptorName, value[i]);
+      _pool->add(_descriptorId, value[i]);
     }
-    else _pool->add(_descriptorName, value);
+    else _pool->add(_descriptorId, value);
   }
 
   void addToPool(const std::vector<Real>& value) {
     if (_setSingle) _pool->set(_descriptorName, value);
-    else            _pool->add(_descriptorName, value);
+    else            _pool->add(_descriptorId, value);
   }
 
   template <typename T>
   void addToPool(const T& value) {
     if (_setSingle) _pool->set(_descriptorName, value);
-    else            _pool->add(_descriptorName, value);
+    else            _pool->add(_descriptorId, value);
    }
 
   template <typename T>
   void addToPool(const TNT::Array2D<T>& value) {
-    _pool->add(_descriptorName, value);
+    _pool->add(_descriptorId, value);
     /*
       if (_setSingle) {
       throw EssentiaException("PoolStorage::addToPool, setting Array2D as single value"
@@ -131,7 +133,7 @@ class PoolStorage : public PoolStorageBase {
                               " is not supported by Pool.");
     }
     else {
-      _pool->add(_descriptorName, value);
+      _pool->add(_descriptorId, value);
     }
   }
 
@@ -30,10 +30,14 @@ namespace streaming {
 const char* RingBufferInput::name = "RingBufferInput";
 const char* RingBufferInput::category = "Input/Output";
 const char* RingBufferInput::description = DOC(
-"This algorithm gets data from an input ringbuffer of type Real that is fed into the essentia streaming mode."
+"This algorithm gets data from an input ringbuffer of type Real that is fed into the essentia streaming mode.\n"
+"\n"
+"Adding data to the ringbuffer never blocks nor allocates memory. When the \"blocking\" parameter is false, "
+"the algorithm does not wait for data either, so that a network can be run from a real-time thread with "
+"Network::runFor()."
 );
 
-RingBufferInput::RingBufferInput():_impl(0)
+RingBufferInput::RingBufferInput():_impl(0), _blocking(true)
 {
   declareOutput(_output, 1024, "signal", "data source of what's coming from the ringbuffer");
   _output.setBufferType(BufferUsage::forAudioStream);
@@ -48,6 +52,7 @@ void RingBufferInput::configure()
 {
 	delete _impl;
 	_impl = new RingBufferImpl(RingBufferImpl::kAvailable,parameter("bufferSize").toInt());
+	_blocking = parameter("blocking").toBool();
 }
 
 void RingBufferInput::add(Real* inputData, int size)
@@ -58,9 +63,14 @@ void RingBufferInput::add(Real* inputData, int size)
 }
 
 AlgorithmStatus RingBufferInput::process() {
-  //std::cerr << "ringbufferinput waiting" << std::endl;
-  _impl->waitAvailable();
-  //std::cerr << "ringbufferinput waiting done" << std::endl;
+  if (_blocking) {
+    //std::cerr << "ringbufferinput waiting" << std::endl;
+    _impl->waitAvailable();
+    //std::cerr << "ringbufferinput waiting done" << std::endl;
+  }
+  else if (_impl->_available == 0) {
+    return NO_INPUT;
+  }
 
   AlgorithmStatus status = acquireData();
 
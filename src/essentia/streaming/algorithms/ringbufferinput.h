@@ -29,6 +29,7 @@ class RingBufferInput : public Algorithm {
  protected:
   Source<Real> _output;
   class RingBufferImpl* _impl;
+  bool _blocking;
 
  public:
   RingBufferInput();
@@ -44,6 +45,7 @@ class RingBufferInput : public Algorithm {
 
   void declareParameters() {
     declareParameter("bufferSize", "the size of the ringbuffer", "", 8192);
+    declareParameter("blocking", "whether to wait for data to be added to the ringbuffer when it is empty, or to return without producing anything (for real-time use)", "{true,false}", true);
   }
 
   void configure();
@@ -29,7 +29,7 @@ const char* RingBufferOutput::name = "RingBufferOutput";
 const char* RingBufferOutput::category = "Input/Output";
 const char* RingBufferOutput::description = DOC("This algorithm fills an output ringbuffer of type Real that can be read from a different thread then.");
 
-RingBufferOutput::RingBufferOutput() : _impl(0)
+RingBufferOutput::RingBufferOutput() : _impl(0), _blocking(true)
 {
   declareInput(_input, 1024, "signal", "the input signal that should go into the ringbuffer");
 }
@@ -43,6 +43,7 @@ void RingBufferOutput::configure()
 {
 	delete _impl;
 	_impl = new RingBufferImpl(RingBufferImpl::kSpace,parameter("bufferSize").toInt());
+	_blocking = parameter("blocking").toBool();
 }
 
 int RingBufferOutput::get(Real* outputData, int max)
@@ -51,7 +52,7 @@ int RingBufferOutput::get(Real* outputData, int max)
 }
 
 AlgorithmStatus RingBufferOutput::process() {
-  _impl->waitSpace();
+  if (_blocking) _impl->waitSpace();
 
   AlgorithmStatus status = acquireData();
   if (status != OK) return status;
@@ -29,6 +29,7 @@ class RingBufferOutput : public Algorithm {
  protected:
   Sink<Real> _input;
   class RingBufferImpl* _impl;
+  bool _blocking;
 
  public:
   RingBufferOutput();
@@ -40,6 +41,7 @@ class RingBufferOutput : public Algorithm {
 
   void declareParameters() {
     declareParameter("bufferSize", "the size of the ringbuffer", "", 8192);
+    declareParameter("blocking", "whether to wait for space in the ringbuffer when it is full, or to throw an exception (for real-time use)", "{true,false}", true);
   }
 
   void configure();
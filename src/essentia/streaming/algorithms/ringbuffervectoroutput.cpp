@@ -32,7 +32,7 @@ const char* RingBufferVectorOutput::description = DOC(
 "followed by the actual frame data."
 );
 
-RingBufferVectorOutput::RingBufferVectorOutput() : _impl(0)
+RingBufferVectorOutput::RingBufferVectorOutput() : _impl(0), _blocking(true)
 {
   declareInput(_input, 4096, "signal", "TODO");
 }
@@ -46,6 +46,7 @@ void RingBufferVectorOutput::configure()
 {
 	delete _impl;
 	_impl = new RingBufferImpl(RingBufferImpl::kSpace,parameter("bufferSize").toInt());
+	_blocking = parameter("blocking").toBool();
 }
 
 int RingBufferVectorOutput::get(Real* outputData, int max)
@@ -54,7 +55,7 @@ int RingBufferVectorOutput::get(Real* outputData, int max)
 }
 
 AlgorithmStatus RingBufferVectorOutput::process() {
-  _impl->waitSpace();
+  if (_blocking) _impl->waitSpace();
 
   AlgorithmStatus status = acquireData();
   if (status != OK) return status;
@@ -29,6 +29,7 @@ class RingBufferVectorOutput : public Algorithm {
  protected:
   Sink< std::vector<Real> > _input;
   class RingBufferImpl* _impl;
+  bool _blocking;
 
  public:
   RingBufferVectorOutput();
@@ -40,6 +41,7 @@ class RingBufferVectorOutput : public Algorithm {
 
   void declareParameters() {
     declareParameter("bufferSize", "size of the ringbuffer", "", 8192);
+    declareParameter("blocking", "whether to wait for space in the ringbuffer when it is full, or to throw an exception (for real-time use)", "{true,false}", true);
   }
 
   void configure();
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "framereader.h"
+#include "algorithmfactory.h"
+#include "essentiamath.h" // for isSilent
+
+using namespace std;
+
+namespace essentia {
+namespace streaming {
+
+FrameReader::FrameReader(Algorithm& owner, Sink<Real>& audio, SourceBase& output)
+  : _owner(owner), _audio(audio), _output(output),
+    _frameSize(0), _hopSize(0), _startIndex(0), _streamIndex(0),
+    _validFrameThreshold(0), _startFromZero(false), _lastFrameToEndOfFile(false),
+    _silentFrames(ADD_NOISE), _frame(0), _lastFrame(false) {
+  _noiseAdder = standard::AlgorithmFactory::create("NoiseAdder");
+}
+
+FrameReader::~FrameReader() {
+  delete _noiseAdder;
+}
+
+FrameReader::SilenceType FrameReader::silenceTypeFromString(const string& name) {
+  if (name == "keep") return KEEP;
+  if (name == "drop") return DROP;
+  return ADD_NOISE;
+}
+
+void FrameReader::configure(int frameSize, int hopSize, bool startFromZero,
+                            bool lastFrameToEndOfFile, Real validFrameThresholdRatio,
+                            SilenceType silentFrames) {
+  _frameSize = frameSize;
+  _hopSize = hopSize;
+  _startFromZero = startFromZero;
+  _lastFrameToEndOfFile = lastFrameToEndOfFile;
+  _silentFrames = silentFrames;
+  _validFrameThreshold = (int)round(validFrameThresholdRatio*_frameSize);
+
+  // Adding noise to avoid divisions by zero (in case the user chooses to do so
+  // by setting the silentFrames parameter to ADD_NOISE).  The level of such noise
+  // is chosen to be -100dB because it will still be detected as a silent frame
+  // by essentia::isSilent() and is unhearable by humans
+  _noiseAdder->configure("fixSeed", false, "level", -100);
+  reset();
+}
+
+void FrameReader::reset() {
+  _streamIndex = 0;
+  if (_startFromZero) _startIndex = 0;
+  else                _startIndex = -(_frameSize+1)/2;
+
+  _frame = 0;
+  _lastFrame = false;
+
+  _audio.setAcquireSize(_frameSize);
+  _audio.setReleaseSize(_hopSize);
+  _output.setAcquireSize(1);
+  _output.setReleaseSize(1);
+}
+
+AlgorithmStatus FrameReader::acquireFrame() {
+  _frame = 0;
+  _lastFrame = false;
+
+  // if _streamIndex < _startIndex, we need to advance into the stream until we
+  // arrive at _startIndex
+  if (_streamIndex < _startIndex) {
+    // to make sure we can skip that many, use frameSize (buffer has been resized
+    // to be able to accomodate at least that many sample before starting processing)
+    int skipSize = _frameSize;
+    int howmuch = min(_startIndex - _streamIndex, skipSize);
+    _audio.setAcquireSize(howmuch);
+    _audio.setReleaseSize(howmuch);
+    _output.setAcquireSize(0);
+    _output.setReleaseSize(0);
+
+    if (_owner.acquireData() != OK) return NO_INPUT;
+
+    _owner.releaseData();
+    _streamIndex += howmuch;
+
+    return OK;
+  }
+
+  // need to know whether we have to zero-pad on the left: ie, _startIndex < 0
+  int zeropadSize = 0;
+  int acquireSize = _frameSize;
+  int releaseSize = min(_hopSize, _frameSize); // in case hopsize > framesize
+  int available = _audio.available();
+
+  // we need this check anyway because we might be at the very end of the stream and try to acquire 0
+  // for our last frame, which will unfortunately work, so just get rid of this case right now
+  if (available == 0) return NO_INPUT;
+
+  if (_startIndex < 0) {
+    // left zero-padding and only acquire  as much as _frameSize + startIndex tokens and should release zero
+    acquireSize = _frameSize + _startIndex;
+    releaseSize = 0;
+    zeropadSize = -_startIndex;
+  }
+
+  // if there are not enough tokens in the stream (howmuch < available):
+  if (acquireSize >= available) { // has to be >= in case the size of the audio fits exactly with frameSize & hopSize
+    if (!_owner.shouldStop()) return NO_INPUT; // not end of stream -> return and wait for more data to come
+
+    acquireSize = available; // need to acquire what's left
+    releaseSize = _startIndex >= 0 ? min(available, _hopSize) : 0; // cannot release more tokens than there are available
+    if (_startFromZero) {
+      if (_lastFrameToEndOfFile) {
+        if (_startIndex >= _streamIndex+available) _lastFrame = true;
+      }
+      else _lastFrame = true;
+    }
+    else {
+      if (_startIndex + _frameSize/2 >= _streamIndex + available) // center of frame >= end of stream
+        _lastFrame = true;
+    }
+  }
+
+  _output.setAcquireSize(1);
+  _output.setReleaseSize(1);
+  _audio.setAcquireSize(acquireSize);
+  _audio.setReleaseSize(releaseSize);
+
+  AlgorithmStatus status = _owner.acquireData();
+
+  if (status != OK) {
+    if (status == NO_INPUT) return NO_INPUT;
+    if (status == NO_OUTPUT) return NO_OUTPUT;
+    throw EssentiaException("FrameReader: something weird happened.");
+  }
+
+  const vector<Real>& audio = _audio.tokens();
+  const vector<Real>* frame = &audio;
+
+  if (zeropadSize > 0 || acquireSize < _frameSize) {
+    // check if the frame is below the threshold (this would only happen
+    // for the last frame in the stream) and if so, don't produce data
+    if (zeropadSize + acquireSize < _validFrameThreshold) {
+      E_INFO(_owner.name() << ": dropping incomplete frame");
+
+      // release inputs (advance to next frame), but not the output frame (we didn't produce anything)
+      _audio.release(_audio.releaseSize());
+      return NO_INPUT;
+    }
+
+    // the frame is not fully contained in the stream, it has to be zero-padded
+    _paddedFrame.resize(_frameSize);
+    fill(_paddedFrame.begin(), _paddedFrame.begin() + zeropadSize, (Real)0.0);
+    fastcopy(_paddedFrame.begin() + zeropadSize, audio.begin(), acquireSize);
+    fill(_paddedFrame.begin() + zeropadSize + acquireSize, _paddedFrame.end(), (Real)0.0);
+    frame = &_paddedFrame;
+  }
+
+  _startIndex += _hopSize;
+
+  if (isSilent(*frame)) {
+    switch (_silentFrames) {
+    case DROP:
+      E_INFO(_owner.name() << ": dropping silent frame");
+
+      // release inputs (advance to next frame), but not the output frame (we didn't produce anything)
+      _audio.release(_audio.releaseSize());
+      return OK;
+
+    case ADD_NOISE: {
+      _noiseInput.assign(_frameSize, 0.0);
+      fastcopy(&_noiseInput[0]+zeropadSize, &(*frame)[0], acquireSize);
+      _noiseAdder->input("signal").set(_noiseInput);
+      _noiseAdder->output("signal").set(_noisyFrame);
+      _noiseAdder->compute();
+      frame = &_noisyFrame;
+      break;
+    }
+
+    // otherwise, don't do nothing...
+    case KEEP:
+    default:
+      ;
+    }
+  }
+
+  _frame = frame;
+  return OK;
+}
+
+AlgorithmStatus FrameReader::releaseFrame() {
+  _owner.releaseData();
+  _streamIndex += _audio.releaseSize();
+  _frame = 0;
+
+  if (_lastFrame) return PASS;
+
+  return OK;
+}
+
+} // namespace streaming
+} // namespace essentia
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_FRAMEREADER_H
+#define ESSENTIA_FRAMEREADER_H
+
+#include "streamingalgorithm.h"
+
+namespace essentia {
+namespace standard {
+class Algorithm;
+}
+
+namespace streaming {
+
+/**
+ * Cuts overlapping frames out of a stream of audio samples, following the
+ * same rules as the FrameCutter algorithm (zero-padding of incomplete frames,
+ * dropping of too short or silent frames, etc.).
+ *
+ * Frames are not copied: as the PhantomBuffer of the input sink guarantees
+ * that the acquired tokens are contiguous in memory, a complete frame is
+ * returned as a read-only view on them. Only the frames that need to be
+ * zero-padded (at the beginning and end of the stream) or to which noise is
+ * added are written to an internal buffer.
+ *
+ * The FrameReader drives the acquisition and release of the tokens of the
+ * algorithm that owns it, and is meant to be used in its process() method as:
+ *
+ * @code
+ *   AlgorithmStatus status = _reader.acquireFrame();
+ *   if (status != OK || !_reader.frame()) return status;
+ *
+ *   // compute the output token(s) from *_reader.frame()
+ *
+ *   return _reader.releaseFrame();
+ * @endcode
+ *
+ * The frame view is only valid until releaseFrame() is called: algorithms
+ * that need to keep it around have to copy it.
+ */
+class FrameReader {
+
+ public:
+  enum SilenceType {KEEP, DROP, ADD_NOISE};
+
+  /**
+   * @param owner the algorithm whose process() method reads the frames
+   * @param audio the sink of owner from which the frames are cut
+   * @param output the output of owner, which produces one token per frame
+   */
+  FrameReader(Algorithm& owner, Sink<Real>& audio, SourceBase& output);
+  ~FrameReader();
+
+  void configure(int frameSize, int hopSize, bool startFromZero,
+                 bool lastFrameToEndOfFile, Real validFrameThresholdRatio,
+                 SilenceType silentFrames);
+  void reset();
+
+  static SilenceType silenceTypeFromString(const std::string& name);
+
+  /**
+   * Acquires the tokens for the next frame, and one token of the output.
+   * Returns OK when some progress has been made; in that case, frame() is
+   * null if no frame has been produced (the beginning of the stream has been
+   * skipped or the frame has been dropped).
+   */
+  AlgorithmStatus acquireFrame();
+
+  /**
+   * The current frame, or 0 if there is none.
+   */
+  const std::vector<Real>* frame() const { return _frame; }
+
+  /**
+   * Releases the tokens of the current frame and the output token. Returns
+   * PASS if this was the last frame of the stream, OK otherwise.
+   */
+  AlgorithmStatus releaseFrame();
+
+ protected:
+  Algorithm& _owner;
+  Sink<Real>& _audio;
+  SourceBase& _output;
+
+  int _frameSize;
+  int _hopSize;
+  int _startIndex; // the desired start index of the next frame
+  int _streamIndex; // the index in the stream
+  int _validFrameThreshold;
+  bool _startFromZero;
+  bool _lastFrameToEndOfFile;
+  SilenceType _silentFrames;
+
+  standard::Algorithm* _noiseAdder;
+
+  const std::vector<Real>* _frame;
+  bool _lastFrame;
+  std::vector<Real> _paddedFrame;
+  std::vector<Real> _noiseInput;
+  std::vector<Real> _noisyFrame;
+
+ private:
+  FrameReader(const FrameReader&);
+  FrameReader& operator=(const FrameReader&);
+};
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_FRAMEREADER_H
@@ -44,6 +44,25 @@ class Window {
 };
 
 
+/**
+ * Describes whether tokens of a given type own heap memory that can be handed
+ * over from a token to another. By default they don't; vectors do.
+ */
+template <typename T>
+struct TokenStorage {
+  static const bool recyclable = false;
+  static bool hasCapacity(const T&) { return true; }
+  static void swap(T&, T&) {}
+};
+
+template <typename T>
+struct TokenStorage<std::vector<T> > {
+  static const bool recyclable = true;
+  static bool hasCapacity(const std::vector<T>& v) { return v.capacity() > 0; }
+  static void swap(std::vector<T>& a, std::vector<T>& b) { a.swap(b); }
+};
+
+
 /**
  * The PhantomBuffer class is an implementation of the MultiRateBuffer interface
  * that has a special zone at its end, called the phantom zone, which is also
@@ -55,13 +74,25 @@ class Window {
  *
  * NB: we can only guarantee that availableFor* returns a least the size of the phantom buffer, not more
  *     we have to choose the size of the phantom zone carefully, or make it dynamically resizable
+ *
+ * When tokens own memory (e.g. frames, which are vectors), a slot of the buffer
+ * that has never been written to would need a new allocation for each token
+ * written to it, which happens for every token of a large buffer that is not
+ * filled entirely. To avoid that, the storage of tokens which have already
+ * been read by all the readers is recycled into the empty slots before they
+ * are given to the writer, so that a buffer only allocates as many tokens as
+ * there are in flight at the same time. Recycling only happens while there is
+ * at least one reader, and it is disabled as soon as a reader starts from the
+ * beginning of the stream (as those are expected to read tokens that have
+ * been produced before they were connected), or with setTokenRecycling().
  */
 template <typename T>
 class PhantomBuffer : public MultiRateBuffer<T> {
 
  public:
 
-  PhantomBuffer(SourceBase* parent, BufferUsage::BufferUsageType type) {
+  PhantomBuffer(SourceBase* parent, BufferUsage::BufferUsageType type) :
+    _recycleTokens(TokenStorage<T>::recyclable), _recycled(0) {
     _parent = parent;
     setBufferType(type);
   }
@@ -113,7 +144,9 @@ class PhantomBuffer : public MultiRateBuffer<T> {
     _parent(parent),
     _bufferSize(size),
     _phantomSize(phantomSize),
-    _buffer(size + phantomSize) {
+    _buffer(size + phantomSize),
+    _recycleTokens(TokenStorage<T>::recyclable),
+    _recycled(0) {
     // initialize views and all??
   }
 
@@ -189,6 +222,17 @@ class PhantomBuffer : public MultiRateBuffer<T> {
 
   void reset();
 
+  /**
+   * Enable or disable the recycling of the memory of tokens which have been
+   * read by all the readers. It is enabled by default for tokens which own
+   * memory.
+   */
+  void setTokenRecycling(bool recycle) {
+    _recycleTokens = recycle && TokenStorage<T>::recyclable;
+  }
+
+  bool tokenRecycling() const { return _recycleTokens; }
+
  protected:
   SourceBase* _parent;
 
@@ -202,6 +246,9 @@ class PhantomBuffer : public MultiRateBuffer<T> {
   RogueVector<T> _writeView;
   std::vector<RogueVector<T> > _readView; // @todo CAREFUL WHEN COPYING ROGUEVECTOR...
 
+  bool _recycleTokens;
+  int _recycled; // total index of the next token whose storage can be recycled
+
   // threading-related & locking structures
   mutable Mutex mutex; // should be locked before any modification to the object
 
@@ -224,6 +271,9 @@ class PhantomBuffer : public MultiRateBuffer<T> {
   void relocateReadWindow(ReaderID id);
   void relocateWriteWindow();
 
+  // give the storage of consumed tokens to the empty slots in [begin, end)
+  void recycleTokens(int begin, int end);
+
 };
 
 } // namespace streaming
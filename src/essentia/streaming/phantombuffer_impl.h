@@ -38,6 +38,10 @@ ReaderID PhantomBuffer<T>::addReader(bool startFromZero) {
   if (!startFromZero) {
     w.end = w.begin = _writeWindow.begin;
   }
+  else {
+    // this reader wants to see the tokens already produced, keep them
+    _recycleTokens = false;
+  }
   _readWindow.push_back(w);
 
   ReaderID id = _readWindow.size() - 1; // index of last one
@@ -114,6 +118,7 @@ bool PhantomBuffer<T>::acquireForWrite(int requested) {
   if (availableForWrite() < requested) return false;
 
   _writeWindow.end = _writeWindow.begin + requested;
+  recycleTokens(_writeWindow.begin, _writeWindow.end);
   updateWriteView();
 
   return true;
@@ -136,6 +141,7 @@ void PhantomBuffer<T>::releaseForWrite(int released) {
     T* first  = &_buffer[_writeWindow.begin];
     T* last   = &_buffer[(std::min)(_writeWindow.begin + released, _phantomSize)];
     T* result = &_buffer[_writeWindow.begin + _bufferSize];
+    recycleTokens(_writeWindow.begin + _bufferSize, _writeWindow.begin + _bufferSize + int(last-first));
     fastcopy(result, first, last-first);
   }
   // replicate from the phantom zone to the beginning if necessary
@@ -144,6 +150,7 @@ void PhantomBuffer<T>::releaseForWrite(int released) {
     T* first  = &_buffer[beginIdx];
     T* last   = &_buffer[_writeWindow.end];
     T* result = &_buffer[beginIdx - _bufferSize];
+    recycleTokens(beginIdx - _bufferSize, _writeWindow.end - _bufferSize);
     fastcopy(result, first, last-first);
   }
 
@@ -294,6 +301,35 @@ void PhantomBuffer<T>::relocateReadWindow(ReaderID id) {
   }
 }
 
+// mutex should be locked before entering this function
+template <typename T>
+void PhantomBuffer<T>::recycleTokens(int begin, int end) {
+  if (!_recycleTokens || _readWindow.empty()) return;
+
+  // tokens which have been released by all the readers can be recycled, except
+  // for the last one produced which can still be asked for
+  int consumed = _writeWindow.total(_bufferSize) - 1;
+  for (uint i=0; i<_readWindow.size(); i++) {
+    consumed = (std::min)(consumed, _readWindow[i].total(_bufferSize));
+  }
+
+  // the slots of older tokens have been overwritten since
+  _recycled = (std::max)(_recycled, _writeWindow.turn*_bufferSize + _writeWindow.end - _bufferSize);
+
+  for (int i=begin; i<end && _recycled<consumed; i++) {
+    if (TokenStorage<T>::hasCapacity(_buffer[i])) continue;
+
+    while (_recycled < consumed) {
+      T& token = _buffer[_recycled % _bufferSize];
+      _recycled++;
+      if (TokenStorage<T>::hasCapacity(token)) {
+        TokenStorage<T>::swap(token, _buffer[i]);
+        break;
+      }
+    }
+  }
+}
+
 template <typename T>
 void PhantomBuffer<T>::reset() {
   // we don't need to clear the buffer, because when new data is written to the
@@ -301,6 +337,7 @@ void PhantomBuffer<T>::reset() {
   // until new data is written
   //_buffer.clear();
   _writeWindow = Window();
+  _recycled = 0;
   for (int i=0; i<(int)_readWindow.size(); i++) {
     _readWindow[i] = Window();
   }
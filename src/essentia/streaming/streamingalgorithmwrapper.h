@@ -65,10 +65,17 @@ class StreamingAlgorithmWrapper : public Algorithm {
   void configure(const ParameterMap& params) {
     _algorithm->configure(params);
     this->setParameters(params);
+    markConfigured();
   }
 
   void configure() {
     _algorithm->configure();
+    markConfigured();
+  }
+
+  // the wrapped algorithm configures itself on its first compute()
+  bool deferDefaultConfiguration() const {
+    return _algorithm->deferDefaultConfiguration();
   }
 
   void reset() {
@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "audiocache.h"
+#include "../threading.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <sys/stat.h>
+
+#ifndef OS_WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <climits>
+#endif
+
+using namespace std;
+
+namespace essentia {
+namespace util {
+
+const char AudioCache::MAGIC[8] = { 'E', 'S', 'S', 'A', 'U', 'D', 'I', '1' };
+
+static ForcedMutex audioCacheMutex;
+static bool audioCacheInitialized = false;
+static string audioCacheDirectory;
+
+string AudioCache::directory() {
+  ForcedMutexLocker lock(audioCacheMutex);
+  if (!audioCacheInitialized) {
+    const char* dir = getenv("ESSENTIA_AUDIO_CACHE");
+    if (dir) audioCacheDirectory = dir;
+    audioCacheInitialized = true;
+  }
+  return audioCacheDirectory;
+}
+
+void AudioCache::setDirectory(const string& directory) {
+  ForcedMutexLocker lock(audioCacheMutex);
+  audioCacheDirectory = directory;
+  audioCacheInitialized = true;
+}
+
+string AudioCache::fileKey(const string& filename, int audioStream) {
+  string absolutePath;
+  long long mtime;
+#ifndef OS_WIN32
+  char resolved[PATH_MAX];
+  struct stat st;
+  if (!realpath(filename.c_str(), resolved) || stat(resolved, &st) != 0) return string();
+  absolutePath = resolved;
+#  ifdef __linux__
+  mtime = (long long)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+#  else
+  mtime = (long long)st.st_mtime;
+#  endif
+#else
+  char resolved[_MAX_PATH];
+  struct _stat64 st;
+  if (!_fullpath(resolved, filename.c_str(), _MAX_PATH) || _stat64(resolved, &st) != 0) return string();
+  absolutePath = resolved;
+  mtime = (long long)st.st_mtime;
+#endif
+
+  // 64-bit FNV-1a hash of the path, which can be too long for a file name
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i=0; i<absolutePath.size(); ++i) {
+    hash = (hash ^ (unsigned char)absolutePath[i]) * 1099511628211ULL;
+  }
+
+  ostringstream key;
+  key << hex << hash << dec << '_' << (long long)st.st_size << '_' << mtime << '_' << audioStream;
+  return key.str();
+}
+
+// path of the file with the given name in the cache directory
+static string cacheFile(const string& name) {
+  string dir = AudioCache::directory();
+  if (dir.empty()) {
+    throw EssentiaException("AudioCache: the cache is disabled, no directory has been set");
+  }
+  if (dir[dir.size()-1] != '/' && dir[dir.size()-1] != '\\') dir += '/';
+  return dir + name;
+}
+
+string AudioCache::indexedMD5(const string& fileKey) {
+  if (fileKey.empty()) return string();
+
+  ifstream in(cacheFile(fileKey + ".md5").c_str());
+  string md5;
+  if (!(in >> md5) || md5.size() != 32 ||
+      md5.find_first_not_of("0123456789abcdef") != string::npos) {
+    return string();
+  }
+  return md5;
+}
+
+void AudioCache::indexMD5(const string& fileKey, const string& md5) {
+  if (fileKey.empty() || md5.empty()) {
+    throw EssentiaException("AudioCache: cannot index a file without its key and its checksum");
+  }
+
+  // same as for the entries, write a temporary file so that concurrent
+  // readers never see an incomplete checksum
+  string indexPath = cacheFile(fileKey + ".md5");
+  ostringstream tmpPath;
+  tmpPath << indexPath << ".tmp";
+#ifndef OS_WIN32
+  tmpPath << "." << getpid();
+#endif
+
+  {
+    ofstream out(tmpPath.str().c_str());
+    out << md5 << '\n';
+    if (!out) {
+      out.close();
+      remove(tmpPath.str().c_str());
+      throw EssentiaException("AudioCache: error while writing file: ", tmpPath.str());
+    }
+  }
+
+#ifdef OS_WIN32
+  remove(indexPath.c_str());
+#endif
+  if (rename(tmpPath.str().c_str(), indexPath.c_str()) != 0) {
+    remove(tmpPath.str().c_str());
+    throw EssentiaException("AudioCache: could not create index file: ", indexPath);
+  }
+}
+
+string AudioCache::path(const string& md5, Real sampleRate, const string& downmix) {
+  if (md5.empty()) {
+    throw EssentiaException("AudioCache: cannot create a cache entry without the checksum of the audio");
+  }
+
+  ostringstream name;
+  name << md5 << '_' << sampleRate << '_' << downmix << ".pcm";
+  return cacheFile(name.str());
+}
+
+void AudioCache::write(const string& path, const vector<Real>& audio,
+                       Real sampleRate, Real originalSampleRate) {
+  Writer writer;
+  writer.open(path);
+  if (!audio.empty()) writer.append(&audio[0], audio.size());
+  writer.commit(sampleRate, originalSampleRate);
+}
+
+
+AudioCache::Writer::Writer() : _size(0) {}
+
+AudioCache::Writer::~Writer() {
+  abort();
+}
+
+void AudioCache::Writer::open(const string& path) {
+  abort();
+
+  ostringstream tmpPath;
+  tmpPath << path << ".tmp";
+#ifndef OS_WIN32
+  tmpPath << "." << getpid();
+#endif
+  tmpPath << "." << (size_t)this;
+
+  _path = path;
+  _tmpPath = tmpPath.str();
+  _size = 0;
+
+  _out.open(_tmpPath.c_str(), ios::binary);
+  if (!_out) {
+    _out.close();
+    _out.clear();
+    throw EssentiaException("AudioCache: could not open file for writing: ", _tmpPath);
+  }
+
+  // the header is written again with the right size on commit()
+  Header header;
+  memset(&header, 0, sizeof(header));
+  _out.write((const char*)&header, sizeof(header));
+}
+
+void AudioCache::Writer::append(const Real* samples, size_t size) {
+  if (!isOpen()) throw EssentiaException("AudioCache: writing to a cache entry which is not open");
+  _out.write((const char*)samples, size*sizeof(Real));
+  if (!_out) {
+    string tmpPath = _tmpPath;
+    abort();
+    throw EssentiaException("AudioCache: error while writing file: ", tmpPath);
+  }
+  _size += size;
+}
+
+void AudioCache::Writer::commit(Real sampleRate, Real originalSampleRate) {
+  if (!isOpen()) throw EssentiaException("AudioCache: committing a cache entry which is not open");
+
+  Header header;
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.size = _size;
+  header.sampleRate = sampleRate;
+  header.originalSampleRate = originalSampleRate;
+
+  _out.seekp(0);
+  _out.write((const char*)&header, sizeof(header));
+  _out.close();
+  if (!_out) {
+    string tmpPath = _tmpPath;
+    abort();
+    throw EssentiaException("AudioCache: error while writing file: ", tmpPath);
+  }
+
+#ifdef OS_WIN32
+  // rename does not replace an existing file on windows
+  remove(_path.c_str());
+#endif
+  if (rename(_tmpPath.c_str(), _path.c_str()) != 0) {
+    string path = _path;
+    abort();
+    throw EssentiaException("AudioCache: could not create cache entry: ", path);
+  }
+  _tmpPath.clear();
+  _path.clear();
+}
+
+void AudioCache::Writer::abort() {
+  if (_out.is_open()) _out.close();
+  _out.clear();
+  if (!_tmpPath.empty()) remove(_tmpPath.c_str());
+  _tmpPath.clear();
+  _path.clear();
+  _size = 0;
+}
+
+
+AudioCache::Entry::Entry() : _open(false), _data(0), _size(0), _sampleRate(0), _originalSampleRate(0),
+                             _mapped(0), _mappedSize(0) {}
+
+AudioCache::Entry::~Entry() {
+  close();
+}
+
+void AudioCache::Entry::close() {
+#ifndef OS_WIN32
+  if (_mapped) munmap(_mapped, _mappedSize);
+#endif
+  _mapped = 0;
+  _mappedSize = 0;
+  _open = false;
+  _data = 0;
+  _size = 0;
+  _buffer.clear();
+}
+
+static bool checkHeader(const AudioCache::Header& header, size_t fileSize) {
+  return memcmp(header.magic, AudioCache::MAGIC, sizeof(AudioCache::MAGIC)) == 0 &&
+         fileSize == sizeof(header) + header.size*sizeof(Real);
+}
+
+bool AudioCache::Entry::open(const string& path) {
+  close();
+
+  Header header;
+
+#ifndef OS_WIN32
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(header)) {
+    ::close(fd);
+    return false;
+  }
+
+  void* mapped = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapped == MAP_FAILED) return false;
+
+  memcpy(&header, mapped, sizeof(header));
+  if (!checkHeader(header, st.st_size)) {
+    munmap(mapped, st.st_size);
+    return false;
+  }
+
+  _mapped = mapped;
+  _mappedSize = st.st_size;
+  _data = (const Real*)((const char*)mapped + sizeof(header));
+#else
+  ifstream in(path.c_str(), ios::binary);
+  if (!in) return false;
+
+  in.seekg(0, ios::end);
+  size_t fileSize = in.tellg();
+  in.seekg(0, ios::beg);
+
+  in.read((char*)&header, sizeof(header));
+  if (!in || !checkHeader(header, fileSize)) return false;
+
+  _buffer.resize(header.size);
+  if (header.size) in.read((char*)&_buffer[0], header.size*sizeof(Real));
+  if (!in) {
+    _buffer.clear();
+    return false;
+  }
+  _data = header.size ? &_buffer[0] : 0;
+#endif
+
+  _open = true;
+  _size = header.size;
+  _sampleRate = header.sampleRate;
+  _originalSampleRate = header.originalSampleRate;
+  return true;
+}
+
+} // namespace util
+} // namespace essentia
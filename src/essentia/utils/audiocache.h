@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_AUDIOCACHE_H
+#define ESSENTIA_AUDIOCACHE_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdint.h>
+#include "../types.h"
+
+namespace essentia {
+namespace util {
+
+/**
+ * On-disk cache of decoded mono audio, so that a file which has already been
+ * decoded, downmixed and resampled does not need to be decoded again (by
+ * another extractor, or by the same one run with another configuration).
+ *
+ * Each entry is a file named after the MD5 checksum of the undecoded audio
+ * (see AudioLoader::md5()), the sampling rate and the downmix type, so that
+ * copies of the same audio share their entries. It contains a 32 bytes
+ * header followed by the raw samples (native endianness), so that it can be
+ * memory-mapped and read without any parsing (see Entry).
+ *
+ * Computing the checksum needs to demux the whole file, so the cache also
+ * keeps a small index from the identity of a file (see fileKey()) to its
+ * checksum. Looking up a file which has already been seen then only needs a
+ * stat() of the file.
+ *
+ * The cache is disabled by default. It is enabled by giving it a directory,
+ * either with setDirectory() or with the ESSENTIA_AUDIO_CACHE environment
+ * variable. Entries are never removed by essentia, the directory can be
+ * cleaned up by deleting its files at any time.
+ */
+class AudioCache {
+
+ public:
+  /**
+   * Directory of the cache, or an empty string if the cache is disabled. It
+   * is initialized from the ESSENTIA_AUDIO_CACHE environment variable.
+   */
+  static std::string directory();
+  static void setDirectory(const std::string& directory);
+  static bool enabled() { return !directory().empty(); }
+
+  /**
+   * Identifies the given audio stream of a file by the absolute path, the
+   * size and the modification time of the file, so that finding its checksum
+   * in the index does not need to read it. A file which is modified in place
+   * without changing its size nor its modification time is not detected.
+   * Returns an empty string if the file cannot be found.
+   */
+  static std::string fileKey(const std::string& filename, int audioStream=0);
+
+  /**
+   * Returns the checksum indexed for the given file key, or an empty string
+   * if there is none.
+   */
+  static std::string indexedMD5(const std::string& fileKey);
+
+  /**
+   * Stores the checksum of the audio identified by the given file key in the
+   * index.
+   */
+  static void indexMD5(const std::string& fileKey, const std::string& md5);
+
+  /**
+   * Path of the cache entry for the audio with the given checksum, in the
+   * current directory.
+   */
+  static std::string path(const std::string& md5, Real sampleRate, const std::string& downmix);
+
+  /**
+   * Writes a cache entry at once (see Writer).
+   */
+  static void write(const std::string& path, const std::vector<Real>& audio,
+                    Real sampleRate, Real originalSampleRate);
+
+  /**
+   * Writes a cache entry as the audio comes, so that it does not need to be
+   * kept in memory. The samples are written to a temporary file, which is
+   * renamed to the entry by commit(), so that concurrent readers never see an
+   * incomplete entry. It is removed if the entry is not committed.
+   */
+  class Writer {
+   public:
+    Writer();
+    ~Writer();
+
+    void open(const std::string& path);
+    bool isOpen() const { return _out.is_open(); }
+    void append(const Real* samples, size_t size);
+    void commit(Real sampleRate, Real originalSampleRate);
+    void abort();
+
+    const std::string& temporaryPath() const { return _tmpPath; }
+
+   protected:
+    std::string _path;
+    std::string _tmpPath;
+    std::ofstream _out;
+    uint64_t _size;
+
+   private:
+    Writer(const Writer&);
+    Writer& operator=(const Writer&);
+  };
+
+  /**
+   * Read-only view of a cache entry, memory-mapped when the platform allows it.
+   */
+  class Entry {
+   public:
+    Entry();
+    ~Entry();
+
+    /**
+     * Returns false if the entry does not exist or is not a valid entry.
+     */
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return _open; }
+
+    const Real* data() const { return _data; }
+    size_t size() const { return _size; }
+    Real sampleRate() const { return _sampleRate; }
+    Real originalSampleRate() const { return _originalSampleRate; }
+
+   protected:
+    bool _open;
+    const Real* _data;
+    size_t _size;
+    Real _sampleRate;
+    Real _originalSampleRate;
+
+    void* _mapped;
+    size_t _mappedSize;
+    std::vector<Real> _buffer; // if the file could not be mapped
+
+   private:
+    Entry(const Entry&);
+    Entry& operator=(const Entry&);
+  };
+
+  struct Header {
+    char magic[8];
+    uint64_t size;
+    double sampleRate;
+    double originalSampleRate;
+  };
+
+  static const char MAGIC[8];
+};
+
+} // namespace util
+} // namespace essentia
+
+#endif // ESSENTIA_AUDIOCACHE_H
@@ -19,13 +19,22 @@
 
 #include "audiocontext.h"
 #include <iostream> // for warning cout
+#include <cstring>
+#ifdef CPP_11
+#  include <system_error>
+#endif
 
 using namespace std;
 using namespace essentia;
 
 AudioContext::AudioContext()
   : _isOpen(false), _avStream(0), _muxCtx(0), _codecCtx(0),
-    _inputBufSize(0), _buffer(0), _convertCtxAv(0) {
+    _inputBufSize(0), _frameSize(0), _bufferFill(0), _convertCtxAv(0),
+    _backgroundEncoding(false), _maxQueuedFrames(32)
+#ifdef CPP_11
+    , _encoderRunning(false), _stopEncoder(false)
+#endif
+    {
   av_log_set_level(AV_LOG_VERBOSE);
   //av_log_set_level(AV_LOG_QUIET);
   
@@ -140,7 +149,9 @@ int AudioContext::create(const std::string& filename,
                                              _codecCtx->channels, 
                                              _codecCtx->frame_size, 
                                              AV_SAMPLE_FMT_FLT, 0);
-  _buffer = (float*)av_malloc(_inputBufSize);
+  _frameSize = _codecCtx->frame_size;
+  _buffer.resize(_codecCtx->channels * _frameSize);
+  _bufferFill = 0;
 
   strncpy(_muxCtx->filename, _filename.c_str(), sizeof(_muxCtx->filename));
 
@@ -175,6 +186,22 @@ void AudioContext::open() {
 
   avformat_write_header(_muxCtx, /* AVDictionary **options */ NULL);
   _isOpen = true;
+
+#ifdef CPP_11
+  if (_backgroundEncoding) startEncoder();
+#endif
+}
+
+
+void AudioContext::setBackgroundEncoding(bool enabled, int maxQueuedFrames) {
+  if (_isOpen) {
+    throw EssentiaException("AudioContext: background encoding has to be set before opening the file");
+  }
+  if (maxQueuedFrames < 1) {
+    throw EssentiaException("AudioContext: the encoder queue should hold at least one frame");
+  }
+  _backgroundEncoding = enabled;
+  _maxQueuedFrames = maxQueuedFrames;
 }
 
 
@@ -183,7 +210,18 @@ void AudioContext::close() {
 
   // Close output file
   if (_isOpen) {
-    writeEOF();
+    // wait for the encoder to be done with all the queued frames, then encode
+    // the last (incomplete) frame and flush the codec, unless the encoder
+    // failed, in which case the file is only closed and the error reported
+    bool failed = false;
+#ifdef CPP_11
+    stopEncoder();
+    failed = bool(_encoderError);
+#endif
+    if (!failed) {
+      if (_bufferFill > 0) writeFrame();
+      writeEOF();
+    }
 
     // Write trailer to the end of the file
     av_write_trailer(_muxCtx);
@@ -193,7 +231,8 @@ void AudioContext::close() {
 
   avcodec_close(_avStream->codec);
 
-  av_freep(&_buffer);
+  _buffer.clear();
+  _bufferFill = 0;
 
   av_freep(&_avStream->codec);
   av_freep(&_avStream);
@@ -203,7 +242,6 @@ void AudioContext::close() {
   _muxCtx = 0;
   _avStream = 0;
   _codecCtx = 0;
-  _buffer = 0;
 
   if (_convertCtxAv) {
     avresample_close(_convertCtxAv);
@@ -211,55 +249,192 @@ void AudioContext::close() {
   }
 
   _isOpen = false;
+
+#ifdef CPP_11
+  // report the error of the encoder thread, even if write() already did
+  if (_encoderError) {
+    exception_ptr error = _encoderError;
+    _encoderError = exception_ptr();
+    rethrow_exception(error);
+  }
+#endif
 }
 
 
 void AudioContext::write(const vector<StereoSample>& stereoData) {
+  write(stereoData.empty() ? 0 : &stereoData[0], (int)stereoData.size());
+}
+
+
+void AudioContext::write(const vector<AudioSample>& monoData) {
+  write(monoData.empty() ? 0 : &monoData[0], (int)monoData.size());
+}
+
+
+void AudioContext::write(const StereoSample* stereoData, int size) {
   if (_codecCtx->channels != 2) {
     throw EssentiaException("Trying to write stereo audio data to an audio file with ", _codecCtx->channels, " channels");
   }
 
-  int dsize = (int)stereoData.size();
-  
-  if (dsize > _codecCtx->frame_size) {
-    // AudioWriter sets up correct buffer sizes in accordance to what 
-    // AudioContext:create() returns. Nevertherless, double-check here.
-    ostringstream msg;
-    msg << "Audio frame size " << _codecCtx->frame_size << 
-           " is not sufficent to store " << dsize << " samples";
-    throw EssentiaException(msg);
-  }
+  while (size > 0) {
+    int n = min(size, _frameSize - _bufferFill);
+    float* dest = &_buffer[2*_bufferFill];
 
-  for (int i=0; i<dsize; ++i) {
-    _buffer[2*i] = (float) stereoData[i].left();
-    _buffer[2*i+1] = (float) stereoData[i].right();
-  }
+    if (sizeof(StereoSample) == 2*sizeof(float) && sizeof(Real) == sizeof(float)) {
+      // StereoSample already is an interleaved pair of floats
+      memcpy(dest, stereoData, n*sizeof(StereoSample));
+    }
+    else {
+      for (int i=0; i<n; ++i) {
+        dest[2*i] = (float) stereoData[i].left();
+        dest[2*i+1] = (float) stereoData[i].right();
+      }
+    }
 
-  encodePacket(dsize);
+    _bufferFill += n;
+    stereoData += n;
+    size -= n;
+
+    if (_bufferFill == _frameSize) writeFrame();
+  }
 }
 
 
-void AudioContext::write(const vector<AudioSample>& monoData) {
+void AudioContext::write(const AudioSample* monoData, int size) {
   if (_codecCtx->channels != 1) {
     throw EssentiaException("Trying to write mono audio data to an audio file with ", _codecCtx->channels, " channels");
   }
 
-  int dsize = (int)monoData.size();
-  if (dsize > _codecCtx->frame_size) {
-    // The same as for stereoData version of write()
-    ostringstream msg;
-    msg << "Audio frame size " << _codecCtx->frame_size << 
-           " is not sufficent to store " << dsize << " samples";
-    throw EssentiaException(msg);
+  while (size > 0) {
+    int n = min(size, _frameSize - _bufferFill);
+    float* dest = &_buffer[_bufferFill];
+
+    if (sizeof(AudioSample) == sizeof(float)) {
+      memcpy(dest, monoData, n*sizeof(AudioSample));
+    }
+    else {
+      for (int i=0; i<n; ++i) dest[i] = (float) monoData[i];
+    }
+
+    _bufferFill += n;
+    monoData += n;
+    size -= n;
+
+    if (_bufferFill == _frameSize) writeFrame();
   }
+}
+
+
+void AudioContext::writeFrame() {
+  int size = _bufferFill;
+  _bufferFill = 0;
+
+#ifdef CPP_11
+  if (_encoderRunning) {
+    unique_lock<mutex> lock(_queueMutex);
+    checkEncoderError();
+    while ((int)_queue.size() >= _maxQueuedFrames && !_encoderError) {
+      _queueNotFull.wait(lock);
+    }
+    checkEncoderError();
+
+    // hand over the frame to the encoder and continue filling a recycled one
+    _queue.push_back(make_pair(vector<float>(), size));
+    _queue.back().first.swap(_buffer);
+    if (!_freeFrames.empty()) {
+      _buffer.swap(_freeFrames.back());
+      _freeFrames.pop_back();
+    }
+    _buffer.resize(_codecCtx->channels * _frameSize);
+
+    _queueNotEmpty.notify_one();
+    return;
+  }
+#endif
+
+  encodePacket(&_buffer[0], size);
+}
+
 
-  for (int i=0; i<dsize; ++i) _buffer[i] = (float) monoData[i];
+#ifdef CPP_11
 
-  encodePacket(dsize);
+void AudioContext::startEncoder() {
+  _stopEncoder = false;
+  _encoderError = exception_ptr();
+  try {
+    _encoder = thread(&AudioContext::runEncoder, this);
+    _encoderRunning = true;
+  }
+  catch (system_error&) {
+    // threads not available on this platform, encode in this one
+    _encoderRunning = false;
+  }
 }
 
 
-void AudioContext::encodePacket(int size) {
+void AudioContext::stopEncoder() {
+  if (!_encoderRunning) return;
+
+  {
+    lock_guard<mutex> lock(_queueMutex);
+    _stopEncoder = true;
+  }
+  _queueNotEmpty.notify_one();
+  _encoder.join();
+
+  _encoderRunning = false;
+  _queue.clear();
+  _freeFrames.clear();
+}
+
+
+void AudioContext::runEncoder() {
+  unique_lock<mutex> lock(_queueMutex);
+
+  while (true) {
+    while (_queue.empty() && !_stopEncoder) _queueNotEmpty.wait(lock);
+    if (_queue.empty()) break;
+
+    pair<vector<float>, int> frame;
+    frame.first.swap(_queue.front().first);
+    frame.second = _queue.front().second;
+    _queue.pop_front();
+
+    // once an error occurred, the remaining frames are dropped
+    if (!_encoderError) {
+      lock.unlock();
+      try {
+        encodePacket(&frame.first[0], frame.second);
+      }
+      catch (...) {
+        lock.lock();
+        _encoderError = current_exception();
+        lock.unlock();
+      }
+      lock.lock();
+    }
+
+    _freeFrames.push_back(vector<float>());
+    _freeFrames.back().swap(frame.first);
+    _queueNotFull.notify_one();
+  }
+}
+
+
+// should be called with _queueMutex locked. The error stays stored, so that
+// the encoder keeps dropping frames and close() does not finish the file; it
+// is only cleared once close() has reported it
+void AudioContext::checkEncoderError() {
+  if (_encoderError) {
+    exception_ptr error = _encoderError;
+    rethrow_exception(error);
+  }
+}
+
+#endif // CPP_11
+
+
+void AudioContext::encodePacket(const float* buffer, int size) {
 
   int tmp_fs = _codecCtx->frame_size;
   if (size < _codecCtx->frame_size) {
@@ -284,11 +459,12 @@ void AudioContext::encodePacket(int size) {
     throw EssentiaException("Could not allocate output buffer for sample format conversion");
   }
  
+  const float* input = buffer;
   int written = avresample_convert(_convertCtxAv,
                                    &bufferFmt, 
                                    outputPlaneSize,
                                    size, 
-                                   (uint8_t**) &_buffer,
+                                   (uint8_t**) &input,
                                    inputPlaneSize, 
                                    size);
 
@@ -25,6 +25,14 @@
 #include "types.h"
 #include "ffmpegapi.h"
 
+#ifdef CPP_11
+#  include <thread>
+#  include <mutex>
+#  include <condition_variable>
+#  include <deque>
+#  include <exception>
+#endif
+
 #define MAX_AUDIO_FRAME_SIZE 192000 // the same value as in AudioLoader
 
 namespace essentia {
@@ -42,29 +50,71 @@ class AudioContext {
   AVCodecContext* _codecCtx;
 
   int _inputBufSize;   // input buffer size
-  float* _buffer;      // input FLT buffer interleaved
+  int _frameSize;      // codec frame size, in samples per channel
+  std::vector<float> _buffer; // input FLT buffer interleaved, holds one codec frame
+  int _bufferFill;            // number of samples (per channel) in _buffer
   uint8_t* _buffer_test; // input buffer in converted to codec sample format
 
   struct AVAudioResampleContext* _convertCtxAv;
 
   //const static int FFMPEG_BUFFER_SIZE = MAX_AUDIO_FRAME_SIZE * 2;
   // MAX_AUDIO_FRAME_SIZE is in bytes, multiply it by 2 to get some margin
-  
+
+  // background encoding: full frames are queued by write() and encoded and
+  // muxed by the encoder thread, so that the caller does not wait for the codec
+  bool _backgroundEncoding;
+  int _maxQueuedFrames;
+#ifdef CPP_11
+  std::thread _encoder;
+  bool _encoderRunning;
+  bool _stopEncoder;
+  std::mutex _queueMutex;
+  std::condition_variable _queueNotEmpty;
+  std::condition_variable _queueNotFull;
+  std::deque<std::pair<std::vector<float>, int> > _queue;
+  std::vector<std::vector<float> > _freeFrames;
+  std::exception_ptr _encoderError;
+
+  void startEncoder();
+  void stopEncoder();
+  void runEncoder();
+  void checkEncoderError();
+#endif
 
  public:
   AudioContext();
-  ~AudioContext() { close(); }
+  ~AudioContext() {
+    // errors of the encoder thread can only be reported by an explicit close()
+    try { close(); } catch (...) {}
+  }
   int create(const std::string& filename, const std::string& format,
              int nChannels, int sampleRate, int bitrate);
   void open();
   bool isOpen() const { return _isOpen; }
+
+  /**
+   * Encodes the audio in a separate thread, which is fed by a queue of at most
+   * maxQueuedFrames codec frames (write() blocks when the queue is full). Has
+   * to be called before open(). Without C++11 threads, the audio is always
+   * encoded in the calling thread.
+   */
+  void setBackgroundEncoding(bool enabled, int maxQueuedFrames=32);
+
+  /**
+   * Writes a block of samples of any size. The samples are accumulated into
+   * frames of the codec's frame size, and the last incomplete frame is
+   * encoded when closing the file.
+   */
+  void write(const AudioSample* monoData, int size);
+  void write(const StereoSample* stereoData, int size);
   void write(const std::vector<AudioSample>& monoData);
   void write(const std::vector<StereoSample>& stereoData);
   void close();
 
  protected:
   int16_t scale(Real value);
-  void encodePacket(int size);
+  void writeFrame();
+  void encodePacket(const float* buffer, int size);
   void writeEOF();
 };
 
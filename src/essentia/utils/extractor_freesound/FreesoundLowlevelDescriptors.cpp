@@ -24,7 +24,14 @@ using namespace essentia::streaming;
 
 const string FreesoundLowlevelDescriptors::nameSpace="lowlevel.";  
 
+FreesoundLowlevelDescriptors::~FreesoundLowlevelDescriptors() {}
+
 void FreesoundLowlevelDescriptors::createNetwork(SourceBase& source, Pool& pool){
+  createNetworkFrames(source, pool);
+  createNetworkWholeAudio(source, pool);
+}
+
+void FreesoundLowlevelDescriptors::createNetworkFrames(SourceBase& source, Pool& pool){
 
   AlgorithmFactory& factory = AlgorithmFactory::instance();
 
@@ -290,6 +297,22 @@ void FreesoundLowlevelDescriptors::createNetwork(SourceBase& source, Pool& pool)
   Algorithm* ln = factory.create("Loudness");
   fc->output("frame") >> ln->input("signal");
   ln->output("loudness") >> PC(pool, nameSpace + "loudness");
+}
+
+void FreesoundLowlevelDescriptors::createNetworkWholeAudio(SourceBase& source, Pool& pool){
+
+  AlgorithmFactory& factory = AlgorithmFactory::instance();
+
+  Real sampleRate = options.value<Real>("analysisSampleRate");
+  int frameSize =   int(options.value<Real>("lowlevel.frameSize"));
+  int hopSize =     int(options.value<Real>("lowlevel.hopSize"));
+  string silentFrames = options.value<string>("lowlevel.silentFrames");
+
+  Algorithm* fc = factory.create("FrameCutter",
+                                 "frameSize", frameSize,
+                                 "hopSize", hopSize,
+                                 "silentFrames", silentFrames);
+  source >> fc->input("signal");
 
   // StartStopSilence
   Algorithm* ss = factory.create("StartStopSilence","threshold",-60);
@@ -36,6 +36,10 @@ class FreesoundLowlevelDescriptors : public FreesoundDescriptorSet {
   ~FreesoundLowlevelDescriptors();
 
  	void createNetwork(SourceBase& source, Pool& pool);
+  // frame-level descriptors, and descriptors of the whole audio, which
+  // together make the network above
+  void createNetworkFrames(SourceBase& source, Pool& pool);
+  void createNetworkWholeAudio(SourceBase& source, Pool& pool);
 	void computeAverageLoudness(Pool& pool);
 };
 
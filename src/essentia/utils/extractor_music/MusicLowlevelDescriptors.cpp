@@ -25,6 +25,8 @@ using namespace essentia::streaming;
 
 const string MusicLowlevelDescriptors::nameSpace="lowlevel.";  
 
+MusicLowlevelDescriptors::~MusicLowlevelDescriptors() {}
+
 void MusicLowlevelDescriptors::createNetworkNeqLoud(SourceBase& source, Pool& pool){
 
   AlgorithmFactory& factory = AlgorithmFactory::instance();
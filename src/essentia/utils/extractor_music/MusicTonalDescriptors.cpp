@@ -77,6 +77,11 @@ void MusicTonalDescriptors::createNetwork(SourceBase& source, Pool& pool) {
 
   Real tuningFreq = pool.value<vector<Real> >(nameSpace + "tuning_frequency").back();
 
+  const char* profileTypesArray[] = { "temperley", "krumhansl", "edma" };
+  vector<string> profileTypes = arrayToVector<string>(profileTypesArray);
+  Real hpcpSizesArray[] = { 36, 120 };
+  vector<Real> hpcpSizes = arrayToVector<Real>(hpcpSizesArray);
+
   AlgorithmFactory& factory = AlgorithmFactory::instance();
 
   Algorithm* fc = factory.create("FrameCutter",
@@ -113,42 +118,32 @@ void MusicTonalDescriptors::createNetwork(SourceBase& source, Pool& pool) {
   // - windowSize = 4.0/3.0
   // - bandPreset = true
 
-  Algorithm* skey_temperley = factory.create("Key",
-                                   "numHarmonics", 4,
-                                   "pcpSize", 36,
-                                   "profileType", "temperley",
-                                   "slope", 0.6,
-                                   "usePolyphony", true,
-                                   "useThreeChords", true);
-
-  Algorithm* skey_krumhansl = factory.create("Key",
-                                   "numHarmonics", 4,
-                                   "pcpSize", 36,
-                                   "profileType", "krumhansl",
-                                   "slope", 0.6,
-                                   "usePolyphony", true,
-                                   "useThreeChords", true);
-
-  Algorithm* skey_edma = factory.create("Key",
-                                   "numHarmonics", 4,
-                                   "pcpSize", 36,
-                                   "profileType", "edma",
-                                   "slope", 0.6,
-                                   "usePolyphony", true,
-                                   "useThreeChords", true);
+  // Key estimation using the temperley, krumhansl and edma profiles, all of
+  // them scored in a single pass over the same averaged HPCP
+  Algorithm* skeys = factory.create("MultiProfileKey",
+                                    "numHarmonics", 4,
+                                    "pcpSize", 36,
+                                    "profileTypes", profileTypes,
+                                    "slope", 0.6,
+                                    "usePolyphony", true,
+                                    "useThreeChords", true);
 
   // TODO review this parameters to improve our chords detection
-  Algorithm* hpcp_chord = factory.create("HPCP",
-                                         "size", 36,
-                                         "referenceFrequency", tuningFreq,
-                                         "harmonics", 8,
-                                         "bandPreset", true,
-                                         "minFrequency", 20.0,
-                                         "maxFrequency", 3500.0,
-                                         "bandSplitFrequency", 500.0,
-                                         "weightType", "cosine",
-                                         "nonLinear", true,
-                                         "windowSize", 0.5);
+  // The HPCPs for chords (size 36) and tuning (size 120) share the same
+  // parameters, so they are computed in a single pass over the peaks
+  Algorithm* hpcp_chord_tuning = factory.create("MultiResolutionHPCP",
+                                                "sizes", hpcpSizes,
+                                                "referenceFrequency", tuningFreq,
+                                                "harmonics", 8,
+                                                "bandPreset", true,
+                                                "minFrequency", 20.0,
+                                                "maxFrequency", 3500.0,
+                                                "bandSplitFrequency", 500.0,
+                                                "weightType", "cosine",
+                                                "nonLinear", true,
+                                                "windowSize", 0.5);
+  SourceBase& hpcp_chord = hpcp_chord_tuning->output("hpcp_0");
+  SourceBase& hpcp_tuning = hpcp_chord_tuning->output("hpcp_1");
 
   Algorithm* schord = factory.create("ChordsDetection");
   Algorithm* schords_desc = factory.create("ChordsDescriptors");
@@ -161,26 +156,21 @@ void MusicTonalDescriptors::createNetwork(SourceBase& source, Pool& pool) {
   peaks->output("frequencies") >> hpcp_key->input("frequencies");
   peaks->output("magnitudes")  >> hpcp_key->input("magnitudes");
   hpcp_key->output("hpcp")     >> PC(pool, nameSpace + "hpcp");
-  hpcp_key->output("hpcp")     >> skey_temperley->input("pcp");
-  hpcp_key->output("hpcp")     >> skey_krumhansl->input("pcp");
-  hpcp_key->output("hpcp")     >> skey_edma->input("pcp");
-
-  skey_temperley->output("key")          >> PC(pool, nameSpace + "key_temperley.key");
-  skey_temperley->output("scale")        >> PC(pool, nameSpace + "key_temperley.scale");
-  skey_temperley->output("strength")     >> PC(pool, nameSpace + "key_temperley.strength");
-
-  skey_krumhansl->output("key")          >> PC(pool, nameSpace + "key_krumhansl.key");
-  skey_krumhansl->output("scale")        >> PC(pool, nameSpace + "key_krumhansl.scale");
-  skey_krumhansl->output("strength")     >> PC(pool, nameSpace + "key_krumhansl.strength");
-
-  skey_edma->output("key")          >> PC(pool, nameSpace + "key_edma.key");
-  skey_edma->output("scale")        >> PC(pool, nameSpace + "key_edma.scale");
-  skey_edma->output("strength")     >> PC(pool, nameSpace + "key_edma.strength");
+  hpcp_key->output("hpcp")     >> skeys->input("pcp");
+
+  for (int i=0; i<(int)profileTypes.size(); i++) {
+    ostringstream index;
+    index << i;
+    string keyName = nameSpace + "key_" + profileTypes[i];
+    skeys->output("key_" + index.str())      >> PC(pool, keyName + ".key");
+    skeys->output("scale_" + index.str())    >> PC(pool, keyName + ".scale");
+    skeys->output("strength_" + index.str()) >> PC(pool, keyName + ".strength");
+  }
 
 
-  peaks->output("frequencies") >> hpcp_chord->input("frequencies");
-  peaks->output("magnitudes")  >> hpcp_chord->input("magnitudes");
-  hpcp_chord->output("hpcp")   >> schord->input("pcp");
+  peaks->output("frequencies") >> hpcp_chord_tuning->input("frequencies");
+  peaks->output("magnitudes")  >> hpcp_chord_tuning->input("magnitudes");
+  hpcp_chord                   >> schord->input("pcp");
   schord->output("strength")   >> PC(pool, nameSpace + "chords_strength");
   
   // TODO: Chords progression has low practical sense and is based on a very simple algorithm prone to errors.
@@ -191,8 +181,8 @@ void MusicTonalDescriptors::createNetwork(SourceBase& source, Pool& pool) {
   //       estimated using temperley profile. Should we align to the most 
   //       frequent chord instead?  
   schord->output("chords")               >> schords_desc->input("chords");
-  skey_temperley->output("key")          >> schords_desc->input("key");
-  skey_temperley->output("scale")        >> schords_desc->input("scale");
+  skeys->output("key_0")                 >> schords_desc->input("key");   // temperley
+  skeys->output("scale_0")               >> schords_desc->input("scale");
   schords_desc->output("chordsHistogram")   >> PC(pool, nameSpace + "chords_histogram");
   schords_desc->output("chordsNumberRate")  >> PC(pool, nameSpace + "chords_number_rate");
   schords_desc->output("chordsChangesRate") >> PC(pool, nameSpace + "chords_changes_rate");
@@ -201,29 +191,15 @@ void MusicTonalDescriptors::createNetwork(SourceBase& source, Pool& pool) {
 
   // HPCP Entropy and Crest
   Algorithm* ent = factory.create("Entropy");
-  hpcp_chord->output("hpcp")  >> ent->input("array");
+  hpcp_chord                  >> ent->input("array");
   ent->output("entropy")      >> PC(pool, nameSpace + "hpcp_entropy");
   
   Algorithm* crest = factory.create("Crest");
-  hpcp_chord->output("hpcp") >> crest->input("array");
+  hpcp_chord                 >> crest->input("array");
   crest->output("crest") >> PC(pool, nameSpace + "hpcp_crest");
 
   // HPCP Tuning
-  Algorithm* hpcp_tuning = factory.create("HPCP",
-                                          "size", 120,
-                                          "referenceFrequency", tuningFreq,
-                                          "harmonics", 8,
-                                          "bandPreset", true,
-                                          "minFrequency", 20.0,
-                                          "maxFrequency", 3500.0,
-                                          "bandSplitFrequency", 500.0,
-                                          "weightType", "cosine",
-                                          "nonLinear", true,
-                                          "windowSize", 0.5);
-
-  peaks->output("frequencies")  >> hpcp_tuning->input("frequencies");
-  peaks->output("magnitudes")   >> hpcp_tuning->input("magnitudes");
-  hpcp_tuning->output("hpcp")   >> PC(pool, nameSpace + "hpcp_highres");
+  hpcp_tuning                  >> PC(pool, nameSpace + "hpcp_highres");
 }
 
 
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "fftcorrelation.h"
+#include "algorithmfactory.h"
+#include "essentiamath.h"
+
+using namespace std;
+
+namespace essentia {
+namespace util {
+
+FFTCorrelation::FFTCorrelation(size_t maxCachedSizes)
+  : _maxCachedSizes(max(maxCachedSizes, (size_t)1)), _uses(0) {}
+
+FFTCorrelation::~FFTCorrelation() {
+  for (size_t i=0; i<_plans.size(); ++i) {
+    delete _plans[i].fft;
+    delete _plans[i].ifft;
+    delete _plans[i].ifftNormalized;
+  }
+}
+
+int FFTCorrelation::fftSize(int sizeX, int sizeY) {
+  return nextPowerTwo(max(sizeX + sizeY - 1, 2));
+}
+
+FFTCorrelation::Plans& FFTCorrelation::plans(int sizeFFT) {
+  _uses++;
+  size_t oldest = 0;
+  for (size_t i=0; i<_plans.size(); ++i) {
+    if (_plans[i].size == sizeFFT) {
+      _plans[i].lastUse = _uses;
+      return _plans[i];
+    }
+    if (_plans[i].lastUse < _plans[oldest].lastUse) oldest = i;
+  }
+
+  // not cached yet: evict the least recently used size if the cache is full
+  if (_plans.size() >= _maxCachedSizes) {
+    delete _plans[oldest].fft;
+    delete _plans[oldest].ifft;
+    delete _plans[oldest].ifftNormalized;
+    _plans.erase(_plans.begin() + oldest);
+  }
+
+  Plans p;
+  p.size = sizeFFT;
+  p.lastUse = _uses;
+  p.fft = standard::AlgorithmFactory::create("FFT", "size", sizeFFT);
+  p.ifft = standard::AlgorithmFactory::create("IFFT", "size", sizeFFT,
+                                              "normalize", false);
+  p.ifftNormalized = 0;
+  _plans.push_back(p);
+  return _plans.back();
+}
+
+void FFTCorrelation::spectrum(const vector<Real>& x, int sizeFFT,
+                              vector<complex<Real> >& fft) {
+  if ((int)x.size() > sizeFFT) {
+    throw EssentiaException("FFTCorrelation: input is larger than the FFT size");
+  }
+  _padded.resize(sizeFFT);
+  for (int i=0; i<(int)x.size(); ++i) _padded[i] = x[i];
+  for (int i=(int)x.size(); i<sizeFFT; ++i) _padded[i] = 0.0;
+
+  standard::Algorithm* algo = plans(sizeFFT).fft;
+  algo->input("frame").set(_padded);
+  algo->output("fft").set(fft);
+  algo->compute();
+}
+
+void FFTCorrelation::inverse(const vector<complex<Real> >& fft,
+                             vector<Real>& x, bool normalize) {
+  int sizeFFT = ((int)fft.size() - 1) * 2;
+
+  // the normalization is left to the IFFT, so that results are exactly
+  // those of an IFFT configured with the same normalization
+  Plans& p = plans(sizeFFT);
+  if (normalize && !p.ifftNormalized) {
+    p.ifftNormalized = standard::AlgorithmFactory::create("IFFT", "size", sizeFFT,
+                                                          "normalize", true);
+  }
+  standard::Algorithm* algo = normalize ? p.ifftNormalized : p.ifft;
+  algo->input("fft").set(fft);
+  algo->output("frame").set(x);
+  algo->compute();
+}
+
+void FFTCorrelation::correlateSpectra(const vector<Real>& x,
+                                      const vector<complex<Real> >& fftY,
+                                      int sizeY, int sizeFFT, int minLag, int maxLag,
+                                      vector<Real>& correlation) {
+  int sizeX = (int)x.size();
+  spectrum(x, sizeFFT, _fftX);
+
+  // X * conj(Y) is the spectrum of the circular cross-correlation, which is
+  // the linear one as sizeFFT >= sizeX + sizeY - 1
+  for (int i=0; i<(int)_fftX.size(); ++i) {
+    _fftX[i] *= conj(fftY[i]);
+  }
+  inverse(_fftX, _corr);
+
+  correlation.resize(maxLag - minLag + 1);
+  for (int lag=minLag; lag<=maxLag; ++lag) {
+    Real value = 0;
+    if (lag >= 0 && lag < sizeX) value = _corr[lag];
+    else if (lag < 0 && lag > -sizeY) value = _corr[sizeFFT + lag];
+    correlation[lag - minLag] = value;
+  }
+}
+
+void FFTCorrelation::crossCorrelation(const vector<Real>& x, const vector<Real>& y,
+                                      int minLag, int maxLag, vector<Real>& correlation) {
+  int sizeFFT = fftSize(x.size(), y.size());
+  spectrum(y, sizeFFT, _fftY);
+  correlateSpectra(x, _fftY, y.size(), sizeFFT, minLag, maxLag, correlation);
+}
+
+void FFTCorrelation::crossCorrelation(const vector<vector<Real> >& xs,
+                                      const vector<Real>& y, int minLag, int maxLag,
+                                      vector<vector<Real> >& correlations) {
+  correlations.resize(xs.size());
+  if (xs.empty()) return;
+
+  int sizeX = xs[0].size();
+  for (size_t i=1; i<xs.size(); ++i) {
+    if ((int)xs[i].size() != sizeX) {
+      throw EssentiaException("FFTCorrelation: batched inputs must all have the same size");
+    }
+  }
+
+  int sizeFFT = fftSize(sizeX, y.size());
+  spectrum(y, sizeFFT, _fftY);
+  for (size_t i=0; i<xs.size(); ++i) {
+    correlateSpectra(xs[i], _fftY, y.size(), sizeFFT, minLag, maxLag, correlations[i]);
+  }
+}
+
+void FFTCorrelation::autoCorrelation(const vector<Real>& x, vector<Real>& correlation) {
+  int size = x.size();
+  if (size == 0) {
+    correlation.clear();
+    return;
+  }
+  int sizeFFT = fftSize(size, size);
+  spectrum(x, sizeFFT, _fftX);
+
+  // squared amplitude of the spectrum
+  for (int i=0; i<(int)_fftX.size(); ++i) {
+    _fftX[i] = complex<Real>(_fftX[i].real() * _fftX[i].real() +
+                             _fftX[i].imag() * _fftX[i].imag(), 0.0);
+  }
+  inverse(_fftX, _corr);
+
+  correlation.assign(_corr.begin(), _corr.begin() + size);
+}
+
+void FFTCorrelation::autoCorrelation(const vector<vector<Real> >& xs,
+                                     vector<vector<Real> >& correlations) {
+  correlations.resize(xs.size());
+  for (size_t i=0; i<xs.size(); ++i) {
+    if (xs[i].size() != xs[0].size()) {
+      throw EssentiaException("FFTCorrelation: batched inputs must all have the same size");
+    }
+    autoCorrelation(xs[i], correlations[i]);
+  }
+}
+
+} // namespace util
+} // namespace essentia
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_FFTCORRELATION_H
+#define ESSENTIA_FFTCORRELATION_H
+
+#include <vector>
+#include <complex>
+#include "../types.h"
+
+namespace essentia {
+namespace standard {
+class Algorithm;
+}
+
+namespace util {
+
+/**
+ * Computes correlations in the frequency domain, in O(n log n).
+ *
+ * FFT sizes are always powers of two, so inputs of different lengths falling
+ * in the same size bucket share the same FFT/IFFT instances (and thus the
+ * same plans). The instances of the last few buckets used are kept, so that
+ * alternating between a few input sizes does not recreate the plans.
+ *
+ * The batched methods process many equal-length windows with the same plans
+ * and buffers; when correlating them against a single reference, the
+ * spectrum of the reference is only computed once.
+ */
+class FFTCorrelation {
+
+ public:
+  FFTCorrelation(size_t maxCachedSizes=4);
+  ~FFTCorrelation();
+
+  /**
+   * Returns the FFT size needed for a linear (non circular) correlation of
+   * arrays of the given sizes.
+   */
+  static int fftSize(int sizeX, int sizeY);
+
+  /**
+   * Computes the spectrum of x, zero-padded to sizeFFT (a power of two).
+   */
+  void spectrum(const std::vector<Real>& x, int sizeFFT,
+                std::vector<std::complex<Real> >& fft);
+
+  /**
+   * Computes the inverse of a spectrum of size sizeFFT/2+1, optionally
+   * normalized by sizeFFT.
+   */
+  void inverse(const std::vector<std::complex<Real> >& fft,
+               std::vector<Real>& x, bool normalize=true);
+
+  /**
+   * Cross-correlation r[lag-minLag] = sum_i x[i]*y[i-lag], for lag in
+   * [minLag, maxLag]. Lags with no overlap between x and y are zero.
+   */
+  void crossCorrelation(const std::vector<Real>& x, const std::vector<Real>& y,
+                        int minLag, int maxLag, std::vector<Real>& correlation);
+
+  /**
+   * Batched cross-correlation of several arrays of the same size with a
+   * single array y.
+   */
+  void crossCorrelation(const std::vector<std::vector<Real> >& xs,
+                        const std::vector<Real>& y, int minLag, int maxLag,
+                        std::vector<std::vector<Real> >& correlations);
+
+  /**
+   * Autocorrelation r[lag] = sum_i x[i]*x[i+lag], for lag in [0, size(x)-1],
+   * without normalization.
+   */
+  void autoCorrelation(const std::vector<Real>& x, std::vector<Real>& correlation);
+
+  /**
+   * Batched autocorrelation of several arrays of the same size.
+   */
+  void autoCorrelation(const std::vector<std::vector<Real> >& xs,
+                       std::vector<std::vector<Real> >& correlations);
+
+ protected:
+  struct Plans {
+    int size;
+    unsigned long lastUse;
+    standard::Algorithm* fft;
+    standard::Algorithm* ifft;           // not normalized
+    standard::Algorithm* ifftNormalized; // created on first use
+  };
+
+  size_t _maxCachedSizes;
+  unsigned long _uses;
+  std::vector<Plans> _plans;
+
+  std::vector<Real> _padded;
+  std::vector<Real> _corr;
+  std::vector<std::complex<Real> > _fftX;
+  std::vector<std::complex<Real> > _fftY;
+
+  Plans& plans(int sizeFFT);
+
+  void correlateSpectra(const std::vector<Real>& x,
+                        const std::vector<std::complex<Real> >& fftY,
+                        int sizeY, int sizeFFT, int minLag, int maxLag,
+                        std::vector<Real>& correlation);
+
+ private:
+  // plans are owned, copying is not allowed
+  FFTCorrelation(const FFTCorrelation&);
+  FFTCorrelation& operator=(const FFTCorrelation&);
+};
+
+} // namespace util
+} // namespace essentia
+
+#endif // ESSENTIA_FFTCORRELATION_H
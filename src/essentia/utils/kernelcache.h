@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_KERNELCACHE_H
+#define ESSENTIA_KERNELCACHE_H
+
+#include <map>
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include "../parameter.h"
+#include "../threading.h"
+
+namespace essentia {
+namespace util {
+
+/**
+ * Returns a string identifying an algorithm configuration, to be used as the
+ * key of a KernelCache. All the parameters are used, except the ones listed
+ * in exclude (which should be appended by the caller if they are changed
+ * at compute time).
+ */
+inline std::string kernelKey(const std::string& name, const ParameterMap& params,
+                             const std::vector<std::string>& exclude = std::vector<std::string>()) {
+  std::string key = name;
+  for (ParameterMap::const_iterator it = params.begin(); it != params.end(); ++it) {
+    if (std::find(exclude.begin(), exclude.end(), it->first) != exclude.end()) continue;
+    key += ";" + it->first + "=" + it->second.toString(17);
+  }
+  return key;
+}
+
+/**
+ * Helpers to write the kernels of a KernelCache to disk. Only vectors of POD
+ * types are supported, which is all the kernels need.
+ */
+template <typename T>
+void writeBinary(std::ostream& out, const std::vector<T>& v) {
+  size_t size = v.size();
+  out.write((const char*)&size, sizeof(size));
+  if (size) out.write((const char*)&v[0], size*sizeof(T));
+}
+
+/**
+ * Returns the number of bytes left to read in the given stream, or -1 if the
+ * stream cannot tell (it is not seekable).
+ */
+inline std::streamoff remainingBytes(std::istream& in) {
+  std::streampos pos = in.tellg();
+  if (pos < 0) return -1;
+  in.seekg(0, std::ios::end);
+  std::streampos end = in.tellg();
+  in.seekg(pos);
+  return end - pos;
+}
+
+/**
+ * Reads the number of elements of a container, each of them taking at least
+ * elementSize bytes in the stream. Throws if the stream cannot hold that many
+ * elements, so that a corrupt or truncated file does not make the caller
+ * allocate an arbitrary amount of memory.
+ */
+inline size_t readSize(std::istream& in, size_t elementSize) {
+  size_t size = 0;
+  in.read((char*)&size, sizeof(size));
+  if (!in) throw EssentiaException("KernelCache: unexpected end of file");
+
+  std::streamoff remaining = remainingBytes(in);
+  if (remaining >= 0 && elementSize > 0 && size > (size_t)remaining / elementSize) {
+    std::ostringstream msg;
+    msg << "KernelCache: corrupt file, " << size << " elements announced but only "
+        << remaining << " bytes left";
+    throw EssentiaException(msg);
+  }
+  return size;
+}
+
+template <typename T>
+void readBinary(std::istream& in, std::vector<T>& v) {
+  size_t size = readSize(in, sizeof(T));
+  v.resize(size);
+  if (size) in.read((char*)&v[0], size*sizeof(T));
+  if (!in) throw EssentiaException("KernelCache: unexpected end of file");
+}
+
+inline void writeBinary(std::ostream& out, const std::string& s) {
+  writeBinary(out, std::vector<char>(s.begin(), s.end()));
+}
+
+inline void readBinary(std::istream& in, std::string& s) {
+  std::vector<char> v;
+  readBinary(in, v);
+  s.assign(v.begin(), v.end());
+}
+
+
+/**
+ * Process-wide cache of precomputed kernels (filterbanks, spectral kernels,
+ * etc.), keyed by the configuration they were computed from (see kernelKey()).
+ * It is meant for algorithms whose configure() is expensive compared to
+ * compute(), and which are reconfigured often with the same parameters.
+ *
+ * Kernels are shared, not copied: get() returns a pointer to the cached
+ * kernel, which stays valid as long as it is held, even if the kernel is
+ * evicted from the cache in the meantime.
+ *
+ * The Kernel type must implement:
+ *   static const char* cacheTag();  // identifies the type of kernel in files
+ *   static int cacheVersion();      // to be increased when the format changes
+ *   void write(std::ostream& out) const;
+ *   void read(std::istream& in);
+ * so that the cache can be saved to disk and loaded in another process.
+ *
+ * The cache holds at most maxSize() kernels; when it is full, the oldest
+ * kernel is discarded.
+ */
+template <typename Kernel>
+class KernelCache {
+
+ public:
+  /**
+   * The cache for this type of kernels.
+   */
+  static KernelCache& instance() {
+    static KernelCache cache;
+    return cache;
+  }
+
+  typedef std::shared_ptr<const Kernel> KernelPtr;
+
+  /**
+   * Returns the kernel for the given key, or a null pointer if it is not in
+   * the cache.
+   */
+  KernelPtr get(const std::string& key) {
+    ForcedMutexLocker lock(_mutex);
+    typename std::map<std::string, KernelPtr>::const_iterator it = _kernels.find(key);
+    if (it == _kernels.end()) {
+      _misses++;
+      return KernelPtr();
+    }
+    _hits++;
+    return it->second;
+  }
+
+  /**
+   * Copies the kernel for the given key into kernel, and returns whether it
+   * was found. Prefer get(key), which does not copy the kernel.
+   */
+  bool get(const std::string& key, Kernel& kernel) {
+    KernelPtr cached = get(key);
+    if (!cached) return false;
+    kernel = *cached;
+    return true;
+  }
+
+  void insert(const std::string& key, const KernelPtr& kernel) {
+    ForcedMutexLocker lock(_mutex);
+    insertLocked(key, kernel);
+  }
+
+  void insert(const std::string& key, const Kernel& kernel) {
+    insert(key, KernelPtr(new Kernel(kernel)));
+  }
+
+  void clear() {
+    ForcedMutexLocker lock(_mutex);
+    _kernels.clear();
+    _order.clear();
+    _hits = 0;
+    _misses = 0;
+  }
+
+  /**
+   * Number of calls to get() which found, or did not find, a kernel since the
+   * cache was created or cleared.
+   */
+  size_t hits() {
+    ForcedMutexLocker lock(_mutex);
+    return _hits;
+  }
+
+  size_t misses() {
+    ForcedMutexLocker lock(_mutex);
+    return _misses;
+  }
+
+  size_t size() {
+    ForcedMutexLocker lock(_mutex);
+    return _kernels.size();
+  }
+
+  size_t maxSize() const { return _maxSize; }
+
+  void setMaxSize(size_t maxSize) {
+    ForcedMutexLocker lock(_mutex);
+    _maxSize = std::max(maxSize, (size_t)1);
+    while (_kernels.size() > _maxSize) evictOldest();
+  }
+
+  /**
+   * Writes all the kernels in the cache to the given file.
+   */
+  void save(const std::string& filename) {
+    ForcedMutexLocker lock(_mutex);
+    std::ofstream out(filename.c_str(), std::ios::binary);
+    if (!out) throw EssentiaException("KernelCache: could not open file for writing: ", filename);
+
+    size_t count = _order.size();
+    int version = Kernel::cacheVersion();
+    out.write(MAGIC, sizeof(MAGIC));
+    writeBinary(out, std::string(Kernel::cacheTag()));
+    out.write((const char*)&version, sizeof(version));
+    out.write((const char*)&count, sizeof(count));
+    for (size_t i=0; i<_order.size(); ++i) {
+      writeBinary(out, _order[i]);
+      _kernels[_order[i]]->write(out);
+    }
+    if (!out) throw EssentiaException("KernelCache: error while writing file: ", filename);
+  }
+
+  /**
+   * Adds the kernels stored in the given file to the cache. Throws if the
+   * file holds another type or version of kernels, or if it is corrupt; in
+   * the latter case, the kernels read before the error are kept.
+   */
+  void load(const std::string& filename) {
+    ForcedMutexLocker lock(_mutex);
+    std::ifstream in(filename.c_str(), std::ios::binary);
+    if (!in) throw EssentiaException("KernelCache: could not open file for reading: ", filename);
+
+    char magic[sizeof(MAGIC)];
+    in.read(magic, sizeof(magic));
+    if (!in || std::string(magic, sizeof(magic)) != std::string(MAGIC, sizeof(MAGIC))) {
+      throw EssentiaException("KernelCache: not a kernel cache file: ", filename);
+    }
+
+    std::string tag;
+    int version = 0;
+    readBinary(in, tag);
+    in.read((char*)&version, sizeof(version));
+    if (!in || tag != Kernel::cacheTag() || version != Kernel::cacheVersion()) {
+      std::ostringstream msg;
+      msg << "KernelCache: " << filename << " holds " << tag << " kernels of version " << version
+          << ", expected " << Kernel::cacheTag() << " kernels of version " << Kernel::cacheVersion();
+      throw EssentiaException(msg);
+    }
+
+    // each kernel takes at least the size of its key
+    size_t count = readSize(in, sizeof(size_t));
+    for (size_t i=0; i<count; ++i) {
+      std::string key;
+      std::shared_ptr<Kernel> kernel(new Kernel());
+      readBinary(in, key);
+      kernel->read(in);
+      if (!in) throw EssentiaException("KernelCache: unexpected end of file: ", filename);
+      insertLocked(key, kernel);
+    }
+  }
+
+ protected:
+  KernelCache() : _maxSize(64), _hits(0), _misses(0) {}
+
+  void insertLocked(const std::string& key, const KernelPtr& kernel) {
+    if (_kernels.find(key) == _kernels.end()) {
+      _order.push_back(key);
+    }
+    _kernels[key] = kernel;
+    while (_kernels.size() > _maxSize) evictOldest();
+  }
+
+  void evictOldest() {
+    _kernels.erase(_order.front());
+    _order.pop_front();
+  }
+
+  static const char MAGIC[8];
+
+  ForcedMutex _mutex;
+  std::map<std::string, KernelPtr> _kernels;
+  std::deque<std::string> _order; // insertion order
+  size_t _maxSize;
+  size_t _hits;
+  size_t _misses;
+
+ private:
+  KernelCache(const KernelCache&);
+  KernelCache& operator=(const KernelCache&);
+};
+
+template <typename Kernel>
+const char KernelCache<Kernel>::MAGIC[8] = { 'E', 'S', 'S', 'K', 'E', 'R', 'N', '2' };
+
+} // namespace util
+} // namespace essentia
+
+#endif // ESSENTIA_KERNELCACHE_H
@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "lowlevelsegments.h"
+#include "../algorithmfactory.h"
+#include <cmath>
+#include <algorithm>
+
+#ifdef CPP_11
+#  include <system_error>
+#endif
+
+using namespace std;
+
+namespace essentia {
+namespace util {
+
+// audio analyzed before the first frame owned by a segment, so that the
+// equal-loudness filter has settled [s]
+static const Real SEGMENT_WARMUP = 1.0;
+
+
+// first sample of a slice starting at the given time, computed as the loaders
+// (and the Trimmer) do
+static long long sliceStart(Real time, Real sampleRate) {
+  return (long long)(time * sampleRate);
+}
+
+// smallest start time for which the loaders start at the given sample, or a
+// negative value if there is none, as times are given in single precision
+static Real sliceStartTime(long long index, Real sampleRate) {
+  Real time = Real(index / (double)sampleRate);
+  while (time > 0 && sliceStart(time, sampleRate) >= index) {
+    time = nextafterf(time, 0);
+  }
+  while (sliceStart(time, sampleRate) < index) {
+    time = nextafterf(time, HUGE_VALF);
+  }
+  return sliceStart(time, sampleRate) == index ? time : -1;
+}
+
+
+void LowlevelSegments::create(const Pool& options, Real analysisLength, const string& filename,
+                              Real replayGain, const string& downmix, NetworkBuilder createNetwork) {
+  clear();
+
+  Real duration = options.value<Real>("segmentDuration");
+  if (duration <= 0) return;
+
+  if (options.value<string>("lowlevel.silentFrames") == "drop") {
+    E_WARNING("LowlevelSegments: segmentDuration is ignored when lowlevel silent frames are dropped");
+    return;
+  }
+
+  Real sampleRate = options.value<Real>("analysisSampleRate");
+  Real startTime = options.value<Real>("startTime");
+  Real endTime = options.value<Real>("endTime");
+  int frameSize = int(options.value<Real>("lowlevel.frameSize"));
+  int hopSize = int(options.value<Real>("lowlevel.hopSize"));
+
+  long long segmentFrames = max(1LL, (long long)(duration * sampleRate / hopSize));
+  long long warmupFrames = (frameSize + (long long)(SEGMENT_WARMUP * sampleRate)) / hopSize + 1;
+  long long totalFrames = (long long)(analysisLength * sampleRate) / hopSize + 1;
+  long long nSegments = (totalFrames + segmentFrames - 1) / segmentFrames;
+  if (nSegments < 2) return;
+
+  // the frames of the whole audio are centered on multiples of the hop size
+  // from its first sample
+  long long firstSample = sliceStart(startTime, sampleRate);
+  Pool segmentOptions = options;
+
+  _segments.resize(nSegments);
+  for (int i=0; i<(int)_segments.size(); ++i) _segments[i].network = 0;
+
+  for (int i=0; i<(int)_segments.size(); ++i) {
+    Segment& segment = _segments[i];
+
+    long long firstFrame = i * segmentFrames;
+    long long nFrames = (i == nSegments-1) ? -1 : segmentFrames;
+
+    // start on a frame whose first sample can be given as a start time,
+    // taking more warm-up frames if needed (the first frame always can)
+    long long skipFrames = min(warmupFrames, firstFrame);
+    Real segmentStart = startTime;
+    while (skipFrames < firstFrame) {
+      segmentStart = sliceStartTime(firstSample + (firstFrame - skipFrames) * hopSize, sampleRate);
+      if (segmentStart >= 0) break;
+      ++skipFrames;
+    }
+    if (skipFrames == firstFrame) segmentStart = startTime;
+
+    Real segmentEnd = endTime;
+    if (nFrames >= 0) {
+      segmentEnd = min(endTime, Real((firstSample + (firstFrame + nFrames) * hopSize + frameSize) / (double)sampleRate));
+    }
+
+    segment.skipFrames = skipFrames;
+    segment.nFrames = nFrames;
+
+    streaming::Algorithm* loader = streaming::AlgorithmFactory::create("FastMonoLoader",
+                                          "filename",   filename,
+                                          "sampleRate", sampleRate,
+                                          "startTime",  segmentStart,
+                                          "endTime",    segmentEnd,
+                                          "replayGain", replayGain,
+                                          "downmix",    downmix,
+                                          "seek",       true);
+    segment.network = new scheduler::Network(loader);
+    createNetwork(loader->output("audio"), segmentOptions, segment.frames);
+  }
+
+  _nextSegment = 0;
+}
+
+
+void LowlevelSegments::computeSegments() {
+  for (int i; (i = _nextSegment++) < (int)_segments.size(); ) {
+#ifdef CPP_11
+    try {
+      _segments[i].network->run();
+    }
+    catch (...) {
+      _segments[i].error = current_exception();
+    }
+#else
+    _segments[i].network->run();
+#endif
+  }
+}
+
+
+void LowlevelSegments::start() {
+#ifdef CPP_11
+  int nWorkers = min((int)_segments.size(), max(1, (int)thread::hardware_concurrency()));
+  for (int i=0; i<nWorkers; ++i) {
+    try {
+      _workers.push_back(thread(&LowlevelSegments::computeSegments, this));
+    }
+    catch (system_error&) {
+      // threads not available on this platform, the segments will be
+      // computed in the calling thread
+      break;
+    }
+  }
+#endif
+}
+
+
+template <typename Map>
+static vector<string> descriptorNames(const Map& descriptors) {
+  vector<string> result;
+  for (typename Map::const_iterator it = descriptors.begin(); it != descriptors.end(); ++it) {
+    result.push_back(it->first);
+  }
+  return result;
+}
+
+// the frames are taken out of the segment pool one descriptor at a time, the
+// pool is discarded afterwards
+template <typename T>
+static void appendOwnFrames(Pool& results, Pool& frames, const vector<string>& names,
+                            long long skipFrames, long long nFrames) {
+  for (int i=0; i<(int)names.size(); ++i) {
+    vector<T> values;
+    frames.take(names[i], values);
+    long long size = values.size();
+    long long begin = min(skipFrames, size);
+    long long end = nFrames < 0 ? size : min(begin + nFrames, size);
+    if (end > begin) {
+      values.erase(values.begin() + end, values.end());
+      values.erase(values.begin(), values.begin() + begin);
+#ifdef CPP_11
+      results.append(names[i], std::move(values));
+#else
+      results.append(names[i], values);
+#endif
+    }
+  }
+}
+
+
+void LowlevelSegments::mergeSegment(Pool& results, Segment& segment) {
+#ifdef CPP_11
+  if (segment.error) rethrow_exception(segment.error);
+#endif
+  Pool& frames = segment.frames;
+  long long skip = segment.skipFrames;
+  long long n = segment.nFrames;
+  appendOwnFrames<Real>(results, frames, descriptorNames(frames.getRealPool()), skip, n);
+  appendOwnFrames<vector<Real> >(results, frames, descriptorNames(frames.getVectorRealMatrixPool()), skip, n);
+  appendOwnFrames<vector<Real> >(results, frames, descriptorNames(frames.getVectorRealRowsPool()), skip, n);
+  appendOwnFrames<string>(results, frames, descriptorNames(frames.getStringPool()), skip, n);
+  appendOwnFrames<vector<string> >(results, frames, descriptorNames(frames.getVectorStringPool()), skip, n);
+
+  // values set once for the whole segment, or of a type which cannot be
+  // stored as frames, cannot be merged
+  vector<string> remaining = frames.descriptorNames();
+  if (!remaining.empty()) {
+    throw EssentiaException("LowlevelSegments: cannot merge the values of '", remaining[0],
+                            "' computed on segments of the audio, it is not a frame-level descriptor");
+  }
+}
+
+
+void LowlevelSegments::merge(Pool& results) {
+  computeSegments();
+#ifdef CPP_11
+  for (int i=0; i<(int)_workers.size(); ++i) _workers[i].join();
+  _workers.clear();
+#endif
+
+  for (int i=0; i<(int)_segments.size(); ++i) {
+    mergeSegment(results, _segments[i]);
+  }
+  clear();
+}
+
+
+void LowlevelSegments::clear() {
+  _nextSegment = (int)_segments.size();
+#ifdef CPP_11
+  for (int i=0; i<(int)_workers.size(); ++i) _workers[i].join();
+  _workers.clear();
+#endif
+
+  for (int i=0; i<(int)_segments.size(); ++i) {
+    delete _segments[i].network;
+  }
+  _segments.clear();
+}
+
+} // namespace util
+} // namespace essentia
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_LOWLEVELSEGMENTS_H
+#define ESSENTIA_LOWLEVELSEGMENTS_H
+
+#include <string>
+#include <vector>
+#include "../pool.h"
+#include "../scheduler/network.h"
+
+#ifdef CPP_11
+#  include <thread>
+#  include <atomic>
+#  include <exception>
+#endif
+
+namespace essentia {
+namespace util {
+
+/**
+ * Computes the frame-level low-level descriptors of an extractor on segments
+ * of the audio, each one in its own network running in a worker thread, while
+ * the extractor computes the other descriptors on the whole audio (see the
+ * segmentDuration parameter of MusicExtractor and FreesoundExtractor).
+ *
+ * A segment is loaded with FastMonoLoader, seeking in the file, from some
+ * frames before the first frame it owns, so that the filters and the
+ * descriptors which depend on the previous frames have (almost) settled.
+ * These frames are dropped when merging the segments. The segments start on
+ * a multiple of the hop size from the start of the analysis, so that they
+ * have exactly the same frames as the whole audio.
+ *
+ * All the networks are created in the calling thread, as creating algorithms
+ * and opening codecs is not thread-safe, and only run in the worker threads.
+ */
+class LowlevelSegments {
+
+ public:
+  /**
+   * Creates the network computing the frame-level descriptors from the
+   * audio given by @e source, and storing them into @e pool.
+   */
+  typedef void (*NetworkBuilder)(streaming::SourceBase& source, Pool& options, Pool& pool);
+
+  LowlevelSegments() : _nextSegment(0) {}
+  ~LowlevelSegments() { clear(); }
+
+  /**
+   * Splits the analyzed audio in segments and creates their networks. The
+   * options are the ones of the extractor, "segmentDuration" being the
+   * duration of the segments in seconds, 0 to disable them. No segment is
+   * created if the audio is not longer than one segment, or if the silent
+   * low-level frames are dropped (the frames could not be matched across
+   * segments).
+   */
+  void create(const Pool& options, Real analysisLength, const std::string& filename,
+              Real replayGain, const std::string& downmix, NetworkBuilder createNetwork);
+
+  bool empty() const { return _segments.empty(); }
+
+  /**
+   * Starts computing the segments in worker threads (in the calling thread,
+   * when calling merge(), if threads are not available).
+   */
+  void start();
+
+  /**
+   * Computes the segments which have not been started yet, waits for all of
+   * them and appends their frames to @e results, in order. Throws the first
+   * exception thrown by a segment, or an EssentiaException if a segment
+   * computed a descriptor which is not a frame-level descriptor of type Real,
+   * vector<Real>, string or vector<string>.
+   */
+  void merge(Pool& results);
+
+  /**
+   * Abandons the segments which have not been started yet, waits for the
+   * running ones and deletes all the networks.
+   */
+  void clear();
+
+ protected:
+  struct Segment {
+    long long skipFrames;
+    long long nFrames;  // -1 for the last segment, which owns all its remaining frames
+    Pool frames;
+    scheduler::Network* network;
+#ifdef CPP_11
+    std::exception_ptr error;
+#endif
+  };
+
+  std::vector<Segment> _segments;
+
+#ifdef CPP_11
+  std::atomic<int> _nextSegment;
+  std::vector<std::thread> _workers;
+#else
+  int _nextSegment;
+#endif
+
+  void computeSegments();
+  void mergeSegment(Pool& results, Segment& segment);
+};
+
+} // namespace util
+} // namespace essentia
+
+#endif // ESSENTIA_LOWLEVELSEGMENTS_H
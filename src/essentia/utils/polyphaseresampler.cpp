@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "polyphaseresampler.h"
+#include <cmath>
+#include <climits>
+#include <sstream>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace essentia {
+namespace util {
+
+// number of zero crossings of the sinc on each side of the filter
+static const int ZERO_CROSSINGS = 32;
+
+// cutoff frequency of the filter, relative to the lowest Nyquist frequency
+static const double ROLLOFF = 0.95;
+
+// shape of the Kaiser window (about 80dB of stopband attenuation)
+static const double KAISER_BETA = 8.0;
+
+// zeroth order modified Bessel function of the first kind
+static double besselI0(double x) {
+  double sum = 1.0, term = 1.0;
+  for (int k=1; k<50; ++k) {
+    term *= (x / (2*k)) * (x / (2*k));
+    sum += term;
+    if (term < sum * 1e-16) break;
+  }
+  return sum;
+}
+
+static long long gcd(long long a, long long b) {
+  while (b) {
+    long long t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+
+PolyphaseResampler::PolyphaseResampler() : _L(1), _M(1) {
+  configure(1, 1);
+}
+
+void PolyphaseResampler::configure(Real inputSampleRate, Real outputSampleRate) {
+  if (inputSampleRate <= 0 || outputSampleRate <= 0 ||
+      inputSampleRate != floor(inputSampleRate) || outputSampleRate != floor(outputSampleRate)) {
+    throw EssentiaException("PolyphaseResampler: the sampling rates must be positive integers");
+  }
+
+  long long in = (long long)inputSampleRate;
+  long long out = (long long)outputSampleRate;
+  long long g = gcd(in, out);
+
+  if (out / g > MAX_PHASES) {
+    ostringstream msg;
+    msg << "PolyphaseResampler: cannot resample from " << in << "Hz to " << out
+        << "Hz, the ratio of the sampling rates needs more than " << MAX_PHASES << " phases";
+    throw EssentiaException(msg);
+  }
+
+  _L = (int)(out / g);
+  _M = (int)(in / g);
+
+  ostringstream key;
+  key << "PolyphaseResampler;L=" << _L << ";M=" << _M;
+
+  _filter = filterCache().get(key.str());
+  if (!_filter) {
+    std::shared_ptr<Filter> filter(new Filter());
+    computeFilter(*filter);
+    _filter = filter;
+    filterCache().insert(key.str(), _filter);
+  }
+
+  _edge.resize(_filter->taps);
+  reset();
+}
+
+void PolyphaseResampler::computeFilter(Filter& filter) {
+  // cutoff, relative to the input Nyquist frequency
+  double fc = ROLLOFF * min(1.0, (double)_L / _M);
+
+  // half-width of the filter, in input samples
+  int halfWidth = (int)ceil(ZERO_CROSSINGS / fc);
+
+  filter.history = halfWidth - 1;
+  filter.taps = (2*halfWidth + 3) & ~3;
+  filter.coefs.assign(_L * filter.taps, 0.0);
+
+  double i0Beta = besselI0(KAISER_BETA);
+
+  for (int p=0; p<_L; ++p) {
+    double frac = (double)p / _L;
+    Real* coefs = &filter.coefs[p*filter.taps];
+
+    for (int m=0; m<filter.taps; ++m) {
+      // distance between the output sample and input sample m
+      double t = frac + filter.history - m;
+      if (fabs(t) >= halfWidth) continue;
+
+      double x = M_PI * fc * t;
+      double sinc = (x == 0) ? 1.0 : sin(x) / x;
+      double r = t / halfWidth;
+      double window = besselI0(KAISER_BETA * sqrt(1 - r*r)) / i0Beta;
+
+      coefs[m] = (Real)(fc * sinc * window);
+    }
+  }
+}
+
+void PolyphaseResampler::reset() {
+  _buffer.assign(_filter->history, 0.0);
+  _bufferStart = -_filter->history;
+  _inputSize = 0;
+  _outputIndex = 0;
+  _phase = 0;
+  _inputIndex = 0;
+}
+
+int PolyphaseResampler::outputSize(int size) const {
+  return (int)(((long long)size*_L + _M - 1) / _M);
+}
+
+int PolyphaseResampler::maxOutputSize(int size) const {
+  return outputSize(size) + 1;
+}
+
+int PolyphaseResampler::maxFlushSize() const {
+  return outputSize(_filter->taps) + 1;
+}
+
+inline Real PolyphaseResampler::dot(const Real* input, int phase) const {
+  const Real* coefs = &_filter->coefs[phase*_filter->taps];
+  const int taps = _filter->taps;
+
+#ifdef __SSE2__
+  __m128 acc = _mm_setzero_ps();
+  for (int i=0; i<taps; i+=4) {
+    acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(input + i), _mm_loadu_ps(coefs + i)));
+  }
+  float sums[4];
+  _mm_storeu_ps(sums, acc);
+  return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+#else
+  Real sum = 0;
+  for (int i=0; i<taps; ++i) {
+    sum += input[i] * coefs[i];
+  }
+  return sum;
+#endif
+}
+
+int PolyphaseResampler::resample(const Real* input, int size, Real* output) {
+  const int taps = _filter->taps;
+  const int history = _filter->history;
+  int n = outputSize(size);
+
+  long long inputIndex = 0;
+  int phase = 0;
+
+  for (int k=0; k<n; ++k) {
+    long long start = inputIndex - history;
+
+    if (start >= 0 && start + taps <= size) {
+      output[k] = dot(input + start, phase);
+    }
+    else {
+      // the filter goes past the edges of the signal, which is zero there
+      for (int i=0; i<taps; ++i) {
+        long long j = start + i;
+        _edge[i] = (j >= 0 && j < size) ? input[j] : 0.0;
+      }
+      output[k] = dot(&_edge[0], phase);
+    }
+
+    phase += _M;
+    inputIndex += phase / _L;
+    phase %= _L;
+  }
+
+  return n;
+}
+
+int PolyphaseResampler::produce(Real* output, long long maxOutputIndex) {
+  const int taps = _filter->taps;
+  const int history = _filter->history;
+  const long long bufferEnd = _bufferStart + (long long)_buffer.size();
+
+  int n = 0;
+  while (_outputIndex < maxOutputIndex && _inputIndex - history + taps <= bufferEnd) {
+    output[n++] = dot(&_buffer[_inputIndex - history - _bufferStart], _phase);
+
+    _outputIndex++;
+    _phase += _M;
+    _inputIndex += _phase / _L;
+    _phase %= _L;
+  }
+
+  return n;
+}
+
+int PolyphaseResampler::process(const Real* input, int size, Real* output) {
+  // drop the samples that are before the filter of the next output sample
+  long long first = min(_inputIndex - _filter->history, _bufferStart + (long long)_buffer.size());
+  if (first > _bufferStart) {
+    _buffer.erase(_buffer.begin(), _buffer.begin() + (first - _bufferStart));
+    _bufferStart = first;
+  }
+
+  _buffer.insert(_buffer.end(), input, input + size);
+  _inputSize += size;
+
+  return produce(output, LLONG_MAX);
+}
+
+int PolyphaseResampler::flush(Real* output) {
+  // the signal is zero after its end
+  _buffer.insert(_buffer.end(), _filter->taps, 0.0);
+
+  long long nOutputs = (_inputSize*_L + _M - 1) / _M;
+  return produce(output, nOutputs);
+}
+
+
+void PolyphaseResampler::Filter::write(ostream& out) const {
+  out.write((const char*)&taps, sizeof(taps));
+  out.write((const char*)&history, sizeof(history));
+  writeBinary(out, coefs);
+}
+
+void PolyphaseResampler::Filter::read(istream& in) {
+  in.read((char*)&taps, sizeof(taps));
+  in.read((char*)&history, sizeof(history));
+  readBinary(in, coefs);
+  if (taps <= 0 || taps % 4 || history < 0 || history >= taps || coefs.size() % taps) {
+    throw EssentiaException("PolyphaseResampler: corrupt filter in the kernel cache");
+  }
+}
+
+} // namespace util
+} // namespace essentia
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_POLYPHASERESAMPLER_H
+#define ESSENTIA_POLYPHASERESAMPLER_H
+
+#include <vector>
+#include <iostream>
+#include "../types.h"
+#include "kernelcache.h"
+
+namespace essentia {
+namespace util {
+
+/**
+ * Polyphase FIR resampler, for conversions between integer sampling rates.
+ *
+ * The ratio outputSampleRate / inputSampleRate is reduced to L/M, and each
+ * output sample is computed as the dot product of the input around it with
+ * one of the L phases of a Kaiser-windowed sinc lowpass filter, cut below the
+ * lowest of the input and output Nyquist frequencies. The filter tables only
+ * depend on L and M, and are shared by all the instances of the process (see
+ * filterCache()).
+ *
+ * The output is not delayed: output sample k is the value of the input signal
+ * at time k*M/L (in input samples), the signal being zero outside of the
+ * input. A signal of n samples gives ceil(n*L/M) samples.
+ *
+ * It can be used either in one shot with resample(), or on a stream with
+ * process() and flush(). In both cases, no memory is allocated once the
+ * resampler has been configured (and the stream buffer has grown to the size
+ * of the largest block).
+ */
+class PolyphaseResampler {
+
+ public:
+  /**
+   * Maximum number of phases of the filter, i.e. maximum value of L.
+   */
+  static const int MAX_PHASES = 1024;
+
+  PolyphaseResampler();
+
+  /**
+   * Throws an EssentiaException if the sampling rates are not integers, or if
+   * their ratio needs more than MAX_PHASES phases.
+   */
+  void configure(Real inputSampleRate, Real outputSampleRate);
+
+  /**
+   * Forgets the samples seen by process(), to start a new stream.
+   */
+  void reset();
+
+  /**
+   * Resamples the whole signal input[0..size) into output, which must have
+   * room for outputSize(size) samples. Returns the number of samples written.
+   * This does not use nor modify the state of the stream.
+   */
+  int resample(const Real* input, int size, Real* output);
+
+  /**
+   * Appends input[0..size) to the stream, and writes the output samples that
+   * can be computed with it. output must have room for maxOutputSize(size)
+   * samples. Returns the number of samples written.
+   */
+  int process(const Real* input, int size, Real* output);
+
+  /**
+   * Writes the output samples remaining at the end of the stream. output must
+   * have room for maxFlushSize() samples. Returns the number of samples
+   * written. The resampler has to be reset before processing a new stream.
+   */
+  int flush(Real* output);
+
+  /**
+   * Number of samples of a resampled signal of size samples.
+   */
+  int outputSize(int size) const;
+
+  int maxOutputSize(int size) const;
+  int maxFlushSize() const;
+
+  int interpolationFactor() const { return _L; }
+  int decimationFactor() const { return _M; }
+
+  /**
+   * The L phases of the filter, each one having the same number of taps
+   * (a multiple of 4).
+   */
+  struct Filter {
+    int taps;
+    int history; // number of input samples before the current one
+    std::vector<Real> coefs; // phase-major, L*taps coefficients
+
+    static const char* cacheTag() { return "PolyphaseResampler"; }
+    static int cacheVersion() { return 1; }
+    void write(std::ostream& out) const;
+    void read(std::istream& in);
+  };
+
+  static KernelCache<Filter>& filterCache() {
+    return KernelCache<Filter>::instance();
+  }
+
+ protected:
+  int _L;
+  int _M;
+  KernelCache<Filter>::KernelPtr _filter;
+
+  // stream state: _buffer holds the input samples from index _bufferStart
+  // (in the stream), which can be before 0 for the zeros preceding it
+  std::vector<Real> _buffer;
+  long long _bufferStart;
+  long long _inputSize;
+  long long _outputIndex;
+  int _phase; // (_outputIndex*_M) % _L
+  long long _inputIndex; // (_outputIndex*_M) / _L
+
+  // zero-padded input at the edges of the signal in resample()
+  std::vector<Real> _edge;
+
+  void computeFilter(Filter& filter);
+  int produce(Real* output, long long maxOutputIndex);
+
+  inline Real dot(const Real* input, int phase) const;
+};
+
+} // namespace util
+} // namespace essentia
+
+#endif // ESSENTIA_POLYPHASERESAMPLER_H
@@ -20,11 +20,20 @@
 #ifndef ESSENTIA_STREAMING_RINGBUFFERIMPL_H
 #define ESSENTIA_STREAMING_RINGBUFFERIMPL_H
 
+#include <cstring>
 #include "atomic.h"
 
 #ifdef OS_WIN32
-
 #include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+
+namespace essentia {
+namespace streaming {
+
+#ifdef OS_WIN32
 
 class Condition {
  protected:
@@ -44,6 +53,12 @@ class Condition {
     waitersCount = 0;
   }
 
+  ~Condition() {
+    CloseHandle(event);
+    DeleteCriticalSection(&waitersCountLock);
+    DeleteCriticalSection(&conditionLock);
+  }
+
   void lock()   { EnterCriticalSection(&conditionLock); }
   void unlock() { LeaveCriticalSection(&conditionLock); }
 
@@ -54,7 +69,7 @@ class Condition {
 
     LeaveCriticalSection(&conditionLock);
 
-    int result = WaitForSingleObject(event, INFINITE);
+    WaitForSingleObject(event, INFINITE);
 
     EnterCriticalSection(&waitersCountLock);
     waitersCount--;
@@ -74,11 +89,8 @@ class Condition {
   }
 };
 
-
 #else // OS_WIN32
 
-#include <pthread.h>
-
 class Condition {
  protected:
   pthread_mutex_t pthreadMutex;
@@ -90,33 +102,45 @@ class Condition {
     pthread_cond_init(&pthreadCondition,0);
   }
 
+  ~Condition() {
+    pthread_cond_destroy(&pthreadCondition);
+    pthread_mutex_destroy(&pthreadMutex);
+  }
+
   void lock()   { pthread_mutex_lock(&pthreadMutex); }
   void unlock() { pthread_mutex_unlock(&pthreadMutex); }
   void wait()   { pthread_cond_wait(&pthreadCondition, &pthreadMutex); }
   void signal() { pthread_cond_signal(&pthreadCondition); }
-
 };
 
-
 #endif // OS_WIN32
 
 
-namespace essentia {
-namespace streaming {
-
+/**
+ * Single-producer, single-consumer ring buffer of Real values, used to pass
+ * audio between a host thread and a streaming network.
+ *
+ * add() and get() never block, never allocate memory and never take a lock
+ * as long as the other side is not waiting: each side only ever writes its
+ * own index, and the amount of data available and of free space are atomic
+ * counters. This makes it safe to call them from a real-time thread. Only
+ * waitAvailable() and waitSpace() sleep, on a condition which add() and get()
+ * signal when (and only when) a waiter is asleep on it.
+ */
 class RingBufferImpl {
  public:
   int _bufferSize;
 
-  int _writeIndex;
-  int _readIndex;
+  int _writeIndex; // only modified by the producer
+  int _readIndex;  // only modified by the consumer
 
   Atomic _available;
   Atomic _space;
 
   Real* _buffer;
 
-  Condition condition;
+  Condition _condition;
+  Atomic _sleeping; // whether the waiting side is (about to be) asleep on _condition
 
   // whether to wait for space (to add data to the buffer)
   // or for availability of data (when reading data from the buffer)
@@ -131,6 +155,7 @@ class RingBufferImpl {
   , _readIndex(0)
   , _available(0)
   , _space(_bufferSize)
+  , _sleeping(0)
   , _waitingCondition(c)
   {
     _buffer = new Real[_bufferSize];
@@ -141,13 +166,12 @@ class RingBufferImpl {
     delete [] _buffer;
   }
 
+  // should only be called when neither side is using the buffer
   void reset() {
     _writeIndex = 0;
     _readIndex = 0;
     _available = 0;
     _space = _bufferSize;
-    delete[] _buffer;
-    _buffer = new Real[_bufferSize];
   }
 
   void waitAvailable(void)
@@ -156,14 +180,7 @@ class RingBufferImpl {
     // has been set accordingly
     assert(_waitingCondition == kAvailable);
 
-    condition.lock();
-
-    while (_available == 0)
-    {
-      condition.wait();
-    }
-
-    condition.unlock();
+    wait(_available);
   }
 
   void waitSpace(void)
@@ -172,14 +189,7 @@ class RingBufferImpl {
     // has been set accordingly
     assert(_waitingCondition == kSpace);
 
-    condition.lock();
-
-    while (_space == 0)
-    {
-      condition.wait();
-    }
-
-    condition.unlock();
+    wait(_space);
   }
 
   int add(const Real* inputData, int inputSize)
@@ -197,18 +207,14 @@ class RingBufferImpl {
       memcpy( &_buffer[_writeIndex], inputData, size * sizeof(AudioSample));
       _writeIndex += size;
     }
+
+    // the data has to be written before it is made available to the consumer
     _space -=  size;
     _available += size;
 
-    condition.lock();
-    if (_waitingCondition == kAvailable)
-    {
-      // the thread that is using this ringbuffer will be waiting for
-      // data to become available - typically the essentia-part from
-      // a RingBufferInput. we signal the waiting condition here
-      condition.signal();
-    }
-    condition.unlock();
+    // the thread that is using this ringbuffer may be waiting for data to
+    // become available - typically the essentia-part from a RingBufferInput
+    if (_waitingCondition == kAvailable) wakeUp();
 
     return size;
   }
@@ -229,22 +235,43 @@ class RingBufferImpl {
       memcpy( outputData, &_buffer[_readIndex], size * sizeof(AudioSample));
       _readIndex += size;
     }
+
+    // the data has to be read before its space is given back to the producer
     _available -= size;
     _space += size;
 
-    condition.lock();
-    if (_waitingCondition == kSpace)
-    {
-      // the thread that is using this ringbuffer will be waiting for
-      // space in the buffer - typically the essentia-part from
-      // a RingBufferOutput. we signal the waiting condition here
-      condition.signal();
-    }
-    condition.unlock();
+    // the thread that is using this ringbuffer may be waiting for space in
+    // the buffer - typically the essentia-part from a RingBufferOutput
+    if (_waitingCondition == kSpace) wakeUp();
 
     return size;
   }
 
+ protected:
+  // sleeps until the counter is not zero. The waiting side announces that it
+  // sleeps before checking the counter for the last time, and the other side
+  // updates the counter before checking whether it has to signal, so that
+  // the signal cannot be missed (the counters are sequentially consistent).
+  void wait(Atomic& counter) {
+    if (counter != 0) return;
+
+    _condition.lock();
+    _sleeping = 1;
+    while (counter == 0) {
+      _condition.wait();
+    }
+    _sleeping = 0;
+    _condition.unlock();
+  }
+
+  // only takes the lock of the condition when the other side sleeps
+  void wakeUp() {
+    if (_sleeping == 0) return;
+
+    _condition.lock();
+    _condition.signal();
+    _condition.unlock();
+  }
 };
 
 } // namespace streaming
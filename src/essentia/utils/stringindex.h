@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_STRINGINDEX_H
+#define ESSENTIA_STRINGINDEX_H
+
+#include <string>
+#include <vector>
+#include "../types.h"
+
+namespace essentia {
+namespace util {
+
+/**
+ * Interns strings: each string inserted gets an integer id, which are given
+ * in order starting from 0 and never change. The ids of the strings are
+ * looked up with an open-addressing hash table (linear probing), so that
+ * looking up a string costs a single hash of it and usually a single string
+ * comparison.
+ */
+class StringIndex {
+
+ public:
+  StringIndex() : _slots(16, -1) {}
+
+  /**
+   * Returns the id of the given string, or -1 if it has not been inserted.
+   */
+  int find(const std::string& str) const {
+    size_t mask = _slots.size() - 1;
+    for (size_t i = hash(str) & mask; ; i = (i+1) & mask) {
+      int id = _slots[i];
+      if (id < 0) return -1;
+      if (_strings[id] == str) return id;
+    }
+  }
+
+  /**
+   * Returns the id of the given string, inserting it if necessary.
+   */
+  int insert(const std::string& str) {
+    int id = find(str);
+    if (id >= 0) return id;
+
+    // keep the load factor below 1/2 so that probe sequences stay short
+    if (2*(_strings.size()+1) > _slots.size()) grow();
+
+    id = _strings.size();
+    _strings.push_back(str);
+    place(id);
+    return id;
+  }
+
+  const std::string& str(int id) const {
+    if (id < 0 || id >= (int)_strings.size()) {
+      throw EssentiaException("StringIndex: invalid id: ", id);
+    }
+    return _strings[id];
+  }
+
+  int size() const { return _strings.size(); }
+
+  void clear() {
+    _strings.clear();
+    _slots.assign(16, -1);
+  }
+
+ protected:
+  std::vector<std::string> _strings; // indexed by id
+  std::vector<int> _slots;           // ids, or -1 for empty slots. The size is a power of 2
+
+  // FNV-1a
+  static size_t hash(const std::string& str) {
+    size_t h = 2166136261u;
+    for (size_t i=0; i<str.size(); ++i) {
+      h = (h ^ (unsigned char)str[i]) * 16777619u;
+    }
+    return h;
+  }
+
+  void place(int id) {
+    size_t mask = _slots.size() - 1;
+    size_t i = hash(_strings[id]) & mask;
+    while (_slots[i] >= 0) i = (i+1) & mask;
+    _slots[i] = id;
+  }
+
+  void grow() {
+    _slots.assign(2*_slots.size(), -1);
+    for (int id=0; id<(int)_strings.size(); ++id) place(id);
+  }
+};
+
+} // namespace util
+} // namespace essentia
+
+#endif // ESSENTIA_STRINGINDEX_H
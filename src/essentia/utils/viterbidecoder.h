@@ -0,0 +1,392 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_VITERBIDECODER_H
+#define ESSENTIA_VITERBIDECODER_H
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include "../types.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace essentia {
+namespace util {
+
+// keeps the largest value, and on ties the one with the lowest rank
+template <typename T>
+inline void keepBest(T v, int rank, T& best, int& bestRank) {
+  if (v > best || (v == best && rank < bestRank)) {
+    best = v;
+    bestRank = rank;
+  }
+}
+
+/**
+ * Updates best with max_i(a[i]*b[i]) and bestRank with the rank of the
+ * product reaching it. Among equal products, the one with the lowest rank
+ * wins. This is the inner max-times (max-plus in the log domain) kernel of
+ * the Viterbi recursion, evaluated on a band of contiguous predecessor
+ * states, with rank giving the order in which the transitions were defined.
+ */
+inline void maxProduct(const float* a, const float* b, const int* rank, size_t n,
+                       float& best, int& bestRank) {
+  size_t i = 0;
+#ifdef __SSE2__
+  if (n >= 4) {
+    __m128 vbest = _mm_set1_ps(best);
+    __m128i vrank = _mm_set1_epi32(bestRank);
+    for (; i+4 <= n; i+=4) {
+      __m128 v = _mm_mul_ps(_mm_loadu_ps(a+i), _mm_loadu_ps(b+i));
+      __m128i r = _mm_loadu_si128((const __m128i*)(rank+i));
+      __m128 take = _mm_or_ps(_mm_cmpgt_ps(v, vbest),
+                              _mm_and_ps(_mm_cmpeq_ps(v, vbest),
+                                         _mm_castsi128_ps(_mm_cmplt_epi32(r, vrank))));
+      __m128i itake = _mm_castps_si128(take);
+      vbest = _mm_or_ps(_mm_and_ps(take, v), _mm_andnot_ps(take, vbest));
+      vrank = _mm_or_si128(_mm_and_si128(itake, r), _mm_andnot_si128(itake, vrank));
+    }
+    float tmp[4];
+    int tmpRank[4];
+    _mm_storeu_ps(tmp, vbest);
+    _mm_storeu_si128((__m128i*)tmpRank, vrank);
+    for (int l=0; l<4; ++l) keepBest(tmp[l], tmpRank[l], best, bestRank);
+  }
+#endif
+  for (; i<n; ++i) keepBest(a[i] * b[i], rank[i], best, bestRank);
+}
+
+inline void maxProduct(const double* a, const double* b, const int* rank, size_t n,
+                       double& best, int& bestRank) {
+  size_t i = 0;
+#ifdef __SSE2__
+  if (n >= 2) {
+    // the ranks are compared as doubles, which represent them exactly
+    __m128d vbest = _mm_set1_pd(best);
+    __m128d vrank = _mm_set1_pd(bestRank);
+    for (; i+2 <= n; i+=2) {
+      __m128d v = _mm_mul_pd(_mm_loadu_pd(a+i), _mm_loadu_pd(b+i));
+      __m128d r = _mm_cvtepi32_pd(_mm_loadl_epi64((const __m128i*)(rank+i)));
+      __m128d take = _mm_or_pd(_mm_cmpgt_pd(v, vbest),
+                               _mm_and_pd(_mm_cmpeq_pd(v, vbest), _mm_cmplt_pd(r, vrank)));
+      vbest = _mm_or_pd(_mm_and_pd(take, v), _mm_andnot_pd(take, vbest));
+      vrank = _mm_or_pd(_mm_and_pd(take, r), _mm_andnot_pd(take, vrank));
+    }
+    double tmp[2], tmpRank[2];
+    _mm_storeu_pd(tmp, vbest);
+    _mm_storeu_pd(tmpRank, vrank);
+    for (int l=0; l<2; ++l) keepBest(tmp[l], (int)tmpRank[l], best, bestRank);
+  }
+#endif
+  for (; i<n; ++i) keepBest(a[i] * b[i], rank[i], best, bestRank);
+}
+
+
+/**
+ * Viterbi decoder for hidden Markov models with sparse transition matrices.
+ *
+ * Transitions are stored grouped by destination state, split into bands of
+ * contiguous source states on which the maximization runs vectorized. Each
+ * transition keeps its rank in the order they were given, so that ties are
+ * broken exactly as a sequential scan would. Banded models
+ * such as the pitch transitions of pYIN or the tempo transitions of
+ * TempoTapDegara thus cost O(states x bandwidth) per frame instead of
+ * O(states^2).
+ *
+ * Probabilities are kept in the scaled (normalized) domain, using T for the
+ * internal computations. Two decoding modes are offered:
+ *  - offline: decode() returns the optimal path over the whole sequence
+ *  - online (fixed-lag): after start(), each call to push() outputs the
+ *    state for the frame that is "lag" frames behind the last frame pushed;
+ *    flush() outputs the remaining ones. Memory is bounded by the lag. With a
+ *    lag greater than or equal to the number of frames, the result is the
+ *    same as the offline one.
+ */
+template <typename T>
+class ViterbiDecoder {
+
+ public:
+  ViterbiDecoder() : _nStates(0), _uniformOnZero(true), _lag(0), _frame(0), _emitted(0) {}
+
+  /**
+   * Sets the transitions given as a list of (from, to, probability) triplets.
+   */
+  void setTransitions(size_t nStates,
+                      const std::vector<size_t>& from,
+                      const std::vector<size_t>& to,
+                      const std::vector<Real>& prob) {
+    _nStates = nStates;
+    std::vector<size_t> count(nStates, 0);
+    for (size_t i=0; i<to.size(); ++i) count[to[i]]++;
+
+    _rowStart.assign(nStates+1, 0);
+    for (size_t j=0; j<nStates; ++j) _rowStart[j+1] = _rowStart[j] + count[j];
+
+    _from.resize(to.size());
+    _prob.resize(to.size());
+    std::vector<size_t> pos(_rowStart.begin(), _rowStart.end()-1);
+    for (size_t i=0; i<to.size(); ++i) {
+      size_t k = pos[to[i]]++;
+      _from[k] = from[i];
+      _prob[k] = (T) prob[i];
+    }
+    buildBands();
+  }
+
+  /**
+   * Sets the transitions given as a dense matrix where matrix[j][i] is the
+   * probability of going from state i to state j. Zero entries are skipped.
+   */
+  void setTransitions(const std::vector<std::vector<Real> >& matrix) {
+    std::vector<size_t> from, to;
+    std::vector<Real> prob;
+    for (size_t j=0; j<matrix.size(); ++j) {
+      for (size_t i=0; i<matrix[j].size(); ++i) {
+        if (matrix[j][i] != 0) {
+          from.push_back(i);
+          to.push_back(j);
+          prob.push_back(matrix[j][i]);
+        }
+      }
+    }
+    setTransitions(matrix.size(), from, to, prob);
+  }
+
+  /**
+   * If true (default), a frame in which all the state probabilities become
+   * zero is reset to a uniform distribution. Otherwise it is left untouched.
+   */
+  void setUniformOnZero(bool uniform) { _uniformOnZero = uniform; }
+
+  size_t numberStates() const { return _nStates; }
+
+  /**
+   * Returns the most likely state sequence for the given observation
+   * probabilities (one vector of at least numberStates() values per frame).
+   * Returns false if the state probabilities became zero at some frame.
+   */
+  template <typename Init, typename Obs>
+  bool decode(const std::vector<Init>& init,
+              const std::vector<std::vector<Obs> >& obs,
+              std::vector<int>& path) {
+    path.clear();
+    if (obs.empty()) return true;
+
+    size_t nFrames = obs.size();
+    _psi.resize(nFrames * _nStates);
+    bool ok = initialize(init, obs[0]);
+    std::fill(_psi.begin(), _psi.begin() + _nStates, 0);
+
+    for (size_t t=1; t<nFrames; ++t) {
+      ok &= forward(obs[t], &_psi[t*_nStates]);
+    }
+
+    path.resize(nFrames);
+    path[nFrames-1] = argmaxDelta();
+    for (size_t t=nFrames-1; t>0; --t) {
+      path[t-1] = _psi[t*_nStates + path[t]];
+    }
+    return ok;
+  }
+
+  /**
+   * Starts online decoding with the given initial state probabilities and
+   * fixed lag (in frames).
+   */
+  template <typename Init>
+  void start(const std::vector<Init>& init, size_t lag) {
+    _init.assign(init.begin(), init.end());
+    _lag = lag;
+    _frame = 0;
+    _emitted = 0;
+    _psi.assign((_lag+1) * _nStates, 0);
+  }
+
+  /**
+   * Feeds one frame of observation probabilities and appends to decided the
+   * state of the frame lag frames behind (if any). Returns false if the state
+   * probabilities became zero.
+   */
+  template <typename Obs>
+  bool push(const std::vector<Obs>& obs, std::vector<int>& decided) {
+    bool ok;
+    size_t slot = _frame % (_lag+1);
+    if (_frame == 0) {
+      ok = initialize(_init, obs);
+      std::fill(_psi.begin(), _psi.begin() + _nStates, 0);
+    }
+    else {
+      ok = forward(obs, &_psi[slot*_nStates]);
+    }
+
+    if (_frame >= _lag) {
+      int state = argmaxDelta();
+      for (size_t t=_frame; t>_frame-_lag; --t) {
+        state = _psi[(t % (_lag+1))*_nStates + state];
+      }
+      decided.push_back(state);
+      _emitted++;
+    }
+    _frame++;
+    return ok;
+  }
+
+  /**
+   * Appends to decided the states of the frames not yet output, tracking back
+   * from the most likely last state.
+   */
+  void flush(std::vector<int>& decided) {
+    if (_emitted >= _frame) return;
+    size_t remaining = _frame - _emitted;
+    std::vector<int> tail(remaining);
+    int state = argmaxDelta();
+    tail[remaining-1] = state;
+    for (size_t k=remaining-1; k>0; --k) {
+      size_t t = _emitted + k;
+      state = _psi[(t % (_lag+1))*_nStates + state];
+      tail[k-1] = state;
+    }
+    decided.insert(decided.end(), tail.begin(), tail.end());
+    _emitted = _frame;
+  }
+
+ protected:
+  size_t _nStates;
+  bool _uniformOnZero;
+
+  // transitions grouped by destination state, in their original order
+  std::vector<size_t> _rowStart;
+  std::vector<size_t> _from;
+  std::vector<T> _prob;
+
+  // the same transitions as bands of contiguous source states
+  std::vector<size_t> _bandRowStart;
+  std::vector<size_t> _bandFrom;
+  std::vector<size_t> _bandSize;
+  std::vector<size_t> _bandProbStart;
+  std::vector<T> _bandProb;
+  std::vector<int> _bandRank; // rank of each transition within its group
+
+  std::vector<T> _delta;
+  std::vector<T> _oldDelta;
+  std::vector<int> _psi;
+
+  // online decoding state
+  std::vector<Real> _init;
+  size_t _lag;
+  size_t _frame;
+  size_t _emitted;
+
+  void buildBands() {
+    _bandRowStart.assign(_nStates+1, 0);
+    _bandFrom.clear();
+    _bandSize.clear();
+    _bandProbStart.clear();
+    _bandProb.clear();
+    _bandRank.clear();
+
+    // (source state, rank) of the transitions of a group
+    std::vector<std::pair<size_t, int> > row;
+    for (size_t j=0; j<_nStates; ++j) {
+      row.clear();
+      for (size_t k=_rowStart[j]; k<_rowStart[j+1]; ++k) {
+        row.push_back(std::make_pair(_from[k], int(k - _rowStart[j])));
+      }
+      // ties are broken with the ranks, so sources can be sorted
+      std::stable_sort(row.begin(), row.end(), CompareFirst());
+
+      for (size_t k=0; k<row.size(); ++k) {
+        if (k == 0 || row[k].first != row[k-1].first + 1) {
+          _bandFrom.push_back(row[k].first);
+          _bandSize.push_back(0);
+          _bandProbStart.push_back(_bandProb.size());
+        }
+        _bandSize.back()++;
+        _bandProb.push_back(_prob[_rowStart[j] + row[k].second]);
+        _bandRank.push_back(row[k].second);
+      }
+      _bandRowStart[j+1] = _bandFrom.size();
+    }
+
+    _delta.assign(_nStates, 0);
+    _oldDelta.assign(_nStates, 0);
+  }
+
+  struct CompareFirst {
+    bool operator()(const std::pair<size_t, int>& a, const std::pair<size_t, int>& b) const {
+      return a.first < b.first;
+    }
+  };
+
+  template <typename Init, typename Obs>
+  bool initialize(const std::vector<Init>& init, const std::vector<Obs>& obs) {
+    for (size_t i=0; i<_nStates; ++i) {
+      _oldDelta[i] = (T) (init[i] * obs[i]);
+    }
+    return normalize(_oldDelta);
+  }
+
+  // computes the state probabilities of the next frame into _oldDelta,
+  // storing the best predecessor of each state in psi
+  template <typename Obs>
+  bool forward(const std::vector<Obs>& obs, int* psi) {
+    for (size_t j=0; j<_nStates; ++j) {
+      T best = 0;
+      int bestRank = std::numeric_limits<int>::max();
+      for (size_t b=_bandRowStart[j]; b<_bandRowStart[j+1]; ++b) {
+        size_t start = _bandProbStart[b];
+        maxProduct(&_oldDelta[_bandFrom[b]], &_bandProb[start], &_bandRank[start],
+                   _bandSize[b], best, bestRank);
+      }
+
+      // as with a sequential scan, only a strictly positive product sets the predecessor
+      psi[j] = best > 0 ? (int) _from[_rowStart[j] + bestRank] : 0;
+      _delta[j] = best * (T) obs[j];
+    }
+
+    _oldDelta.swap(_delta);
+    return normalize(_oldDelta);
+  }
+
+  bool normalize(std::vector<T>& delta) {
+    T sum = 0;
+    for (size_t i=0; i<_nStates; ++i) sum += delta[i];
+
+    if (sum > 0) {
+      for (size_t i=0; i<_nStates; ++i) delta[i] /= sum;
+      return true;
+    }
+    if (_uniformOnZero) {
+      std::fill(delta.begin(), delta.end(), (T) 1. / _nStates);
+    }
+    return false;
+  }
+
+  int argmaxDelta() const {
+    return int(std::max_element(_oldDelta.begin(), _oldDelta.end()) - _oldDelta.begin());
+  }
+};
+
+} // namespace util
+} // namespace essentia
+
+#endif // ESSENTIA_VITERBIDECODER_H
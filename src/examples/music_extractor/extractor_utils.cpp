@@ -23,7 +23,7 @@ void setExtractorOptions(const std::string& filename, Pool& options) {
   yaml->output("pool").set(opts);
   yaml->compute();
   delete yaml;
-  options.merge(opts, "replace");
+  options.absorb(opts, "replace");
 }
 
 
@@ -533,3 +533,11 @@ class Pool:
 
     def clear(self):
         return self.cppPool.clear()
+
+    def swap(self, pool):
+        # exchanges the contents of both pools without copying them
+        return self.cppPool.swap(pool.cppPool)
+
+    def absorb(self, pool, mergeType=''):
+        # same as merge, but moves the values of pool, which is empty afterwards
+        return self.cppPool.absorb(pool.cppPool, mergeType)
@@ -192,7 +192,7 @@ PyObject* paramToPython(const Parameter& p) {
     case Parameter::VECTOR_REAL: {
       // we have to do the vectors in a special way since they need to not be deleted (i.e. toPython
       // won't make a copy of them: toPythonRef)
-      vector<Real> v = p.toVectorReal();
+      const vector<Real>& v = p.denseValues();
       RogueVector<Real>* r = new RogueVector<Real>(v.size(), 0);
       for (int i=0; i<int(v.size()); ++i) (*r)[i] = v[i];
       return toPython(r, paramTypeToEdt(pType));
@@ -200,7 +200,7 @@ PyObject* paramToPython(const Parameter& p) {
     PARAM_CASE(VECTOR_STRING, vector<string>, VectorString);
     PARAM_CASE(VECTOR_BOOL, vector<bool>, VectorBool);
     case Parameter::VECTOR_INT: {
-      vector<int> v = p.toVectorInt();
+      const vector<int>& v = p.denseIntValues();
       RogueVector<int>* r = new RogueVector<int>(v.size(), 0);
       for (int i=0; i<int(v.size()); ++i) (*r)[i] = v[i];
       return toPython(r, paramTypeToEdt(pType));
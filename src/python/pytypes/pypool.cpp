@@ -44,6 +44,10 @@ PyMethodDef PyPool_methods[] = {
                       "Pool.removeNamespace(namespace) removes all descriptors in the pool under \"namespace\"" },
   { "clear",         (PyCFunction)PyPool::clear, METH_NOARGS,
                       "Pool.clear() clears out the pool" },
+  { "swap",          (PyCFunction)PyPool::swap, METH_O,
+                      "Pool.swap(pool) exchanges the contents of the pool with the ones of \"pool\", without copying them" },
+  { "absorb",        (PyCFunction)PyPool::absorb, METH_VARARGS,
+                      "Pool.absorb(pool, mergeType) merges \"pool\" in the pool by moving its values, \"pool\" is empty afterwards" },
   { "descriptorNames",(PyCFunction)PyPool::descriptorNames, METH_VARARGS,
                       "Pool.descriptorNames(namespace) returns a list of all descriptors in the pool under \"namespace\". If no namespace is supplied it returns a list of all descriptors" },
   { "__keyType__",    (PyCFunction)PyPool::keyType, METH_O,
@@ -135,8 +139,9 @@ PyObject* PyPool::keyType(PyPool* self, PyObject* obj) {
     return PyString_FromString( edtToString(VECTOR_STEREOSAMPLE).c_str() );
   }
 
-  // search vector<Real> sub-pool
-  if (p.getVectorRealPool().find(key) != p.getVectorRealPool().end()) {
+  // search vector<Real> sub-pools
+  if (p.getVectorRealRowsPool().find(key) != p.getVectorRealRowsPool().end() ||
+      p.getVectorRealMatrixPool().find(key) != p.getVectorRealMatrixPool().end()) {
     return PyString_FromString( edtToString(VECTOR_VECTOR_REAL).c_str() );
   }
 
@@ -514,7 +519,24 @@ PyObject* PyPool::value(PyPool* self, PyObject* pyArgs) {
       }
       case VECTOR_STRING: return VectorString::toPythonCopy(&p.value<vector<string> >(key));
       case VECTOR_STEREOSAMPLE: return VectorStereoSample::toPythonCopy(&p.value<vector<StereoSample> >(key));
-      case VECTOR_VECTOR_REAL: return VectorVectorReal::toPythonCopy(&p.value<vector<vector<Real> > >(key));
+      case VECTOR_VECTOR_REAL: {
+        // frames which are stored contiguously are copied in one go into a
+        // 2D numpy array, without converting them to one vector per frame
+        map<string, FrameMatrix>::const_iterator it = p.getVectorRealMatrixPool().find(key);
+        if (it != p.getVectorRealMatrixPool().end()) {
+          const FrameMatrix& frames = it->second;
+          npy_intp dims[2] = { frames.rows(), frames.cols() };
+          PyArrayObject* result = (PyArrayObject*)PyArray_SimpleNew(2, dims, PyArray_FLOAT);
+          if (result == NULL) {
+            throw EssentiaException("Pool.value: could not create the numpy array for ", key);
+          }
+          if (!frames.empty()) {
+            fastcopy((Real*)result->data, frames.row(0), (int)frames.values().size());
+          }
+          return (PyObject*)result;
+        }
+        return VectorVectorReal::toPythonCopy(&p.value<vector<vector<Real> > >(key));
+      }
       case VECTOR_VECTOR_STRING: return VectorVectorString::toPythonCopy(&p.value<vector<vector<string> > >(key));
       case VECTOR_MATRIX_REAL: return VectorMatrixReal::toPythonCopy(&p.value<vector<TNT::Array2D<Real> > >(key));
       default:
@@ -592,3 +614,40 @@ PyObject* PyPool::clear(PyPool* self) {
   self->pool->clear();
   Py_RETURN_NONE;
 }
+
+PyObject* PyPool::swap(PyPool* self, PyObject* obj) {
+  if (!PyType_IsSubtype(obj->ob_type, &PyPoolType)) {
+    PyErr_SetString(PyExc_TypeError, "expecting a Pool argument");
+    return NULL;
+  }
+
+  self->pool->swap(*reinterpret_cast<PyPool*>(obj)->pool);
+  Py_RETURN_NONE;
+}
+
+PyObject* PyPool::absorb(PyPool* self, PyObject* pyArgs) {
+  vector<PyObject*> args = unpack(pyArgs);
+
+  if (args.size() != 2) {
+    PyErr_SetString(PyExc_RuntimeError, "2 arguments required (pool, string)");
+    return NULL;
+  }
+  if (!PyType_IsSubtype(args[0]->ob_type, &PyPoolType)) {
+    PyErr_SetString(PyExc_TypeError, "pool.absorb, first argument should be a pool");
+    return NULL;
+  }
+  if (!PyString_Check(args[1])) {
+    PyErr_SetString(PyExc_TypeError, "pool.absorb, second argument should be a string");
+    return NULL;
+  }
+
+  try {
+    self->pool->absorb(*reinterpret_cast<PyPool*>(args[0])->pool, PyString_AsString(args[1]));
+  }
+  catch (const exception& e) {
+    PyErr_SetString(PyExc_RuntimeError, e.what());
+    return NULL;
+  }
+
+  Py_RETURN_NONE;
+}
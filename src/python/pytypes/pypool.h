@@ -61,6 +61,8 @@ class PyPool {
   static PyObject* removeNamespace(PyPool* self, PyObject* pyArgs);
   static PyObject* descriptorNames(PyPool* self, PyObject* pyArgs);
   static PyObject* clear(PyPool* self);
+  static PyObject* swap(PyPool* self, PyObject* obj);
+  static PyObject* absorb(PyPool* self, PyObject* pyArgs);
   static PyObject* keyType(PyPool* self, PyObject* obj);
 };
 
@@ -0,0 +1,6 @@
+
+#ifndef VERSION_H_
+#define VERSION_H_
+#define ESSENTIA_VERSION "2.1-beta6-dev"
+#define ESSENTIA_GIT_SHA "ef45375-dirty"
+#endif /* VERSION_H_ */
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "essentia_gtest.h"
+#include "algorithmpool.h"
+using namespace std;
+using namespace essentia;
+using namespace essentia::standard;
+
+
+TEST(AlgorithmPool, Configure) {
+  ParameterMap params;
+  params.add("size", 16);
+  Algorithm* spectrum = AlgorithmPool::acquire("Spectrum", params);
+  EXPECT_EQ(spectrum->name(), "Spectrum");
+  EXPECT_EQ(spectrum->parameter("size").toInt(), 16);
+
+  vector<Real> frame(16, 1), result;
+  spectrum->input("frame").set(frame);
+  spectrum->output("spectrum").set(result);
+  spectrum->compute();
+  EXPECT_EQ(result.size(), (size_t)9);
+  EXPECT_EQ(result[0], 16);
+
+  AlgorithmPool::release(spectrum);
+  AlgorithmPool::clear();
+}
+
+TEST(AlgorithmPool, Recycle) {
+  ParameterMap params;
+  params.add("size", 32);
+  Algorithm* first = AlgorithmPool::acquire("Spectrum", params);
+  Algorithm* second = AlgorithmPool::acquire("Spectrum", params);
+  EXPECT_NE(first, second);
+  AlgorithmPool::release(first);
+
+#ifdef CPP_11
+  // the released instance is given back for the same configuration only
+  Algorithm* other = AlgorithmPool::acquire("Spectrum");
+  EXPECT_NE(other, first);
+  Algorithm* recycled = AlgorithmPool::acquire("Spectrum", params);
+  EXPECT_EQ(recycled, first);
+  EXPECT_EQ(recycled->parameter("size").toInt(), 32);
+  AlgorithmPool::release(recycled);
+  AlgorithmPool::release(other);
+#endif
+
+  AlgorithmPool::release(second);
+  AlgorithmPool::clear();
+}
+
+TEST(AlgorithmPool, Reconfigured) {
+  ParameterMap params;
+  params.add("size", 64);
+  Algorithm* spectrum = AlgorithmPool::acquire("Spectrum", params);
+  spectrum->configure("size", 128);
+  AlgorithmPool::release(spectrum);
+
+  // an instance reconfigured after being acquired is not given back for the
+  // configuration it was acquired with
+  Algorithm* reacquired = AlgorithmPool::acquire("Spectrum", params);
+  EXPECT_EQ(reacquired->parameter("size").toInt(), 64);
+
+  vector<Real> frame(64, 1), result;
+  reacquired->input("frame").set(frame);
+  reacquired->output("spectrum").set(result);
+  reacquired->compute();
+  EXPECT_EQ(result.size(), (size_t)33);
+
+  AlgorithmPool::release(reacquired);
+  AlgorithmPool::clear();
+}
+
+TEST(AlgorithmPool, MaxFreeTotal) {
+#ifdef CPP_11
+  // released instances with many different configurations do not pile up,
+  // the oldest ones are deleted
+  size_t n = AlgorithmPool::maxFreeTotal() + 2;
+  vector<Algorithm*> algos(n);
+  for (size_t i=0; i<n; ++i) {
+    ParameterMap params;
+    params.add("size", int(2*i + 2));
+    algos[i] = AlgorithmPool::acquire("Spectrum", params);
+  }
+  for (size_t i=0; i<n; ++i) AlgorithmPool::release(algos[i]);
+
+  ParameterMap newest, oldest;
+  newest.add("size", int(2*n));
+  oldest.add("size", 2);
+  Algorithm* recycled = AlgorithmPool::acquire("Spectrum", newest);
+  EXPECT_EQ(recycled, algos[n-1]);
+  Algorithm* created = AlgorithmPool::acquire("Spectrum", oldest);
+  EXPECT_EQ(created->parameter("size").toInt(), 2);
+
+  AlgorithmPool::release(recycled);
+  AlgorithmPool::release(created);
+  AlgorithmPool::clear();
+#endif
+}
+
+TEST(AlgorithmPool, InvalidRelease) {
+#ifdef CPP_11
+  Algorithm* spectrum = AlgorithmFactory::create("Spectrum");
+  ASSERT_THROW(AlgorithmPool::release(spectrum), EssentiaException);
+  delete spectrum;
+#endif
+  ParameterMap params;
+  params.add("unknown", 1);
+  ASSERT_THROW(AlgorithmPool::acquire("Spectrum", params), EssentiaException);
+}
@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include <fstream>
+#include "essentia_gtest.h"
+#include "network.h"
+#include "vectorinput.h"
+#include "vectoroutput.h"
+#include "audiocache.h"
+#include "audiocachestorage.h"
+using namespace std;
+using namespace essentia;
+using namespace essentia::streaming;
+using util::AudioCache;
+
+
+static vector<Real> testSignal(int size) {
+  vector<Real> signal(size);
+  for (int i=0; i<size; ++i) signal[i] = sin(0.01*i) + 0.1*sin(0.37*i*i);
+  return signal;
+}
+
+static bool fileExists(const string& path) {
+  return ifstream(path.c_str()).good();
+}
+
+
+TEST(AudioCache, Path) {
+  string directory = AudioCache::directory();
+
+  AudioCache::setDirectory("");
+  EXPECT_FALSE(AudioCache::enabled());
+  ASSERT_THROW(AudioCache::path("0123", 44100, "mix"), EssentiaException);
+
+  AudioCache::setDirectory("build/test");
+  EXPECT_TRUE(AudioCache::enabled());
+  EXPECT_EQ("build/test/0123_44100_mix.pcm", AudioCache::path("0123", 44100, "mix"));
+  EXPECT_EQ("build/test/0123_16000_left.pcm", AudioCache::path("0123", 16000, "left"));
+  ASSERT_THROW(AudioCache::path("", 44100, "mix"), EssentiaException);
+
+  AudioCache::setDirectory(directory);
+}
+
+TEST(AudioCache, FileKey) {
+  string path = "build/test/audiocache_filekey.wav";
+  {
+    ofstream out(path.c_str(), ios::binary);
+    out << "not really audio";
+  }
+
+  string key = AudioCache::fileKey(path);
+  EXPECT_FALSE(key.empty());
+  EXPECT_EQ(key, AudioCache::fileKey("build/test/../test/audiocache_filekey.wav"));
+  EXPECT_NE(key, AudioCache::fileKey(path, 1));
+
+  // a modified file gets another key
+  {
+    ofstream out(path.c_str(), ios::binary | ios::app);
+    out << ", still not audio";
+  }
+  EXPECT_NE(key, AudioCache::fileKey(path));
+
+  remove(path.c_str());
+  EXPECT_EQ("", AudioCache::fileKey(path));
+}
+
+TEST(AudioCache, Index) {
+  string directory = AudioCache::directory();
+  AudioCache::setDirectory("build/test");
+
+  string md5 = "0123456789abcdef0123456789abcdef";
+  string indexPath = "build/test/audiocache_index.md5";
+  remove(indexPath.c_str());
+
+  EXPECT_EQ("", AudioCache::indexedMD5("audiocache_index"));
+  EXPECT_EQ("", AudioCache::indexedMD5(""));
+
+  AudioCache::indexMD5("audiocache_index", md5);
+  EXPECT_EQ(md5, AudioCache::indexedMD5("audiocache_index"));
+  ASSERT_THROW(AudioCache::indexMD5("", md5), EssentiaException);
+
+  // entries are named after the checksum, not after the file
+  EXPECT_EQ("build/test/" + md5 + "_44100_mix.pcm", AudioCache::path(md5, 44100, "mix"));
+
+  // a corrupted index is ignored
+  {
+    ofstream out(indexPath.c_str());
+    out << "0123";
+  }
+  EXPECT_EQ("", AudioCache::indexedMD5("audiocache_index"));
+
+  remove(indexPath.c_str());
+  AudioCache::setDirectory(directory);
+}
+
+TEST(AudioCache, WriteRead) {
+  string path = "build/test/audiocache.pcm";
+  vector<Real> signal = testSignal(10000);
+  AudioCache::write(path, signal, 16000, 44100);
+
+  AudioCache::Entry entry;
+  ASSERT_TRUE(entry.open(path));
+  EXPECT_EQ(signal.size(), entry.size());
+  EXPECT_EQ(16000, entry.sampleRate());
+  EXPECT_EQ(44100, entry.originalSampleRate());
+  EXPECT_VEC_EQ(signal, vector<Real>(entry.data(), entry.data() + entry.size()));
+
+  // empty signal
+  AudioCache::write(path, vector<Real>(), 16000, 44100);
+  ASSERT_TRUE(entry.open(path));
+  EXPECT_EQ((size_t)0, entry.size());
+  entry.close();
+  EXPECT_FALSE(entry.isOpen());
+
+  remove(path.c_str());
+}
+
+TEST(AudioCache, Writer) {
+  string path = "build/test/audiocache_writer.pcm";
+  remove(path.c_str());
+  vector<Real> signal = testSignal(10000);
+
+  // the entry is written as the samples come, and only appears on commit
+  AudioCache::Writer writer;
+  writer.open(path);
+  string tmpPath = writer.temporaryPath();
+  for (int i=0; i<(int)signal.size(); i+=3000) {
+    writer.append(&signal[i], min(3000, (int)signal.size() - i));
+  }
+  AudioCache::Entry entry;
+  EXPECT_FALSE(entry.open(path));
+  EXPECT_TRUE(fileExists(tmpPath));
+
+  writer.commit(16000, 44100);
+  EXPECT_FALSE(writer.isOpen());
+  EXPECT_FALSE(fileExists(tmpPath));
+  ASSERT_TRUE(entry.open(path));
+  EXPECT_EQ(16000, entry.sampleRate());
+  EXPECT_EQ(44100, entry.originalSampleRate());
+  EXPECT_VEC_EQ(signal, vector<Real>(entry.data(), entry.data() + entry.size()));
+  entry.close();
+  remove(path.c_str());
+
+  // an entry which is not committed is removed
+  writer.open(path);
+  tmpPath = writer.temporaryPath();
+  writer.append(&signal[0], 100);
+  writer.abort();
+  EXPECT_FALSE(fileExists(tmpPath));
+  EXPECT_FALSE(entry.open(path));
+
+  {
+    AudioCache::Writer other;
+    other.open(path);
+    tmpPath = other.temporaryPath();
+    other.append(&signal[0], 100);
+  }
+  EXPECT_FALSE(fileExists(tmpPath));
+  EXPECT_FALSE(entry.open(path));
+}
+
+TEST(AudioCache, InvalidEntry) {
+  string path = "build/test/audiocache_invalid.pcm";
+  AudioCache::Entry entry;
+  EXPECT_FALSE(entry.open(path + ".missing"));
+
+  // truncated file
+  AudioCache::write(path, testSignal(1000), 16000, 44100);
+  {
+    ifstream in(path.c_str(), ios::binary);
+    vector<char> data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    in.close();
+    ofstream out(path.c_str(), ios::binary);
+    out.write(&data[0], data.size() - 4);
+  }
+  EXPECT_FALSE(entry.open(path));
+
+  // not a cache file
+  {
+    ofstream out(path.c_str(), ios::binary);
+    out << "this is not an audio cache entry, but it is long enough";
+  }
+  EXPECT_FALSE(entry.open(path));
+  EXPECT_FALSE(entry.isOpen());
+
+  remove(path.c_str());
+}
+
+TEST(AudioCacheStorage, RecordAndServe) {
+  string path = "build/test/audiocachestorage.pcm";
+  remove(path.c_str());
+  vector<Real> signal = testSignal(300000);
+
+  // record: the signal goes through and is written at the end of the stream
+  {
+    VectorInput<Real>* gen = new VectorInput<Real>(&signal);
+    AudioCacheStorage* storage = new AudioCacheStorage();
+    vector<Real> output;
+    VectorOutput<Real>* out = new VectorOutput<Real>(&output);
+
+    storage->record(path, gen, 16000, 44100);
+    connect(gen->output("data"), storage->input("signal"));
+    connect(storage->output("signal"), out->input("data"));
+    scheduler::Network(gen).run();
+
+    EXPECT_VEC_EQ(signal, output);
+  }
+
+  // serve: the storage is a generator of the recorded signal
+  {
+    VectorInput<Real>* gen = new VectorInput<Real>(&signal);
+    AudioCacheStorage* storage = new AudioCacheStorage();
+    vector<Real> output;
+    VectorOutput<Real>* out = new VectorOutput<Real>(&output);
+
+    ASSERT_TRUE(storage->serve(path));
+    EXPECT_EQ(44100, storage->entry().originalSampleRate());
+    connect(gen->output("data"), storage->input("signal"));
+    connect(storage->output("signal"), out->input("data"));
+
+    {
+      scheduler::Network network(storage);
+      network.run();
+      EXPECT_VEC_EQ(signal, output);
+
+      // and can be run again after a reset
+      output.clear();
+      network.reset();
+      network.run();
+      EXPECT_VEC_EQ(signal, output);
+    }
+
+    // the input is not part of the network, as it is not needed
+    delete gen;
+  }
+
+  remove(path.c_str());
+}
+
+TEST(AudioCacheStorage, RecordStoppedEarly) {
+  string path = "build/test/audiocachestorage_stopped.pcm";
+  remove(path.c_str());
+  vector<Real> signal = testSignal(5000);
+
+  // the decoder has not reached the end of the file: nothing is cached
+  VectorInput<Real>* decoder = new VectorInput<Real>(&signal);
+  {
+    VectorInput<Real>* gen = new VectorInput<Real>(&signal);
+    AudioCacheStorage* storage = new AudioCacheStorage();
+    vector<Real> output;
+    VectorOutput<Real>* out = new VectorOutput<Real>(&output);
+
+    storage->record(path, decoder, 16000, 44100);
+    connect(gen->output("data"), storage->input("signal"));
+    connect(storage->output("signal"), out->input("data"));
+    scheduler::Network(gen).run();
+    EXPECT_VEC_EQ(signal, output);
+  }
+  delete decoder;
+
+  AudioCache::Entry entry;
+  EXPECT_FALSE(entry.open(path));
+}
+
+TEST(AudioCacheStorage, PassThrough) {
+  string path = "build/test/audiocachestorage_passthrough.pcm";
+  remove(path.c_str());
+  vector<Real> signal = testSignal(5000);
+
+  VectorInput<Real>* gen = new VectorInput<Real>(&signal);
+  AudioCacheStorage* storage = new AudioCacheStorage();
+  vector<Real> output;
+  VectorOutput<Real>* out = new VectorOutput<Real>(&output);
+
+  // no valid entry: serve() falls back to passing through
+  EXPECT_FALSE(storage->serve(path));
+  EXPECT_FALSE(storage->serving());
+  connect(gen->output("data"), storage->input("signal"));
+  connect(storage->output("signal"), out->input("data"));
+  scheduler::Network(gen).run();
+
+  EXPECT_VEC_EQ(signal, output);
+  AudioCache::Entry entry;
+  EXPECT_FALSE(entry.open(path));
+}
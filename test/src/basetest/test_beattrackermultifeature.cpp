@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "essentia_gtest.h"
+#include "algorithmfactory.h"
+#ifdef CPP_11
+#include <thread>
+#endif
+using namespace std;
+using namespace essentia;
+
+
+// clicks at 120 bpm, with a little deterministic noise in between
+static vector<Real> clickTrack(Real seconds) {
+  const Real sampleRate = 44100.;
+  vector<Real> signal(int(seconds * sampleRate));
+  for (size_t i=0; i<signal.size(); ++i) {
+    signal[i] = 0.001 * Real((i*7919) % 101) / 101;
+  }
+  for (size_t beat=0; beat*sampleRate/2 < signal.size(); ++beat) {
+    size_t start = size_t(beat * sampleRate / 2);
+    for (size_t i=start; i<min(start+441, signal.size()); ++i) {
+      signal[i] = 0.9 * (1 - Real(i-start)/441);
+    }
+  }
+  return signal;
+}
+
+static void trackBeats(const vector<Real>* signal, vector<Real>* ticks, Real* confidence) {
+  standard::Algorithm* tracker = standard::AlgorithmFactory::create("BeatTrackerMultiFeature");
+  tracker->input("signal").set(*signal);
+  tracker->output("ticks").set(*ticks);
+  tracker->output("confidence").set(*confidence);
+  tracker->compute();
+  delete tracker;
+}
+
+TEST(BeatTrackerMultiFeature, ClickTrack) {
+  vector<Real> signal = clickTrack(12);
+  vector<Real> ticks;
+  Real confidence;
+  trackBeats(&signal, &ticks, &confidence);
+
+  ASSERT_GT(ticks.size(), (size_t)10);
+  for (size_t i=1; i<ticks.size(); ++i) {
+    EXPECT_NEAR(ticks[i] - ticks[i-1], 0.5, 0.03);
+  }
+}
+
+TEST(BeatTrackerMultiFeature, Reproducible) {
+  // the beat candidates are computed concurrently inside each instance, and
+  // the results should not depend on that, nor on other instances running
+  vector<Real> signal = clickTrack(8);
+  vector<Real> ticks[3];
+  Real confidence[3];
+
+  trackBeats(&signal, &ticks[0], &confidence[0]);
+#ifdef CPP_11
+  thread other(trackBeats, &signal, &ticks[1], &confidence[1]);
+  trackBeats(&signal, &ticks[2], &confidence[2]);
+  other.join();
+#else
+  trackBeats(&signal, &ticks[1], &confidence[1]);
+  trackBeats(&signal, &ticks[2], &confidence[2]);
+#endif
+
+  EXPECT_VEC_EQ(ticks[1], ticks[0]);
+  EXPECT_VEC_EQ(ticks[2], ticks[0]);
+  EXPECT_EQ(confidence[1], confidence[0]);
+  EXPECT_EQ(confidence[2], confidence[0]);
+}
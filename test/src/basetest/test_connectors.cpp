@@ -632,3 +632,48 @@ TEST(Connectors, KindaComplexMess) {
   delete source1;
   delete sink5;
 }
+
+TEST(Connectors, TokenRecycling) {
+  Source<vector<Real> > source("Source1");
+  Sink<vector<Real> > sink("Sink1");
+  source.setBufferInfo(BufferInfo(64, 8));
+  connect(source, sink);
+
+  vector<Real> frame(32);
+  for (int i=0; i<16; i++) {
+    frame[0] = i;
+    source.push(frame);
+    EXPECT_EQ(sink.pop()[0], i);
+  }
+
+  // slots which have never been written to get the storage of the tokens
+  // which have already been read
+  ASSERT_TRUE(source.acquire(1));
+  EXPECT_GE(source.firstToken().capacity(), (size_t)32);
+  source.release(0);
+}
+
+TEST(Connectors, TokenRecyclingMultiReader) {
+  Source<vector<Real> > source("Source1");
+  Sink<vector<Real> > fast("Sink1");
+  Sink<vector<Real> > slow("Sink2");
+  source.setBufferInfo(BufferInfo(16, 4));
+  connect(source, fast);
+  connect(source, slow);
+
+  // go around the buffer and its phantom zone several times, with the slow
+  // reader lagging behind: the tokens it has not read yet must not be touched
+  int lag = 10, total = 100;
+  for (int i=0; i<total; i++) {
+    source.push(vector<Real>(i%7 + 1, Real(i)));
+    EXPECT_EQ(fast.pop(), vector<Real>(i%7 + 1, Real(i)));
+    if (i >= lag) {
+      EXPECT_EQ(slow.pop(), vector<Real>((i-lag)%7 + 1, Real(i-lag)));
+    }
+  }
+  EXPECT_EQ(source.lastTokenProduced(), vector<Real>((total-1)%7 + 1, Real(total-1)));
+
+  for (int i=total-lag; i<total; i++) {
+    EXPECT_EQ(slow.pop(), vector<Real>(i%7 + 1, Real(i)));
+  }
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "essentia_gtest.h"
+#include "fftcorrelation.h"
+#include "algorithmfactory.h"
+#include "essentiamath.h"
+using namespace std;
+using namespace essentia;
+using util::FFTCorrelation;
+
+
+static vector<Real> directCrossCorrelation(const vector<Real>& x, const vector<Real>& y,
+                                           int minLag, int maxLag) {
+  vector<Real> result;
+  for (int lag=minLag; lag<=maxLag; ++lag) {
+    double corr = 0;
+    for (int i=max(0, lag); i<min((int)x.size(), (int)y.size() + lag); ++i) {
+      corr += x[i] * y[i-lag];
+    }
+    result.push_back(corr);
+  }
+  return result;
+}
+
+static void expectClose(const vector<Real>& x, const vector<Real>& y) {
+  ASSERT_EQ(x.size(), y.size());
+  for (int i=0; i<(int)x.size(); ++i) {
+    EXPECT_NEAR(x[i], y[i], 1e-3) << "Vectors differ at index " << i;
+  }
+}
+
+static vector<Real> testSignal(int size, int seed) {
+  vector<Real> x(size);
+  for (int i=0; i<size; ++i) {
+    x[i] = sin(0.1 * (i+1) * (seed+1)) + 0.5 * cos(0.037 * i * i + seed);
+  }
+  return x;
+}
+
+
+TEST(FFTCorrelation, CrossCorrelation) {
+  FFTCorrelation correlator;
+  vector<Real> x = testSignal(300, 0);
+  vector<Real> y = testSignal(123, 1);
+
+  // lags beyond the overlap of both arrays must be zero
+  vector<Real> result;
+  correlator.crossCorrelation(x, y, -150, 320, result);
+  vector<Real> expected = directCrossCorrelation(x, y, -150, 320);
+  expectClose(result, expected);
+}
+
+TEST(FFTCorrelation, AutoCorrelation) {
+  FFTCorrelation correlator;
+  vector<Real> x = testSignal(257, 2);
+
+  vector<Real> result;
+  correlator.autoCorrelation(x, result);
+  // autocorrelation r[lag] = sum_i x[i]*x[i+lag] is the cross-correlation at -lag
+  vector<Real> expected = directCrossCorrelation(x, x, -256, 0);
+  reverse(expected.begin(), expected.end());
+  expectClose(result, expected);
+}
+
+TEST(FFTCorrelation, Batched) {
+  FFTCorrelation correlator(2);
+  vector<vector<Real> > xs;
+  for (int i=0; i<5; ++i) xs.push_back(testSignal(100, i));
+  vector<Real> y = testSignal(40, 7);
+
+  vector<vector<Real> > result;
+  correlator.crossCorrelation(xs, y, -10, 60, result);
+  ASSERT_EQ(result.size(), xs.size());
+  for (size_t i=0; i<xs.size(); ++i) {
+    vector<Real> expected = directCrossCorrelation(xs[i], y, -10, 60);
+    expectClose(result[i], expected);
+  }
+
+  // alternate between more sizes than the cache holds
+  for (int size=10; size<=1000; size*=10) {
+    vector<Real> x = testSignal(size, size);
+    vector<Real> single;
+    correlator.crossCorrelation(x, y, 0, 5, single);
+    vector<Real> expected = directCrossCorrelation(x, y, 0, 5);
+    expectClose(single, expected);
+  }
+
+  xs.push_back(testSignal(99, 0));
+  ASSERT_THROW(correlator.crossCorrelation(xs, y, 0, 1, result), EssentiaException);
+}
+
+// AutoCorrelation as it was computed with its own FFT and IFFT instances
+static vector<Real> referenceAutoCorrelation(const vector<Real>& x, bool generalized) {
+  int sizeFFT = int(nextPowerTwo(2*x.size()));
+  vector<Real> padded(sizeFFT, 0.0), corr;
+  copy(x.begin(), x.end(), padded.begin());
+  vector<complex<Real> > fft;
+
+  standard::Algorithm* fftAlgo = standard::AlgorithmFactory::create("FFT", "size", sizeFFT);
+  standard::Algorithm* ifftAlgo = standard::AlgorithmFactory::create("IFFT", "size", sizeFFT,
+                                                                     "normalize", !generalized);
+  fftAlgo->input("frame").set(padded);
+  fftAlgo->output("fft").set(fft);
+  fftAlgo->compute();
+  for (int i=0; i<(int)fft.size(); i++) {
+    if (!generalized) {
+      fft[i] = complex<Real>(fft[i].real() * fft[i].real() + fft[i].imag() * fft[i].imag(), 0.0);
+    }
+    else {
+      fft[i] = complex<Real>(pow(sqrt(pow(fft[i].real() / sizeFFT, 2) + pow(fft[i].imag() / sizeFFT, 2)), 0.5), 0.0);
+    }
+  }
+  ifftAlgo->input("fft").set(fft);
+  ifftAlgo->output("frame").set(corr);
+  ifftAlgo->compute();
+  delete fftAlgo;
+  delete ifftAlgo;
+
+  corr.resize(x.size());
+  return corr;
+}
+
+TEST(FFTCorrelation, AutoCorrelationUnchanged) {
+  // the shared plans give exactly the same results as dedicated instances,
+  // including the normalization of the inverse transform
+  standard::Algorithm* standardAC = standard::AlgorithmFactory::create("AutoCorrelation");
+  standard::Algorithm* generalizedAC = standard::AlgorithmFactory::create("AutoCorrelation",
+                                                                          "generalized", true);
+  int sizes[] = { 100, 257, 100, 1000 };
+  for (int i=0; i<4; ++i) {
+    vector<Real> x = testSignal(sizes[i], i), result, generalized;
+    standardAC->input("array").set(x);
+    standardAC->output("autoCorrelation").set(result);
+    standardAC->compute();
+    generalizedAC->input("array").set(x);
+    generalizedAC->output("autoCorrelation").set(generalized);
+    generalizedAC->compute();
+
+    vector<Real> expected = referenceAutoCorrelation(x, false);
+    vector<Real> expectedGeneralized = referenceAutoCorrelation(x, true);
+    EXPECT_VEC_EQ(result, expected);
+    EXPECT_VEC_EQ(generalized, expectedGeneralized);
+  }
+  delete standardAC;
+  delete generalizedAC;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "essentia_gtest.h"
+#include "algorithmfactory.h"
+using namespace std;
+using namespace essentia;
+using namespace essentia::standard;
+
+
+TEST(IOHandles, Bind) {
+  Algorithm* magnitude = AlgorithmFactory::create("Magnitude");
+  InputHandle<vector<complex<Real> > > input = magnitude->inputHandle<vector<complex<Real> > >("complex");
+  OutputHandle<vector<Real> > output = magnitude->outputHandle<vector<Real> >("magnitude");
+
+  vector<complex<Real> > frame(2, complex<Real>(3, 4));
+  vector<Real> result;
+  input.set(frame);
+  output.set(result);
+  magnitude->compute();
+
+  vector<Real> expected(2, 5);
+  EXPECT_VEC_EQ(result, expected);
+
+  // rebinding through the handle is seen by the algorithm
+  vector<complex<Real> > frame2(1, complex<Real>(0, 2));
+  vector<Real> result2;
+  input.set(frame2);
+  output.set(result2);
+  magnitude->compute();
+
+  EXPECT_EQ(result2.size(), (size_t)1);
+  EXPECT_EQ(result2[0], 2);
+  EXPECT_VEC_EQ(result, expected);
+
+  delete magnitude;
+}
+
+TEST(IOHandles, WrongType) {
+  Algorithm* magnitude = AlgorithmFactory::create("Magnitude");
+  ASSERT_THROW(magnitude->inputHandle<vector<Real> >("complex"), EssentiaException);
+  ASSERT_THROW(magnitude->outputHandle<Real>("magnitude"), EssentiaException);
+  ASSERT_THROW(magnitude->inputHandle<vector<complex<Real> > >("unknown"), EssentiaException);
+  delete magnitude;
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "essentia_gtest.h"
+#include "kernelcache.h"
+#include "algorithmfactory.h"
+#include "algorithms/standard/constantq.h"
+#include "algorithms/standard/nsgconstantq.h"
+#include <fstream>
+#include <cstring>
+using namespace std;
+using namespace essentia;
+using util::KernelCache;
+
+
+struct TestKernel {
+  vector<double> values;
+  vector<int> indices;
+
+  static const char* cacheTag() { return "TestKernel"; }
+  static int cacheVersion() { return 1; }
+
+  void write(ostream& out) const {
+    util::writeBinary(out, values);
+    util::writeBinary(out, indices);
+  }
+
+  void read(istream& in) {
+    util::readBinary(in, values);
+    util::readBinary(in, indices);
+  }
+};
+
+// same format, but another type of kernel
+struct OtherKernel : public TestKernel {
+  static const char* cacheTag() { return "OtherKernel"; }
+};
+
+// same type of kernel, but another version of the format
+struct TestKernelV2 : public TestKernel {
+  static int cacheVersion() { return 2; }
+};
+
+static TestKernel testKernel(int n) {
+  TestKernel kernel;
+  for (int i=0; i<n; ++i) {
+    kernel.values.push_back(sin(0.1*i) / (n+1));
+    kernel.indices.push_back(i*n);
+  }
+  return kernel;
+}
+
+static string readFile(const string& filename) {
+  ifstream in(filename.c_str(), ios::binary);
+  return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+}
+
+static void writeFile(const string& filename, const string& data) {
+  ofstream out(filename.c_str(), ios::binary);
+  out.write(data.data(), data.size());
+}
+
+
+TEST(KernelCache, GetInsert) {
+  KernelCache<TestKernel>& cache = KernelCache<TestKernel>::instance();
+  cache.clear();
+
+  EXPECT_FALSE(cache.get("a").get());
+  EXPECT_EQ(cache.misses(), (size_t)1);
+
+  cache.insert("a", testKernel(3));
+  cache.insert("b", testKernel(5));
+  EXPECT_EQ(cache.size(), (size_t)2);
+
+  KernelCache<TestKernel>::KernelPtr kernel = cache.get("b");
+  ASSERT_TRUE(kernel.get());
+  EXPECT_VEC_EQ(kernel->values, testKernel(5).values);
+  EXPECT_VEC_EQ(kernel->indices, testKernel(5).indices);
+  EXPECT_EQ(cache.hits(), (size_t)1);
+
+  // the kernel is shared, not copied
+  EXPECT_EQ(cache.get("b").get(), kernel.get());
+
+  // inserting the same key replaces the kernel, while the previous one stays
+  // valid for whoever still holds it
+  KernelCache<TestKernel>::KernelPtr previous = cache.get("a");
+  cache.insert("a", testKernel(4));
+  EXPECT_EQ(cache.size(), (size_t)2);
+  ASSERT_TRUE(cache.get("a").get());
+  EXPECT_EQ(cache.get("a")->values.size(), (size_t)4);
+  EXPECT_EQ(previous->values.size(), (size_t)3);
+}
+
+TEST(KernelCache, MaxSize) {
+  KernelCache<TestKernel>& cache = KernelCache<TestKernel>::instance();
+  cache.clear();
+  size_t maxSize = cache.maxSize();
+  cache.setMaxSize(2);
+
+  cache.insert("a", testKernel(1));
+  cache.insert("b", testKernel(2));
+  cache.insert("c", testKernel(3));
+
+  // the oldest kernel has been discarded
+  EXPECT_EQ(cache.size(), (size_t)2);
+  EXPECT_FALSE(cache.get("a").get());
+  EXPECT_TRUE(cache.get("c").get());
+
+  cache.setMaxSize(maxSize);
+}
+
+TEST(KernelCache, SaveLoad) {
+  KernelCache<TestKernel>& cache = KernelCache<TestKernel>::instance();
+  cache.clear();
+  cache.insert("a", testKernel(7));
+  cache.insert("empty", testKernel(0));
+
+  string filename = "build/test/kernelcache.bin";
+  cache.save(filename);
+  cache.clear();
+  cache.load(filename);
+  EXPECT_EQ(cache.size(), (size_t)2);
+
+  KernelCache<TestKernel>::KernelPtr kernel = cache.get("a");
+  ASSERT_TRUE(kernel.get());
+  EXPECT_VEC_EQ(kernel->values, testKernel(7).values);
+  EXPECT_VEC_EQ(kernel->indices, testKernel(7).indices);
+  kernel = cache.get("empty");
+  ASSERT_TRUE(kernel.get());
+  EXPECT_EQ(kernel->values.size(), (size_t)0);
+
+  ASSERT_THROW(cache.load(filename + ".missing"), EssentiaException);
+}
+
+TEST(KernelCache, LoadOtherKernels) {
+  KernelCache<TestKernel>& cache = KernelCache<TestKernel>::instance();
+  cache.clear();
+  cache.insert("a", testKernel(7));
+  string filename = "build/test/kernelcache.bin";
+  cache.save(filename);
+
+  KernelCache<OtherKernel>::instance().clear();
+  ASSERT_THROW(KernelCache<OtherKernel>::instance().load(filename), EssentiaException);
+  EXPECT_EQ(KernelCache<OtherKernel>::instance().size(), (size_t)0);
+
+  KernelCache<TestKernelV2>::instance().clear();
+  ASSERT_THROW(KernelCache<TestKernelV2>::instance().load(filename), EssentiaException);
+  EXPECT_EQ(KernelCache<TestKernelV2>::instance().size(), (size_t)0);
+}
+
+TEST(KernelCache, LoadCorruptFile) {
+  KernelCache<TestKernel>& cache = KernelCache<TestKernel>::instance();
+  cache.clear();
+  cache.insert("a", testKernel(7));
+  string filename = "build/test/kernelcache.bin";
+  cache.save(filename);
+  string data = readFile(filename);
+
+  // any truncated file is detected
+  string corruptFilename = "build/test/kernelcache_corrupt.bin";
+  for (size_t size=0; size<data.size(); ++size) {
+    writeFile(corruptFilename, data.substr(0, size));
+    ASSERT_THROW(cache.load(corruptFilename), EssentiaException) << "truncated at " << size;
+  }
+
+  // a huge size does not make the cache allocate it: the values of kernel
+  // "a" come after the magic, the tag, the version, the count and the key
+  size_t offset = 8 + sizeof(size_t) + strlen(TestKernel::cacheTag()) + sizeof(int) +
+                  sizeof(size_t) + sizeof(size_t) + 1;
+  string corrupt = data;
+  size_t huge = (size_t)1 << 60;
+  ASSERT_LT(offset + sizeof(size_t), corrupt.size());
+  corrupt.replace(offset, sizeof(size_t), string((const char*)&huge, sizeof(size_t)));
+  writeFile(corruptFilename, corrupt);
+  ASSERT_THROW(cache.load(corruptFilename), EssentiaException);
+}
+
+TEST(KernelCache, ConstantQ) {
+  // configuring twice with the same parameters uses the cached kernel
+  util::KernelCache<standard::ConstantQ::Kernel>& cache = standard::ConstantQ::kernelCache();
+  cache.clear();
+
+  vector<Real> frame(8192);
+  for (int i=0; i<(int)frame.size(); ++i) frame[i] = sin(0.05*i + 1e-5*i*i);
+
+  vector<vector<complex<Real> > > results(2);
+  for (int i=0; i<2; ++i) {
+    standard::Algorithm* cq = standard::AlgorithmFactory::create("ConstantQ",
+                                                                 "minFrequency", 110,
+                                                                 "numberBins", 48);
+    EXPECT_EQ(cache.hits(), (size_t)i);
+    EXPECT_EQ(cache.misses(), (size_t)1);
+    cq->input("frame").set(frame);
+    cq->output("constantq").set(results[i]);
+    cq->compute();
+    delete cq;
+  }
+  EXPECT_VEC_EQ(results[0], results[1]);
+  EXPECT_EQ(cache.size(), (size_t)1);
+}
+
+TEST(KernelCache, NSGConstantQ) {
+  // configuring twice with the same parameters uses the cached filterbank
+  util::KernelCache<standard::NSGConstantQ::Filterbank>& cache = standard::NSGConstantQ::filterbankCache();
+  cache.clear();
+
+  vector<Real> frame(4096);
+  for (int i=0; i<(int)frame.size(); ++i) frame[i] = sin(0.05*i + 1e-5*i*i);
+
+  vector<vector<vector<complex<Real> > > > results(2);
+  vector<vector<complex<Real> > > dc(2), nf(2);
+  for (int i=0; i<2; ++i) {
+    standard::Algorithm* cq = standard::AlgorithmFactory::create("NSGConstantQ",
+                                                                 "inputSize", 4096,
+                                                                 "minFrequency", 110,
+                                                                 "maxFrequency", 3520);
+    EXPECT_EQ(cache.hits(), (size_t)i);
+    EXPECT_EQ(cache.misses(), (size_t)1);
+    cq->input("frame").set(frame);
+    cq->output("constantq").set(results[i]);
+    cq->output("constantqdc").set(dc[i]);
+    cq->output("constantqnf").set(nf[i]);
+    cq->compute();
+    delete cq;
+  }
+  ASSERT_EQ(results[0].size(), results[1].size());
+  EXPECT_VEC_EQ(results[0][0], results[1][0]);
+  EXPECT_VEC_EQ(results[0].back(), results[1].back());
+  EXPECT_VEC_EQ(dc[0], dc[1]);
+  EXPECT_VEC_EQ(nf[0], nf[1]);
+  EXPECT_EQ(cache.size(), (size_t)1);
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "essentia_gtest.h"
+#include "network.h"
+#include "vectorinput.h"
+#include "vectoroutput.h"
+#include "streamingalgorithmwrapper.h"
+using namespace std;
+using namespace essentia;
+
+
+namespace essentia {
+namespace standard {
+
+// defers its default configuration like the expensive algorithms, and counts
+// how many times it is configured
+class CountingConfigure : public Algorithm {
+ protected:
+  Input<Real> _input;
+  Output<Real> _output;
+
+ public:
+  static int configureCount;
+
+  CountingConfigure() {
+    declareInput(_input, "input", "the input value");
+    declareOutput(_output, "output", "the input value times the gain");
+  }
+
+  void declareParameters() {
+    declareParameter("gain", "the gain", "(-inf,inf)", 2.0);
+  }
+
+  bool deferDefaultConfiguration() const { return true; }
+
+  void configure() {
+    markConfigured();
+    ++configureCount;
+  }
+
+  void compute() {
+    ensureConfigured();
+    _output.get() = _input.get() * parameter("gain").toReal();
+  }
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+};
+
+int CountingConfigure::configureCount = 0;
+const char* CountingConfigure::name = "CountingConfigure";
+const char* CountingConfigure::category = "Test";
+const char* CountingConfigure::description = "Counts its configurations.";
+
+} // namespace standard
+
+namespace streaming {
+
+class CountingConfigure : public StreamingAlgorithmWrapper {
+ protected:
+  Sink<Real> _input;
+  Source<Real> _output;
+
+ public:
+  CountingConfigure() {
+    declareAlgorithm("CountingConfigure");
+    declareInput(_input, TOKEN, "input");
+    declareOutput(_output, TOKEN, "output");
+  }
+};
+
+} // namespace streaming
+} // namespace essentia
+
+static void registerCountingConfigure() {
+  static standard::AlgorithmFactory::Registrar<standard::CountingConfigure> regStandard;
+  static streaming::AlgorithmFactory::Registrar<streaming::CountingConfigure, standard::CountingConfigure> regStreaming;
+}
+
+
+static vector<Real> windowedFrame(standard::Algorithm* windowing, int size) {
+  vector<Real> frame(size, 1), result;
+  windowing->input("frame").set(frame);
+  windowing->output("frame").set(result);
+  windowing->compute();
+  return result;
+}
+
+TEST(LazyConfigure, DefaultConfiguration) {
+  standard::Algorithm* lazy = standard::AlgorithmFactory::create("Windowing");
+  EXPECT_TRUE(lazy->deferDefaultConfiguration());
+  EXPECT_EQ(lazy->parameter("type").toString(), "hann");
+
+  standard::Algorithm* eager = standard::AlgorithmFactory::create("Windowing");
+  eager->configure();
+
+  // the deferred configuration happens on the first compute
+  EXPECT_VEC_EQ(windowedFrame(lazy, 16), windowedFrame(eager, 16));
+  EXPECT_VEC_EQ(windowedFrame(lazy, 16), windowedFrame(eager, 16));
+
+  delete lazy;
+  delete eager;
+}
+
+TEST(LazyConfigure, ExplicitConfiguration) {
+  standard::Algorithm* lazy = standard::AlgorithmFactory::create("Windowing",
+                                                                 "type", "square",
+                                                                 "normalized", false);
+  vector<Real> expected(16, 1);
+  EXPECT_VEC_EQ(windowedFrame(lazy, 16), expected);
+
+  // an explicit configuration is not overwritten by the default one
+  standard::Algorithm* reconfigured = standard::AlgorithmFactory::create("Windowing");
+  reconfigured->configure("type", "square", "normalized", false);
+  EXPECT_VEC_EQ(windowedFrame(reconfigured, 16), expected);
+
+  delete lazy;
+  delete reconfigured;
+}
+
+TEST(LazyConfigure, InvalidParameters) {
+  // explicit configurations are still checked when they are given
+  standard::Algorithm* fft = standard::AlgorithmFactory::create("FFT");
+  ASSERT_THROW(fft->configure("size", -1), EssentiaException);
+  delete fft;
+}
+
+TEST(LazyConfigure, Streaming) {
+  vector<vector<Real> > frames(3, vector<Real>(16, 1)), output;
+
+  streaming::VectorInput<vector<Real> >* gen = new streaming::VectorInput<vector<Real> >(&frames);
+  streaming::Algorithm* windowing = streaming::AlgorithmFactory::create("Windowing");
+  EXPECT_TRUE(windowing->deferDefaultConfiguration());
+
+  connect(gen->output("data"), windowing->input("frame"));
+  connect(windowing->output("frame"), output);
+  scheduler::Network(gen).run();
+
+  standard::Algorithm* eager = standard::AlgorithmFactory::create("Windowing");
+  eager->configure();
+  vector<vector<Real> > expected(3, windowedFrame(eager, 16));
+  delete eager;
+
+  EXPECT_MATRIX_EQ(output, expected);
+}
+
+TEST(LazyConfigure, ConfigureCount) {
+  registerCountingConfigure();
+  Real input = 3, output;
+
+  // deferred, then done once on the first compute
+  standard::CountingConfigure::configureCount = 0;
+  standard::Algorithm* deferred = standard::AlgorithmFactory::create("CountingConfigure");
+  EXPECT_EQ(standard::CountingConfigure::configureCount, 0);
+  deferred->input("input").set(input);
+  deferred->output("output").set(output);
+  deferred->compute();
+  deferred->compute();
+  EXPECT_EQ(standard::CountingConfigure::configureCount, 1);
+  EXPECT_EQ(output, 6);
+  delete deferred;
+
+  // every explicit configuration replaces the deferred one
+  for (int explicitCall=0; explicitCall<2; ++explicitCall) {
+    standard::CountingConfigure::configureCount = 0;
+    standard::Algorithm* configured = standard::AlgorithmFactory::create("CountingConfigure");
+    if (explicitCall == 0) configured->configure();
+    else configured->configure("gain", 2.0);
+    configured->input("input").set(input);
+    configured->output("output").set(output);
+    configured->compute();
+    EXPECT_EQ(standard::CountingConfigure::configureCount, 1);
+    EXPECT_EQ(output, 6);
+    delete configured;
+  }
+}
+
+TEST(LazyConfigure, ConfigureCountStreaming) {
+  registerCountingConfigure();
+  vector<Real> input(3, 1), output;
+
+  for (int explicitCall=0; explicitCall<3; ++explicitCall) {
+    standard::CountingConfigure::configureCount = 0;
+    output.clear();
+
+    streaming::VectorInput<Real>* gen = new streaming::VectorInput<Real>(&input);
+    streaming::Algorithm* counting = streaming::AlgorithmFactory::create("CountingConfigure");
+    EXPECT_TRUE(counting->deferDefaultConfiguration());
+    if (explicitCall == 1) counting->configure();
+    if (explicitCall == 2) counting->configure("gain", 2.0);
+
+    connect(gen->output("data"), counting->input("input"));
+    connect(counting->output("output"), output);
+    scheduler::Network(gen).run();
+
+    EXPECT_EQ(standard::CountingConfigure::configureCount, 1);
+    EXPECT_VEC_EQ(output, vector<Real>(3, 2));
+  }
+}
@@ -21,6 +21,12 @@
 #include "network.h"
 #include "networkparser.h"
 #include "graphutils.h"
+#include "ringbufferinput.h"
+#include "vectoroutput.h"
+#ifdef CPP_11
+#include <thread>
+#include <chrono>
+#endif
 using namespace std;
 using namespace essentia;
 using namespace essentia::streaming;
@@ -891,6 +897,301 @@ TEST(Network, DiamondShape3) {
 }
 
 
+TEST(Network, CompiledNetworkCache) {
+  AlgorithmFactory& factory = AlgorithmFactory::instance();
+  CompiledNetworkCache::instance().clear();
+
+  vector<string> orders[2];
+  string signatures[2];
+
+  for (int n=0; n<2; n++) {
+    Algorithm* A = factory.create("A");
+    Algorithm* DiamondShape = factory.create("DiamondShapeAlgo");
+    Pool pool;
+
+    A->output("out") >> DiamondShape->input("src");
+    DiamondShape->output("dest") >> PC(pool, "freqs");
+
+    AlgoVector algos;
+    signatures[n] = structuralSignature(A, algos);
+    EXPECT_EQ(A, algos[0]);
+
+    // the second network reuses the execution network of the first one
+    Network network(A);
+    network.setCacheExecutionNetwork(true);
+    network.update();
+    EXPECT_EQ((size_t)1, CompiledNetworkCache::instance().size());
+
+    const vector<Algorithm*>& order = network.linearExecutionOrder();
+    ASSERT_EQ((size_t)8, order.size());
+    for (int i=0; i<(int)order.size(); i++) {
+      orders[n].push_back(removeNodeIdFromName(order[i]->name()));
+    }
+    EXPECT_EQ("A", orders[n][0]);
+    EXPECT_EQ("HarmonicPeaks", orders[n][5]);
+    EXPECT_EQ(8, (int)depthFirstSearch(network.executionNetworkRoot()).size());
+  }
+
+  EXPECT_EQ(signatures[0], signatures[1]);
+  EXPECT_EQ(orders[0], orders[1]);
+
+  // a network with another structure gets its own execution network
+  Algorithm* A = factory.create("A");
+  Algorithm* B = factory.create("B");
+  Algorithm* F = factory.create("F1");
+
+  A->output("out") >> B->input("in");
+  B->output("out") >> F->input("in1");
+  A->output("out") >> F->input("in2");
+
+  AlgoVector algos;
+  EXPECT_NE(signatures[0], structuralSignature(A, algos));
+  EXPECT_EQ((size_t)3, algos.size());
+
+  Network n(A);
+  n.setCacheExecutionNetwork(true);
+  n.update();
+  EXPECT_EQ((size_t)2, CompiledNetworkCache::instance().size());
+  ASSERT_EQ((size_t)3, n.linearExecutionOrder().size());
+  EXPECT_EQ("F1", n.linearExecutionOrder()[2]->name());
+
+  // the networks do not use the cache by default
+  Algorithm* A2 = factory.create("A");
+  Algorithm* B2 = factory.create("B");
+  A2->output("out") >> B2->input("in");
+  B2->output("out") >> NOWHERE;
+  Network uncached(A2);
+  uncached.update();
+  EXPECT_EQ((size_t)2, CompiledNetworkCache::instance().size());
+}
+
+TEST(Network, CompiledNetworkRead) {
+  CompiledNetwork compiled;
+  compiled.nodeAlgos.push_back(0);
+  compiled.nodeAlgos.push_back(1);
+  compiled.nodeChildren.resize(2);
+  compiled.nodeChildren[0].push_back(1);
+  compiled.root = 0;
+  compiled.executionOrder.push_back(0);
+  compiled.executionOrder.push_back(1);
+
+  ostringstream out;
+  compiled.write(out);
+  string data = out.str();
+
+  CompiledNetwork read;
+  istringstream in(data);
+  read.read(in);
+  EXPECT_EQ(compiled.nodeAlgos, read.nodeAlgos);
+  EXPECT_EQ(compiled.nodeChildren, read.nodeChildren);
+  EXPECT_EQ(compiled.root, read.root);
+  EXPECT_EQ(compiled.executionOrder, read.executionOrder);
+
+  // truncated data
+  for (size_t size=0; size<data.size(); size++) {
+    istringstream truncated(data.substr(0, size));
+    ASSERT_THROW(read.read(truncated), EssentiaException) << "truncated at " << size;
+  }
+
+  // a corrupt number of nodes does not allocate them
+  size_t huge = (size_t)1 << 60;
+  string corrupt = data;
+  corrupt.replace(0, sizeof(size_t), string((const char*)&huge, sizeof(size_t)));
+  istringstream corrupted(corrupt);
+  ASSERT_THROW(read.read(corrupted), EssentiaException);
+}
+
+TEST(Network, LatencyReport) {
+  AlgorithmFactory& factory = AlgorithmFactory::instance();
+  RingBufferInput* gen = new RingBufferInput();
+  gen->declareParameters();
+  gen->configure();
+  Algorithm* fc = factory.create("FrameCutter",
+                                 "frameSize", 1024,
+                                 "hopSize", 512);
+  Algorithm* spectrum = factory.create("Spectrum");
+  vector<vector<Real> > spectra;
+
+  gen->output("signal") >> fc->input("signal");
+  fc->output("frame") >> spectrum->input("frame");
+  spectrum->output("spectrum") >> spectra;
+
+  Network network(gen);
+  vector<AlgorithmLatency> report = network.latencyReport();
+  ASSERT_EQ((size_t)4, report.size());
+
+  EXPECT_EQ((Algorithm*)gen, report[0].algorithm);
+  EXPECT_EQ(0, report[0].acquireSize);
+  EXPECT_EQ(0, report[0].pathLatency);
+
+  // the latencies are in samples
+  EXPECT_EQ(fc, report[1].algorithm);
+  EXPECT_EQ(fc->input("signal").acquireSize(), report[1].acquireSize);
+  EXPECT_EQ(1, report[1].tokenSize);
+  EXPECT_EQ(report[1].acquireSize, report[1].pathLatency);
+
+  // a frame stands for a hop of samples, and the first one is there as soon
+  // as the frame cutter has run
+  EXPECT_EQ(spectrum, report[2].algorithm);
+  EXPECT_EQ(1, report[2].acquireSize);
+  EXPECT_EQ(0, report[2].lookahead);
+  EXPECT_EQ(512, report[2].tokenSize);
+  EXPECT_EQ(report[1].pathLatency, report[2].pathLatency);
+  EXPECT_EQ(512, report[3].tokenSize);
+  EXPECT_EQ(report[2].pathLatency, report[3].pathLatency);
+}
+
+TEST(Network, LatencyReportSeveralFrames) {
+  AlgorithmFactory& factory = AlgorithmFactory::instance();
+  RingBufferInput* gen = new RingBufferInput();
+  gen->declareParameters();
+  gen->configure();
+  Algorithm* fc = factory.create("FrameCutter",
+                                 "frameSize", 1024,
+                                 "hopSize", 256);
+  Algorithm* spectrum = factory.create("Spectrum");
+  vector<vector<Real> > spectra;
+
+  gen->output("signal") >> fc->input("signal");
+  fc->output("frame") >> spectrum->input("frame");
+  spectrum->output("spectrum") >> spectra;
+  spectrum->input("frame").setAcquireSize(4);
+
+  Network network(gen);
+  vector<AlgorithmLatency> report = network.latencyReport();
+  ASSERT_EQ((size_t)4, report.size());
+
+  // the spectrum waits for 3 more hops of the frame cutter
+  EXPECT_EQ(spectrum, report[2].algorithm);
+  EXPECT_EQ(4, report[2].acquireSize);
+  EXPECT_EQ(report[1].pathLatency + 3*256, report[2].pathLatency);
+}
+
+// copies its input, and has a hop size in seconds as some algorithms do
+class HopInSecondsAlgo : public Algorithm {
+ protected:
+  Sink<Real> _src;
+  Source<Real> _dest;
+
+ public:
+  HopInSecondsAlgo() {
+    declareInput(_src, 1, "src", "where to copy from");
+    declareOutput(_dest, 1, "dest", "where to copy to");
+  }
+
+  AlgorithmStatus process() {
+    AlgorithmStatus status = acquireData();
+    if (status != OK) return status;
+    _dest.firstToken() = _src.firstToken();
+    releaseData();
+    return OK;
+  }
+
+  void declareParameters() {
+    declareParameter("hopSize", "the hop size [s]", "(0,inf)", 2.5);
+  }
+};
+
+TEST(Network, LatencyReportHopInSeconds) {
+  RingBufferInput* gen = new RingBufferInput();
+  gen->declareParameters();
+  gen->configure();
+  HopInSecondsAlgo* hop = new HopInSecondsAlgo();
+  hop->declareParameters();
+  hop->configure();
+  HopInSecondsAlgo* copy = new HopInSecondsAlgo();
+  copy->declareParameters();
+  copy->configure();
+  vector<Real> output;
+
+  gen->output("signal") >> hop->input("src");
+  hop->output("dest") >> copy->input("src");
+  copy->output("dest") >> output;
+
+  Network network(gen);
+  vector<AlgorithmLatency> report = network.latencyReport();
+  ASSERT_EQ((size_t)4, report.size());
+
+  // a hop size which is not a number of tokens does not change the token size
+  EXPECT_EQ((Algorithm*)copy, report[2].algorithm);
+  EXPECT_EQ(1, report[2].tokenSize);
+}
+
+TEST(Network, RunFor) {
+  AlgorithmFactory& factory = AlgorithmFactory::instance();
+  Algorithm* gen = new RingBufferInput();
+  gen->declareParameters();
+  gen->configure("bufferSize", 4096,
+                 "blocking", false);
+  Algorithm* fc = factory.create("FrameCutter",
+                                 "frameSize", 512,
+                                 "hopSize", 256,
+                                 "startFromZero", true);
+  vector<vector<Real> > frames;
+
+  gen->output("signal") >> fc->input("signal");
+  fc->output("frame") >> frames;
+
+  Network network(gen);
+  network.runPrepare();
+
+  // nothing to process: returns straight away instead of waiting for data
+  EXPECT_EQ(0, network.runFor(1024));
+  EXPECT_TRUE(frames.empty());
+
+  vector<Real> signal(2048, 1.0);
+  static_cast<RingBufferInput*>(gen)->add(&signal[0], (int)signal.size());
+  EXPECT_EQ(2048, network.runFor(2048));
+  // the frame cutter keeps the last frame until it knows whether it is the last one
+  EXPECT_EQ((size_t)6, frames.size());
+
+  EXPECT_EQ(0, network.runFor(1024));
+  EXPECT_EQ((size_t)6, frames.size());
+
+  static_cast<RingBufferInput*>(gen)->add(&signal[0], 256);
+  EXPECT_EQ(256, network.runFor(1024));
+  EXPECT_EQ((size_t)7, frames.size());
+}
+
+#ifdef CPP_11
+static void feedRingBuffer(RingBufferInput* input, int chunks) {
+  vector<Real> signal(512, 1.0);
+  for (int i=0; i<chunks; i++) {
+    this_thread::sleep_for(chrono::milliseconds(10));
+    input->add(&signal[0], (int)signal.size());
+  }
+}
+
+TEST(Network, RunForBlocking) {
+  AlgorithmFactory& factory = AlgorithmFactory::instance();
+  Algorithm* gen = new RingBufferInput();
+  gen->declareParameters();
+  gen->configure("bufferSize", 4096,
+                 "blocking", true);
+  Algorithm* fc = factory.create("FrameCutter",
+                                 "frameSize", 512,
+                                 "hopSize", 256,
+                                 "startFromZero", true);
+  vector<vector<Real> > frames;
+
+  gen->output("signal") >> fc->input("signal");
+  fc->output("frame") >> frames;
+
+  Network network(gen);
+  network.runPrepare();
+
+  // the generator sleeps until the other thread adds data
+  thread producer(feedRingBuffer, static_cast<RingBufferInput*>(gen), 4);
+  int produced = 0;
+  while (produced < 2048) produced += network.runFor(2048 - produced);
+  producer.join();
+
+  EXPECT_EQ(2048, produced);
+  EXPECT_EQ((size_t)6, frames.size());
+}
+#endif
+
+
 TEST(Network, TeeProxyComposite) {
   AlgorithmFactory& factory = AlgorithmFactory::instance();
 
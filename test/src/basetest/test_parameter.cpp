@@ -188,6 +188,73 @@ TEST_F(Parameter, ToVectorReal) {
   EXPECT_VEC_EQ(p.toVectorReal(), _vr1);
 }
 
+TEST_F(Parameter, ToVectorInt) {
+  vector<int> v(3);
+  v[0] = 69;
+  v[1] = -69;
+  v[2] = 101;
+  Param p(v);
+  EXPECT_VEC_EQ(p.toVectorInt(), v);
+  EXPECT_EQ(p.toString(), "[69, -69, 101]");
+  EXPECT_EQ(p.denseIntValues().size(), (size_t)3);
+  EXPECT_EQ(p.denseIntValues()[1], -69);
+  ASSERT_THROW(p.toVectorReal(), EssentiaException);
+  ASSERT_THROW(p.denseValues(), EssentiaException);
+  ASSERT_THROW(Param(_vr1).denseIntValues(), EssentiaException);
+}
+
+TEST_F(Parameter, VectorIntExact) {
+  // not representable as a Real
+  vector<int> v(2);
+  v[0] = 16777217;
+  v[1] = -2147483647;
+  Param p(v);
+  EXPECT_VEC_EQ(p.toVectorInt(), v);
+  EXPECT_EQ(p.toString(), "[16777217, -2147483647]");
+
+  Param copy(p);
+  EXPECT_VEC_EQ(copy.toVectorInt(), v);
+  EXPECT_TRUE(copy == p);
+
+  v[0] = 16777216;
+  EXPECT_FALSE(Param(v) == p);
+}
+
+TEST_F(Parameter, Matrix) {
+  TNT::Array2D<Real> m(2, 3);
+  for (int i=0; i<2; ++i) {
+    for (int j=0; j<3; ++j) m[i][j] = i*10 + j + 0.5;
+  }
+  Param p(m);
+  EXPECT_EQ(p.toString(), "[[0.5, 1.5, 2.5], [10.5, 11.5, 12.5]]");
+  EXPECT_EQ(p.matrixRows(), 2);
+  EXPECT_EQ(p.matrixCols(), 3);
+  EXPECT_EQ(p.denseValues()[4], (Real)11.5);
+
+  TNT::Array2D<Real> result = p.toMatrixReal();
+  EXPECT_EQ(result.dim1(), 2);
+  EXPECT_EQ(result.dim2(), 3);
+  for (int i=0; i<2; ++i) {
+    for (int j=0; j<3; ++j) EXPECT_EQ(result[i][j], m[i][j]);
+  }
+
+  Param copy(p);
+  EXPECT_EQ(copy, p);
+  m[1][2] = 0;
+  EXPECT_NE(Param(m), p);
+  // same values, different shape
+  EXPECT_NE(Param(TNT::Array2D<Real>(3, 2, (Real)1)), Param(TNT::Array2D<Real>(2, 3, (Real)1)));
+}
+
+TEST_F(Parameter, DenseValues) {
+  Param p(_vr1);
+  // no copy is made when accessing the values
+  EXPECT_EQ(&p.denseValues(), &p.denseValues());
+  EXPECT_VEC_EQ(p.denseValues(), _vr1);
+  ASSERT_THROW(Param(_vs1).denseValues(), EssentiaException);
+  ASSERT_THROW(Param(Param::VECTOR_REAL).denseValues(), EssentiaException);
+}
+
 TEST_F(Parameter, ToMapReal) {
   map<string, Real> m;
   m["foo"] = 123.456;
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "essentia_gtest.h"
+#include "polyphaseresampler.h"
+using namespace std;
+using namespace essentia;
+using util::PolyphaseResampler;
+
+
+static vector<Real> sine(Real freq, Real sampleRate, int size) {
+  vector<Real> signal(size);
+  for (int i=0; i<size; ++i) signal[i] = sin(2*M_PI*freq*i/sampleRate);
+  return signal;
+}
+
+// maximum error against a sine, away from the edges of the signal
+static Real sineError(const vector<Real>& resampled, Real freq, Real sampleRate) {
+  Real error = 0;
+  int margin = (int)(sampleRate / 100);
+  for (int i=margin; i<(int)resampled.size()-margin; ++i) {
+    error = max(error, (Real)fabs(resampled[i] - sin(2*M_PI*freq*i/sampleRate)));
+  }
+  return error;
+}
+
+static vector<Real> resample(PolyphaseResampler& resampler, const vector<Real>& signal) {
+  vector<Real> resampled(resampler.outputSize(signal.size()));
+  int size = resampler.resample(&signal[0], signal.size(), &resampled[0]);
+  EXPECT_EQ((int)resampled.size(), size);
+  return resampled;
+}
+
+
+TEST(PolyphaseResampler, Ratios) {
+  PolyphaseResampler resampler;
+  vector<Real> signal = sine(440, 44100, 44100);
+
+  resampler.configure(44100, 22050);
+  EXPECT_EQ(1, resampler.interpolationFactor());
+  EXPECT_EQ(2, resampler.decimationFactor());
+  vector<Real> resampled = resample(resampler, signal);
+  EXPECT_EQ(22050, (int)resampled.size());
+  EXPECT_LT(sineError(resampled, 440, 22050), 1e-4);
+
+  resampler.configure(44100, 16000);
+  EXPECT_EQ(160, resampler.interpolationFactor());
+  EXPECT_EQ(441, resampler.decimationFactor());
+  resampled = resample(resampler, signal);
+  EXPECT_EQ(16000, (int)resampled.size());
+  EXPECT_LT(sineError(resampled, 440, 16000), 1e-4);
+
+  resampler.configure(44100, 8000);
+  resampled = resample(resampler, signal);
+  EXPECT_EQ(8000, (int)resampled.size());
+  EXPECT_LT(sineError(resampled, 440, 8000), 1e-4);
+
+  resampler.configure(44100, 4*44100);
+  resampled = resample(resampler, signal);
+  EXPECT_EQ(4*44100, (int)resampled.size());
+  EXPECT_LT(sineError(resampled, 440, 4*44100), 1e-4);
+
+  signal = sine(1000, 48000, 4800);
+  resampler.configure(48000, 44100);
+  resampled = resample(resampler, signal);
+  EXPECT_EQ(4410, (int)resampled.size());
+  EXPECT_LT(sineError(resampled, 1000, 44100), 1e-4);
+}
+
+TEST(PolyphaseResampler, AntiAliasing) {
+  // a sine above the output Nyquist frequency is removed
+  PolyphaseResampler resampler;
+  resampler.configure(44100, 16000);
+  vector<Real> resampled = resample(resampler, sine(9000, 44100, 44100));
+
+  Real peak = 0;
+  for (int i=160; i<(int)resampled.size()-160; ++i) peak = max(peak, (Real)fabs(resampled[i]));
+  EXPECT_LT(peak, 1e-3);
+}
+
+TEST(PolyphaseResampler, Stream) {
+  // resampling a stream by blocks of any size gives the same result as
+  // resampling the whole signal at once
+  int rates[][2] = { {44100, 16000}, {48000, 44100}, {44100, 4*44100}, {44100, 22050} };
+  vector<Real> signal = sine(440, 44100, 10000);
+  for (int i=0; i<(int)signal.size(); ++i) signal[i] += 0.1*sin(0.37*i*i);
+
+  PolyphaseResampler resampler;
+  for (int r=0; r<4; ++r) {
+    resampler.configure(rates[r][0], rates[r][1]);
+    vector<Real> expected = resample(resampler, signal);
+
+    for (int blockSize=1; blockSize<=4096; blockSize*=8) {
+      resampler.reset();
+      vector<Real> resampled;
+      vector<Real> block(max(resampler.maxOutputSize(blockSize), resampler.maxFlushSize()));
+
+      for (int start=0; start<(int)signal.size(); start+=blockSize) {
+        int size = min(blockSize, (int)signal.size()-start);
+        int n = resampler.process(&signal[start], size, &block[0]);
+        EXPECT_LE(n, resampler.maxOutputSize(size));
+        resampled.insert(resampled.end(), block.begin(), block.begin()+n);
+      }
+      int n = resampler.flush(&block[0]);
+      EXPECT_LE(n, resampler.maxFlushSize());
+      resampled.insert(resampled.end(), block.begin(), block.begin()+n);
+
+      EXPECT_VEC_EQ(expected, resampled);
+    }
+  }
+}
+
+TEST(PolyphaseResampler, SharedFilters) {
+  PolyphaseResampler::filterCache().clear();
+  PolyphaseResampler a, b;
+  a.configure(44100, 16000);
+  size_t size = PolyphaseResampler::filterCache().size();
+  b.configure(44100, 16000);
+  EXPECT_EQ(size, PolyphaseResampler::filterCache().size());
+  b.configure(88200, 32000); // same ratio
+  EXPECT_EQ(size, PolyphaseResampler::filterCache().size());
+}
+
+TEST(PolyphaseResampler, InvalidRates) {
+  PolyphaseResampler resampler;
+  ASSERT_THROW(resampler.configure(44100, 44101), EssentiaException);
+  ASSERT_THROW(resampler.configure(44100.5, 22050), EssentiaException);
+  ASSERT_THROW(resampler.configure(0, 22050), EssentiaException);
+}
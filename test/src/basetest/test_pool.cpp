@@ -18,7 +18,11 @@
  */
 
 #include <algorithm>
+#include <sstream>
 #include "essentia_gtest.h"
+#ifdef CPP_11
+#include <thread>
+#endif
 using namespace std;
 using essentia::Real;
 using essentia::EssentiaException;
@@ -264,3 +268,358 @@ TEST(Pool, IntegrityCheck) {
   p.add("foo.bar", (Real)1.23456789);
   ASSERT_THROW(p.add("foo.bar", "mixed up the types!"), EssentiaException);
 }
+
+TEST(Pool, ParentChildDescriptors) {
+  essentia::Pool p;
+  p.add("foo.bar.baz", (Real)1);
+  ASSERT_THROW(p.add("foo.bar", (Real)2), EssentiaException);
+  ASSERT_THROW(p.add("foo", "parent"), EssentiaException);
+  ASSERT_THROW(p.add("foo.bar.baz.qux", (Real)3), EssentiaException);
+  p.add("foo.barbaz", (Real)4);
+
+  // once the child is removed, the parent name can be used
+  p.remove("foo.bar.baz");
+  p.add("foo.bar", (Real)5);
+  EXPECT_EQ(p.value<vector<Real> >("foo.bar")[0], 5);
+
+  p.removeNamespace("foo");
+  p.add("foo", "parent");
+  ASSERT_THROW(p.add("foo.bar", (Real)6), EssentiaException);
+}
+
+TEST(Pool, DescriptorId) {
+  essentia::Pool p;
+  essentia::DescriptorId id = p.descriptorId("foo.bar");
+  EXPECT_EQ(p.descriptorId("foo.bar"), id);
+  EXPECT_EQ(p.descriptorName(id), "foo.bar");
+  EXPECT_FALSE(p.contains<vector<Real> >("foo.bar"));
+
+  p.add(id, (Real)1);
+  p.add("foo.bar", (Real)2);
+  p.add(id, (Real)3);
+  vector<Real> expected;
+  expected.push_back(1); expected.push_back(2); expected.push_back(3);
+  EXPECT_VEC_EQ(p.value<vector<Real> >("foo.bar"), expected);
+
+  // the same validation applies when adding by id
+  ASSERT_THROW(p.add(id, "mixed up the types!"), EssentiaException);
+  ASSERT_THROW(p.add(p.descriptorId("foo"), (Real)1), EssentiaException);
+  ASSERT_THROW(p.add(-1, (Real)1), EssentiaException);
+
+  // ids stay valid when the descriptor is removed
+  p.remove("foo.bar");
+  p.add(id, "string");
+  EXPECT_EQ(p.value<vector<string> >("foo.bar")[0], "string");
+
+  p.clear();
+  p.add(id, (Real)4);
+  EXPECT_EQ(p.value<vector<Real> >("foo.bar").size(), (size_t)1);
+}
+
+TEST(Pool, DescriptorIdCopy) {
+  essentia::Pool p;
+  essentia::DescriptorId id = p.descriptorId("foo.bar");
+  p.add(id, (Real)1);
+
+  essentia::Pool copy(p);
+  copy.add(copy.descriptorId("foo.bar"), (Real)2);
+  EXPECT_EQ(p.value<vector<Real> >("foo.bar").size(), (size_t)1);
+  EXPECT_EQ(copy.value<vector<Real> >("foo.bar").size(), (size_t)2);
+
+  // assigning keeps the ids of the pool assigned to
+  essentia::Pool other;
+  essentia::DescriptorId otherId = other.descriptorId("other");
+  other = copy;
+  EXPECT_EQ(other.descriptorId("other"), otherId);
+  other.add(other.descriptorId("foo.bar"), (Real)3);
+  EXPECT_EQ(other.value<vector<Real> >("foo.bar").size(), (size_t)3);
+  EXPECT_EQ(copy.value<vector<Real> >("foo.bar").size(), (size_t)2);
+  ASSERT_THROW(other.add("foo.bar.baz", (Real)1), EssentiaException);
+}
+
+TEST(Pool, FrameMatrix) {
+  essentia::Pool p;
+  vector<Real> frame(4, 1);
+  p.add("frames", frame);
+  frame[0] = 2;
+  p.add("frames", frame);
+  essentia::DescriptorId id = p.descriptorId("frames");
+  frame[0] = 3;
+  p.add(id, frame);
+
+  // frames of the same size are stored contiguously
+  ASSERT_EQ(p.getVectorRealMatrixPool().count("frames"), (size_t)1);
+  EXPECT_EQ(p.getVectorRealRowsPool().count("frames"), (size_t)0);
+  const essentia::FrameMatrix& matrix = p.getVectorRealMatrixPool().find("frames")->second;
+  EXPECT_EQ(matrix.rows(), 3);
+  EXPECT_EQ(matrix.cols(), 4);
+  EXPECT_EQ(matrix.row(2)[0], 3);
+  EXPECT_TRUE(p.contains<vector<vector<Real> > >("frames"));
+
+  vector<vector<Real> > more(2, vector<Real>(4, 4));
+  p.append("frames", more);
+  EXPECT_EQ(p.getVectorRealMatrixPool().find("frames")->second.rows(), 5);
+
+  // and they can still be retrieved as one vector per frame
+  const vector<vector<Real> >& frames = p.value<vector<vector<Real> > >("frames");
+  ASSERT_EQ(frames.size(), (size_t)5);
+  EXPECT_EQ(frames[1][0], 2);
+  EXPECT_EQ(frames[4][3], 4);
+  EXPECT_EQ(p.getVectorRealPool().find("frames")->second.size(), (size_t)5);
+
+  p.remove("frames");
+  EXPECT_FALSE(p.contains<vector<vector<Real> > >("frames"));
+  p.add("frames", vector<Real>(2, 1));
+  EXPECT_EQ(p.getVectorRealMatrixPool().find("frames")->second.rows(), 1);
+}
+
+TEST(Pool, FrameMatrixDifferentSizes) {
+  essentia::Pool p;
+  p.add("frames", vector<Real>(4, 1));
+  p.add("frames", vector<Real>(2, 2));
+  essentia::DescriptorId id = p.descriptorId("frames");
+  p.add(id, vector<Real>(3, 3));
+
+  // frames of different sizes are stored one vector per frame
+  EXPECT_EQ(p.getVectorRealMatrixPool().count("frames"), (size_t)0);
+  ASSERT_EQ(p.getVectorRealRowsPool().count("frames"), (size_t)1);
+  const vector<vector<Real> >& frames = p.value<vector<vector<Real> > >("frames");
+  ASSERT_EQ(frames.size(), (size_t)3);
+  EXPECT_EQ(frames[0].size(), (size_t)4);
+  EXPECT_EQ(frames[1].size(), (size_t)2);
+  EXPECT_EQ(frames[2].size(), (size_t)3);
+
+  vector<vector<Real> > mixed;
+  mixed.push_back(vector<Real>(1, 1));
+  mixed.push_back(vector<Real>(2, 1));
+  p.append("mixed", mixed);
+  EXPECT_EQ(p.getVectorRealMatrixPool().count("mixed"), (size_t)0);
+  EXPECT_EQ(p.value<vector<vector<Real> > >("mixed").size(), (size_t)2);
+
+  // merging pools converts the frames which cannot be stored contiguously
+  essentia::Pool other;
+  other.add("frames", vector<Real>(4, 4));
+  other.add("other", vector<Real>(4, 4));
+  p.merge(other, "append");
+  EXPECT_EQ(p.value<vector<vector<Real> > >("frames").size(), (size_t)4);
+  EXPECT_EQ(p.value<vector<vector<Real> > >("other").size(), (size_t)1);
+  // the merged pool is not converted
+  EXPECT_EQ(other.getVectorRealMatrixPool().count("frames"), (size_t)1);
+  EXPECT_EQ(other.getVectorRealMatrixPool().count("other"), (size_t)1);
+}
+
+#ifdef CPP_11
+static void readFrames(const essentia::Pool* p, int first, int step, size_t* total) {
+  for (int i=first; i>=0 && i<100; i+=step) {
+    ostringstream name;
+    name << "frames" << i;
+    *total += p->value<vector<vector<Real> > >(name.str()).size();
+  }
+}
+
+TEST(Pool, FrameMatrixConcurrentReads) {
+  // the descriptors of a const pool are converted when read, which must be
+  // safe from several threads
+  essentia::Pool p;
+  for (int i=0; i<100; ++i) {
+    ostringstream name;
+    name << "frames" << i;
+    p.add(name.str(), vector<Real>(4, 1));
+    p.add(name.str(), vector<Real>(4, 2));
+  }
+
+  size_t total[2] = { 0, 0 };
+  thread other(readFrames, &p, 0, 1, &total[0]);
+  readFrames(&p, 99, -1, &total[1]);
+  other.join();
+
+  EXPECT_EQ(total[0], (size_t)200);
+  EXPECT_EQ(total[1], (size_t)200);
+  EXPECT_EQ(p.getVectorRealMatrixPool().size(), (size_t)0);
+  EXPECT_EQ(p.getVectorRealRowsPool().size(), (size_t)100);
+}
+#endif
+
+TEST(Pool, Swap) {
+  essentia::Pool p1, p2;
+  essentia::DescriptorId id = p1.descriptorId("foo.bar");
+  p1.add(id, (Real)1);
+  p1.set("single", "value");
+  p2.add("other", (Real)2);
+
+  const Real* data = &p1.value<vector<Real> >("foo.bar")[0];
+  p1.swap(p2);
+
+  EXPECT_FALSE(p1.contains<vector<Real> >("foo.bar"));
+  EXPECT_EQ(p1.value<vector<Real> >("other")[0], 2);
+  EXPECT_EQ(p2.value<string>("single"), "value");
+  // the values are not copied
+  EXPECT_EQ(&p2.value<vector<Real> >("foo.bar")[0], data);
+
+  // the ids are kept by the pool which gave them
+  p1.add(id, (Real)3);
+  EXPECT_EQ(p1.value<vector<Real> >("foo.bar")[0], 3);
+  ASSERT_THROW(p1.add("foo", (Real)4), EssentiaException);
+  p2.add("foo.baz", (Real)5);
+}
+
+TEST(Pool, Absorb) {
+  essentia::Pool p1, p2;
+  p1.add("foo.bar", (Real)1);
+  p2.add("foo.bar", (Real)2);
+  p2.add("foo.baz", (Real)3);
+  p2.set("single", (Real)4);
+  p2.add("array", TNT::Array2D<Real>(2, 2, 0.0));
+
+  const Real* data = &p2.value<vector<Real> >("foo.baz")[0];
+  p1.absorb(p2, "append");
+
+  EXPECT_EQ(p2.descriptorNames().size(), (size_t)0);
+  EXPECT_EQ(p1.value<vector<Real> >("foo.bar").size(), (size_t)2);
+  EXPECT_EQ(p1.value<Real>("single"), 4);
+  EXPECT_EQ(p1.value<vector<TNT::Array2D<Real> > >("array").size(), (size_t)1);
+  EXPECT_EQ(&p1.value<vector<Real> >("foo.baz")[0], data);
+
+  // same errors as merge
+  essentia::Pool p3;
+  p3.add("foo.bar", (Real)5);
+  p3.add("other", (Real)7);
+  ASSERT_THROW(p1.absorb(p3), EssentiaException);
+  // the descriptors which could not be absorbed are still in p3
+  EXPECT_TRUE(p3.contains<vector<Real> >("foo.bar"));
+  p3.clear();
+  p3.add("foo", (Real)6);
+  ASSERT_THROW(p1.absorb(p3), EssentiaException);
+  EXPECT_TRUE(p3.contains<vector<Real> >("foo"));
+
+  // pools absorbing each other in turn
+  p3.clear();
+  p3.add("foo.bar", (Real)8);
+  p1.absorb(p3, "append");
+  p3.absorb(p1, "append");
+  EXPECT_EQ(p1.descriptorNames().size(), (size_t)0);
+  EXPECT_EQ(p3.value<vector<Real> >("foo.bar").size(), (size_t)3);
+}
+
+
+TEST(Pool, Take) {
+  essentia::Pool p;
+  p.add("foo.bar", (Real)1);
+  p.add("foo.bar", (Real)2);
+  p.set("single", "value");
+
+  vector<Real> values;
+  p.take("foo.bar", values);
+  EXPECT_EQ(values.size(), (size_t)2);
+  EXPECT_FALSE(p.contains<vector<Real> >("foo.bar"));
+
+  string single;
+  p.take("single", single);
+  EXPECT_EQ(single, "value");
+  EXPECT_EQ(p.descriptorNames().size(), (size_t)0);
+
+  ASSERT_THROW(p.take("foo.bar", values), EssentiaException);
+}
+
+TEST(Pool, TakeFrameMatrix) {
+  essentia::Pool p;
+  vector<Real> frame(3);
+  for (int i=0; i<4; ++i) {
+    frame[0] = i;
+    p.add("frames", frame);
+    p.add("other", frame);
+  }
+  const Real* data = p.getVectorRealMatrixPool().find("frames")->second.row(0);
+
+  essentia::FrameMatrix frames;
+  p.take("frames", frames);
+  EXPECT_EQ(frames.rows(), 4);
+  EXPECT_EQ(frames.cols(), 3);
+  EXPECT_EQ(frames.row(0), data);
+  EXPECT_EQ(frames.row(3)[0], 3);
+  EXPECT_FALSE(p.contains<vector<vector<Real> > >("frames"));
+
+  // taking the frames as rows does not convert them in the pool first
+  vector<vector<Real> > rows;
+  p.take("other", rows);
+  EXPECT_EQ(rows.size(), (size_t)4);
+  EXPECT_EQ(rows[2][0], 2);
+  EXPECT_TRUE(p.getVectorRealRowsPool().empty());
+  EXPECT_EQ(p.descriptorNames().size(), (size_t)0);
+
+  // frames of different sizes are not stored contiguously
+  p.add("rows", frame);
+  p.add("rows", vector<Real>(2));
+  ASSERT_THROW(p.take("rows", frames), EssentiaException);
+  p.take("rows", rows);
+  EXPECT_EQ(rows.size(), (size_t)2);
+  ASSERT_THROW(p.take("rows", rows), EssentiaException);
+}
+
+#ifdef CPP_11
+TEST(Pool, AppendMove) {
+  essentia::Pool p;
+  vector<vector<Real> > frames(2, vector<Real>(4, 1));
+  const Real* data = &frames[0][0];
+  p.append("frames", std::move(frames));
+  EXPECT_EQ(&p.value<vector<vector<Real> > >("frames")[0][0], data);
+
+  vector<vector<Real> > more(1, vector<Real>(4, 2));
+  data = &more[0][0];
+  p.append("frames", std::move(more));
+  EXPECT_EQ(p.value<vector<vector<Real> > >("frames").size(), (size_t)3);
+  EXPECT_EQ(&p.value<vector<vector<Real> > >("frames")[2][0], data);
+}
+
+TEST(Pool, AggregateFrameMatrix) {
+  // the same frames, stored contiguously and as one vector per frame
+  vector<vector<Real> > frames(20, vector<Real>(3));
+  for (int i=0; i<20; ++i) {
+    for (int j=0; j<3; ++j) frames[i][j] = sin(0.3*i*(j+1)) + 0.01*i*j;
+  }
+  essentia::Pool matrix, rows;
+  for (int i=0; i<20; ++i) matrix.add("frames", frames[i]);
+  rows.append("frames", vector<vector<Real> >(frames));
+  ASSERT_EQ(matrix.getVectorRealMatrixPool().size(), (size_t)1);
+  ASSERT_EQ(rows.getVectorRealRowsPool().size(), (size_t)1);
+
+  const char* statNames[] = { "mean", "median", "min", "max", "var", "stdev", "skew", "kurt",
+                              "dmean", "dvar", "dmean2", "dvar2", "cov", "icov", "value" };
+  vector<string> stats(statNames, statNames + 15);
+
+  essentia::Pool fromMatrix, fromRows;
+  essentia::standard::Algorithm* aggregator =
+    essentia::standard::AlgorithmFactory::create("PoolAggregator", "defaultStats", stats);
+  aggregator->input("input").set(matrix);
+  aggregator->output("output").set(fromMatrix);
+  aggregator->compute();
+  aggregator->input("input").set(rows);
+  aggregator->output("output").set(fromRows);
+  aggregator->compute();
+  delete aggregator;
+
+  // the frames are aggregated as they are stored
+  EXPECT_EQ(matrix.getVectorRealMatrixPool().size(), (size_t)1);
+
+  vector<string> names = fromRows.descriptorNames();
+  ASSERT_EQ(fromMatrix.descriptorNames(), names);
+  for (int i=0; i<(int)names.size(); ++i) {
+    vector<vector<Real> > expected, result;
+    if (fromRows.contains<vector<Real> >(names[i])) {
+      expected.push_back(fromRows.value<vector<Real> >(names[i]));
+      result.push_back(fromMatrix.value<vector<Real> >(names[i]));
+    }
+    else {
+      expected = fromRows.value<vector<vector<Real> > >(names[i]);
+      result = fromMatrix.value<vector<vector<Real> > >(names[i]);
+    }
+    ASSERT_EQ(result.size(), expected.size()) << names[i];
+    for (int j=0; j<(int)expected.size(); ++j) {
+      ASSERT_EQ(result[j].size(), expected[j].size()) << names[i];
+      for (int k=0; k<(int)expected[j].size(); ++k) {
+        EXPECT_NEAR(result[j][k], expected[j][k], 1e-4*max((Real)1, fabs(expected[j][k]))) << names[i];
+      }
+    }
+  }
+}
+#endif
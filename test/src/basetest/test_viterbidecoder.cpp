@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "essentia_gtest.h"
+#include "viterbidecoder.h"
+using namespace std;
+using namespace essentia;
+using util::ViterbiDecoder;
+
+
+// reference dense implementation, scanning all the transitions in order
+static vector<int> denseViterbi(const vector<Real>& init,
+                                const vector<vector<Real> >& trans, // [to][from]
+                                const vector<vector<Real> >& obs) {
+  size_t n = init.size();
+  vector<double> delta(n), oldDelta(n);
+  vector<vector<int> > psi(obs.size(), vector<int>(n, 0));
+  double sum = 0;
+  for (size_t i=0; i<n; ++i) { oldDelta[i] = init[i] * obs[0][i]; sum += oldDelta[i]; }
+  for (size_t i=0; i<n; ++i) oldDelta[i] /= sum;
+
+  for (size_t t=1; t<obs.size(); ++t) {
+    sum = 0;
+    for (size_t j=0; j<n; ++j) {
+      delta[j] = 0;
+      for (size_t i=0; i<n; ++i) {
+        double v = oldDelta[i] * (double) trans[j][i];
+        if (v > delta[j]) { delta[j] = v; psi[t][j] = i; }
+      }
+      delta[j] *= obs[t][j];
+      sum += delta[j];
+    }
+    for (size_t j=0; j<n; ++j) oldDelta[j] = delta[j] / sum;
+  }
+
+  vector<int> path(obs.size());
+  path.back() = max_element(oldDelta.begin(), oldDelta.end()) - oldDelta.begin();
+  for (size_t t=obs.size()-1; t>0; --t) path[t-1] = psi[t][path[t]];
+  return path;
+}
+
+static void bandedModel(size_t nStates, int width, size_t nFrames,
+                        vector<Real>& init,
+                        vector<vector<Real> >& trans,
+                        vector<vector<Real> >& obs) {
+  init.assign(nStates, 1.0 / nStates);
+  trans.assign(nStates, vector<Real>(nStates, 0));
+  for (int j=0; j<(int)nStates; ++j) {
+    for (int i=max(0, j-width); i<=min((int)nStates-1, j+width); ++i) {
+      trans[j][i] = Real(width + 1 - abs(i-j));
+    }
+  }
+  obs.assign(nFrames, vector<Real>(nStates));
+  for (size_t t=0; t<nFrames; ++t) {
+    for (size_t i=0; i<nStates; ++i) {
+      // a slowly moving peak with some deterministic clutter
+      Real center = nStates/2 + (nStates/3) * sin(0.05 * t);
+      obs[t][i] = exp(-0.1 * (i-center)*(i-center)) + 0.01 * ((i*7 + t*13) % 11);
+    }
+  }
+}
+
+
+TEST(ViterbiDecoder, SameAsDense) {
+  vector<Real> init;
+  vector<vector<Real> > trans, obs;
+  bandedModel(37, 3, 200, init, trans, obs);
+
+  ViterbiDecoder<double> decoder;
+  decoder.setTransitions(trans);
+  vector<int> path;
+  EXPECT_TRUE(decoder.decode(init, obs, path));
+
+  vector<int> expected = denseViterbi(init, trans, obs);
+  EXPECT_VEC_EQ(path, expected);
+}
+
+TEST(ViterbiDecoder, TripletsSameAsMatrix) {
+  vector<Real> init;
+  vector<vector<Real> > trans, obs;
+  bandedModel(20, 2, 50, init, trans, obs);
+
+  // triplets given in an order that is not sorted by source state
+  vector<size_t> from, to;
+  vector<Real> prob;
+  for (int i=(int)trans.size()-1; i>=0; --i) {
+    for (size_t j=0; j<trans.size(); ++j) {
+      if (trans[j][i] != 0) {
+        from.push_back(i);
+        to.push_back(j);
+        prob.push_back(trans[j][i]);
+      }
+    }
+  }
+
+  ViterbiDecoder<double> dense, sparse;
+  dense.setTransitions(trans);
+  sparse.setTransitions(trans.size(), from, to, prob);
+
+  vector<int> densePath, sparsePath;
+  dense.decode(init, obs, densePath);
+  sparse.decode(init, obs, sparsePath);
+  EXPECT_VEC_EQ(densePath, sparsePath);
+}
+
+template <typename T>
+static vector<int> decodeTies(size_t nStates, size_t nFrames) {
+  // all the transitions and observations are equal, and each state is
+  // reached from the highest source state first
+  vector<size_t> from, to;
+  vector<Real> prob;
+  for (size_t j=0; j<nStates; ++j) {
+    for (int i=(int)nStates-1; i>=0; --i) {
+      from.push_back(i);
+      to.push_back(j);
+      prob.push_back(1);
+    }
+  }
+  vector<Real> init(nStates, 1);
+  vector<vector<Real> > obs(nFrames, vector<Real>(nStates, 1));
+
+  ViterbiDecoder<T> decoder;
+  decoder.setTransitions(nStates, from, to, prob);
+  vector<int> path;
+  decoder.decode(init, obs, path);
+  return path;
+}
+
+TEST(ViterbiDecoder, TiesInTransitionOrder) {
+  // ties go to the transition given first, as with a sequential scan
+  const size_t nStates = 13, nFrames = 6;
+  vector<int> expected(nFrames, nStates-1);
+  expected.back() = 0;
+
+  vector<int> floatPath = decodeTies<float>(nStates, nFrames);
+  vector<int> doublePath = decodeTies<double>(nStates, nFrames);
+  EXPECT_VEC_EQ(floatPath, expected);
+  EXPECT_VEC_EQ(doublePath, expected);
+}
+
+TEST(ViterbiDecoder, OnlineFullLag) {
+  vector<Real> init;
+  vector<vector<Real> > trans, obs;
+  bandedModel(25, 4, 120, init, trans, obs);
+
+  ViterbiDecoder<double> decoder;
+  decoder.setTransitions(trans);
+  vector<int> offline;
+  decoder.decode(init, obs, offline);
+
+  vector<int> online;
+  decoder.start(init, obs.size());
+  for (size_t t=0; t<obs.size(); ++t) {
+    decoder.push(obs[t], online);
+  }
+  EXPECT_EQ(online.size(), (size_t)0);
+  decoder.flush(online);
+
+  EXPECT_VEC_EQ(online, offline);
+}
+
+TEST(ViterbiDecoder, OnlineFixedLag) {
+  vector<Real> init;
+  vector<vector<Real> > trans, obs;
+  bandedModel(25, 4, 120, init, trans, obs);
+
+  ViterbiDecoder<float> decoder;
+  decoder.setTransitions(trans);
+
+  const size_t lag = 10;
+  vector<int> online;
+  decoder.start(init, lag);
+  for (size_t t=0; t<obs.size(); ++t) {
+    decoder.push(obs[t], online);
+    EXPECT_EQ(online.size(), t+1 >= lag+1 ? t+1-lag : 0);
+  }
+  decoder.flush(online);
+  EXPECT_EQ(online.size(), obs.size());
+}
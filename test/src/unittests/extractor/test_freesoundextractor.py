@@ -45,6 +45,19 @@ class TestFreesoundExtractor(TestCase):
         self.assertValidPool(pool)
         self.assertValidPool(poolFrames)
 
+    def testSegmentDuration(self):
+        # segments are computed in parallel and merged back in order, giving
+        # the same frames as a single pass, and the same descriptors of the
+        # whole audio
+        inputFilename = join(testdata.audio_dir, 'recorded', 'musicbox.wav')
+        _, frames = FreesoundExtractor()(inputFilename)
+        _, segmentFrames = FreesoundExtractor(segmentDuration=10)(inputFilename)
+        for name in ['lowlevel.spectral_centroid', 'lowlevel.spectral_rms', 'lowlevel.zerocrossingrate']:
+            self.assertEqual(len(segmentFrames[name]), len(frames[name]))
+            self.assertAlmostEqualVector(segmentFrames[name], frames[name], 1e-2)
+        for name in ['lowlevel.sound_start_frame', 'lowlevel.sound_stop_frame']:
+            self.assertEqual(segmentFrames[name], frames[name])
+
     def testRobustness(self):
         # TODO test that computed descriptors are similar across formats
         return
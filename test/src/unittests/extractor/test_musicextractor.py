@@ -45,6 +45,17 @@ class TestMusicExtractor(TestCase):
         self.assertValidPool(pool)
         self.assertValidPool(poolFrames)
 
+    def testSegmentDuration(self):
+        # segments are computed in parallel and merged back in order, giving
+        # the same frames as a single pass. Their values differ slightly, as
+        # the filters of a segment only start one second before its frames
+        inputFilename = join(testdata.audio_dir, 'recorded', 'musicbox.wav')
+        _, frames = MusicExtractor()(inputFilename)
+        _, segmentFrames = MusicExtractor(segmentDuration=10)(inputFilename)
+        for name in ['lowlevel.spectral_centroid', 'lowlevel.spectral_rms', 'lowlevel.zerocrossingrate']:
+            self.assertEqual(len(segmentFrames[name]), len(frames[name]))
+            self.assertAlmostEqualVector(segmentFrames[name], frames[name], 1e-2)
+
     def testRobustness(self):
         # TODO test that computed descriptors are similar across formats
         return
@@ -71,6 +71,27 @@ class TestAudioWriter_Streaming(TestCase):
 
         self.compare(pool['audio'], signal)
 
+    def testBackgroundEncoding(self):
+        # encoding in a separate thread should give exactly the same file
+        from math import sin, pi
+        size = 100000
+        signal = [[0.5*sin(2.0*pi*440.0*i/44100.), 0.3*sin(2.0*pi*220.0*i/44100.)] for i in range(size)]
+
+        for format in ['wav', 'aiff', 'flac']:
+            contents = []
+            for backgroundEncoding in [False, True]:
+                filename = 'audiowritertest_%s.%s' % (backgroundEncoding, format)
+                gen = VectorInput(signal)
+                writer = AudioWriter(filename=filename, format=format,
+                                     backgroundEncoding=backgroundEncoding)
+                gen.data >> writer.audio
+                run(gen)
+                with open(filename, 'rb') as f:
+                    contents.append(f.read())
+                os.remove(filename)
+
+            self.assertEqual(contents[0], contents[1])
+
     def testEmpty(self):
         inputFilename = join(testdata.audio_dir, 'generated', 'empty', 'empty.aiff')
         outputFilename = 'audiowritertest.aiff'
@@ -0,0 +1,109 @@
+#!/usr/bin/env python
+
+# Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+#
+# This file is part of Essentia
+#
+# Essentia is free software: you can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the Free
+# Software Foundation (FSF), either version 3 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the Affero GNU General Public License
+# version 3 along with this program. If not, see http://www.gnu.org/licenses/
+
+
+
+from essentia_test import *
+from essentia.streaming import FastMonoLoader, EasyLoader
+import math
+class TestFastMonoLoader_Streaming(TestCase):
+
+    def loadBoth(self, filename, **params):
+        pool = Pool()
+
+        loader = FastMonoLoader(filename=filename, **params)
+        loader.audio >> (pool, 'fast')
+        run(loader)
+
+        # resampleQuality has no equivalent in EasyLoader
+        params.pop('resampleQuality', None)
+        loader = EasyLoader(filename=filename, **params)
+        loader.audio >> (pool, 'easy')
+        run(loader)
+
+        return pool['fast'], pool['easy']
+
+    def testNoResample(self):
+        # without resampling, the output is exactly the one of EasyLoader
+        filename = join(testdata.audio_dir, 'generated','synthesised','impulse','resample',
+                        'impulses_1samp_44100.wav')
+        for downmix, replayGain, startTime, endTime in [ ('left' , 0.,   0.,    10.),
+                                                        ('right', -15., 3.34,  5.68),
+                                                        ('mix'  , 30.,  0.168, 8.32) ]:
+            fast, easy = self.loadBoth(filename, downmix=downmix, replayGain=replayGain,
+                                       startTime=startTime, endTime=endTime)
+            self.assertEqualVector(fast, easy)
+
+    def testStereo(self):
+        filename = join(testdata.audio_dir, 'recorded', 'musicbox.wav')
+        for downmix in ['left', 'right', 'mix']:
+            fast, easy = self.loadBoth(filename, downmix=downmix, startTime=1., endTime=5.)
+            self.assertEqualVector(fast, easy)
+
+    def testResample(self):
+        filename = join(testdata.audio_dir, 'generated','synthesised','impulse','resample',
+                        'impulses_1samp_44100.wav')
+        for sampleRate, quality in [ (22050, 1), (48000, 1), (16000, 5) ]:
+            fast, easy = self.loadBoth(filename, sampleRate=sampleRate, resampleQuality=quality,
+                                       startTime=1., endTime=9.)
+            self.assertEqual(len(fast), int(8.*sampleRate))
+            # away from the edges, an impulse at every sample stays constant
+            margin = sampleRate // 100
+            self.assertAlmostEqual(sum(fast[margin:-margin]) / len(fast[margin:-margin]), 1., 1e-3)
+            if quality != 5:
+                self.assertAlmostEqualVector(fast[margin:-margin], easy[margin:-margin], 1e-3)
+
+    def testSeek(self):
+        # pcm files have exact timestamps, so seeking gives the same samples
+        filename = join(testdata.audio_dir, 'recorded', 'musicbox.wav')
+        for startTime, endTime in [ (0., 2.), (3.2, 7.5), (30., 31.) ]:
+            pool = Pool()
+            for seek in [ True, False ]:
+                loader = FastMonoLoader(filename=filename, seek=seek,
+                                        startTime=startTime, endTime=endTime)
+                loader.audio >> (pool, str(seek))
+                run(loader)
+            self.assertEqualVector(pool['True'], pool['False'])
+
+    def testInvalidParam(self):
+        filename = join(testdata.audio_dir, 'generated','synthesised','impulse','resample',
+                        'impulses_1samp_44100.wav')
+        self.assertConfigureFails(FastMonoLoader(), {'filename':'unknown.wav'})
+        self.assertConfigureFails(FastMonoLoader(), {'filename':filename, 'downmix' : 'stereo'})
+        self.assertConfigureFails(FastMonoLoader(), {'filename':filename, 'sampleRate' : 0})
+        self.assertConfigureFails(FastMonoLoader(), {'filename':filename, 'startTime' : -1})
+        self.assertConfigureFails(FastMonoLoader(), {'filename':filename, 'resampleQuality' : 6})
+        self.assertConfigureFails(FastMonoLoader(), {'filename':filename, 'startTime':10, 'endTime' : 1})
+
+    def testLoadMultiple(self):
+        from essentia.standard import FastMonoLoader as stdFastMonoLoader
+        aiffpath = join('generated','synthesised','impulse','aiff')
+        filename = join(testdata.audio_dir,aiffpath,'impulses_1second_44100.aiff')
+        algo = stdFastMonoLoader(filename=filename)
+        audio1 = algo()
+        audio2 = algo()
+        self.assertEquals(len(audio1), 441000);
+        self.assertEqualVector(audio2, audio1)
+
+
+
+suite = allTests(TestFastMonoLoader_Streaming)
+
+if __name__ == '__main__':
+    TextTestRunner(verbosity=2).run(suite)
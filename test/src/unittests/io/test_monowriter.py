@@ -52,6 +52,22 @@ class TestMonoWriter(TestCase):
         self.assertAlmostEqualVector(left, input, 5e-2)
 
 
+    def testBackgroundEncoding(self):
+        # encoding in a separate thread should give exactly the same file
+        sr = 44100
+        input = [0.5*sin(2.0*pi*440.0*i/sr) for i in range(3*sr)]
+        for format in ['wav', 'aiff', 'flac']:
+            contents = []
+            for backgroundEncoding in [False, True]:
+                filename = 'foo.' + format
+                MonoWriter(filename=filename, format=format, sampleRate=sr,
+                           backgroundEncoding=backgroundEncoding)(input)
+                with open(filename, 'rb') as f:
+                    contents.append(f.read())
+                os.remove(filename)
+
+            self.assertEqual(contents[0], contents[1])
+
     def testEmpty(self):
         MonoWriter(filename = 'foo.wav')([])
         self.assertTrue( not os.path.exists('foo.wav') )
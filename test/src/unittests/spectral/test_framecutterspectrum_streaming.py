@@ -0,0 +1,79 @@
+#!/usr/bin/env python
+
+# Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+#
+# This file is part of Essentia
+#
+# Essentia is free software: you can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the Free
+# Software Foundation (FSF), either version 3 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the Affero GNU General Public License
+# version 3 along with this program. If not, see http://www.gnu.org/licenses/
+
+
+
+from essentia_test import *
+import essentia.streaming as es
+
+class TestFrameCutterSpectrum_Streaming(TestCase):
+
+    def fused(self, input, **options):
+        gen = VectorInput(input)
+        pool = Pool()
+        spectrum = es.FrameCutterSpectrum(**options)
+        gen.data >> spectrum.signal
+        spectrum.spectrum >> (pool, 'spectrum')
+        run(gen)
+        if pool.descriptorNames(): return pool['spectrum']
+        return []
+
+    def chained(self, input, frameSize, hopSize, windowType, **options):
+        gen = VectorInput(input)
+        pool = Pool()
+        frameCutter = es.FrameCutter(frameSize=frameSize, hopSize=hopSize, **options)
+        spectrum = es.WindowedSpectrum(size=frameSize, type=windowType)
+        gen.data >> frameCutter.signal
+        frameCutter.frame >> spectrum.frame
+        spectrum.spectrum >> (pool, 'spectrum')
+        run(gen)
+        if pool.descriptorNames(): return pool['spectrum']
+        return []
+
+    def testSameAsFrameCutterWindowedSpectrum(self):
+        input = [sin(0.05*i) * (i % 7) / 7. for i in range(5000)]
+        # frames in the middle of the stream are views on the input buffer,
+        # the first and last ones are zero-padded
+        for frameSize, hopSize in [ (1024, 256), (512, 512), (300, 700) ]:
+            for startFromZero in [ True, False ]:
+                options = { 'silentFrames': 'keep', 'startFromZero': startFromZero }
+                self.assertEqualMatrix(
+                    self.fused(input, frameSize=frameSize, hopSize=hopSize,
+                               windowType='hamming', **options),
+                    self.chained(input, frameSize, hopSize, 'hamming', **options))
+
+    def testDropSilentFrames(self):
+        input = [0.]*4096 + [sin(0.1*i) for i in range(4096)]
+        options = { 'silentFrames': 'drop', 'startFromZero': True }
+        self.assertEqualMatrix(
+            self.fused(input, frameSize=1024, hopSize=512, windowType='hann', **options),
+            self.chained(input, 1024, 512, 'hann', **options))
+
+    def testEmpty(self):
+        self.assertEqualVector(self.fused([]), [])
+
+    def testInvalidParam(self):
+        self.assertConfigureFails(es.FrameCutterSpectrum(), { 'frameSize': 1 })
+        self.assertConfigureFails(es.FrameCutterSpectrum(), { 'validFrameThresholdRatio': 0.7 })
+
+
+suite = allTests(TestFrameCutterSpectrum_Streaming)
+
+if __name__ == '__main__':
+    TextTestRunner(verbosity=2).run(suite)
@@ -0,0 +1,77 @@
+#!/usr/bin/env python
+
+# Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+#
+# This file is part of Essentia
+#
+# Essentia is free software: you can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the Free
+# Software Foundation (FSF), either version 3 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the Affero GNU General Public License
+# version 3 along with this program. If not, see http://www.gnu.org/licenses/
+
+
+
+
+from essentia_test import *
+from numpy import random
+
+
+class TestMultiResolutionHPCP(TestCase):
+
+    def randomPeaks(self, n):
+        frequencies = sorted(random.rand(n) * 3000 + 50)
+        magnitudes = random.rand(n)
+        return array(frequencies), array(magnitudes)
+
+    def compareWithHPCP(self, sizes, **params):
+        multi = MultiResolutionHPCP(sizes=sizes, **params)
+        hpcps = [HPCP(size=size, **params) for size in sizes]
+
+        for i in range(10):
+            frequencies, magnitudes = self.randomPeaks(40)
+            outputs = multi(frequencies, magnitudes)
+            self.assertEqual(len(outputs), len(sizes))
+            for output, hpcp in zip(outputs, hpcps):
+                self.assertEqualVector(output, hpcp(frequencies, magnitudes))
+
+    def testSameAsHPCP(self):
+        self.compareWithHPCP([12, 36, 120])
+
+    def testSameAsHPCPWithHarmonics(self):
+        self.compareWithHPCP([36, 120], harmonics=8, bandPreset=True,
+                             weightType='cosine', nonLinear=True, windowSize=0.5)
+
+    def testSameAsHPCPWithoutWeighting(self):
+        self.compareWithHPCP([12, 24], harmonics=4, bandPreset=False, weightType='none')
+
+    def testSingleSize(self):
+        self.compareWithHPCP([36], maxShifted=True)
+
+    def testEmpty(self):
+        outputs = MultiResolutionHPCP(sizes=[12, 36])([], [])
+        self.assertEqualVector(outputs[0], zeros(12))
+        self.assertEqualVector(outputs[1], zeros(36))
+
+    def testInvalidParam(self):
+        self.assertConfigureFails(MultiResolutionHPCP(), {'sizes': []})
+        self.assertConfigureFails(MultiResolutionHPCP(), {'sizes': [12, 13]})
+        self.assertConfigureFails(MultiResolutionHPCP(), {'sizes': [12.5]})
+        # the window does not span a bin of the 12 bins HPCP
+        self.assertConfigureFails(MultiResolutionHPCP(), {'sizes': [12, 36], 'windowSize': 0.5})
+
+    def testSizeMismatch(self):
+        self.assertComputeFails(MultiResolutionHPCP(), [10, 200], [1])
+
+
+suite = allTests(TestMultiResolutionHPCP)
+
+if __name__ == '__main__':
+    TextTestRunner(verbosity=2).run(suite)
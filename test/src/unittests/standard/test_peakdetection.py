@@ -298,6 +298,37 @@ class TestPeakDetection(TestCase):
         self.assertEqualVector(posis, [peak1, peak3])
         self.assertEqualVector(vals, [4.0, 5.0])
 
+    def testThreshold(self):
+        # long runs of values (and plateaus) below the threshold are skipped,
+        # but peaks right after them must still be found
+        input = [0.1]*20 + [0.3, 0.2, 0.2, 0.2, 0.1] + [0.2]*9 + [0.9, 0.4] + [0.1]*5 + [0.5, 0.6]
+        inputSize = len(input)
+        config = { 'range': inputSize-1,  'maxPosition': inputSize-1, 'orderBy': 'position',
+                   'threshold': 0.25, 'interpolate': False }
+        pdetect = PeakDetection(**config)
+        (posis, vals) = pdetect(input)
+        self.assertEqualVector(posis, [20, 34, inputSize-1])
+        self.assertAlmostEqualVector(vals, [0.3, 0.9, 0.6])
+
+    def testMinPeakDistanceCascade(self):
+        # a peak removed by a larger one does not remove the smaller peaks
+        # around it, and reconfiguring does not keep the previous peaks
+        input = [0, 3, 0, 2, 0, 1, 0, 0, 0, 4, 0]
+        inputSize = len(input)
+        pdetect = PeakDetection()
+        for i in range(2):
+            pdetect.configure(range=inputSize-1, maxPosition=inputSize-1, orderBy='position',
+                              minPeakDistance=3.0, interpolate=False)
+            (posis, vals) = pdetect(input)
+            self.assertEqualVector(posis, [1, 5, 9])
+            self.assertEqualVector(vals, [3, 1, 4])
+
+        pdetect.configure(range=inputSize-1, maxPosition=inputSize-1, orderBy='amplitude',
+                          minPeakDistance=3.0, interpolate=False, maxPeaks=2)
+        (posis, vals) = pdetect(input)
+        self.assertEqualVector(posis, [9, 1])
+        self.assertEqualVector(vals, [4, 3])
+
 
 suite = allTests(TestPeakDetection)
 
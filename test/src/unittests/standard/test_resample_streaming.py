@@ -134,6 +134,27 @@ class TestResample_Streaming(TestCase):
     #    gen.data >> resample.signal
     #    resample.signal >> (pool, 'signal')
     #    self.assertRaises(RuntimeError, lambda: run(gen))
+    def testPolyphase(self):
+        # the streaming polyphase resampler gives the same samples as the
+        # standard one
+        for outputSampleRate in [16000, 22050, 4*44100]:
+            input = numpy.sin(0.01*numpy.arange(44100)).astype(numpy.float32)
+            expected = essentia.standard.Resample(inputSampleRate=44100,
+                                                  outputSampleRate=outputSampleRate,
+                                                  quality=5)(input)
+
+            resample = Resample(inputSampleRate=44100,
+                                outputSampleRate=outputSampleRate,
+                                quality=5)
+            pool = Pool()
+            gen = VectorInput(input)
+            gen.data >> resample.signal
+            resample.signal >> (pool, 'signal')
+            run(gen)
+
+            self.assertEqual(len(expected), len(input)*outputSampleRate//44100)
+            self.assertEqualVector(pool['signal'], expected)
+
 
 suite = allTests(TestResample_Streaming)
 
@@ -0,0 +1,76 @@
+#!/usr/bin/env python
+
+# Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+#
+# This file is part of Essentia
+#
+# Essentia is free software: you can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the Free
+# Software Foundation (FSF), either version 3 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the Affero GNU General Public License
+# version 3 along with this program. If not, see http://www.gnu.org/licenses/
+
+
+
+from essentia_test import *
+
+class TestWindowedSpectrum(TestCase):
+
+    def chained(self, signal, spectrumType='magnitude', **params):
+        windowed = Windowing(**params)(signal)
+        if spectrumType == 'magnitude':
+            return Spectrum(size=len(windowed))(windowed)
+        power = PowerSpectrum(size=len(windowed))(windowed)
+        if spectrumType == 'power':
+            return power
+        return UnaryOperator(type='lin2db')(power)
+
+    def testSameAsWindowingSpectrum(self):
+        input = readVector( join(filedir(), 'spectrum', 'input.txt') )
+
+        for windowType in ['hann', 'hamming', 'blackmanharris62', 'square']:
+            for zeroPhase in [True, False]:
+                params = { 'size': len(input), 'type': windowType,
+                           'zeroPhase': zeroPhase, 'zeroPadding': 16 }
+                self.assertEqualVector(WindowedSpectrum(**params)(input),
+                                       self.chained(input, **params))
+
+    def testSpectrumTypes(self):
+        input = readVector( join(filedir(), 'spectrum', 'input.txt') )
+
+        for spectrumType in ['power', 'db']:
+            result = WindowedSpectrum(size=len(input), spectrumType=spectrumType)(input)
+            expected = self.chained(input, spectrumType, size=len(input))
+            self.assertEqualVector(result, expected)
+
+    def testSizeChange(self):
+        # the window is recomputed if the frame size changes
+        algo = WindowedSpectrum(size=512, type='hann')
+        for size in [512, 100, 512]:
+            signal = [sin(0.1*i) for i in range(size)]
+            self.assertEqualVector(algo(signal),
+                                   self.chained(signal, size=size, type='hann'))
+
+    def testEmpty(self):
+        self.assertComputeFails(WindowedSpectrum(), [])
+
+    def testOne(self):
+        self.assertComputeFails(WindowedSpectrum(), [1])
+
+    def testOddSize(self):
+        self.assertComputeFails(WindowedSpectrum(), [1, 2, 3])
+
+    def testZero(self):
+        self.assertEqualVector(WindowedSpectrum()(zeros(1024)), zeros(513))
+
+suite = allTests(TestWindowedSpectrum)
+
+if __name__ == '__main__':
+    TextTestRunner(verbosity=2).run(suite)
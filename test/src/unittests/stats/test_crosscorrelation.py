@@ -90,6 +90,29 @@ class TestCrossCorrelation(TestCase):
 
         self.assertAlmostEqualVector(result, [0]*11)
 
+    def testFFT(self):
+        # the FFT method is only exact up to an error proportional to the
+        # energy of the inputs, hence the absolute tolerance
+        x = numpy.sin(numpy.arange(3000) * 0.013) + 0.3 * numpy.cos(numpy.arange(3000) * 0.41)
+        y = numpy.cos(numpy.arange(1500) * 0.027)
+        x = x.astype(numpy.float32)
+        y = y.astype(numpy.float32)
+
+        expected = numpy.correlate(x.astype(numpy.float64), y.astype(numpy.float64), 'full')
+        # numpy's full correlation starts at lag -(len(y)-1); pad with zeros
+        # for the lags without overlap
+        expected = numpy.concatenate([[0]*10, expected, [0]*10])
+
+        result = CrossCorrelation(minLag=-(len(y)-1)-10, maxLag=len(x)-1+10, method='fft')(x, y)
+        self.assertAlmostEqualVectorAbs(result, expected, 1e-2)
+
+        # the default, direct, computation is not affected by the lag range
+        direct = CrossCorrelation(minLag=-(len(y)-1)-10, maxLag=len(x)-1+10)(x, y)
+        self.assertAlmostEqualVectorAbs(direct, expected, 1e-3)
+
+        auto = CrossCorrelation(minLag=-(len(y)-1)-10, maxLag=len(x)-1+10, method='auto')(x, y)
+        self.assertAlmostEqualVectorAbs(auto, result, 1e-6)
+
 
 suite = allTests(TestCrossCorrelation)
 
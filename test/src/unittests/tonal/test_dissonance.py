@@ -106,6 +106,16 @@ class TestDissonance(TestCase):
         self.assertEqual(result2, 0)
         self.assertTrue(result1 > result2)
 
+    def testDistantPeaks(self):
+        # silent peaks further than a critical band away from the others do
+        # not change the dissonance
+        cFreq = 261.63
+        cisFreq = 277.18
+        result1 = Dissonance()([cFreq, cisFreq], [1, 1])
+        result2 = Dissonance()([60, 100, cFreq, cisFreq, 2000, 2000, 5000, 9000],
+                               [0, 0, 1, 1, 0, 0, 0, 0])
+        self.assertAlmostEqual(result1, result2)
+
     def testHigherOctave(self):
         # In general, roughness is more noticeable in lower octaves, thus
         cFreq = 261.63
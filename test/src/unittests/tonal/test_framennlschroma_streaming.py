@@ -0,0 +1,107 @@
+#!/usr/bin/env python
+
+# Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+#
+# This file is part of Essentia
+#
+# Essentia is free software: you can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the Free
+# Software Foundation (FSF), either version 3 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the Affero GNU General Public License
+# version 3 along with this program. If not, see http://www.gnu.org/licenses/
+
+
+
+from essentia_test import *
+import essentia.streaming as es
+
+class TestFrameNNLSChroma_Streaming(TestCase):
+
+    def spectra(self):
+        # a few seconds of harmonic notes, slightly out of tune
+        sr = 44100
+        audio = []
+        for note in range(6):
+            f = 220 * 2**(note / 12.) * 1.01
+            audio += [sum(sin(2*pi*f*k*i/sr) / k for k in range(1, 5)) * 0.2
+                      for i in range(sr // 2)]
+        w = Windowing(type='hann', normalized=False)
+        spectrum = Spectrum()
+        return [ spectrum(w(frame)) for frame in
+                 FrameGenerator(array(audio), frameSize=16384, hopSize=2048,
+                                startFromZero=True) ]
+
+    def streamingChroma(self, spectra, **options):
+        gen = VectorInput(spectra)
+        pool = Pool()
+        logSpectrum = es.LogSpectrum(frameSize=8193)
+        nnls = es.FrameNNLSChroma(frameSize=8193, **options)
+        gen.data >> logSpectrum.spectrum
+        logSpectrum.logFreqSpectrum >> nnls.logSpectrum
+        logSpectrum.meanTuning >> nnls.meanTuning
+        logSpectrum.localTuning >> nnls.localTuning
+        nnls.semitoneSpectrum >> (pool, 'semitone')
+        nnls.chromagram >> (pool, 'chroma')
+        nnls.bassChromagram >> (pool, 'bass')
+        nnls.tunedLogfreqSpectrum >> None
+        run(gen)
+        return pool
+
+    def standardChroma(self, spectra, **options):
+        logSpectrum = LogSpectrum(frameSize=8193)
+        frames, localTunings = [], []
+        for spectrum in spectra:
+            logFreqSpectrum, meanTuning, localTuning = logSpectrum(spectrum)
+            frames.append(logFreqSpectrum)
+            localTunings.append(localTuning)
+        _, semitone, bass, chroma = NNLSChroma(frameSize=8193, **options)(
+            array(frames), meanTuning, array(localTunings))
+        return semitone, bass, chroma
+
+    def testLocalTuningSameAsNNLSChroma(self):
+        # with the local tuning of each frame, results do not depend on the
+        # batch size and are the same as the ones of NNLSChroma
+        spectra = self.spectra()
+        for useNNLS in [ False, True ]:
+            semitone, bass, chroma = self.standardChroma(spectra, useNNLS=useNNLS, tuningMode='local')
+            for batchSize in [ 1, 5, 1000 ]:
+                pool = self.streamingChroma(spectra, useNNLS=useNNLS, tuningMode='local',
+                                            batchSize=batchSize)
+                self.assertEqualMatrix(pool['semitone'], semitone)
+                self.assertEqualMatrix(pool['chroma'], chroma)
+                self.assertEqualMatrix(pool['bass'], bass)
+
+    def testGlobalTuning(self):
+        # the tuning of the last frame is the one of the whole audio
+        spectra = self.spectra()
+        semitone, bass, chroma = self.standardChroma(spectra)
+        pool = self.streamingChroma(spectra)
+        self.assertEqual(len(pool['chroma']), len(chroma))
+        self.assertEqualVector(pool['chroma'][-1], chroma[-1])
+        self.assertEqualVector(pool['semitone'][-1], semitone[-1])
+
+        # with a bounded tuning estimation, all frames are produced too
+        pool = self.streamingChroma(spectra, tuningFrames=4)
+        self.assertEqual(len(pool['chroma']), len(chroma))
+
+    def testEmpty(self):
+        pool = self.streamingChroma([])
+        self.assertEqual(pool.descriptorNames(), [])
+
+    def testInvalidParam(self):
+        self.assertConfigureFails(es.FrameNNLSChroma(), { 'batchSize': 0 })
+        self.assertConfigureFails(es.FrameNNLSChroma(), { 'tuningFrames': -1 })
+        self.assertConfigureFails(es.FrameNNLSChroma(), { 'tuningMode': 'none' })
+
+
+suite = allTests(TestFrameNNLSChroma_Streaming)
+
+if __name__ == '__main__':
+    TextTestRunner(verbosity=2).run(suite)
@@ -0,0 +1,73 @@
+#!/usr/bin/env python
+
+# Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+#
+# This file is part of Essentia
+#
+# Essentia is free software: you can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the Free
+# Software Foundation (FSF), either version 3 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the Affero GNU General Public License
+# version 3 along with this program. If not, see http://www.gnu.org/licenses/
+
+
+
+
+from essentia_test import *
+from numpy import random
+
+
+class TestMultiProfileKey(TestCase):
+
+    def compareWithKey(self, profileTypes, pcpSize=36, **params):
+        multi = MultiProfileKey(profileTypes=profileTypes, pcpSize=pcpSize, **params)
+        keys = [Key(profileType=p, pcpSize=pcpSize, **params) for p in profileTypes]
+
+        for i in range(10):
+            pcp = random.rand(pcpSize)
+            outputs = multi(pcp)
+            self.assertEqual(len(outputs), 4*len(profileTypes))
+            for j, key in enumerate(keys):
+                expected = key(pcp)
+                self.assertEqual(outputs[4*j], expected[0])
+                self.assertEqual(outputs[4*j+1], expected[1])
+                self.assertEqual(outputs[4*j+2], expected[2])
+                self.assertEqual(outputs[4*j+3], expected[3])
+
+    def testSameAsKey(self):
+        self.compareWithKey(['temperley', 'krumhansl', 'edma'])
+
+    def testSameAsKeyMajMin(self):
+        self.compareWithKey(['edma', 'bgate', 'braw', 'shaath'], useMajMin=True)
+
+    def testSameAsKeyOtherSizes(self):
+        self.compareWithKey(['diatonic', 'noland', 'gomez'], pcpSize=12)
+        self.compareWithKey(['temperley2005', 'thpcp', 'edmm'], pcpSize=120)
+
+    def testSizeChange(self):
+        # the profiles are interpolated to the size of the input pcp
+        multi = MultiProfileKey(profileTypes=['temperley', 'krumhansl'], pcpSize=36)
+        key = Key(profileType='krumhansl', pcpSize=36)
+        pcp = random.rand(120)
+        self.assertEqual(multi(pcp)[4:], key(pcp))
+
+    def testInvalidParam(self):
+        self.assertConfigureFails(MultiProfileKey(), {'profileTypes': []})
+        self.assertConfigureFails(MultiProfileKey(), {'profileTypes': ['temperley', 'unknown']})
+
+    def testInvalidInput(self):
+        self.assertComputeFails(MultiProfileKey(), [])
+        self.assertComputeFails(MultiProfileKey(), [1]*13)
+
+
+suite = allTests(TestMultiProfileKey)
+
+if __name__ == '__main__':
+    TextTestRunner(verbosity=2).run(suite)
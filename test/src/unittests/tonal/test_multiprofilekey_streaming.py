@@ -0,0 +1,56 @@
+#!/usr/bin/env python
+
+# Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+#
+# This file is part of Essentia
+#
+# Essentia is free software: you can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the Free
+# Software Foundation (FSF), either version 3 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the Affero GNU General Public License
+# version 3 along with this program. If not, see http://www.gnu.org/licenses/
+
+
+
+
+from essentia_test import *
+from essentia.streaming import MultiProfileKey, Key
+from numpy import random
+
+
+class TestMultiProfileKey_Streaming(TestCase):
+
+    def testSameAsKey(self):
+        profileTypes = ['temperley', 'krumhansl', 'edma']
+        frames = random.rand(50, 36)
+
+        gen = VectorInput(frames)
+        multi = MultiProfileKey(profileTypes=profileTypes)
+        keys = [Key(profileType=p) for p in profileTypes]
+        pool = Pool()
+
+        gen.data >> multi.pcp
+        for i, key in enumerate(keys):
+            gen.data >> key.pcp
+            for output in ['key', 'scale', 'strength']:
+                getattr(multi, output + '_' + str(i)) >> (pool, 'multi.%s_%d' % (output, i))
+                getattr(key, output) >> (pool, 'key.%s_%d' % (output, i))
+        run(gen)
+
+        for i in range(len(profileTypes)):
+            for output in ['key', 'scale', 'strength']:
+                self.assertEqual(pool['multi.%s_%d' % (output, i)],
+                                 pool['key.%s_%d' % (output, i)])
+
+
+suite = allTests(TestMultiProfileKey_Streaming)
+
+if __name__ == '__main__':
+    TextTestRunner(verbosity=2).run(suite)
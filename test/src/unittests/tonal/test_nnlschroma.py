@@ -69,6 +69,42 @@ class TestNNLSChroma(TestCase):
             self.assertEqual(outs[0].sum() + outs[1].sum() + numpy.sum(outs[-2:]), .0)
             size = int(size/2)
 
+    def testNNLSActivations(self):
+        # note activations are non-negative, and explain a non-zero spectrum
+        logSpectrum = LogSpectrum(frameSize=8193)
+        frames = []
+        for i in range(4):
+            spectrum = zeros(8193)
+            spectrum[100 + 40*i::100 + 40*i] = 1.
+            logFreqSpectrum, meanTuning, _ = logSpectrum(spectrum)
+            frames.append(logFreqSpectrum)
+
+        _, semitoneSpectrum, _, chroma = NNLSChroma(frameSize=8193)(array(frames), meanTuning, array([]))
+        self.assertTrue((semitoneSpectrum >= 0).all())
+        self.assertTrue(semitoneSpectrum.sum() > 0)
+        self.assertTrue(chroma.sum() > 0)
+
+    def testFramesIndependent(self):
+        # the result of each frame does not depend on the other frames, nor on
+        # how they are split between threads
+        logSpectrum = LogSpectrum(frameSize=8193)
+        frames, localTunings = [], []
+        for i in range(40):
+            spectrum = zeros(8193)
+            spectrum[60 + 7*i::60 + 7*i] = 1.
+            spectrum[200 + 3*i::200 + 3*i] = .5
+            logFreqSpectrum, meanTuning, localTuning = logSpectrum(spectrum)
+            frames.append(logFreqSpectrum)
+            localTunings.append(localTuning)
+
+        nnlsChroma = NNLSChroma(frameSize=8193, tuningMode='local')
+        _, semitoneSpectrum, _, chroma = nnlsChroma(array(frames), meanTuning, array(localTunings))
+        for begin, end in [ (0, 1), (5, 6), (3, 20), (17, 40) ]:
+            _, semitonePart, _, chromaPart = nnlsChroma(array(frames[begin:end]), meanTuning,
+                                                        array(localTunings[begin:end]))
+            self.assertEqualMatrix(semitonePart, semitoneSpectrum[begin:end])
+            self.assertEqualMatrix(chromaPart, chroma[begin:end])
+
     def testInvalidInput(self):
         self.assertComputeFails(NNLSChroma(), array([array([])]), zeros(3), zeros(2))
         self.assertComputeFails(NNLSChroma(), array([array([0.5])]), zeros(3), zeros(2))